@@ -53,6 +53,7 @@
 #include "heaputl.h"
 #include "striutl.h"
 #include "str_rtl.h"
+#include "flt_rtl.h"
 #include "cmd_rtl.h"
 #include "cmd_drv.h"
 #include "rtl_err.h"
@@ -62,7 +63,24 @@
 #include "arr_rtl.h"
 
 
-#define QSORT_LIMIT 8
+#define QSORT_LIMIT 16
+#define NINTHER_LIMIT 128
+#define RADIX_SORT_THRESHOLD 64
+
+typedef enum {
+    SORT_WITH_FUNCTION, SORT_INTEGER, SORT_BINARY, SORT_CHAR,
+    SORT_FLOAT, SORT_STRING
+  } sortKindType;
+
+#define RADIX_SORTABLE(kind) ((kind) == SORT_INTEGER || (kind) == SORT_BINARY || (kind) == SORT_CHAR)
+
+intType intCmpValue (const rtlValueUnion value1, const rtlValueUnion value2);
+intType uintCmpValue (const rtlValueUnion value1, const rtlValueUnion value2);
+intType chrCmpValue (const rtlValueUnion value1, const rtlValueUnion value2);
+#if WITH_FLOAT
+intType fltCmpValue (const rtlValueUnion value1, const rtlValueUnion value2);
+#endif
+intType strCmpValue (const rtlValueUnion value1, const rtlValueUnion value2);
 
 
 
@@ -99,130 +117,495 @@ static void printArgv (const int argc, const cstriType *const argv)
 
 
 /**
- *  Sort an array of 'rtlObjectType' elements with the quicksort algorithm.
- *  In contrast to qsort() this function uses a different compare function.
- *  The compare function of qsort() has two void pointers as parameters.
+ *  Determine how the elements of an array are compared.
+ *  Arrays that are sorted with one of the compare functions of
+ *  integer, bin64, char, float or string are sorted without
+ *  calling cmp_func.
+ */
+static sortKindType sortKind (const compareFuncType cmp_func)
+
+  {
+    sortKindType kind;
+
+  /* sortKind */
+    if (cmp_func == &intCmpValue) {
+      kind = SORT_INTEGER;
+    } else if (cmp_func == &uintCmpValue) {
+      kind = SORT_BINARY;
+    } else if (cmp_func == &chrCmpValue) {
+      kind = SORT_CHAR;
+#if WITH_FLOAT
+    } else if (cmp_func == &fltCmpValue) {
+      kind = SORT_FLOAT;
+#endif
+    } else if (cmp_func == &strCmpValue) {
+      kind = SORT_STRING;
+    } else {
+      kind = SORT_WITH_FUNCTION;
+    } /* if */
+    return kind;
+  } /* sortKind */
+
+
+
+/**
+ *  Compare two values like cmp_func would do.
+ *  For the element types recognized by sortKind() the comparison
+ *  is done inline or with a direct call.
+ */
+static inline intType compareValues (const rtlValueUnion value1,
+    const rtlValueUnion value2, const sortKindType kind,
+    const compareFuncType cmp_func)
+
+  {
+    intType signumValue;
+
+  /* compareValues */
+    switch (kind) {
+      case SORT_INTEGER:
+        signumValue = (intType) (value1.intValue > value2.intValue) -
+                      (intType) (value1.intValue < value2.intValue);
+        break;
+      case SORT_BINARY:
+        signumValue = (intType) (value1.binaryValue > value2.binaryValue) -
+                      (intType) (value1.binaryValue < value2.binaryValue);
+        break;
+      case SORT_CHAR:
+        signumValue = (intType) (value1.charValue > value2.charValue) -
+                      (intType) (value1.charValue < value2.charValue);
+        break;
+#if WITH_FLOAT
+      case SORT_FLOAT:
+#if FLOAT_COMPARISON_OKAY
+        if (value1.floatValue < value2.floatValue) {
+          signumValue = -1;
+        } else if (value1.floatValue > value2.floatValue) {
+          signumValue = 1;
+        } else {
+          /* Equal values or at least one NaN. */
+          signumValue = fltCmp(value1.floatValue, value2.floatValue);
+        } /* if */
+#else
+        signumValue = fltCmp(value1.floatValue, value2.floatValue);
+#endif
+        break;
+#endif
+      case SORT_STRING:
+        signumValue = strCompare(value1.striValue, value2.striValue);
+        break;
+      default:
+        signumValue = cmp_func(value1, value2);
+        break;
+    } /* switch */
+    return signumValue;
+  } /* compareValues */
+
+
+
+/**
+ *  Sort an array of 'rtlObjectType' elements with insertion sort.
+ *  Insertion sort is stable and fast for small or nearly sorted arrays.
  *  @param begin_sort Pointer to first element to be sorted.
  *  @param end_sort Pointer to the last element to be sorted.
- *  @param cmp_func Pointer to a compare function that gets two values as
- *         'rtlValueUnion' and compares them.
  */
-static void rtl_qsort_array (rtlObjectType *begin_sort, rtlObjectType *end_sort,
+static void rtl_insertion_sort (rtlObjectType *begin_sort,
+    rtlObjectType *end_sort, const sortKindType kind,
     const compareFuncType cmp_func)
 
   {
-    rtlValueUnion compare_elem;
-    rtlValueUnion help_element;
+    rtlValueUnion insert_value;
+    rtlObjectType *next_elem;
+    rtlObjectType *insert_elem;
+
+  /* rtl_insertion_sort */
+    for (next_elem = begin_sort + 1; next_elem <= end_sort; next_elem++) {
+      insert_value = next_elem->value;
+      insert_elem = next_elem;
+      while (insert_elem != begin_sort &&
+             compareValues(insert_elem[-1].value, insert_value,
+                           kind, cmp_func) > 0) {
+        insert_elem->value = insert_elem[-1].value;
+        insert_elem--;
+      } /* while */
+      insert_elem->value = insert_value;
+    } /* for */
+  } /* rtl_insertion_sort */
+
+
+
+/**
+ *  Sort an array of 'rtlObjectType' elements with heapsort.
+ *  Heapsort is used by rtl_intro_sort() when the recursion gets too
+ *  deep. It guarantees O(n log n) also for adversarial input.
+ *  @param base Pointer to first element to be sorted.
+ *  @param size Number of elements to be sorted.
+ */
+static void rtl_heap_sort (rtlObjectType *base, memSizeType size,
+    const sortKindType kind, const compareFuncType cmp_func)
+
+  {
+    rtlValueUnion root_value;
+    memSizeType start = size >> 1;
+    memSizeType end = size;
+    memSizeType root;
+    memSizeType child;
+
+  /* rtl_heap_sort */
+    while (end > 1) {
+      if (start > 0) {
+        start--;
+        root_value = base[start].value;
+        root = start;
+      } else {
+        end--;
+        root_value = base[end].value;
+        base[end].value = base[0].value;
+        root = 0;
+      } /* if */
+      child = 2 * root + 1;
+      while (child < end) {
+        if (child + 1 < end &&
+            compareValues(base[child].value, base[child + 1].value,
+                          kind, cmp_func) < 0) {
+          child++;
+        } /* if */
+        if (compareValues(root_value, base[child].value,
+                          kind, cmp_func) < 0) {
+          base[root].value = base[child].value;
+          root = child;
+          child = 2 * root + 1;
+        } else {
+          child = end; /* leave while-loop */
+        } /* if */
+      } /* while */
+      base[root].value = root_value;
+    } /* while */
+  } /* rtl_heap_sort */
+
+
+
+static rtlObjectType *rtl_median_of_three (rtlObjectType *elem1,
+    rtlObjectType *elem2, rtlObjectType *elem3,
+    const sortKindType kind, const compareFuncType cmp_func)
+
+  {
+    rtlObjectType *median;
+
+  /* rtl_median_of_three */
+    if (compareValues(elem1->value, elem2->value, kind, cmp_func) < 0) {
+      if (compareValues(elem2->value, elem3->value, kind, cmp_func) < 0) {
+        median = elem2;
+      } else if (compareValues(elem1->value, elem3->value, kind, cmp_func) < 0) {
+        median = elem3;
+      } else {
+        median = elem1;
+      } /* if */
+    } else {
+      if (compareValues(elem1->value, elem3->value, kind, cmp_func) < 0) {
+        median = elem1;
+      } else if (compareValues(elem2->value, elem3->value, kind, cmp_func) < 0) {
+        median = elem3;
+      } else {
+        median = elem2;
+      } /* if */
+    } /* if */
+    return median;
+  } /* rtl_median_of_three */
+
+
+
+/**
+ *  Sort an array of 'rtlObjectType' elements with introsort.
+ *  The pivot is the median of three elements or for large arrays the
+ *  median of three medians (ninther). Hoare partitioning splits runs
+ *  of equal elements evenly. The smaller partition is sorted
+ *  recursively and the larger one iteratively. When depth_limit is
+ *  exhausted heapsort takes over.
+ *  @param begin_sort Pointer to first element to be sorted.
+ *  @param end_sort Pointer to the last element to be sorted.
+ *  @param depth_limit Number of partitioning levels before heapsort
+ *         is used.
+ */
+static void rtl_intro_sort (rtlObjectType *begin_sort, rtlObjectType *end_sort,
+    const sortKindType kind, const compareFuncType cmp_func,
+    unsigned int depth_limit)
+
+  {
+    rtlValueUnion pivot;
+    rtlValueUnion help_value;
+    memSizeType step;
     rtlObjectType *middle_elem;
+    rtlObjectType *pivot_elem;
     rtlObjectType *less_elem;
     rtlObjectType *greater_elem;
-    intType cmp;
 
-  /* rtl_qsort_array */
-    if (end_sort - begin_sort < QSORT_LIMIT) {
-      /* Use insertion sort */
-      for (middle_elem = begin_sort + 1; middle_elem <= end_sort; middle_elem++) {
-        compare_elem = middle_elem->value;
+  /* rtl_intro_sort */
+    while (end_sort - begin_sort >= QSORT_LIMIT) {
+      if (depth_limit == 0) {
+        rtl_heap_sort(begin_sort, (memSizeType) (end_sort - begin_sort) + 1,
+                      kind, cmp_func);
+        end_sort = begin_sort; /* leave while-loop */
+      } else {
+        depth_limit--;
+        middle_elem = &begin_sort[(memSizeType) (end_sort - begin_sort) >> 1];
+        if (end_sort - begin_sort >= NINTHER_LIMIT) {
+          step = (memSizeType) (end_sort - begin_sort) >> 3;
+          pivot_elem = rtl_median_of_three(
+              rtl_median_of_three(begin_sort, &begin_sort[step],
+                                  &begin_sort[2 * step], kind, cmp_func),
+              rtl_median_of_three(middle_elem - step, middle_elem,
+                                  middle_elem + step, kind, cmp_func),
+              rtl_median_of_three(end_sort - 2 * step, end_sort - step,
+                                  end_sort, kind, cmp_func),
+              kind, cmp_func);
+        } else {
+          pivot_elem = rtl_median_of_three(begin_sort, middle_elem,
+                                           end_sort, kind, cmp_func);
+        } /* if */
+        /* Moving the pivot to the front guarantees that both  */
+        /* partitions are non-empty.                           */
+        pivot = pivot_elem->value;
+        pivot_elem->value = begin_sort->value;
+        begin_sort->value = pivot;
         less_elem = begin_sort - 1;
+        greater_elem = end_sort + 1;
         do {
-          less_elem++;
-          cmp = cmp_func(less_elem->value, compare_elem);
-        } while (cmp < 0);
-        memmove(&less_elem[1], less_elem, (memSizeType)
-                (middle_elem - less_elem) * sizeof(rtlObjectType));
-        less_elem->value = compare_elem;
-      } /* for */
+          do {
+            less_elem++;
+          } while (compareValues(less_elem->value, pivot, kind, cmp_func) < 0);
+          do {
+            greater_elem--;
+          } while (compareValues(greater_elem->value, pivot, kind, cmp_func) > 0);
+          if (less_elem < greater_elem) {
+            help_value = less_elem->value;
+            less_elem->value = greater_elem->value;
+            greater_elem->value = help_value;
+          } /* if */
+        } while (less_elem < greater_elem);
+        if (greater_elem - begin_sort < end_sort - greater_elem) {
+          rtl_intro_sort(begin_sort, greater_elem, kind, cmp_func, depth_limit);
+          begin_sort = greater_elem + 1;
+        } else {
+          rtl_intro_sort(greater_elem + 1, end_sort, kind, cmp_func, depth_limit);
+          end_sort = greater_elem;
+        } /* if */
+      } /* if */
+    } /* while */
+    rtl_insertion_sort(begin_sort, end_sort, kind, cmp_func);
+  } /* rtl_intro_sort */
+
+
+
+/**
+ *  Sort an array of integer, bin64 or char elements with LSD radix sort.
+ *  The values are mapped to unsigned keys with the same order. Each
+ *  pass distributes the elements by one byte of the key. Passes where
+ *  all keys have the same byte are skipped. Radix sort is stable.
+ *  @param arr Pointer to first element to be sorted.
+ *  @param size Number of elements to be sorted.
+ *  @return TRUE if the array has been sorted, or
+ *          FALSE if there was not enough memory.
+ */
+static boolType rtl_radix_sort (rtlObjectType *arr, memSizeType size,
+    const sortKindType kind)
+
+  {
+    memSizeType count[sizeof(uintType)][256];
+    const uintType signBit = ~(~(uintType) 0 >> 1);
+    rtlObjectType *buffer;
+    rtlObjectType *source;
+    rtlObjectType *dest;
+    rtlObjectType *help_ptr;
+    uintType key;
+    charType ch;
+    memSizeType pos;
+    memSizeType digit;
+    memSizeType bucket;
+    memSizeType sum;
+    memSizeType bucket_size;
+    boolType okay;
+
+  /* rtl_radix_sort */
+    if (unlikely(!ALLOC_TABLE(buffer, rtlObjectType, size))) {
+      okay = FALSE;
     } else {
-      middle_elem = &begin_sort[((memSizeType)(end_sort - begin_sort)) >> 1];
-      compare_elem = middle_elem->value;
-      middle_elem->value = end_sort->value;
-      end_sort->value = compare_elem;
-      less_elem = begin_sort - 1;
-      greater_elem = end_sort;
-      do {
-        do {
-          less_elem++;
-          cmp = cmp_func(less_elem->value, compare_elem);
-        } while (cmp < 0);
-        do {
-          greater_elem--;
-          cmp = cmp_func(greater_elem->value, compare_elem);
-        } while (cmp > 0 && greater_elem != begin_sort);
-        help_element = less_elem->value;
-        less_elem->value = greater_elem->value;
-        greater_elem->value = help_element;
-      } while (greater_elem > less_elem);
-      greater_elem->value = less_elem->value;
-      less_elem->value = compare_elem;
-      end_sort->value = help_element;
-      rtl_qsort_array(begin_sort, less_elem - 1, cmp_func);
-      rtl_qsort_array(less_elem + 1, end_sort, cmp_func);
+      if (kind == SORT_INTEGER) {
+        for (pos = 0; pos < size; pos++) {
+          arr[pos].value.binaryValue = (uintType) arr[pos].value.intValue ^ signBit;
+        } /* for */
+      } else if (kind == SORT_CHAR) {
+        for (pos = 0; pos < size; pos++) {
+          ch = arr[pos].value.charValue;
+          arr[pos].value.binaryValue = (uintType) ch;
+        } /* for */
+      } /* if */
+      memset(count, 0, sizeof(count));
+      for (pos = 0; pos < size; pos++) {
+        key = arr[pos].value.binaryValue;
+        for (digit = 0; digit < sizeof(uintType); digit++) {
+          count[digit][key & 0xFF]++;
+          key >>= 8;
+        } /* for */
+      } /* for */
+      source = arr;
+      dest = buffer;
+      for (digit = 0; digit < sizeof(uintType); digit++) {
+        if (count[digit][(source[0].value.binaryValue >> (digit * 8)) & 0xFF] != size) {
+          sum = 0;
+          for (bucket = 0; bucket < 256; bucket++) {
+            bucket_size = count[digit][bucket];
+            count[digit][bucket] = sum;
+            sum += bucket_size;
+          } /* for */
+          for (pos = 0; pos < size; pos++) {
+            bucket = (memSizeType) (source[pos].value.binaryValue >> (digit * 8)) & 0xFF;
+            dest[count[digit][bucket]++] = source[pos];
+          } /* for */
+          help_ptr = source;
+          source = dest;
+          dest = help_ptr;
+        } /* if */
+      } /* for */
+      if (source != arr) {
+        memcpy(arr, source, size * sizeof(rtlObjectType));
+      } /* if */
+      FREE_TABLE(buffer, rtlObjectType, size);
+      if (kind == SORT_INTEGER) {
+        for (pos = 0; pos < size; pos++) {
+          arr[pos].value.intValue = (intType) (arr[pos].value.binaryValue ^ signBit);
+        } /* for */
+      } else if (kind == SORT_CHAR) {
+        for (pos = 0; pos < size; pos++) {
+          key = arr[pos].value.binaryValue;
+          arr[pos].value.charValue = (charType) key;
+        } /* for */
+      } /* if */
+      okay = TRUE;
     } /* if */
-  } /* rtl_qsort_array */
+    return okay;
+  } /* rtl_radix_sort */
 
 
 
 /**
- *  Reverse sort an array of 'rtlObjectType' elements with the quicksort algorithm.
- *  In contrast to qsort() this function uses a different compare function.
- *  The compare function of qsort() has two void pointers as parameters.
+ *  Sort an array of 'rtlObjectType' elements with merge sort.
+ *  Merge sort is stable. Merging is skipped if the two sorted halves
+ *  are already in order.
  *  @param begin_sort Pointer to first element to be sorted.
- *  @param end_sort Pointer to the last element to be sorted.
+ *  @param size Number of elements to be sorted.
+ *  @param buffer Temporary space for size / 2 elements.
+ */
+static void rtl_merge_sort (rtlObjectType *begin_sort, memSizeType size,
+    rtlObjectType *buffer, const sortKindType kind,
+    const compareFuncType cmp_func)
+
+  {
+    memSizeType half;
+    rtlObjectType *left;
+    rtlObjectType *left_end;
+    rtlObjectType *right;
+    rtlObjectType *right_end;
+    rtlObjectType *dest;
+
+  /* rtl_merge_sort */
+    if (size <= QSORT_LIMIT) {
+      rtl_insertion_sort(begin_sort, &begin_sort[size - 1], kind, cmp_func);
+    } else {
+      half = size >> 1;
+      rtl_merge_sort(begin_sort, half, buffer, kind, cmp_func);
+      rtl_merge_sort(&begin_sort[half], size - half, buffer, kind, cmp_func);
+      if (compareValues(begin_sort[half - 1].value, begin_sort[half].value,
+                        kind, cmp_func) > 0) {
+        memcpy(buffer, begin_sort, half * sizeof(rtlObjectType));
+        left = buffer;
+        left_end = &buffer[half];
+        right = &begin_sort[half];
+        right_end = &begin_sort[size];
+        dest = begin_sort;
+        while (left < left_end && right < right_end) {
+          if (compareValues(right->value, left->value, kind, cmp_func) < 0) {
+            *dest = *right;
+            right++;
+          } else {
+            *dest = *left;
+            left++;
+          } /* if */
+          dest++;
+        } /* while */
+        memcpy(dest, left, (memSizeType) (left_end - left) * sizeof(rtlObjectType));
+      } /* if */
+    } /* if */
+  } /* rtl_merge_sort */
+
+
+
+static void rtl_reverse_array (rtlObjectType *begin_reverse,
+    rtlObjectType *end_reverse)
+
+  {
+    rtlValueUnion help_value;
+
+  /* rtl_reverse_array */
+    while (begin_reverse < end_reverse) {
+      help_value = begin_reverse->value;
+      begin_reverse->value = end_reverse->value;
+      end_reverse->value = help_value;
+      begin_reverse++;
+      end_reverse--;
+    } /* while */
+  } /* rtl_reverse_array */
+
+
+
+/**
+ *  Sort an array of 'rtlObjectType' elements.
+ *  Integer, bin64 and char arrays are sorted with radix sort. Other
+ *  arrays are checked for an ascending or descending order first and
+ *  sorted with introsort afterwards.
+ *  @param arr Pointer to first element to be sorted.
+ *  @param size Number of elements to be sorted.
  *  @param cmp_func Pointer to a compare function that gets two values as
  *         'rtlValueUnion' and compares them.
  */
-static void rtl_qsort_array_reverse (rtlObjectType *begin_sort, rtlObjectType *end_sort,
+static void rtl_sort_array (rtlObjectType *arr, memSizeType size,
     const compareFuncType cmp_func)
 
   {
-    rtlValueUnion compare_elem;
-    rtlValueUnion help_element;
-    rtlObjectType *middle_elem;
-    rtlObjectType *less_elem;
-    rtlObjectType *greater_elem;
-    intType cmp;
-
-  /* rtl_qsort_array_reverse */
-    if (end_sort - begin_sort < QSORT_LIMIT) {
-      /* Use insertion sort */
-      for (middle_elem = begin_sort + 1; middle_elem <= end_sort; middle_elem++) {
-        compare_elem = middle_elem->value;
-        greater_elem = begin_sort - 1;
-        do {
-          greater_elem++;
-          cmp = cmp_func(greater_elem->value, compare_elem);
-        } while (cmp > 0);
-        memmove(&greater_elem[1], greater_elem, (memSizeType)
-                (middle_elem - greater_elem) * sizeof(rtlObjectType));
-        greater_elem->value = compare_elem;
-      } /* for */
-    } else {
-      middle_elem = &begin_sort[((memSizeType)(end_sort - begin_sort)) >> 1];
-      compare_elem = middle_elem->value;
-      middle_elem->value = end_sort->value;
-      end_sort->value = compare_elem;
-      greater_elem = begin_sort - 1;
-      less_elem = end_sort;
-      do {
-        do {
-          greater_elem++;
-          cmp = cmp_func(greater_elem->value, compare_elem);
-        } while (cmp > 0);
-        do {
-          less_elem--;
-          cmp = cmp_func(less_elem->value, compare_elem);
-        } while (cmp < 0 && less_elem != begin_sort);
-        help_element = greater_elem->value;
-        greater_elem->value = less_elem->value;
-        less_elem->value = help_element;
-      } while (less_elem > greater_elem);
-      less_elem->value = greater_elem->value;
-      greater_elem->value = compare_elem;
-      end_sort->value = help_element;
-      rtl_qsort_array_reverse(begin_sort, greater_elem - 1, cmp_func);
-      rtl_qsort_array_reverse(greater_elem + 1, end_sort, cmp_func);
+    sortKindType kind;
+    memSizeType pos;
+    memSizeType length;
+    unsigned int depth_limit = 0;
+
+  /* rtl_sort_array */
+    if (size >= 2) {
+      kind = sortKind(cmp_func);
+      if (size < RADIX_SORT_THRESHOLD || !RADIX_SORTABLE(kind) ||
+          !rtl_radix_sort(arr, size, kind)) {
+        pos = 1;
+        while (pos < size &&
+               compareValues(arr[pos - 1].value, arr[pos].value,
+                             kind, cmp_func) <= 0) {
+          pos++;
+        } /* while */
+        if (pos == 1) {
+          while (pos < size &&
+                 compareValues(arr[pos - 1].value, arr[pos].value,
+                               kind, cmp_func) > 0) {
+            pos++;
+          } /* while */
+          if (pos == size) {
+            rtl_reverse_array(arr, &arr[size - 1]);
+          } /* if */
+        } /* if */
+        if (pos < size) {
+          for (length = size; length > 1; length >>= 1) {
+            depth_limit += 2;
+          } /* for */
+          rtl_intro_sort(arr, &arr[size - 1], kind, cmp_func, depth_limit);
+        } /* if */
+      } /* if */
     } /* if */
-  } /* rtl_qsort_array_reverse */
+  } /* rtl_sort_array */
 
 
 
@@ -2052,6 +2435,16 @@ rtlArrayType arrRemoveArray (rtlArrayType *arr_to, intType position, intType len
 
 
 
+/**
+ *  Sort an array with the given compare function.
+ *  Arrays of integer, bin64 and char elements are sorted with radix
+ *  sort. Other arrays are sorted with introsort. Arrays of float and
+ *  string elements are compared without calling cmp_func.
+ *  The sort is not stable.
+ *  @param arr1 Array to be sorted. The array is sorted in place.
+ *  @param cmp_func Compare function for the elements.
+ *  @return the sorted array arr1.
+ */
 rtlArrayType arrSort (rtlArrayType arr1, const compareFuncType cmp_func)
 
   { /* arrSort */
@@ -2061,27 +2454,87 @@ rtlArrayType arrSort (rtlArrayType arr1, const compareFuncType cmp_func)
                        arr1 != NULL ? arr1->min_position : (intType) 1,
                        arr1 != NULL ? arr1->max_position : (intType) 0,
                        (memSizeType) cmp_func););
-    rtl_qsort_array(arr1->arr, &arr1->arr[arr1->max_position - arr1->min_position], cmp_func);
+    rtl_sort_array(arr1->arr, arraySize(arr1), cmp_func);
     return arr1;
   } /* arrSort */
 
 
 
+/**
+ *  Reverse sort an array with the given compare function.
+ *  The array is sorted like arrSort() does and reversed afterwards.
+ *  The sort is not stable.
+ *  @param arr1 Array to be sorted. The array is sorted in place.
+ *  @param cmp_func Compare function for the elements.
+ *  @return the reverse sorted array arr1.
+ */
 rtlArrayType arrSortReverse (rtlArrayType arr1, const compareFuncType cmp_func)
 
-  { /* arrSortReverse */
+  {
+    memSizeType size;
+
+  /* arrSortReverse */
     logFunction(printf("arrSortReverse(" FMT_U_MEM " (array[" FMT_D
                                        " .. " FMT_D "]), " FMT_U_MEM ")\n",
                        (memSizeType) arr1,
                        arr1 != NULL ? arr1->min_position : (intType) 1,
                        arr1 != NULL ? arr1->max_position : (intType) 0,
                        (memSizeType) cmp_func););
-    rtl_qsort_array_reverse(arr1->arr, &arr1->arr[arr1->max_position - arr1->min_position], cmp_func);
+    size = arraySize(arr1);
+    if (size >= 2) {
+      rtl_sort_array(arr1->arr, size, cmp_func);
+      rtl_reverse_array(arr1->arr, &arr1->arr[size - 1]);
+    } /* if */
     return arr1;
   } /* arrSortReverse */
 
 
 
+/**
+ *  Sort an array with the given compare function and keep the
+ *  relative order of elements that are considered equal.
+ *  Arrays of integer, bin64 and char elements are sorted with radix
+ *  sort. Other arrays are sorted with merge sort.
+ *  @param arr1 Array to be sorted. The array is sorted in place.
+ *  @param cmp_func Compare function for the elements.
+ *  @return the sorted array arr1.
+ *  @exception MEMORY_ERROR Not enough memory for the merge buffer.
+ */
+rtlArrayType arrSortStable (rtlArrayType arr1, const compareFuncType cmp_func)
+
+  {
+    memSizeType size;
+    sortKindType kind;
+    rtlObjectType *buffer;
+
+  /* arrSortStable */
+    logFunction(printf("arrSortStable(" FMT_U_MEM " (array[" FMT_D
+                                      " .. " FMT_D "]), " FMT_U_MEM ")\n",
+                       (memSizeType) arr1,
+                       arr1 != NULL ? arr1->min_position : (intType) 1,
+                       arr1 != NULL ? arr1->max_position : (intType) 0,
+                       (memSizeType) cmp_func););
+    size = arraySize(arr1);
+    kind = sortKind(cmp_func);
+    if (size < RADIX_SORT_THRESHOLD || !RADIX_SORTABLE(kind) ||
+        !rtl_radix_sort(arr1->arr, size, kind)) {
+      if (size > QSORT_LIMIT) {
+        if (unlikely(!ALLOC_TABLE(buffer, rtlObjectType, size >> 1))) {
+          logError(printf("arrSortStable: ALLOC_TABLE() failed.\n"););
+          raise_error(MEMORY_ERROR);
+        } else {
+          rtl_merge_sort(arr1->arr, size, buffer, kind, cmp_func);
+          FREE_TABLE(buffer, rtlObjectType, size >> 1);
+        } /* if */
+      } else if (size >= 2) {
+        rtl_insertion_sort(arr1->arr, &arr1->arr[size - 1], kind, cmp_func);
+      } /* if */
+    } /* if */
+    return arr1;
+  } /* arrSortStable */
+
+
+
 /**
  *  Get a sub array from the position 'start' with maximum length 'length'.
  *  @return the sub array from position 'start' with maximum length 'length'.
@@ -66,6 +66,7 @@ rtlValueUnion arrRemove (rtlArrayType *arr_to, intType position);
 rtlArrayType arrRemoveArray (rtlArrayType *arr_to, intType position, intType length);
 rtlArrayType arrSort (rtlArrayType arr1, const compareFuncType cmp_func);
 rtlArrayType arrSortReverse (rtlArrayType arr1, const compareFuncType cmp_func);
+rtlArrayType arrSortStable (rtlArrayType arr1, const compareFuncType cmp_func);
 rtlArrayType arrSubarr (const const_rtlArrayType arr1, intType start, intType len);
 rtlArrayType arrSubarrTemp (rtlArrayType *arr_temp, intType start, intType len);
 rtlArrayType arrTail (const const_rtlArrayType arr1, intType start);
@@ -43,159 +43,403 @@
 #include "executl.h"
 #include "objutl.h"
 #include "runerr.h"
+#include "intlib.h"
+#include "chrlib.h"
+#include "fltlib.h"
+#include "strlib.h"
+#include "flt_rtl.h"
+#include "str_rtl.h"
 
 #undef EXTERN
 #define EXTERN
 #include "arrlib.h"
 
 
-#define QSORT_LIMIT 8
+#define QSORT_LIMIT 16
+#define NINTHER_LIMIT 128
+
+typedef enum {
+    SORT_WITH_FUNCTION, SORT_INTEGER, SORT_CHAR, SORT_FLOAT, SORT_STRING
+  } sortKindType;
+
+
+
+/**
+ *  Determine how the elements of an array are compared.
+ *  Arrays that are sorted with the compare function of integer, char,
+ *  float or string are sorted without calling cmp_func.
+ */
+static sortKindType sortKind (const objectType cmp_func)
+
+  {
+    actType action;
+    sortKindType kind = SORT_WITH_FUNCTION;
+
+  /* sortKind */
+    if (CATEGORY_OF_OBJ(cmp_func) == ACTOBJECT) {
+      action = take_action(cmp_func);
+      if (action == int_cmp) {
+        kind = SORT_INTEGER;
+      } else if (action == chr_cmp) {
+        kind = SORT_CHAR;
+#if WITH_FLOAT
+      } else if (action == flt_cmp) {
+        kind = SORT_FLOAT;
+#endif
+      } else if (action == str_cmp) {
+        kind = SORT_STRING;
+      } /* if */
+    } /* if */
+    return kind;
+  } /* sortKind */
+
+
+
+/**
+ *  Compare two objects like the compare function cmp_func would do.
+ *  For the element types recognized by sortKind() the comparison
+ *  is done without calling cmp_func.
+ */
+static inline intType compareObjects (const objectType object1,
+    const objectType object2, const sortKindType kind,
+    const objectType cmp_func)
+
+  {
+    objectType cmp_obj;
+    intType signumValue;
+
+  /* compareObjects */
+    switch (kind) {
+      case SORT_INTEGER:
+        signumValue = (intType) (take_int(object1) > take_int(object2)) -
+                      (intType) (take_int(object1) < take_int(object2));
+        break;
+      case SORT_CHAR:
+        signumValue = (intType) (take_char(object1) > take_char(object2)) -
+                      (intType) (take_char(object1) < take_char(object2));
+        break;
+#if WITH_FLOAT
+      case SORT_FLOAT:
+        signumValue = fltCmp(take_float(object1), take_float(object2));
+        break;
+#endif
+      case SORT_STRING:
+        signumValue = strCompare(take_stri(object1), take_stri(object2));
+        break;
+      default:
+        cmp_obj = param3_call(cmp_func, object1, object2, cmp_func);
+        isit_int2(cmp_obj);
+        signumValue = take_int(cmp_obj);
+        FREE_OBJECT(cmp_obj);
+        break;
+    } /* switch */
+    return signumValue;
+  } /* compareObjects */
 
 
 
 /**
- *  Sort an array of 'objectRecord' elements with the quicksort algorithm.
- *  In contrast to qsort() this function uses a different compare function.
- *  The compare function of qsort() has two void pointers as parameters.
+ *  Sort an array of 'objectRecord' elements with insertion sort.
+ *  Insertion sort is stable and fast for small or nearly sorted arrays.
  *  @param begin_sort Pointer to first element to be sorted.
  *  @param end_sort Pointer to the last element to be sorted.
- *  @param cmp_func Object describing the compare function to be used.
  */
-static void qsort_array (objectType begin_sort, objectType end_sort,
-    objectType cmp_func)
+static void insertion_sort (objectType begin_sort, objectType end_sort,
+    const sortKindType kind, const objectType cmp_func)
 
   {
-    objectRecord compare_elem;
-    objectRecord help_element;
-    objectType middle_elem;
-    objectType less_elem;
-    objectType greater_elem;
-    objectType cmp_obj;
-    intType cmp;
+    objectRecord insert_elem;
+    objectType next_elem;
+    objectType insert_pos;
+
+  /* insertion_sort */
+    for (next_elem = begin_sort + 1; next_elem <= end_sort; next_elem++) {
+      insert_elem = *next_elem;
+      insert_pos = next_elem;
+      while (insert_pos != begin_sort &&
+             compareObjects(&insert_pos[-1], &insert_elem,
+                            kind, cmp_func) > 0) {
+        *insert_pos = insert_pos[-1];
+        insert_pos--;
+      } /* while */
+      *insert_pos = insert_elem;
+    } /* for */
+  } /* insertion_sort */
 
-  /* qsort_array */
-    if (end_sort - begin_sort < QSORT_LIMIT) {
-      /* Use insertion sort */
-      for (middle_elem = begin_sort + 1; middle_elem <= end_sort; middle_elem++) {
-        compare_elem = *middle_elem;
-        less_elem = begin_sort - 1;
-        do {
-          less_elem++;
-          cmp_obj = param3_call(cmp_func, less_elem, &compare_elem, cmp_func);
-          isit_int2(cmp_obj);
-          cmp = take_int(cmp_obj);
-          FREE_OBJECT(cmp_obj);
-        } while (cmp < 0);
-        memmove(&less_elem[1], less_elem,
-                (memSizeType) (middle_elem - less_elem) * sizeof(objectRecord));
-        *less_elem = compare_elem;
-      } /* for */
+
+
+/**
+ *  Sort an array of 'objectRecord' elements with heapsort.
+ *  Heapsort is used by intro_sort() when the recursion gets too
+ *  deep. It guarantees O(n log n) also for adversarial input.
+ *  @param base Pointer to first element to be sorted.
+ *  @param size Number of elements to be sorted.
+ */
+static void heap_sort (objectType base, memSizeType size,
+    const sortKindType kind, const objectType cmp_func)
+
+  {
+    objectRecord root_elem;
+    memSizeType start = size >> 1;
+    memSizeType end = size;
+    memSizeType root;
+    memSizeType child;
+
+  /* heap_sort */
+    while (end > 1) {
+      if (start > 0) {
+        start--;
+        root_elem = base[start];
+        root = start;
+      } else {
+        end--;
+        root_elem = base[end];
+        base[end] = base[0];
+        root = 0;
+      } /* if */
+      child = 2 * root + 1;
+      while (child < end) {
+        if (child + 1 < end &&
+            compareObjects(&base[child], &base[child + 1],
+                           kind, cmp_func) < 0) {
+          child++;
+        } /* if */
+        if (compareObjects(&root_elem, &base[child], kind, cmp_func) < 0) {
+          base[root] = base[child];
+          root = child;
+          child = 2 * root + 1;
+        } else {
+          child = end; /* leave while-loop */
+        } /* if */
+      } /* while */
+      base[root] = root_elem;
+    } /* while */
+  } /* heap_sort */
+
+
+
+static objectType median_of_three (objectType elem1,
+    objectType elem2, objectType elem3,
+    const sortKindType kind, const objectType cmp_func)
+
+  {
+    objectType median;
+
+  /* median_of_three */
+    if (compareObjects(elem1, elem2, kind, cmp_func) < 0) {
+      if (compareObjects(elem2, elem3, kind, cmp_func) < 0) {
+        median = elem2;
+      } else if (compareObjects(elem1, elem3, kind, cmp_func) < 0) {
+        median = elem3;
+      } else {
+        median = elem1;
+      } /* if */
     } else {
-      middle_elem = &begin_sort[(memSizeType) (end_sort - begin_sort) >> 1];
-      compare_elem = *middle_elem;
-      *middle_elem = *end_sort;
-      *end_sort = compare_elem;
-      less_elem = begin_sort - 1;
-      greater_elem = end_sort;
-      do {
-        do {
-          less_elem++;
-          cmp_obj = param3_call(cmp_func, less_elem, &compare_elem, cmp_func);
-          isit_int2(cmp_obj);
-          cmp = take_int(cmp_obj);
-          FREE_OBJECT(cmp_obj);
-        } while (cmp < 0);
-        do {
-          greater_elem--;
-          cmp_obj = param3_call(cmp_func, greater_elem, &compare_elem, cmp_func);
-          isit_int2(cmp_obj);
-          cmp = take_int(cmp_obj);
-          FREE_OBJECT(cmp_obj);
-        } while (cmp > 0 && greater_elem != begin_sort);
-        help_element = *less_elem;
-        *less_elem = *greater_elem;
-        *greater_elem = help_element;
-      } while (greater_elem > less_elem);
-      *greater_elem = *less_elem;
-      *less_elem = compare_elem;
-      *end_sort = help_element;
-      qsort_array(begin_sort, less_elem - 1, cmp_func);
-      qsort_array(less_elem + 1, end_sort, cmp_func);
+      if (compareObjects(elem1, elem3, kind, cmp_func) < 0) {
+        median = elem1;
+      } else if (compareObjects(elem2, elem3, kind, cmp_func) < 0) {
+        median = elem3;
+      } else {
+        median = elem2;
+      } /* if */
     } /* if */
-  } /* qsort_array */
+    return median;
+  } /* median_of_three */
 
 
 
 /**
- *  Reverse sort an array of 'objectRecord' elements with the quicksort algorithm.
- *  In contrast to qsort() this function uses a different compare function.
- *  The compare function of qsort() has two void pointers as parameters.
+ *  Sort an array of 'objectRecord' elements with introsort.
+ *  The pivot is the median of three elements or for large arrays the
+ *  median of three medians (ninther). Hoare partitioning splits runs
+ *  of equal elements evenly. The smaller partition is sorted
+ *  recursively and the larger one iteratively. When depth_limit is
+ *  exhausted heapsort takes over.
  *  @param begin_sort Pointer to first element to be sorted.
  *  @param end_sort Pointer to the last element to be sorted.
- *  @param cmp_func Object describing the compare function to be used.
+ *  @param depth_limit Number of partitioning levels before heapsort
+ *         is used.
  */
-static void qsort_array_reverse (objectType begin_sort, objectType end_sort,
-    objectType cmp_func)
+static void intro_sort (objectType begin_sort, objectType end_sort,
+    const sortKindType kind, const objectType cmp_func,
+    unsigned int depth_limit)
 
   {
-    objectRecord compare_elem;
+    objectRecord pivot;
     objectRecord help_element;
+    memSizeType step;
     objectType middle_elem;
+    objectType pivot_elem;
     objectType less_elem;
     objectType greater_elem;
-    objectType cmp_obj;
-    intType cmp;
-
-  /* qsort_array_reverse */
-    if (end_sort - begin_sort < QSORT_LIMIT) {
-      /* Use insertion sort */
-      for (middle_elem = begin_sort + 1; middle_elem <= end_sort; middle_elem++) {
-        compare_elem = *middle_elem;
-        greater_elem = begin_sort - 1;
+
+  /* intro_sort */
+    while (end_sort - begin_sort >= QSORT_LIMIT) {
+      if (depth_limit == 0) {
+        heap_sort(begin_sort, (memSizeType) (end_sort - begin_sort) + 1,
+                  kind, cmp_func);
+        end_sort = begin_sort; /* leave while-loop */
+      } else {
+        depth_limit--;
+        middle_elem = &begin_sort[(memSizeType) (end_sort - begin_sort) >> 1];
+        if (end_sort - begin_sort >= NINTHER_LIMIT) {
+          step = (memSizeType) (end_sort - begin_sort) >> 3;
+          pivot_elem = median_of_three(
+              median_of_three(begin_sort, &begin_sort[step],
+                              &begin_sort[2 * step], kind, cmp_func),
+              median_of_three(middle_elem - step, middle_elem,
+                              middle_elem + step, kind, cmp_func),
+              median_of_three(end_sort - 2 * step, end_sort - step,
+                              end_sort, kind, cmp_func),
+              kind, cmp_func);
+        } else {
+          pivot_elem = median_of_three(begin_sort, middle_elem,
+                                       end_sort, kind, cmp_func);
+        } /* if */
+        /* Moving the pivot to the front guarantees that both  */
+        /* partitions are non-empty.                           */
+        pivot = *pivot_elem;
+        *pivot_elem = *begin_sort;
+        *begin_sort = pivot;
+        less_elem = begin_sort - 1;
+        greater_elem = end_sort + 1;
         do {
-          greater_elem++;
-          cmp_obj = param3_call(cmp_func, greater_elem, &compare_elem, cmp_func);
-          isit_int2(cmp_obj);
-          cmp = take_int(cmp_obj);
-          FREE_OBJECT(cmp_obj);
-        } while (cmp > 0);
-        memmove(&greater_elem[1], greater_elem,
-                (memSizeType) (middle_elem - greater_elem) * sizeof(objectRecord));
-        *greater_elem = compare_elem;
-      } /* for */
+          do {
+            less_elem++;
+          } while (compareObjects(less_elem, &pivot, kind, cmp_func) < 0);
+          do {
+            greater_elem--;
+          } while (compareObjects(greater_elem, &pivot, kind, cmp_func) > 0);
+          if (less_elem < greater_elem) {
+            help_element = *less_elem;
+            *less_elem = *greater_elem;
+            *greater_elem = help_element;
+          } /* if */
+        } while (less_elem < greater_elem);
+        if (greater_elem - begin_sort < end_sort - greater_elem) {
+          intro_sort(begin_sort, greater_elem, kind, cmp_func, depth_limit);
+          begin_sort = greater_elem + 1;
+        } else {
+          intro_sort(greater_elem + 1, end_sort, kind, cmp_func, depth_limit);
+          end_sort = greater_elem;
+        } /* if */
+      } /* if */
+    } /* while */
+    insertion_sort(begin_sort, end_sort, kind, cmp_func);
+  } /* intro_sort */
+
+
+
+/**
+ *  Sort an array of 'objectRecord' elements with merge sort.
+ *  Merge sort is stable. Merging is skipped if the two sorted halves
+ *  are already in order.
+ *  @param begin_sort Pointer to first element to be sorted.
+ *  @param size Number of elements to be sorted.
+ *  @param buffer Temporary space for size / 2 elements.
+ */
+static void merge_sort (objectType begin_sort, memSizeType size,
+    objectType buffer, const sortKindType kind, const objectType cmp_func)
+
+  {
+    memSizeType half;
+    objectType left;
+    objectType left_end;
+    objectType right;
+    objectType right_end;
+    objectType dest;
+
+  /* merge_sort */
+    if (size <= QSORT_LIMIT) {
+      insertion_sort(begin_sort, &begin_sort[size - 1], kind, cmp_func);
     } else {
-      middle_elem = &begin_sort[(memSizeType) (end_sort - begin_sort) >> 1];
-      compare_elem = *middle_elem;
-      *middle_elem = *end_sort;
-      *end_sort = compare_elem;
-      greater_elem = begin_sort - 1;
-      less_elem = end_sort;
-      do {
-        do {
-          greater_elem++;
-          cmp_obj = param3_call(cmp_func, greater_elem, &compare_elem, cmp_func);
-          isit_int2(cmp_obj);
-          cmp = take_int(cmp_obj);
-          FREE_OBJECT(cmp_obj);
-        } while (cmp > 0);
-        do {
-          less_elem--;
-          cmp_obj = param3_call(cmp_func, less_elem, &compare_elem, cmp_func);
-          isit_int2(cmp_obj);
-          cmp = take_int(cmp_obj);
-          FREE_OBJECT(cmp_obj);
-        } while (cmp < 0 && less_elem != begin_sort);
-        help_element  = *greater_elem;
-        *greater_elem = *less_elem;
-        *less_elem = help_element;
-      } while (less_elem > greater_elem);
-      *less_elem = *greater_elem;
-      *greater_elem = compare_elem;
-      *end_sort = help_element;
-      qsort_array_reverse(begin_sort, greater_elem - 1, cmp_func);
-      qsort_array_reverse(greater_elem + 1, end_sort, cmp_func);
+      half = size >> 1;
+      merge_sort(begin_sort, half, buffer, kind, cmp_func);
+      merge_sort(&begin_sort[half], size - half, buffer, kind, cmp_func);
+      if (compareObjects(&begin_sort[half - 1], &begin_sort[half],
+                         kind, cmp_func) > 0) {
+        memcpy(buffer, begin_sort, half * sizeof(objectRecord));
+        left = buffer;
+        left_end = &buffer[half];
+        right = &begin_sort[half];
+        right_end = &begin_sort[size];
+        dest = begin_sort;
+        while (left < left_end && right < right_end) {
+          if (compareObjects(right, left, kind, cmp_func) < 0) {
+            *dest = *right;
+            right++;
+          } else {
+            *dest = *left;
+            left++;
+          } /* if */
+          dest++;
+        } /* while */
+        memcpy(dest, left, (memSizeType) (left_end - left) * sizeof(objectRecord));
+      } /* if */
+    } /* if */
+  } /* merge_sort */
+
+
+
+static void reverse_array (objectType begin_reverse, objectType end_reverse)
+
+  {
+    objectRecord help_element;
+
+  /* reverse_array */
+    while (begin_reverse < end_reverse) {
+      help_element = *begin_reverse;
+      *begin_reverse = *end_reverse;
+      *end_reverse = help_element;
+      begin_reverse++;
+      end_reverse--;
+    } /* while */
+  } /* reverse_array */
+
+
+
+/**
+ *  Sort an array of 'objectRecord' elements.
+ *  The array is checked for an ascending or descending order first
+ *  and sorted with introsort afterwards.
+ *  @param arr Pointer to first element to be sorted.
+ *  @param size Number of elements to be sorted.
+ *  @param cmp_func Object describing the compare function to be used.
+ */
+static void sort_array (objectType arr, memSizeType size,
+    const objectType cmp_func)
+
+  {
+    sortKindType kind;
+    memSizeType pos;
+    memSizeType length;
+    unsigned int depth_limit = 0;
+
+  /* sort_array */
+    if (size >= 2) {
+      kind = sortKind(cmp_func);
+      pos = 1;
+      while (pos < size &&
+             compareObjects(&arr[pos - 1], &arr[pos], kind, cmp_func) <= 0) {
+        pos++;
+      } /* while */
+      if (pos == 1) {
+        while (pos < size &&
+               compareObjects(&arr[pos - 1], &arr[pos], kind, cmp_func) > 0) {
+          pos++;
+        } /* while */
+        if (pos == size) {
+          reverse_array(arr, &arr[size - 1]);
+        } /* if */
+      } /* if */
+      if (pos < size) {
+        for (length = size; length > 1; length >>= 1) {
+          depth_limit += 2;
+        } /* for */
+        intro_sort(arr, &arr[size - 1], kind, cmp_func, depth_limit);
+      } /* if */
     } /* if */
-  } /* qsort_array_reverse */
+  } /* sort_array */
 
 
 
@@ -1877,9 +2121,7 @@ objectType arr_sort (listType arguments)
         } /* if */
       } /* if */
     } /* if */
-    qsort_array(result->arr,
-        &result->arr[result->max_position - result->min_position],
-        data_cmp_func);
+    sort_array(result->arr, arraySize(result), data_cmp_func);
     return bld_array_temp(result);
   } /* arr_sort */
 
@@ -1921,14 +2163,85 @@ objectType arr_sort_reverse (listType arguments)
         } /* if */
       } /* if */
     } /* if */
-    qsort_array_reverse(result->arr,
-        &result->arr[result->max_position - result->min_position],
-        data_cmp_func);
+    result_size = arraySize(result);
+    if (result_size >= 2) {
+      sort_array(result->arr, result_size, data_cmp_func);
+      reverse_array(result->arr, &result->arr[result_size - 1]);
+    } /* if */
     return bld_array_temp(result);
   } /* arr_sort_reverse */
 
 
 
+/**
+ *  Sort an array with the compare function and keep the relative
+ *  order of elements that are considered equal (stable sort).
+ *  @return the sorted array.
+ *  @exception MEMORY_ERROR Not enough memory to sort the array.
+ */
+objectType arr_sort_stable (listType arguments)
+
+  {
+    objectType arr_arg;
+    objectType data_cmp_func;
+    arrayType arr1;
+    objectType array_exec_object;
+    memSizeType result_size;
+    memSizeType buffer_size;
+    objectType buffer = NULL;
+    arrayType result;
+
+  /* arr_sort_stable */
+    arr_arg = arg_1(arguments);
+    isit_array(arr_arg);
+    data_cmp_func    = take_reference(arg_2(arguments));
+    arr1 = take_array(arr_arg);
+    result_size = arraySize(arr1);
+    buffer_size = result_size >> 1;
+    if (result_size > QSORT_LIMIT &&
+        unlikely(!ALLOC_TABLE(buffer, objectRecord, buffer_size))) {
+      logError(printf("arr_sort_stable: ALLOC_TABLE() failed.\n"););
+      return raise_exception(SYS_MEM_EXCEPTION);
+    } /* if */
+    if (TEMP2_OBJECT(arr_arg)) {
+      result = arr1;
+      arr_arg->value.arrayValue = NULL;
+    } else {
+      if (unlikely(!ALLOC_ARRAY(result, result_size))) {
+        logError(printf("arr_sort_stable: ALLOC_ARRAY() failed.\n"););
+        if (buffer != NULL) {
+          FREE_TABLE(buffer, objectRecord, buffer_size);
+        } /* if */
+        return raise_exception(SYS_MEM_EXCEPTION);
+      } else {
+        array_exec_object = curr_exec_object;
+        result->min_position = arr1->min_position;
+        result->max_position = arr1->max_position;
+        if (unlikely(!crea_array(result->arr, arr1->arr, result_size))) {
+          logError(printf("arr_sort_stable: crea_array() failed.\n"););
+          FREE_ARRAY(result, result_size);
+          if (buffer != NULL) {
+            FREE_TABLE(buffer, objectRecord, buffer_size);
+          } /* if */
+          return raise_with_obj_and_args(SYS_MEM_EXCEPTION,
+                                         array_exec_object,
+                                         arguments);
+        } /* if */
+      } /* if */
+    } /* if */
+    if (buffer != NULL) {
+      merge_sort(result->arr, result_size, buffer,
+                 sortKind(data_cmp_func), data_cmp_func);
+      FREE_TABLE(buffer, objectRecord, buffer_size);
+    } else if (result_size >= 2) {
+      insertion_sort(result->arr, &result->arr[result_size - 1],
+                     sortKind(data_cmp_func), data_cmp_func);
+    } /* if */
+    return bld_array_temp(result);
+  } /* arr_sort_stable */
+
+
+
 /**
  *  Get a sub array from the position 'start' with maximum length 'length'.
  *  @return the sub array from position 'start' with maximum length 'length'.
@@ -1,7 +1,7 @@
 /********************************************************************/
 /*                                                                  */
 /*  big_drv.h     Driver functions for the bigInteger type.         */
-/*  Copyright (C) 1989 - 2014  Thomas Mertes                        */
+/*  Copyright (C) 1989 - 2014, 2026  Thomas Mertes                  */
 /*                                                                  */
 /*  This file is part of the Seed7 Runtime Library.                 */
 /*                                                                  */
@@ -25,6 +25,7 @@
 /*  Module: Seed7 Runtime Library                                   */
 /*  File: seed7/src/big_drv.h                                       */
 /*  Changes: 2005, 2006, 2008 - 2010, 2013, 2014  Thomas Mertes     */
+/*           2026  Thomas Mertes                                    */
 /*  Content: Driver functions for the bigInteger type.              */
 /*                                                                  */
 /********************************************************************/
@@ -103,6 +104,8 @@ bigIntType bigLShiftOne (const intType lshift);
 bigIntType bigLog2BaseIPow (const intType log2base, const intType exponent);
 bigIntType bigMDiv (const const_bigIntType dividend, const const_bigIntType divisor);
 bigIntType bigMod (const const_bigIntType dividend, const const_bigIntType divisor);
+bigIntType bigModPow (const const_bigIntType base,
+    const const_bigIntType exponent, const const_bigIntType modulus);
 bigIntType bigMult (const_bigIntType factor1, const_bigIntType factor2);
 void bigMultAssign (bigIntType *const big_variable, const_bigIntType factor);
 bigIntType bigMultSignedDigit (const_bigIntType factor1, intType factor2);
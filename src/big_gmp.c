@@ -1,7 +1,7 @@
 /********************************************************************/
 /*                                                                  */
 /*  big_gmp.c     Functions for bigInteger using the gmp library.   */
-/*  Copyright (C) 2008 - 2019, 2022, 2024  Thomas Mertes            */
+/*  Copyright (C) 2008 - 2019, 2022, 2024, 2026  Thomas Mertes      */
 /*                                                                  */
 /*  This file is part of the Seed7 Runtime Library.                 */
 /*                                                                  */
@@ -24,7 +24,7 @@
 /*                                                                  */
 /*  Module: Seed7 Runtime Library                                   */
 /*  File: seed7/src/big_gmp.c                                       */
-/*  Changes: 2008, 2009, 2010, 2013 - 2019  Thomas Mertes           */
+/*  Changes: 2008, 2009, 2010, 2013 - 2019, 2026  Thomas Mertes     */
 /*  Content: Functions for bigInteger using the gmp library.        */
 /*                                                                  */
 /********************************************************************/
@@ -1524,6 +1524,50 @@ bigIntType bigMod (const const_bigIntType dividend, const const_bigIntType divis
 
 
 
+/**
+ *  Compute the modular exponentiation of base ** exponent.
+ *  @return base ** exponent mod modulus
+ *  @exception RANGE_ERROR If exponent or modulus are negative.
+ *  @exception NUMERIC_ERROR If modulus is zero and exponent is positive.
+ */
+bigIntType bigModPow (const const_bigIntType base,
+    const const_bigIntType exponent, const const_bigIntType modulus)
+
+  {
+    bigIntType power;
+
+  /* bigModPow */
+    logFunction(printf("bigModPow(%s, ", bigHexCStri(base));
+                printf("%s, ", bigHexCStri(exponent));
+                printf("%s)\n", bigHexCStri(modulus)););
+    if (unlikely(mpz_sgn(exponent) < 0 || mpz_sgn(modulus) < 0)) {
+      logError(printf("bigModPow(%s, ", bigHexCStri(base));
+               printf("%s, ", bigHexCStri(exponent));
+               printf("%s): Exponent or modulus is negative.\n",
+                      bigHexCStri(modulus)););
+      raise_error(RANGE_ERROR);
+      power = NULL;
+    } else if (mpz_sgn(exponent) == 0) {
+      ALLOC_BIG(power);
+      mpz_init_set_ui(power, 1);
+    } else if (unlikely(mpz_sgn(modulus) == 0)) {
+      logError(printf("bigModPow(%s, ", bigHexCStri(base));
+               printf("%s, ", bigHexCStri(exponent));
+               printf("%s): Division by zero.\n",
+                      bigHexCStri(modulus)););
+      raise_error(NUMERIC_ERROR);
+      power = NULL;
+    } else {
+      ALLOC_BIG(power);
+      mpz_init(power);
+      mpz_powm(power, base, exponent, modulus);
+    } /* if */
+    logFunction(printf("bigModPow --> %s\n", bigHexCStri(power)););
+    return power;
+  } /* bigModPow */
+
+
+
 /**
  *  Multiply two 'bigInteger' numbers.
  *  @return the product of the two numbers.
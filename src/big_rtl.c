@@ -1,7 +1,7 @@
 /********************************************************************/
 /*                                                                  */
 /*  big_rtl.c     Functions for the built-in bigInteger support.    */
-/*  Copyright (C) 2006 - 2020, 2022 - 2025  Thomas Mertes           */
+/*  Copyright (C) 2006 - 2020, 2022 - 2026  Thomas Mertes           */
 /*                                                                  */
 /*  This file is part of the Seed7 Runtime Library.                 */
 /*                                                                  */
@@ -24,7 +24,7 @@
 /*                                                                  */
 /*  Module: Seed7 Runtime Library                                   */
 /*  File: seed7/src/big_rtl.c                                       */
-/*  Changes: 2006 - 2020, 2022 - 2025  Thomas Mertes                */
+/*  Changes: 2006 - 2020, 2022 - 2026  Thomas Mertes                */
 /*  Content: Functions for the built-in bigInteger support.         */
 /*                                                                  */
 /********************************************************************/
@@ -54,6 +54,12 @@
 
 #define KARATSUBA_MULT_THRESHOLD 32
 #define KARATSUBA_SQUARE_THRESHOLD 32
+#define TOOM3_MULT_THRESHOLD 250
+#define TOOM3_SQUARE_THRESHOLD 250
+#define NTT_MULT_THRESHOLD 20000
+#define NTT_SQUARE_THRESHOLD 20000
+#define BURNIKEL_ZIEGLER_THRESHOLD 80
+#define MONTGOMERY_MAX_SIZE 1500
 #define OCTAL_DIGIT_BITS 3
 
 
@@ -1743,128 +1749,6 @@ static bigIntType bigDivSizeLess (const const_bigIntType dividend,
 
 
 
-/**
- *  Multiplies big2 with multiplier and subtracts the product from
- *  big1 at the digit position pos1 of big1. Big1, big2 and
- *  multiplier are nonnegative big integer values.
- *  The algorithm tries to save computations. Therefore
- *  there are checks for mult_carry != 0 and sbtr_carry == 0.
- */
-static bigDigitType uBigMultSub (const bigIntType big1, const const_bigIntType big2,
-    const bigDigitType multiplier, const memSizeType pos1)
-
-  {
-    memSizeType pos = 0;
-    doubleBigDigitType mult_carry = 0;
-    doubleBigDigitType sbtr_carry = 1;
-
-  /* uBigMultSub */
-    do {
-      mult_carry += (doubleBigDigitType) big2->bigdigits[pos] * multiplier;
-      sbtr_carry += big1->bigdigits[pos1 + pos] + (~mult_carry & BIGDIGIT_MASK);
-      big1->bigdigits[pos1 + pos] = (bigDigitType) (sbtr_carry & BIGDIGIT_MASK);
-      mult_carry >>= BIGDIGIT_SIZE;
-      sbtr_carry >>= BIGDIGIT_SIZE;
-      pos++;
-    } while (pos < big2->size);
-    for (pos += pos1; mult_carry != 0 && pos < big1->size; pos++) {
-      sbtr_carry += big1->bigdigits[pos] + (~mult_carry & BIGDIGIT_MASK);
-      big1->bigdigits[pos] = (bigDigitType) (sbtr_carry & BIGDIGIT_MASK);
-      mult_carry >>= BIGDIGIT_SIZE;
-      sbtr_carry >>= BIGDIGIT_SIZE;
-    } /* for */
-    for (; sbtr_carry == 0 && pos < big1->size; pos++) {
-      sbtr_carry = (doubleBigDigitType) big1->bigdigits[pos] + BIGDIGIT_MASK;
-      big1->bigdigits[pos] = (bigDigitType) (sbtr_carry & BIGDIGIT_MASK);
-      sbtr_carry >>= BIGDIGIT_SIZE;
-    } /* for */
-    return (bigDigitType) (sbtr_carry & BIGDIGIT_MASK);
-  } /* uBigMultSub */
-
-
-
-/**
- *  Adds big2 to big1 at the digit position pos1. Big1 and big2
- *  are nonnegative big integer values. The size of big1 must be
- *  greater or equal the size of big2. The final carry is ignored.
- */
-static void uBigAddTo (const bigIntType big1, const const_bigIntType big2,
-    const memSizeType pos1)
-
-  {
-    memSizeType pos = 0;
-    doubleBigDigitType carry = 0;
-
-  /* uBigAddTo */
-    do {
-      carry += (doubleBigDigitType) big1->bigdigits[pos1 + pos] + big2->bigdigits[pos];
-      big1->bigdigits[pos1 + pos] = (bigDigitType) (carry & BIGDIGIT_MASK);
-      carry >>= BIGDIGIT_SIZE;
-      pos++;
-    } while (pos < big2->size);
-    for (pos += pos1; pos < big1->size; pos++) {
-      carry += big1->bigdigits[pos];
-      big1->bigdigits[pos] = (bigDigitType) (carry & BIGDIGIT_MASK);
-      carry >>= BIGDIGIT_SIZE;
-    } /* for */
-  } /* uBigAddTo */
-
-
-
-/**
- *  Computes quotient and remainder of an integer division of dividend by
- *  divisor for nonnegative big integers. The remainder is delivered in
- *  dividend. There are several preconditions for this function. Divisor
- *  must have at least 2 digits and dividend must have at least one
- *  digit more than divisor. If dividend and divisor have the same length in
- *  digits nothing is done. The most significant bit of divisor must be
- *  set. The most significant digit of dividend must be less than the
- *  most significant digit of divisor. The computations to meet this
- *  preconditions are done outside this function. The special cases
- *  with a one digit divisor or a dividend with less digits than divisor are
- *  handled in other functions. This algorithm based on the algorithm
- *  from D.E. Knuth described in "The art of computer programming"
- *  volume 2 (Seminumerical algorithms).
- */
-static void uBigDiv (const bigIntType dividend, const const_bigIntType divisor,
-    const bigIntType quotient)
-
-  {
-    memSizeType pos1;
-    doubleBigDigitType twodigits;
-    doubleBigDigitType remainder;
-    bigDigitType quotientdigit;
-    bigDigitType sbtr_carry;
-
-  /* uBigDiv */
-    for (pos1 = dividend->size - 1; pos1 >= divisor->size; pos1--) {
-      twodigits = (((doubleBigDigitType) dividend->bigdigits[pos1]) << BIGDIGIT_SIZE) |
-          dividend->bigdigits[pos1 - 1];
-      if (unlikely(dividend->bigdigits[pos1] == divisor->bigdigits[divisor->size - 1])) {
-        quotientdigit = BIGDIGIT_MASK;
-      } else {
-        quotientdigit = (bigDigitType) (twodigits / divisor->bigdigits[divisor->size - 1]);
-      } /* if */
-      remainder = twodigits - (doubleBigDigitType) quotientdigit *
-          divisor->bigdigits[divisor->size - 1];
-      while (remainder <= BIGDIGIT_MASK &&
-          (doubleBigDigitType) divisor->bigdigits[divisor->size - 2] * quotientdigit >
-          (remainder << BIGDIGIT_SIZE | dividend->bigdigits[pos1 - 2])) {
-        quotientdigit--;
-        remainder = twodigits - (doubleBigDigitType) quotientdigit *
-            divisor->bigdigits[divisor->size - 1];
-      } /* while */
-      sbtr_carry = uBigMultSub(dividend, divisor, quotientdigit, pos1 - divisor->size);
-      if (sbtr_carry == 0) {
-        uBigAddTo(dividend, divisor, pos1 - divisor->size);
-        quotientdigit--;
-      } /* if */
-      quotient->bigdigits[pos1 - divisor->size] = quotientdigit;
-    } /* for */
-  } /* uBigDiv */
-
-
-
 /**
  *  Computes quotient and remainder of an integer division of dividend
  *  by one divisor_digit for nonnegative big integers. The divisor_digit
@@ -2375,57 +2259,6 @@ static bigIntType bigModSizeLess (const const_bigIntType dividend,
 
 
 
-/**
- *  Computes the remainder of an integer division of dividend by divisor
- *  for nonnegative big integers. The remainder is delivered in
- *  dividend. There are several preconditions for this function. Divisor
- *  must have at least 2 digits and dividend must have at least one
- *  digit more than divisor. If dividend and divisor have the same length in
- *  digits nothing is done. The most significant bit of divisor must be
- *  set. The most significant digit of dividend must be less than the
- *  most significant digit of divisor. The computations to meet this
- *  preconditions are done outside this function. The special cases
- *  with a one digit divisor or a dividend with less digits than divisor are
- *  handled in other functions. This algorithm based on the algorithm
- *  from D.E. Knuth described in "The art of computer programming"
- *  volume 2 (Seminumerical algorithms).
- */
-static void uBigRem (const bigIntType dividend, const const_bigIntType divisor)
-
-  {
-    memSizeType pos1;
-    doubleBigDigitType twodigits;
-    doubleBigDigitType remainder;
-    bigDigitType quotientdigit;
-    bigDigitType sbtr_carry;
-
-  /* uBigRem */
-    for (pos1 = dividend->size - 1; pos1 >= divisor->size; pos1--) {
-      twodigits = (((doubleBigDigitType) dividend->bigdigits[pos1]) << BIGDIGIT_SIZE) |
-          dividend->bigdigits[pos1 - 1];
-      if (unlikely(dividend->bigdigits[pos1] == divisor->bigdigits[divisor->size - 1])) {
-        quotientdigit = BIGDIGIT_MASK;
-      } else {
-        quotientdigit = (bigDigitType) (twodigits / divisor->bigdigits[divisor->size - 1]);
-      } /* if */
-      remainder = twodigits - (doubleBigDigitType) quotientdigit *
-          divisor->bigdigits[divisor->size - 1];
-      while (remainder <= BIGDIGIT_MASK &&
-          (doubleBigDigitType) divisor->bigdigits[divisor->size - 2] * quotientdigit >
-          (remainder << BIGDIGIT_SIZE | dividend->bigdigits[pos1 - 2])) {
-        quotientdigit--;
-        remainder = twodigits - (doubleBigDigitType) quotientdigit *
-            divisor->bigdigits[divisor->size - 1];
-      } /* while */
-      sbtr_carry = uBigMultSub(dividend, divisor, quotientdigit, pos1 - divisor->size);
-      if (sbtr_carry == 0) {
-        uBigAddTo(dividend, divisor, pos1 - divisor->size);
-      } /* if */
-    } /* for */
-  } /* uBigRem */
-
-
-
 static void uBigDigitAdd (const bigDigitType *const big1, const memSizeType size1,
     const bigDigitType *const big2, const memSizeType size2, bigDigitType *const result)
 
@@ -2559,81 +2392,959 @@ static void uBigKaratsubaMult (const bigDigitType *const factor1,
 
 
 
-static void uBigDigitSquare (const bigDigitType *const big1,
-    const memSizeType size, bigDigitType *const square)
+static void uBigDigitSquare (const bigDigitType *const big1,
+    const memSizeType size, bigDigitType *const square)
+
+  {
+    memSizeType pos1;
+    memSizeType pos2;
+    doubleBigDigitType carry;
+    doubleBigDigitType product;
+    bigDigitType digit;
+
+  /* uBigDigitSquare */
+    digit = big1[0];
+    carry = (doubleBigDigitType) digit * digit;
+    square[0] = (bigDigitType) (carry & BIGDIGIT_MASK);
+    carry >>= BIGDIGIT_SIZE;
+    if (size == 1) {
+      square[1] = (bigDigitType) (carry);
+    } else {
+      for (pos2 = 1; pos2 < size; pos2++) {
+        product = (doubleBigDigitType) digit * big1[pos2];
+        carry += (product << 1) & BIGDIGIT_MASK;
+        square[pos2] = (bigDigitType) (carry & BIGDIGIT_MASK);
+        carry >>= BIGDIGIT_SIZE;
+        carry += product >> (BIGDIGIT_SIZE - 1);
+      } /* for */
+      square[pos2] = (bigDigitType) (carry & BIGDIGIT_MASK);
+      square[pos2 + 1] = (bigDigitType) (carry >> BIGDIGIT_SIZE);
+      for (pos1 = 1; pos1 < size; pos1++) {
+        digit = big1[pos1];
+        carry = (doubleBigDigitType) square[pos1 << 1] +
+            (doubleBigDigitType) digit * digit;
+        square[pos1 << 1] = (bigDigitType) (carry & BIGDIGIT_MASK);
+        carry >>= BIGDIGIT_SIZE;
+        for (pos2 = pos1 + 1; pos2 < size; pos2++) {
+          product = (doubleBigDigitType) digit * big1[pos2];
+          carry += (doubleBigDigitType) square[pos1 + pos2] +
+              ((product << 1) & BIGDIGIT_MASK);
+          square[pos1 + pos2] = (bigDigitType) (carry & BIGDIGIT_MASK);
+          carry >>= BIGDIGIT_SIZE;
+          carry += product >> (BIGDIGIT_SIZE - 1);
+        } /* for */
+        carry += (doubleBigDigitType) square[pos1 + pos2];
+        square[pos1 + pos2] = (bigDigitType) (carry & BIGDIGIT_MASK);
+        if (pos1 < size - 1) {
+          square[pos1 + pos2 + 1] = (bigDigitType) (carry >> BIGDIGIT_SIZE);
+        } /* if */
+      } /* for */
+    } /* if */
+  } /* uBigDigitSquare */
+
+
+
+static void uBigKaratsubaSquare (const bigDigitType *const big1,
+    const memSizeType size, bigDigitType *const square, bigDigitType *const temp)
+
+  {
+    memSizeType sizeLo;
+    memSizeType sizeHi;
+
+  /* uBigKaratsubaSquare */
+    logMessage(printf("uBigKaratsubaSquare: size=" FMT_U_MEM "\n", size););
+    if (size < KARATSUBA_SQUARE_THRESHOLD) {
+      uBigDigitSquare(big1, size, square);
+    } else {
+      sizeHi = size >> 1;
+      sizeLo = size - sizeHi;
+      uBigDigitAdd(big1, sizeLo, &big1[sizeLo], sizeHi, square);
+      uBigKaratsubaSquare(square, sizeLo + 1, temp, &temp[(sizeLo + 1) << 1]);
+      uBigKaratsubaSquare(big1, sizeLo, square, &temp[(sizeLo + 1) << 1]);
+      uBigKaratsubaSquare(&big1[sizeLo], sizeHi, &square[sizeLo << 1], &temp[(sizeLo + 1) << 1]);
+      uBigDigitSbtrFrom(temp, (sizeLo + 1) << 1, square, sizeLo << 1);
+      uBigDigitSbtrFrom(temp, (sizeLo + 1) << 1, &square[sizeLo << 1], sizeHi << 1);
+      uBigDigitAddTo(&square[sizeLo], sizeLo + (sizeHi << 1), temp, (sizeLo + 1) << 1);
+    } /* if */
+  } /* uBigKaratsubaSquare */
+
+
+
+/**
+ *  Add the product of big2 and digit to big1.
+ *  The carry is propagated up to size1. It is assumed that
+ *  size1 >= size2 holds and that the sum fits into big1.
+ */
+static void uBigDigitMultAddTo (bigDigitType *const big1, const memSizeType size1,
+    const bigDigitType *const big2, const memSizeType size2,
+    const bigDigitType digit)
+
+  {
+    memSizeType pos = 0;
+    doubleBigDigitType carry = 0;
+
+  /* uBigDigitMultAddTo */
+    do {
+      carry += (doubleBigDigitType) big1[pos] +
+          (doubleBigDigitType) big2[pos] * digit;
+      big1[pos] = (bigDigitType) (carry & BIGDIGIT_MASK);
+      carry >>= BIGDIGIT_SIZE;
+      pos++;
+    } while (pos < size2);
+    for (; carry != 0 && pos < size1; pos++) {
+      carry += big1[pos];
+      big1[pos] = (bigDigitType) (carry & BIGDIGIT_MASK);
+      carry >>= BIGDIGIT_SIZE;
+    } /* for */
+  } /* uBigDigitMultAddTo */
+
+
+
+/**
+ *  Subtract the product of big2 and digit from big1.
+ *  It is assumed that size1 >= size2 holds and that the
+ *  difference is not negative.
+ */
+static void uBigDigitMultSbtrFrom (bigDigitType *const big1, const memSizeType size1,
+    const bigDigitType *const big2, const memSizeType size2,
+    const bigDigitType digit)
+
+  {
+    memSizeType pos = 0;
+    doubleBigDigitType mult_carry = 0;
+    doubleBigDigitType sbtr_carry = 1;
+
+  /* uBigDigitMultSbtrFrom */
+    do {
+      mult_carry += (doubleBigDigitType) big2[pos] * digit;
+      sbtr_carry += (doubleBigDigitType) big1[pos] +
+          (~mult_carry & BIGDIGIT_MASK);
+      big1[pos] = (bigDigitType) (sbtr_carry & BIGDIGIT_MASK);
+      mult_carry >>= BIGDIGIT_SIZE;
+      sbtr_carry >>= BIGDIGIT_SIZE;
+      pos++;
+    } while (pos < size2);
+    for (; (mult_carry != 0 || sbtr_carry == 0) && pos < size1; pos++) {
+      sbtr_carry += (doubleBigDigitType) big1[pos] +
+          (~mult_carry & BIGDIGIT_MASK);
+      big1[pos] = (bigDigitType) (sbtr_carry & BIGDIGIT_MASK);
+      mult_carry = 0;
+      sbtr_carry >>= BIGDIGIT_SIZE;
+    } /* for */
+  } /* uBigDigitMultSbtrFrom */
+
+
+
+/**
+ *  Shift big1 to the right by one bit.
+ */
+static void uBigDigitHalve (bigDigitType *const big1, const memSizeType size)
+
+  {
+    memSizeType pos;
+
+  /* uBigDigitHalve */
+    for (pos = 0; pos < size - 1; pos++) {
+      big1[pos] = (bigDigitType) (((big1[pos] >> 1) |
+          (big1[pos + 1] << (BIGDIGIT_SIZE - 1))) & BIGDIGIT_MASK);
+    } /* for */
+    big1[pos] >>= 1;
+  } /* uBigDigitHalve */
+
+
+
+/**
+ *  Divide big1 by 3. The division must be exact.
+ *  Exact division multiplies every digit with the inverse of 3
+ *  modulo 2**BIGDIGIT_SIZE. This way no division is necessary.
+ */
+static void uBigDigitExactDivideBy3 (bigDigitType *const big1, const memSizeType size)
+
+  {
+    const bigDigitType inverse = (BIGDIGIT_MASK / 3) * 2 + 1;
+    memSizeType pos;
+    bigDigitType digit;
+    bigDigitType quotient;
+    doubleBigDigitType carry = 0;
+
+  /* uBigDigitExactDivideBy3 */
+    for (pos = 0; pos < size; pos++) {
+      digit = big1[pos];
+      quotient = (bigDigitType) ((digit - carry) & BIGDIGIT_MASK);
+      carry = digit < carry;
+      quotient = (bigDigitType) (((doubleBigDigitType) quotient * inverse) & BIGDIGIT_MASK);
+      big1[pos] = quotient;
+      carry += ((doubleBigDigitType) quotient * 3) >> BIGDIGIT_SIZE;
+    } /* for */
+  } /* uBigDigitExactDivideBy3 */
+
+
+
+/**
+ *  Evaluate the Toom-3 split a0 + a1*x + a2*x**2 at x = -1.
+ *  The sum a0 + a2 is already computed and has size + 1 digits.
+ *  The absolute value of the result is written to value.
+ *  @return TRUE if the value is negative, FALSE otherwise.
+ */
+static boolType uBigToom3EvalMinus1 (const bigDigitType *const sum,
+    const bigDigitType *const middle, const memSizeType size,
+    bigDigitType *const value)
+
+  {
+    memSizeType pos;
+    boolType negative;
+
+  /* uBigToom3EvalMinus1 */
+    pos = size;
+    if (sum[size] == 0) {
+      do {
+        pos--;
+      } while (pos > 0 && sum[pos] == middle[pos]);
+    } /* if */
+    negative = pos != size && sum[pos] < middle[pos];
+    if (negative) {
+      memcpy(value, middle, (size_t) size * sizeof(bigDigitType));
+      value[size] = 0;
+      uBigDigitSbtrFrom(value, size + 1, sum, size + 1);
+    } else {
+      memcpy(value, sum, (size_t) (size + 1) * sizeof(bigDigitType));
+      uBigDigitSbtrFrom(value, size + 1, middle, size);
+    } /* if */
+    return negative;
+  } /* uBigToom3EvalMinus1 */
+
+
+
+/**
+ *  Evaluate the Toom-3 split a0 + a1*x + a2*x**2 at x = 2.
+ *  The parts a0 and a1 have sizeLo digits and a2 has sizeHi digits.
+ *  The result is written to value, which has sizeLo + 1 digits.
+ */
+static void uBigToom3EvalPlus2 (const bigDigitType *const big1,
+    const memSizeType sizeLo, const memSizeType sizeHi,
+    bigDigitType *const value)
+
+  { /* uBigToom3EvalPlus2 */
+    memcpy(value, big1, (size_t) sizeLo * sizeof(bigDigitType));
+    value[sizeLo] = 0;
+    uBigDigitMultAddTo(value, sizeLo + 1, &big1[sizeLo], sizeLo, 2);
+    uBigDigitMultAddTo(value, sizeLo + 1, &big1[sizeLo << 1], sizeHi, 4);
+  } /* uBigToom3EvalPlus2 */
+
+
+
+/**
+ *  Combine the five point values of a Toom-3 multiplication.
+ *  The value at 0 (2 * sizeLo digits) is at the start of product and
+ *  the value at infinity (2 * sizeHi digits) starts at product[4 * sizeLo].
+ *  The values at 1, -1 and 2 (2 * sizeLo + 2 digits each) are at the
+ *  start of temp. The value at -1 is given as absolute value, which is
+ *  negated if minus1Negative is TRUE. All interpolation steps work with
+ *  unsigned values, since every intermediate result is not negative.
+ */
+static void uBigToom3Interpolate (bigDigitType *const product,
+    const memSizeType sizeLo, const memSizeType sizeHi,
+    bigDigitType *const temp, const boolType minus1Negative)
+
+  {
+    memSizeType size;
+    bigDigitType *valueAt1;
+    bigDigitType *valueAtMinus1;
+    bigDigitType *valueAt2;
+    bigDigitType *odd;
+    bigDigitType *even;
+
+  /* uBigToom3Interpolate */
+    size = (sizeLo + 1) << 1;
+    valueAt1 = temp;
+    valueAtMinus1 = &temp[size];
+    valueAt2 = &temp[size << 1];
+    /* Compute (r1 - rm1) / 2 = c1 + c3 and (r1 + rm1) / 2 = c0 + c2 + c4. */
+    uBigDigitSbtrFrom(valueAt1, size, valueAtMinus1, size);
+    uBigDigitHalve(valueAt1, size);
+    uBigDigitAddTo(valueAtMinus1, size, valueAt1, size);
+    if (minus1Negative) {
+      odd = valueAtMinus1;
+      even = valueAt1;
+    } else {
+      odd = valueAt1;
+      even = valueAtMinus1;
+    } /* if */
+    /* c2 = even - c0 - c4 */
+    uBigDigitSbtrFrom(even, size, product, sizeLo << 1);
+    uBigDigitSbtrFrom(even, size, &product[sizeLo << 2], sizeHi << 1);
+    /* c3 = (r2 - c0 - 4 * c2 - 16 * c4 - 2 * (c1 + c3)) / 6 */
+    uBigDigitSbtrFrom(valueAt2, size, product, sizeLo << 1);
+    uBigDigitMultSbtrFrom(valueAt2, size, &product[sizeLo << 2], sizeHi << 1, 16);
+    uBigDigitMultSbtrFrom(valueAt2, size, even, size, 4);
+    uBigDigitMultSbtrFrom(valueAt2, size, odd, size, 2);
+    uBigDigitHalve(valueAt2, size);
+    uBigDigitExactDivideBy3(valueAt2, size);
+    /* c1 = (c1 + c3) - c3 */
+    uBigDigitSbtrFrom(odd, size, valueAt2, size);
+    memset(&product[sizeLo << 1], 0, (size_t) (sizeLo << 1) * sizeof(bigDigitType));
+    uBigDigitAddTo(&product[sizeLo], 3 * sizeLo + (sizeHi << 1), odd, size);
+    uBigDigitAddTo(&product[sizeLo << 1], (sizeLo + sizeHi) << 1, even, size);
+    /* The value of c3 fits into sizeLo + sizeHi + 1 digits. */
+    uBigDigitAddTo(&product[3 * sizeLo], sizeLo + (sizeHi << 1), valueAt2,
+                   size <= sizeLo + (sizeHi << 1) ? size : sizeLo + (sizeHi << 1));
+  } /* uBigToom3Interpolate */
+
+
+
+/**
+ *  Multiply two unsigned digit arrays of the same size with Toom-3.
+ *  The factors are split into three parts and the product is
+ *  interpolated from five products with a third of the size.
+ *  Below TOOM3_MULT_THRESHOLD the Karatsuba multiplication is used.
+ *  The product has 2 * size digits and temp needs 4 * size digits.
+ */
+static void uBigToom3Mult (const bigDigitType *const factor1,
+    const bigDigitType *const factor2, const memSizeType size,
+    bigDigitType *const product, bigDigitType *const temp)
+
+  {
+    memSizeType sizeLo;
+    memSizeType sizeHi;
+    memSizeType sizeEval;
+    bigDigitType *sum1;
+    bigDigitType *sum2;
+    bigDigitType *value1;
+    bigDigitType *value2;
+    boolType minus1Negative;
+
+  /* uBigToom3Mult */
+    logMessage(printf("uBigToom3Mult: size=" FMT_U_MEM "\n", size););
+    if (size < TOOM3_MULT_THRESHOLD) {
+      uBigKaratsubaMult(factor1, factor2, size, product, temp);
+    } else {
+      sizeLo = (size + 2) / 3;
+      sizeHi = size - (sizeLo << 1);
+      sizeEval = sizeLo + 1;
+      /* The evaluated values are stored in product, */
+      /* which is not needed until c0 is computed.   */
+      sum1 = product;
+      sum2 = &product[sizeEval];
+      value1 = &product[sizeEval << 1];
+      value2 = &product[3 * sizeEval];
+      uBigDigitAdd(factor1, sizeLo, &factor1[sizeLo << 1], sizeHi, sum1);
+      uBigDigitAdd(factor2, sizeLo, &factor2[sizeLo << 1], sizeHi, sum2);
+      memcpy(value1, sum1, (size_t) sizeEval * sizeof(bigDigitType));
+      uBigDigitAddTo(value1, sizeEval, &factor1[sizeLo], sizeLo);
+      memcpy(value2, sum2, (size_t) sizeEval * sizeof(bigDigitType));
+      uBigDigitAddTo(value2, sizeEval, &factor2[sizeLo], sizeLo);
+      uBigToom3Mult(value1, value2, sizeEval, temp, &temp[6 * sizeEval]);
+      minus1Negative =
+          uBigToom3EvalMinus1(sum1, &factor1[sizeLo], sizeLo, value1) !=
+          uBigToom3EvalMinus1(sum2, &factor2[sizeLo], sizeLo, value2);
+      uBigToom3Mult(value1, value2, sizeEval, &temp[sizeEval << 1],
+                    &temp[6 * sizeEval]);
+      uBigToom3EvalPlus2(factor1, sizeLo, sizeHi, value1);
+      uBigToom3EvalPlus2(factor2, sizeLo, sizeHi, value2);
+      uBigToom3Mult(value1, value2, sizeEval, &temp[sizeEval << 2],
+                    &temp[6 * sizeEval]);
+      uBigToom3Mult(factor1, factor2, sizeLo, product, &temp[6 * sizeEval]);
+      uBigToom3Mult(&factor1[sizeLo << 1], &factor2[sizeLo << 1], sizeHi,
+                    &product[sizeLo << 2], &temp[6 * sizeEval]);
+      uBigToom3Interpolate(product, sizeLo, sizeHi, temp, minus1Negative);
+    } /* if */
+  } /* uBigToom3Mult */
+
+
+
+/**
+ *  Square an unsigned digit array with Toom-3.
+ *  Below TOOM3_SQUARE_THRESHOLD the Karatsuba squaring is used.
+ *  The square has 2 * size digits and temp needs 4 * size digits.
+ */
+static void uBigToom3Square (const bigDigitType *const big1,
+    const memSizeType size, bigDigitType *const square, bigDigitType *const temp)
+
+  {
+    memSizeType sizeLo;
+    memSizeType sizeHi;
+    memSizeType sizeEval;
+    bigDigitType *sum;
+    bigDigitType *value;
+
+  /* uBigToom3Square */
+    logMessage(printf("uBigToom3Square: size=" FMT_U_MEM "\n", size););
+    if (size < TOOM3_SQUARE_THRESHOLD) {
+      uBigKaratsubaSquare(big1, size, square, temp);
+    } else {
+      sizeLo = (size + 2) / 3;
+      sizeHi = size - (sizeLo << 1);
+      sizeEval = sizeLo + 1;
+      sum = square;
+      value = &square[sizeEval];
+      uBigDigitAdd(big1, sizeLo, &big1[sizeLo << 1], sizeHi, sum);
+      memcpy(value, sum, (size_t) sizeEval * sizeof(bigDigitType));
+      uBigDigitAddTo(value, sizeEval, &big1[sizeLo], sizeLo);
+      uBigToom3Square(value, sizeEval, temp, &temp[6 * sizeEval]);
+      uBigToom3EvalMinus1(sum, &big1[sizeLo], sizeLo, value);
+      uBigToom3Square(value, sizeEval, &temp[sizeEval << 1], &temp[6 * sizeEval]);
+      uBigToom3EvalPlus2(big1, sizeLo, sizeHi, value);
+      uBigToom3Square(value, sizeEval, &temp[sizeEval << 2], &temp[6 * sizeEval]);
+      uBigToom3Square(big1, sizeLo, square, &temp[6 * sizeEval]);
+      uBigToom3Square(&big1[sizeLo << 1], sizeHi, &square[sizeLo << 2],
+                      &temp[6 * sizeEval]);
+      uBigToom3Interpolate(square, sizeLo, sizeHi, temp, FALSE);
+    } /* if */
+  } /* uBigToom3Square */
+
+
+
+#if BIGDIGIT_SIZE == 32
+/* The number theoretic transform (NTT) multiplication splits the  */
+/* 32-bit bigdigits into 16-bit limbs and computes the convolution */
+/* of the limbs modulo two primes below 2**31. With Montgomery     */
+/* arithmetic no division is necessary. The primes allow transform */
+/* lengths up to 2**26. The convolution coefficients are below     */
+/* 2**25 * 2**32, which is less than the product of the primes.    */
+/* Therefore the coefficients are restored with the Chinese        */
+/* remainder theorem.                                              */
+#define NTT_PRIME1          1811939329  /* 27 * 2**26 + 1 */
+#define NTT_PRIME1_ROOT             13
+#define NTT_PRIME2          2013265921  /* 15 * 2**27 + 1 */
+#define NTT_PRIME2_ROOT             31
+#define NTT_MAX_LENGTH  ((memSizeType) 1 << 26)
+
+
+
+/**
+ *  Compute -prime**-1 mod 2**32 for the Montgomery reduction.
+ */
+static uint32Type nttNegInverse (const uint32Type prime)
+
+  {
+    uint32Type inverse = prime;
+    int count;
+
+  /* nttNegInverse */
+    /* Every Newton step doubles the number of correct bits. */
+    for (count = 0; count < 4; count++) {
+      inverse *= 2 - prime * inverse;
+    } /* for */
+    return (uint32Type) 0 - inverse;
+  } /* nttNegInverse */
+
+
+
+/**
+ *  Montgomery reduction: Compute value * 2**-32 mod prime.
+ *  The value must be less than prime * 2**32.
+ */
+static inline uint32Type nttReduce (const uint64Type value, const uint32Type prime,
+    const uint32Type negInverse)
+
+  {
+    uint32Type factor;
+    uint64Type sum;
+
+  /* nttReduce */
+    factor = (uint32Type) value * negInverse;
+    sum = (value + (uint64Type) factor * prime) >> 32;
+    return (uint32Type) (sum >= prime ? sum - prime : sum);
+  } /* nttReduce */
+
+
+
+static uint32Type nttPower (uint32Type base, memSizeType exponent,
+    const uint32Type prime)
+
+  {
+    uint64Type power = 1;
+
+  /* nttPower */
+    while (exponent != 0) {
+      if (exponent & 1) {
+        power = power * base % prime;
+      } /* if */
+      base = (uint32Type) ((uint64Type) base * base % prime);
+      exponent >>= 1;
+    } /* while */
+    return (uint32Type) power;
+  } /* nttPower */
+
+
+
+/**
+ *  In place NTT of data with a power of two length.
+ *  The table roots contains the powers of the root of unity for
+ *  every transform level: roots[half + i] is the i-th power of the
+ *  root for the level, where pairs with distance half are combined.
+ */
+static void nttTransform (bigDigitType *const data, const memSizeType length,
+    const bigDigitType *const roots, const uint32Type prime,
+    const uint32Type negInverse)
+
+  {
+    memSizeType pos1;
+    memSizeType pos2 = 0;
+    memSizeType bit;
+    memSizeType half;
+    memSizeType start;
+    bigDigitType swap;
+    uint32Type value1;
+    uint32Type value2;
+
+  /* nttTransform */
+    for (pos1 = 1; pos1 < length; pos1++) {
+      bit = length >> 1;
+      while (pos2 & bit) {
+        pos2 ^= bit;
+        bit >>= 1;
+      } /* while */
+      pos2 |= bit;
+      if (pos1 < pos2) {
+        swap = data[pos1];
+        data[pos1] = data[pos2];
+        data[pos2] = swap;
+      } /* if */
+    } /* for */
+    for (half = 1; half < length; half <<= 1) {
+      for (start = 0; start < length; start += half << 1) {
+        for (pos1 = start; pos1 < start + half; pos1++) {
+          value1 = data[pos1];
+          value2 = nttReduce((uint64Type) data[pos1 + half] * roots[half + pos1 - start],
+                             prime, negInverse);
+          data[pos1] = value1 + value2 >= prime ?
+              value1 + value2 - prime : value1 + value2;
+          data[pos1 + half] = value1 >= value2 ?
+              value1 - value2 : value1 + prime - value2;
+        } /* for */
+      } /* for */
+    } /* for */
+  } /* nttTransform */
+
+
+
+/**
+ *  Compute the cyclic convolution of the 16-bit limbs of two
+ *  digit arrays modulo prime. If factor2 is NULL factor1 is squared.
+ *  The result is written to data1 in normal (not Montgomery) form.
+ *  The arrays data1, data2 and roots have length elements.
+ */
+static void nttConvolution (const bigDigitType *const factor1, const memSizeType size1,
+    const bigDigitType *const factor2, const memSizeType size2,
+    const uint32Type prime, const uint32Type primitiveRoot,
+    const memSizeType length, bigDigitType *const data1,
+    bigDigitType *const data2, bigDigitType *const roots)
+
+  {
+    uint32Type negInverse;
+    uint32Type rSquare;
+    uint32Type root;
+    uint32Type lengthInverse;
+    memSizeType half;
+    memSizeType pos;
+    bigDigitType swap;
+
+  /* nttConvolution */
+    negInverse = nttNegInverse(prime);
+    rSquare = (uint32Type) (((uint64Type) 1 << 32) % prime);
+    rSquare = (uint32Type) ((uint64Type) rSquare * rSquare % prime);
+    half = length >> 1;
+    root = nttPower(primitiveRoot, (prime - 1) / length, prime);
+    root = nttReduce((uint64Type) root * rSquare, prime, negInverse);
+    roots[half] = nttReduce(rSquare, prime, negInverse);
+    for (pos = half + 1; pos < length; pos++) {
+      roots[pos] = nttReduce((uint64Type) roots[pos - 1] * root, prime, negInverse);
+    } /* for */
+    for (pos = half - 1; pos != 0; pos--) {
+      roots[pos] = roots[pos << 1];
+    } /* for */
+    for (pos = 0; pos < size1; pos++) {
+      data1[pos << 1] = nttReduce((uint64Type) (factor1[pos] & 0xFFFF) * rSquare,
+                                  prime, negInverse);
+      data1[(pos << 1) + 1] = nttReduce((uint64Type) (factor1[pos] >> 16) * rSquare,
+                                        prime, negInverse);
+    } /* for */
+    memset(&data1[size1 << 1], 0, (size_t) (length - (size1 << 1)) * sizeof(bigDigitType));
+    nttTransform(data1, length, roots, prime, negInverse);
+    if (factor2 == NULL) {
+      for (pos = 0; pos < length; pos++) {
+        data1[pos] = nttReduce((uint64Type) data1[pos] * data1[pos], prime, negInverse);
+      } /* for */
+    } else {
+      for (pos = 0; pos < size2; pos++) {
+        data2[pos << 1] = nttReduce((uint64Type) (factor2[pos] & 0xFFFF) * rSquare,
+                                    prime, negInverse);
+        data2[(pos << 1) + 1] = nttReduce((uint64Type) (factor2[pos] >> 16) * rSquare,
+                                          prime, negInverse);
+      } /* for */
+      memset(&data2[size2 << 1], 0, (size_t) (length - (size2 << 1)) * sizeof(bigDigitType));
+      nttTransform(data2, length, roots, prime, negInverse);
+      for (pos = 0; pos < length; pos++) {
+        data1[pos] = nttReduce((uint64Type) data1[pos] * data2[pos], prime, negInverse);
+      } /* for */
+    } /* if */
+    /* The inverse transform is a transform with reversed */
+    /* order of the elements 1 to length - 1.              */
+    nttTransform(data1, length, roots, prime, negInverse);
+    for (pos = 1; pos < half; pos++) {
+      swap = data1[pos];
+      data1[pos] = data1[length - pos];
+      data1[length - pos] = swap;
+    } /* for */
+    /* Multiply with length**-1 and leave the Montgomery form. */
+    lengthInverse = prime - (prime - 1) / (uint32Type) length;
+    for (pos = 0; pos < length; pos++) {
+      data1[pos] = nttReduce((uint64Type) data1[pos] * lengthInverse, prime, negInverse);
+    } /* for */
+  } /* nttConvolution */
+
+
+
+/**
+ *  Multiply two unsigned digit arrays with the NTT multiplication.
+ *  If factor2 is NULL factor1 is squared. The product has
+ *  size1 + size2 digits.
+ *  @return TRUE if the product was computed, or FALSE if
+ *          there is not enough memory.
+ */
+static boolType uBigNttMult (const bigDigitType *const factor1, const memSizeType size1,
+    const bigDigitType *const factor2, const memSizeType size2,
+    bigDigitType *const product)
+
+  {
+    memSizeType length = 2;
+    memSizeType bufferSize;
+    bigIntType buffer;
+    bigDigitType *residue1;
+    bigDigitType *residue2;
+    bigDigitType *data2;
+    bigDigitType *roots;
+    uint32Type negInverse2;
+    uint32Type prime1Inverse;
+    uint32Type difference;
+    uint64Type coefficient;
+    uint64Type carry = 0;
+    bigDigitType lowLimb = 0;
+    memSizeType pos;
+    boolType okay;
+
+  /* uBigNttMult */
+    logMessage(printf("uBigNttMult: size1=" FMT_U_MEM ", size2=" FMT_U_MEM "\n",
+                      size1, size2););
+    while (length < (size1 + size2) << 1) {
+      length <<= 1;
+    } /* while */
+    bufferSize = factor2 == NULL ? 3 * length : length << 2;
+    if (unlikely(!ALLOC_BIG(buffer, bufferSize))) {
+      okay = FALSE;
+    } else {
+      residue1 = buffer->bigdigits;
+      residue2 = &residue1[length];
+      roots = &residue2[length];
+      data2 = factor2 == NULL ? NULL : &roots[length];
+      nttConvolution(factor1, size1, factor2, size2, NTT_PRIME1, NTT_PRIME1_ROOT,
+                     length, residue1, data2, roots);
+      nttConvolution(factor1, size1, factor2, size2, NTT_PRIME2, NTT_PRIME2_ROOT,
+                     length, residue2, data2, roots);
+      negInverse2 = nttNegInverse(NTT_PRIME2);
+      /* prime1Inverse is prime1**-1 mod prime2 in Montgomery form. */
+      prime1Inverse = nttPower(NTT_PRIME1, NTT_PRIME2 - 2, NTT_PRIME2);
+      prime1Inverse = (uint32Type) (((uint64Type) prime1Inverse << 32) % NTT_PRIME2);
+      for (pos = 0; pos < (size1 + size2) << 1; pos++) {
+        /* Chinese remainder theorem: The coefficient is */
+        /* residue1 + prime1 * ((residue2 - residue1) *   */
+        /* prime1**-1 mod prime2).                        */
+        difference = residue2[pos] >= residue1[pos] ?
+            residue2[pos] - residue1[pos] :
+            residue2[pos] + NTT_PRIME2 - residue1[pos];
+        coefficient = (uint64Type) residue1[pos] + (uint64Type) NTT_PRIME1 *
+            nttReduce((uint64Type) difference * prime1Inverse, NTT_PRIME2, negInverse2);
+        carry += coefficient;
+        if (pos & 1) {
+          product[pos >> 1] = lowLimb | (bigDigitType) ((carry & 0xFFFF) << 16);
+        } else {
+          lowLimb = (bigDigitType) (carry & 0xFFFF);
+        } /* if */
+        carry >>= 16;
+      } /* for */
+      FREE_BIG2(buffer, bufferSize);
+      okay = TRUE;
+    } /* if */
+    return okay;
+  } /* uBigNttMult */
+#endif
+
+
+
+/**
+ *  Multiplies big2 with multiplier and subtracts the product from
+ *  big1. Big2 has size2 digits and big1 has size2 + 1 digits.
+ *  @return the final subtraction carry. A carry of zero signals
+ *          that the product was greater than big1.
+ */
+static bigDigitType uBigDigitMultSub (bigDigitType *const big1,
+    const bigDigitType *const big2, const memSizeType size2,
+    const bigDigitType multiplier)
+
+  {
+    memSizeType pos = 0;
+    doubleBigDigitType mult_carry = 0;
+    doubleBigDigitType sbtr_carry = 1;
+
+  /* uBigDigitMultSub */
+    do {
+      mult_carry += (doubleBigDigitType) big2[pos] * multiplier;
+      sbtr_carry += big1[pos] + (~mult_carry & BIGDIGIT_MASK);
+      big1[pos] = (bigDigitType) (sbtr_carry & BIGDIGIT_MASK);
+      mult_carry >>= BIGDIGIT_SIZE;
+      sbtr_carry >>= BIGDIGIT_SIZE;
+      pos++;
+    } while (pos < size2);
+    sbtr_carry += big1[pos] + (~mult_carry & BIGDIGIT_MASK);
+    big1[pos] = (bigDigitType) (sbtr_carry & BIGDIGIT_MASK);
+    sbtr_carry >>= BIGDIGIT_SIZE;
+    return (bigDigitType) (sbtr_carry & BIGDIGIT_MASK);
+  } /* uBigDigitMultSub */
+
+
+
+/**
+ *  Computes quotient and remainder of an integer division of the
+ *  unsigned digit arrays dividend and divisor. The remainder is
+ *  delivered in dividend. Divisor must have at least 2 digits and
+ *  the most significant bit of divisor must be set. The upper
+ *  divisorSize digits of dividend must be less than divisor.
+ *  The quotient has dividendSize - divisorSize digits. If quotient
+ *  is NULL only the remainder is computed. This algorithm based on
+ *  the algorithm from D.E. Knuth described in "The art of computer
+ *  programming" volume 2 (Seminumerical algorithms).
+ */
+static void uBigDigitDiv (bigDigitType *const dividend, const memSizeType dividendSize,
+    const bigDigitType *const divisor, const memSizeType divisorSize,
+    bigDigitType *const quotient)
+
+  {
+    memSizeType pos1;
+    doubleBigDigitType twodigits;
+    doubleBigDigitType remainder;
+    bigDigitType quotientdigit;
+    bigDigitType divisorTop;
+    bigDigitType divisorSecond;
+
+  /* uBigDigitDiv */
+    divisorTop = divisor[divisorSize - 1];
+    divisorSecond = divisor[divisorSize - 2];
+    for (pos1 = dividendSize - 1; pos1 >= divisorSize; pos1--) {
+      twodigits = (((doubleBigDigitType) dividend[pos1]) << BIGDIGIT_SIZE) |
+          dividend[pos1 - 1];
+      if (unlikely(dividend[pos1] == divisorTop)) {
+        quotientdigit = BIGDIGIT_MASK;
+      } else {
+        quotientdigit = (bigDigitType) (twodigits / divisorTop);
+      } /* if */
+      remainder = twodigits - (doubleBigDigitType) quotientdigit * divisorTop;
+      while (remainder <= BIGDIGIT_MASK &&
+          (doubleBigDigitType) divisorSecond * quotientdigit >
+          (remainder << BIGDIGIT_SIZE | dividend[pos1 - 2])) {
+        quotientdigit--;
+        remainder = twodigits - (doubleBigDigitType) quotientdigit * divisorTop;
+      } /* while */
+      if (uBigDigitMultSub(&dividend[pos1 - divisorSize], divisor, divisorSize,
+                           quotientdigit) == 0) {
+        uBigDigitAddTo(&dividend[pos1 - divisorSize], divisorSize + 1,
+                       divisor, divisorSize);
+        quotientdigit--;
+      } /* if */
+      if (quotient != NULL) {
+        quotient[pos1 - divisorSize] = quotientdigit;
+      } /* if */
+    } /* for */
+  } /* uBigDigitDiv */
+
+
+
+/**
+ *  Divide a dividend with 2 * size digits by a divisor with size
+ *  digits with the recursive algorithm of Burnikel and Ziegler.
+ *  The most significant bit of divisor must be set and the upper
+ *  half of dividend must be less than divisor. The quotient has
+ *  size digits. The remainder is delivered in the lower half of
+ *  dividend and the upper half is set to zero. Temp needs
+ *  3 * size digits. Each half of the quotient is computed by
+ *  dividing three half sized digit blocks by two: The upper
+ *  half of the divisor estimates the quotient with a recursive
+ *  call and the lower half of the divisor corrects it.
+ */
+static void uBigBzDiv2n1n (bigDigitType *const dividend,
+    const bigDigitType *const divisor, const memSizeType size,
+    bigDigitType *const quotient, bigDigitType *const temp)
 
   {
-    memSizeType pos1;
-    memSizeType pos2;
-    doubleBigDigitType carry;
-    doubleBigDigitType product;
-    bigDigitType digit;
+    memSizeType half;
+    memSizeType part;
+    bigDigitType *block;
+    bigDigitType *quotientPart;
+    memSizeType pos;
 
-  /* uBigDigitSquare */
-    digit = big1[0];
-    carry = (doubleBigDigitType) digit * digit;
-    square[0] = (bigDigitType) (carry & BIGDIGIT_MASK);
-    carry >>= BIGDIGIT_SIZE;
-    if (size == 1) {
-      square[1] = (bigDigitType) (carry);
+  /* uBigBzDiv2n1n */
+    logMessage(printf("uBigBzDiv2n1n: size=" FMT_U_MEM "\n", size););
+    if ((size & 1) != 0 || size < BURNIKEL_ZIEGLER_THRESHOLD) {
+      uBigDigitDiv(dividend, size << 1, divisor, size, quotient);
     } else {
-      for (pos2 = 1; pos2 < size; pos2++) {
-        product = (doubleBigDigitType) digit * big1[pos2];
-        carry += (product << 1) & BIGDIGIT_MASK;
-        square[pos2] = (bigDigitType) (carry & BIGDIGIT_MASK);
-        carry >>= BIGDIGIT_SIZE;
-        carry += product >> (BIGDIGIT_SIZE - 1);
+      half = size >> 1;
+      for (part = 2; part != 0; ) {
+        part--;
+        /* Divide the 3 * half digits of block by divisor. */
+        block = &dividend[part * half];
+        quotientPart = &quotient[part * half];
+        pos = half;
+        do {
+          pos--;
+        } while (pos != 0 && block[size + pos] == divisor[half + pos]);
+        if (block[size + pos] < divisor[half + pos]) {
+          uBigBzDiv2n1n(&block[half], &divisor[half], half, quotientPart, temp);
+        } else {
+          /* The upper digits of block and divisor are equal. The   */
+          /* quotient is estimated as BIGDIGIT_MASK in every digit.  */
+          memset(quotientPart, 0xFF, (size_t) half * sizeof(bigDigitType));
+          memset(&block[size], 0, (size_t) half * sizeof(bigDigitType));
+          uBigDigitAddTo(&block[half], size, &divisor[half], half);
+        } /* if */
+        uBigToom3Mult(quotientPart, divisor, half, temp, &temp[size]);
+        uBigDigitSbtrFrom(block, size + half, temp, size);
+        while (IS_NEGATIVE(block[size + half - 1])) {
+          uBigDigitAddTo(block, size + half, divisor, size);
+          for (pos = 0; quotientPart[pos] == 0; pos++) {
+            quotientPart[pos] = BIGDIGIT_MASK;
+          } /* for */
+          quotientPart[pos]--;
+        } /* while */
       } /* for */
-      square[pos2] = (bigDigitType) (carry & BIGDIGIT_MASK);
-      square[pos2 + 1] = (bigDigitType) (carry >> BIGDIGIT_SIZE);
-      for (pos1 = 1; pos1 < size; pos1++) {
-        digit = big1[pos1];
-        carry = (doubleBigDigitType) square[pos1 << 1] +
-            (doubleBigDigitType) digit * digit;
-        square[pos1 << 1] = (bigDigitType) (carry & BIGDIGIT_MASK);
-        carry >>= BIGDIGIT_SIZE;
-        for (pos2 = pos1 + 1; pos2 < size; pos2++) {
-          product = (doubleBigDigitType) digit * big1[pos2];
-          carry += (doubleBigDigitType) square[pos1 + pos2] +
-              ((product << 1) & BIGDIGIT_MASK);
-          square[pos1 + pos2] = (bigDigitType) (carry & BIGDIGIT_MASK);
-          carry >>= BIGDIGIT_SIZE;
-          carry += product >> (BIGDIGIT_SIZE - 1);
-        } /* for */
-        carry += (doubleBigDigitType) square[pos1 + pos2];
-        square[pos1 + pos2] = (bigDigitType) (carry & BIGDIGIT_MASK);
-        if (pos1 < size - 1) {
-          square[pos1 + pos2 + 1] = (bigDigitType) (carry >> BIGDIGIT_SIZE);
-        } /* if */
+    } /* if */
+  } /* uBigBzDiv2n1n */
+
+
+
+/**
+ *  Computes quotient and remainder of an integer division with the
+ *  algorithm of Burnikel and Ziegler. The preconditions are the
+ *  same as for uBigDiv(). The divisor is padded with zero digits
+ *  to a block size which can be halved down to the
+ *  BURNIKEL_ZIEGLER_THRESHOLD. The dividend is processed in blocks
+ *  of this size. If quotient is NULL only the remainder is computed.
+ *  @return TRUE if the division was done, or FALSE if there is not
+ *          enough memory.
+ */
+static boolType uBigBurnikelZieglerDiv (const bigIntType dividend,
+    const const_bigIntType divisor, const bigIntType quotient)
+
+  {
+    memSizeType blockSize;
+    memSizeType multiple = 1;
+    memSizeType padding;
+    memSizeType numBlocks;
+    memSizeType bufferSize;
+    bigIntType buffer;
+    bigDigitType *work;
+    bigDigitType *divisorWork;
+    bigDigitType *quotientWork;
+    bigDigitType *temp;
+    memSizeType block;
+    boolType okay;
+
+  /* uBigBurnikelZieglerDiv */
+    logFunction(printf("uBigBurnikelZieglerDiv(size=" FMT_U_MEM ", size=" FMT_U_MEM ")\n",
+                       dividend->size, divisor->size););
+    while (divisor->size / multiple >= BURNIKEL_ZIEGLER_THRESHOLD) {
+      multiple <<= 1;
+    } /* while */
+    blockSize = ((divisor->size - 1) / multiple + 1) * multiple;
+    padding = blockSize - divisor->size;
+    numBlocks = (dividend->size + padding - 1) / blockSize + 1;
+    /* The buffer holds the padded dividend, the padded divisor, */
+    /* the quotient and 3 * blockSize digits of temp.            */
+    bufferSize = (2 * numBlocks + 3) * blockSize;
+    if (unlikely(numBlocks > MAX_BIG_LEN / 2 / blockSize ||
+                 !ALLOC_BIG(buffer, bufferSize))) {
+      okay = FALSE;
+    } else {
+      work = buffer->bigdigits;
+      divisorWork = &work[numBlocks * blockSize];
+      quotientWork = &divisorWork[blockSize];
+      temp = &quotientWork[(numBlocks - 1) * blockSize];
+      memset(work, 0, (size_t) padding * sizeof(bigDigitType));
+      memcpy(&work[padding], dividend->bigdigits,
+             (size_t) dividend->size * sizeof(bigDigitType));
+      memset(&work[padding + dividend->size], 0,
+             (size_t) (numBlocks * blockSize - padding - dividend->size) *
+             sizeof(bigDigitType));
+      memset(divisorWork, 0, (size_t) padding * sizeof(bigDigitType));
+      memcpy(&divisorWork[padding], divisor->bigdigits,
+             (size_t) divisor->size * sizeof(bigDigitType));
+      for (block = numBlocks - 1; block != 0; ) {
+        block--;
+        uBigBzDiv2n1n(&work[block * blockSize], divisorWork, blockSize,
+                      &quotientWork[block * blockSize], temp);
       } /* for */
+      if (quotient != NULL) {
+        memcpy(quotient->bigdigits, quotientWork,
+               (size_t) (dividend->size - divisor->size) * sizeof(bigDigitType));
+      } /* if */
+      memcpy(dividend->bigdigits, &work[padding],
+             (size_t) divisor->size * sizeof(bigDigitType));
+      memset(&dividend->bigdigits[divisor->size], 0,
+             (size_t) (dividend->size - divisor->size) * sizeof(bigDigitType));
+      FREE_BIG2(buffer, bufferSize);
+      okay = TRUE;
     } /* if */
-  } /* uBigDigitSquare */
+    return okay;
+  } /* uBigBurnikelZieglerDiv */
 
 
 
-static void uBigKaratsubaSquare (const bigDigitType *const big1,
-    const memSizeType size, bigDigitType *const square, bigDigitType *const temp)
+/**
+ *  Computes quotient and remainder of an integer division of dividend by
+ *  divisor for nonnegative big integers. The remainder is delivered in
+ *  dividend. There are several preconditions for this function. Divisor
+ *  must have at least 2 digits and dividend must have at least one
+ *  digit more than divisor. If dividend and divisor have the same length in
+ *  digits nothing is done. The most significant bit of divisor must be
+ *  set. The most significant digit of dividend must be less than the
+ *  most significant digit of divisor. The computations to meet this
+ *  preconditions are done outside this function. The special cases
+ *  with a one digit divisor or a dividend with less digits than divisor are
+ *  handled in other functions. If divisor is big and the quotient has
+ *  at least half the size of divisor the algorithm of Burnikel and
+ *  Ziegler is used. Otherwise the algorithm from D.E. Knuth described
+ *  in "The art of computer programming" volume 2 (Seminumerical
+ *  algorithms) is used.
+ */
+static void uBigDiv (const bigIntType dividend, const const_bigIntType divisor,
+    const bigIntType quotient)
 
-  {
-    memSizeType sizeLo;
-    memSizeType sizeHi;
+  { /* uBigDiv */
+    if (divisor->size < BURNIKEL_ZIEGLER_THRESHOLD ||
+        (dividend->size - divisor->size) << 1 < divisor->size ||
+        !uBigBurnikelZieglerDiv(dividend, divisor, quotient)) {
+      uBigDigitDiv(dividend->bigdigits, dividend->size,
+                   divisor->bigdigits, divisor->size, quotient->bigdigits);
+    } /* if */
+  } /* uBigDiv */
 
-  /* uBigKaratsubaSquare */
-    logMessage(printf("uBigKaratsubaSquare: size=" FMT_U_MEM "\n", size););
-    if (size < KARATSUBA_SQUARE_THRESHOLD) {
-      uBigDigitSquare(big1, size, square);
-    } else {
-      sizeHi = size >> 1;
-      sizeLo = size - sizeHi;
-      uBigDigitAdd(big1, sizeLo, &big1[sizeLo], sizeHi, square);
-      uBigKaratsubaSquare(square, sizeLo + 1, temp, &temp[(sizeLo + 1) << 1]);
-      uBigKaratsubaSquare(big1, sizeLo, square, &temp[(sizeLo + 1) << 1]);
-      uBigKaratsubaSquare(&big1[sizeLo], sizeHi, &square[sizeLo << 1], &temp[(sizeLo + 1) << 1]);
-      uBigDigitSbtrFrom(temp, (sizeLo + 1) << 1, square, sizeLo << 1);
-      uBigDigitSbtrFrom(temp, (sizeLo + 1) << 1, &square[sizeLo << 1], sizeHi << 1);
-      uBigDigitAddTo(&square[sizeLo], sizeLo + (sizeHi << 1), temp, (sizeLo + 1) << 1);
+
+
+/**
+ *  Computes the remainder of an integer division of dividend by divisor
+ *  for nonnegative big integers. The remainder is delivered in
+ *  dividend. The preconditions are the same as for uBigDiv().
+ */
+static void uBigRem (const bigIntType dividend, const const_bigIntType divisor)
+
+  { /* uBigRem */
+    if (divisor->size < BURNIKEL_ZIEGLER_THRESHOLD ||
+        (dividend->size - divisor->size) << 1 < divisor->size ||
+        !uBigBurnikelZieglerDiv(dividend, divisor, NULL)) {
+      uBigDigitDiv(dividend->bigdigits, dividend->size,
+                   divisor->bigdigits, divisor->size, NULL);
     } /* if */
-  } /* uBigKaratsubaSquare */
+  } /* uBigRem */
+
 
 
 static void uBigMultPositiveWithDigit (const const_bigIntType factor1,
@@ -2826,7 +3537,9 @@ static void bigMultAssign1 (bigIntType *const big_variable, bigDigitType factor_
 
 
 /**
- *  Multiply two unsigned big integers with the Karatsuba multiplication.
+ *  Multiply two unsigned big integers.
+ *  Depending on the sizes the schoolbook, Karatsuba, Toom-3 or
+ *  NTT multiplication is used.
  *  @return the product, and NULL if there is not enough memory.
  */
 static bigIntType uBigMultK (const_bigIntType factor1, const_bigIntType factor2,
@@ -2846,6 +3559,25 @@ static bigIntType uBigMultK (const_bigIntType factor1, const_bigIntType factor2,
       factor1 = factor2;
       factor2 = help_big;
     } /* if */
+#if BIGDIGIT_SIZE == 32
+    if (factor2->size >= NTT_MULT_THRESHOLD &&
+        (factor1->size + factor2->size) << 1 <= NTT_MAX_LENGTH) {
+      if (likely(ALLOC_BIG(product, factor1->size + factor2->size))) {
+        product->size = factor1->size + factor2->size;
+        if (unlikely(!uBigNttMult(factor1->bigdigits, factor1->size,
+                                  factor2->bigdigits, factor2->size,
+                                  product->bigdigits))) {
+          FREE_BIG2(product, factor1->size + factor2->size);
+          product = NULL;
+        } else {
+          if (negative) {
+            negate_positive_big(product);
+          } /* if */
+          product = normalize(product);
+        } /* if */
+      } /* if */
+    } else
+#endif
     if (factor1->size >= KARATSUBA_MULT_THRESHOLD &&
         factor2->size >= KARATSUBA_MULT_THRESHOLD) {
       if (factor2->size << 1 <= factor1->size) {
@@ -2864,11 +3596,11 @@ static bigIntType uBigMultK (const_bigIntType factor1, const_bigIntType factor2,
               FREE_BIG2(product, (factor1->size >> 1) + (factor2->size << 1));
               product = NULL;
             } else {
-              uBigKaratsubaMult(factor1->bigdigits, factor2->bigdigits,
-                                factor1->size >> 1, product->bigdigits, temp->bigdigits);
-              uBigKaratsubaMult(&factor1->bigdigits[factor1->size >> 1], factor2->bigdigits,
-                                factor2->size, temp->bigdigits,
-                                &temp->bigdigits[factor2->size << 1]);
+              uBigToom3Mult(factor1->bigdigits, factor2->bigdigits,
+                            factor1->size >> 1, product->bigdigits, temp->bigdigits);
+              uBigToom3Mult(&factor1->bigdigits[factor1->size >> 1], factor2->bigdigits,
+                            factor2->size, temp->bigdigits,
+                            &temp->bigdigits[factor2->size << 1]);
               memset(&product->bigdigits[(factor1->size >> 1) << 1], 0,
                      (size_t) (product->size - ((factor1->size >> 1) << 1)) * sizeof(bigDigitType));
               uBigDigitAddTo(&product->bigdigits[factor1->size >> 1],
@@ -2898,7 +3630,7 @@ static bigIntType uBigMultK (const_bigIntType factor1, const_bigIntType factor2,
               FREE_BIG2(product, factor1->size << 1);
               product = NULL;
             } else {
-              uBigKaratsubaMult(factor1->bigdigits, factor2->bigdigits,
+              uBigToom3Mult(factor1->bigdigits, factor2->bigdigits,
                   factor1->size, product->bigdigits, temp->bigdigits);
               product->size = factor1->size << 1;
               if (negative) {
@@ -2928,7 +3660,9 @@ static bigIntType uBigMultK (const_bigIntType factor1, const_bigIntType factor2,
 
 
 /**
- *  Square an unsigned big integer with the Karatsuba multiplication.
+ *  Square an unsigned big integer.
+ *  Depending on the size the schoolbook, Karatsuba, Toom-3 or
+ *  NTT squaring is used.
  *  @return the square, and NULL if there is not enough memory.
  */
 static bigIntType uBigSquareK (const_bigIntType big1)
@@ -2940,13 +3674,28 @@ static bigIntType uBigSquareK (const_bigIntType big1)
   /* uBigSquareK */
     logFunction(printf("uBigSquareK(size= " FMT_U_MEM ")\n",
                        big1->size););
+#if BIGDIGIT_SIZE == 32
+    if (big1->size >= NTT_SQUARE_THRESHOLD &&
+        big1->size << 2 <= NTT_MAX_LENGTH) {
+      if (likely(ALLOC_BIG(square, big1->size << 1))) {
+        square->size = big1->size << 1;
+        if (unlikely(!uBigNttMult(big1->bigdigits, big1->size, NULL, big1->size,
+                                  square->bigdigits))) {
+          FREE_BIG2(square, big1->size << 1);
+          square = NULL;
+        } else {
+          square = normalize(square);
+        } /* if */
+      } /* if */
+    } else
+#endif
     if (big1->size >= KARATSUBA_SQUARE_THRESHOLD) {
       if (likely(ALLOC_BIG(square, big1->size << 1))) {
         if (unlikely(!ALLOC_BIG(temp, big1->size << 2))) {
           FREE_BIG2(square, big1->size << 1);
           square = NULL;
         } else {
-          uBigKaratsubaSquare(big1->bigdigits, big1->size,
+          uBigToom3Square(big1->bigdigits, big1->size,
               square->bigdigits, temp->bigdigits);
           square->size = big1->size << 1;
           square = normalize(square);
@@ -3112,6 +3861,302 @@ static int uBigIsNot0 (const const_bigIntType big)
 
 
 
+/**
+ *  Get the bit with the number bitPos of an unsigned big integer.
+ */
+static inline unsigned int uBigBit (const const_bigIntType big1,
+    const memSizeType bitPos)
+
+  { /* uBigBit */
+    return (unsigned int)
+        (big1->bigdigits[bitPos >> BIGDIGIT_LOG2_SIZE] >> (bitPos & BIGDIGIT_SIZE_MASK)) & 1;
+  } /* uBigBit */
+
+
+
+/**
+ *  Compute -digit**-1 mod 2**BIGDIGIT_SIZE for an odd digit.
+ *  Every Newton iteration doubles the number of correct bits.
+ *  An odd digit is its own inverse modulo 8.
+ */
+static bigDigitType uBigMontgomeryNegInverse (const bigDigitType digit)
+
+  {
+    doubleBigDigitType inverse;
+    unsigned int bits;
+
+  /* uBigMontgomeryNegInverse */
+    inverse = digit;
+    for (bits = 3; bits < BIGDIGIT_SIZE; bits <<= 1) {
+      inverse = (inverse * ((2 - digit * inverse) & BIGDIGIT_MASK)) & BIGDIGIT_MASK;
+    } /* for */
+    return (bigDigitType) ((0 - inverse) & BIGDIGIT_MASK);
+  } /* uBigMontgomeryNegInverse */
+
+
+
+/**
+ *  Montgomery multiplication of two digit arrays with size digits.
+ *  The result is factor1 * factor2 * 2**(-size*BIGDIGIT_SIZE) mod modulus.
+ *  If factor2 is NULL factor1 is squared. The factors must be less
+ *  than modulus and modulus must be odd. The product is computed with
+ *  uBigToom3Mult() or uBigToom3Square() and reduced afterwards.
+ *  Temp needs 6 * size + 1 digits. The result may be identical to a factor.
+ */
+static void uBigMontgomeryMult (const bigDigitType *const factor1,
+    const bigDigitType *const factor2, const bigDigitType *const modulus,
+    const memSizeType size, const bigDigitType negInverse,
+    bigDigitType *const temp, bigDigitType *const result)
+
+  {
+    memSizeType pos1;
+    memSizeType pos2;
+    doubleBigDigitType carry;
+    bigDigitType reductionDigit;
+    bigDigitType *reduced;
+    boolType greaterEqual;
+
+  /* uBigMontgomeryMult */
+    if (factor2 == NULL) {
+      uBigToom3Square(factor1, size, temp, &temp[(size << 1) + 1]);
+    } else {
+      uBigToom3Mult(factor1, factor2, size, temp, &temp[(size << 1) + 1]);
+    } /* if */
+    temp[size << 1] = 0;
+    for (pos1 = 0; pos1 < size; pos1++) {
+      reductionDigit = (bigDigitType) ((doubleBigDigitType) temp[pos1] * negInverse & BIGDIGIT_MASK);
+      carry = 0;
+      for (pos2 = 0; pos2 < size; pos2++) {
+        carry += (doubleBigDigitType) temp[pos1 + pos2] +
+            (doubleBigDigitType) reductionDigit * modulus[pos2];
+        temp[pos1 + pos2] = (bigDigitType) (carry & BIGDIGIT_MASK);
+        carry >>= BIGDIGIT_SIZE;
+      } /* for */
+      for (pos2 = pos1 + size; carry != 0; pos2++) {
+        carry += temp[pos2];
+        temp[pos2] = (bigDigitType) (carry & BIGDIGIT_MASK);
+        carry >>= BIGDIGIT_SIZE;
+      } /* for */
+    } /* for */
+    reduced = &temp[size];
+    greaterEqual = reduced[size] != 0;
+    if (!greaterEqual) {
+      pos1 = size;
+      do {
+        pos1--;
+      } while (pos1 != 0 && reduced[pos1] == modulus[pos1]);
+      greaterEqual = reduced[pos1] >= modulus[pos1];
+    } /* if */
+    if (greaterEqual) {
+      uBigDigitSbtrFrom(reduced, size + 1, modulus, size);
+    } /* if */
+    memcpy(result, reduced, (size_t) size * sizeof(bigDigitType));
+  } /* uBigMontgomeryMult */
+
+
+
+/**
+ *  Compute base ** exponent mod modulus for an odd modulus.
+ *  The powers are computed in the Montgomery representation with
+ *  a sliding window of exponent bits. A table with the odd powers
+ *  of base allows to process several exponent bits with one
+ *  multiplication. The exponent must be positive.
+ */
+static bigIntType bigModPowMontgomery (const const_bigIntType base,
+    const const_bigIntType exponent, const const_bigIntType modulus)
+
+  {
+    memSizeType size;
+    memSizeType bitLength;
+    memSizeType bitsLeft;
+    memSizeType windowEnd;
+    memSizeType pos;
+    unsigned int windowSize;
+    memSizeType tableSize;
+    memSizeType bufferSize;
+    memSizeType value;
+    bigDigitType negInverse;
+    bigIntType baseMod;
+    bigIntType shifted;
+    bigIntType buffer;
+    bigDigitType *table;
+    bigDigitType *square;
+    bigDigitType *accu;
+    bigDigitType *temp;
+    boolType started = FALSE;
+    bigIntType power;
+
+  /* bigModPowMontgomery */
+    size = modulus->size;
+    if (modulus->bigdigits[size - 1] == 0) {
+      size--;
+    } /* if */
+    bitLength = ((exponent->size - 1) << BIGDIGIT_LOG2_SIZE) +
+        (memSizeType) (digitMostSignificantBit(exponent->bigdigits[exponent->size - 1]) + 1);
+    if (bitLength > 671) {
+      windowSize = 6;
+    } else if (bitLength > 239) {
+      windowSize = 5;
+    } else if (bitLength > 79) {
+      windowSize = 4;
+    } else if (bitLength > 23) {
+      windowSize = 3;
+    } else {
+      windowSize = 1;
+    } /* if */
+    tableSize = (memSizeType) 1 << (windowSize - 1);
+    bufferSize = (tableSize + 8) * size + 1;
+    if (unlikely((baseMod = bigMod(base, modulus)) == NULL)) {
+      power = NULL;
+    } else if (unlikely((shifted = bigLShift(baseMod,
+        (intType) (size << BIGDIGIT_LOG2_SIZE))) == NULL)) {
+      bigDestr(baseMod);
+      power = NULL;
+    } else {
+      bigDestr(baseMod);
+      baseMod = bigMod(shifted, modulus);
+      bigDestr(shifted);
+      if (unlikely(baseMod == NULL)) {
+        power = NULL;
+      } else if (unlikely(!ALLOC_BIG(buffer, bufferSize))) {
+        bigDestr(baseMod);
+        raise_error(MEMORY_ERROR);
+        power = NULL;
+      } else if (unlikely(!ALLOC_BIG_SIZE_OK(power, size + 1))) {
+        FREE_BIG2(buffer, bufferSize);
+        bigDestr(baseMod);
+        raise_error(MEMORY_ERROR);
+      } else {
+        negInverse = uBigMontgomeryNegInverse(modulus->bigdigits[0]);
+        table = buffer->bigdigits;
+        square = &table[tableSize * size];
+        accu = &square[size];
+        temp = &accu[size];
+        memset(table, 0, (size_t) size * sizeof(bigDigitType));
+        memcpy(table, baseMod->bigdigits,
+               (size_t) (baseMod->size < size ? baseMod->size : size) *
+               sizeof(bigDigitType));
+        bigDestr(baseMod);
+        if (tableSize > 1) {
+          uBigMontgomeryMult(table, NULL, modulus->bigdigits, size, negInverse,
+                             temp, square);
+          for (pos = 1; pos < tableSize; pos++) {
+            uBigMontgomeryMult(&table[(pos - 1) * size], square, modulus->bigdigits,
+                               size, negInverse, temp, &table[pos * size]);
+          } /* for */
+        } /* if */
+        bitsLeft = bitLength;
+        while (bitsLeft != 0) {
+          if (uBigBit(exponent, bitsLeft - 1) == 0) {
+            uBigMontgomeryMult(accu, NULL, modulus->bigdigits, size, negInverse,
+                               temp, accu);
+            bitsLeft--;
+          } else {
+            windowEnd = bitsLeft > windowSize ? bitsLeft - windowSize : 0;
+            while (uBigBit(exponent, windowEnd) == 0) {
+              windowEnd++;
+            } /* while */
+            value = 0;
+            for (pos = bitsLeft; pos > windowEnd; ) {
+              pos--;
+              value = value << 1 | uBigBit(exponent, pos);
+              if (started) {
+                uBigMontgomeryMult(accu, NULL, modulus->bigdigits, size, negInverse,
+                                   temp, accu);
+              } /* if */
+            } /* for */
+            if (started) {
+              uBigMontgomeryMult(accu, &table[(value >> 1) * size], modulus->bigdigits,
+                                 size, negInverse, temp, accu);
+            } else {
+              memcpy(accu, &table[(value >> 1) * size],
+                     (size_t) size * sizeof(bigDigitType));
+              started = TRUE;
+            } /* if */
+            bitsLeft = windowEnd;
+          } /* if */
+        } /* while */
+        /* Leave the Montgomery representation by multiplying with 1. */
+        memset(square, 0, (size_t) size * sizeof(bigDigitType));
+        square[0] = 1;
+        uBigMontgomeryMult(accu, square, modulus->bigdigits, size, negInverse,
+                           temp, power->bigdigits);
+        power->bigdigits[size] = 0;
+        power->size = size + 1;
+        power = normalize(power);
+        FREE_BIG2(buffer, bufferSize);
+      } /* if */
+    } /* if */
+    return power;
+  } /* bigModPowMontgomery */
+
+
+
+/**
+ *  Compute factor1 * factor2 mod modulus. If factor2 is NULL
+ *  factor1 is squared. Factor1 is assumed to be a temporary
+ *  value which is destroyed.
+ */
+static bigIntType bigMultModTemp (bigIntType factor1,
+    const const_bigIntType factor2, const const_bigIntType modulus)
+
+  {
+    bigIntType product;
+    bigIntType result;
+
+  /* bigMultModTemp */
+    if (factor2 == NULL) {
+      product = bigSquare(factor1);
+    } else {
+      product = bigMult(factor1, factor2);
+    } /* if */
+    FREE_BIG(factor1);
+    if (unlikely(product == NULL)) {
+      result = NULL;
+    } else {
+      result = bigMod(product, modulus);
+      FREE_BIG(product);
+    } /* if */
+    return result;
+  } /* bigMultModTemp */
+
+
+
+/**
+ *  Compute base ** exponent mod modulus with a binary
+ *  left-to-right exponentiation. Every step is reduced with
+ *  bigMod(). The exponent must be positive.
+ */
+static bigIntType bigModPowSquareMult (const const_bigIntType base,
+    const const_bigIntType exponent, const const_bigIntType modulus)
+
+  {
+    memSizeType bitsLeft;
+    bigIntType baseMod;
+    bigIntType power;
+
+  /* bigModPowSquareMult */
+    bitsLeft = ((exponent->size - 1) << BIGDIGIT_LOG2_SIZE) +
+        (memSizeType) (digitMostSignificantBit(exponent->bigdigits[exponent->size - 1]) + 1);
+    if (unlikely((baseMod = bigMod(base, modulus)) == NULL)) {
+      power = NULL;
+    } else {
+      power = bigCreate(baseMod);
+      bitsLeft--;
+      while (bitsLeft != 0 && power != NULL) {
+        bitsLeft--;
+        power = bigMultModTemp(power, NULL, modulus);
+        if (power != NULL && uBigBit(exponent, bitsLeft) != 0) {
+          power = bigMultModTemp(power, baseMod, modulus);
+        } /* if */
+      } /* while */
+      bigDestr(baseMod);
+    } /* if */
+    return power;
+  } /* bigModPowSquareMult */
+
+
+
 /**
  *  Compute the absolute value of a 'bigInteger' number.
  *  @return the absolute value.
@@ -5968,6 +7013,50 @@ bigIntType bigMod (const const_bigIntType dividend, const const_bigIntType divis
 
 
 
+/**
+ *  Compute the modular exponentiation of base ** exponent.
+ *  For an odd modulus the Montgomery multiplication is used.
+ *  @return base ** exponent mod modulus
+ *  @exception RANGE_ERROR If exponent or modulus are negative.
+ *  @exception NUMERIC_ERROR If modulus is zero and exponent is positive.
+ */
+bigIntType bigModPow (const const_bigIntType base,
+    const const_bigIntType exponent, const const_bigIntType modulus)
+
+  {
+    bigIntType power;
+
+  /* bigModPow */
+    logFunction(printf("bigModPow(%s, ", bigHexCStri(base));
+                printf("%s, ", bigHexCStri(exponent));
+                printf("%s)\n", bigHexCStri(modulus)););
+    if (unlikely(IS_NEGATIVE(exponent->bigdigits[exponent->size - 1]) ||
+                 IS_NEGATIVE(modulus->bigdigits[modulus->size - 1]))) {
+      logError(printf("bigModPow(%s, ", bigHexCStri(base));
+               printf("%s, ", bigHexCStri(exponent));
+               printf("%s): Exponent or modulus is negative.\n",
+                      bigHexCStri(modulus)););
+      raise_error(RANGE_ERROR);
+      power = NULL;
+    } else if (exponent->size == 1 && exponent->bigdigits[0] == 0) {
+      if (unlikely(!ALLOC_BIG_SIZE_OK(power, 1))) {
+        raise_error(MEMORY_ERROR);
+      } else {
+        power->size = 1;
+        power->bigdigits[0] = 1;
+      } /* if */
+    } else if ((modulus->bigdigits[0] & 1) != 0 &&
+               modulus->size <= MONTGOMERY_MAX_SIZE) {
+      power = bigModPowMontgomery(base, exponent, modulus);
+    } else {
+      power = bigModPowSquareMult(base, exponent, modulus);
+    } /* if */
+    logFunction(printf("bigModPow --> %s\n", bigHexCStri(power)););
+    return power;
+  } /* bigModPow */
+
+
+
 /**
  *  Multiply two 'bigInteger' numbers.
  *  @return the product of the two numbers.
@@ -1,7 +1,7 @@
 /********************************************************************/
 /*                                                                  */
 /*  s7   Seed7 interpreter                                          */
-/*  Copyright (C) 1990 - 2019  Thomas Mertes                        */
+/*  Copyright (C) 1990 - 2019, 2026  Thomas Mertes                  */
 /*                                                                  */
 /*  This program is free software; you can redistribute it and/or   */
 /*  modify it under the terms of the GNU General Public License as  */
@@ -20,7 +20,7 @@
 /*                                                                  */
 /*  Module: Library                                                 */
 /*  File: seed7/src/biglib.c                                        */
-/*  Changes: 2005, 2006, 2013 - 2018  Thomas Mertes                 */
+/*  Changes: 2005, 2006, 2013 - 2018, 2026  Thomas Mertes           */
 /*  Content: All primitive actions for the bigInteger type.         */
 /*                                                                  */
 /********************************************************************/
@@ -657,6 +657,25 @@ objectType big_mod (listType arguments)
 
 
 
+/**
+ *  Compute the modular exponentiation of base ** exponent.
+ *  @return base ** exponent mod modulus
+ *  @exception RANGE_ERROR If exponent or modulus are negative.
+ *  @exception NUMERIC_ERROR If modulus is zero and exponent is positive.
+ */
+objectType big_modpow (listType arguments)
+
+  { /* big_modpow */
+    isit_bigint(arg_1(arguments));
+    isit_bigint(arg_2(arguments));
+    isit_bigint(arg_3(arguments));
+    return bld_bigint_temp(
+        bigModPow(take_bigint(arg_1(arguments)), take_bigint(arg_2(arguments)),
+                  take_bigint(arg_3(arguments))));
+  } /* big_modpow */
+
+
+
 /**
  *  Multiply two 'bigInteger' numbers.
  *  @return the product of the two numbers.
@@ -1,7 +1,7 @@
 /********************************************************************/
 /*                                                                  */
 /*  s7   Seed7 interpreter                                          */
-/*  Copyright (C) 1990 - 2014  Thomas Mertes                        */
+/*  Copyright (C) 1990 - 2014, 2026  Thomas Mertes                  */
 /*                                                                  */
 /*  This program is free software; you can redistribute it and/or   */
 /*  modify it under the terms of the GNU General Public License as  */
@@ -20,7 +20,7 @@
 /*                                                                  */
 /*  Module: Library                                                 */
 /*  File: seed7/src/biglib.h                                        */
-/*  Changes: 2005, 2006, 2013, 2014  Thomas Mertes                  */
+/*  Changes: 2005, 2006, 2013, 2014, 2026  Thomas Mertes            */
 /*  Content: All primitive actions for the bigInteger type.         */
 /*                                                                  */
 /********************************************************************/
@@ -57,6 +57,7 @@ objectType big_lshift_assign  (listType arguments);
 objectType big_lt             (listType arguments);
 objectType big_mdiv           (listType arguments);
 objectType big_mod            (listType arguments);
+objectType big_modpow         (listType arguments);
 objectType big_mult           (listType arguments);
 objectType big_mult_assign    (listType arguments);
 objectType big_ne             (listType arguments);
@@ -2,7 +2,7 @@
 /*                                                                  */
 /*  s7   Seed7 interpreter                                          */
 /*  Copyright (C) 1990 - 2000, 2011, 2013, 2015  Thomas Mertes      */
-/*                2017, 2024, 2025  Thomas Mertes                   */
+/*                2017, 2024, 2025, 2026  Thomas Mertes             */
 /*                                                                  */
 /*  This program is free software; you can redistribute it and/or   */
 /*  modify it under the terms of the GNU General Public License as  */
@@ -22,7 +22,7 @@
 /*  Module: General                                                 */
 /*  File: seed7/src/blockutl.c                                      */
 /*  Changes: 1992, 1993, 1994, 2011, 2013, 2015  Thomas Mertes      */
-/*           2017, 2024, 2025  Thomas Mertes                        */
+/*           2017, 2024, 2025, 2026  Thomas Mertes                  */
 /*  Content: Functions to maintain objects of type blockType.       */
 /*                                                                  */
 /********************************************************************/
@@ -46,6 +46,7 @@
 #include "traceutl.h"
 #include "objutl.h"
 #include "match.h"
+#include "bytecode.h"
 
 #undef EXTERN
 #define EXTERN
@@ -199,6 +200,7 @@ void free_block (blockType block)
   { /* free_block */
     logFunction(printf("free_block(" FMT_U_MEM ")\n",
                        (memSizeType) block););
+    free_bytecode(block);
     free_expression(block->body);
     free_local_consts(block->local_consts);
     free_loclist(block->params);
@@ -237,6 +239,7 @@ blockType new_block (const_locObjType block_result,
       created_block->local_vars = block_local_vars;
       created_block->local_consts = block_local_consts;
       created_block->body = block_body;
+      created_block->code = NULL;
     } /* if */
     logFunction(printf("new_block --> " FMT_U_MEM "\n", (memSizeType) created_block););
     return created_block;
@@ -2,7 +2,7 @@
 /*                                                                  */
 /*  bst_rtl.c     Primitive actions for the byte string type.       */
 /*  Copyright (C) 1989 - 2011, 2013 - 2016, 2018  Thomas Mertes     */
-/*                2024  Thomas Mertes                               */
+/*                2024, 2026  Thomas Mertes                         */
 /*                                                                  */
 /*  This file is part of the Seed7 Runtime Library.                 */
 /*                                                                  */
@@ -26,6 +26,7 @@
 /*  Module: Seed7 Runtime Library                                   */
 /*  File: seed7/src/bst_rtl.c                                       */
 /*  Changes: 2007, 2010, 2011, 2013 - 2016, 2018  Thomas Mertes     */
+/*           2026  Thomas Mertes                                    */
 /*  Content: Primitive actions for the byte string type.            */
 /*                                                                  */
 /********************************************************************/
@@ -331,7 +332,7 @@ void bstDestrValue (const rtlValueUnion old_value)
 intType bstHashCode (const const_bstriType bstri)
 
   { /* bstHashCode */
-    return bstringHashCode(bstri);
+    return (intType) hash_ustri(bstri->mem, bstri->size);
   } /* bstHashCode */
 
 
@@ -1,7 +1,7 @@
 /********************************************************************/
 /*                                                                  */
 /*  bst_rtl.h     Primitive actions for the byte string type.       */
-/*  Copyright (C) 1989 - 2010  Thomas Mertes                        */
+/*  Copyright (C) 1989 - 2010, 2026  Thomas Mertes                  */
 /*                                                                  */
 /*  This file is part of the Seed7 Runtime Library.                 */
 /*                                                                  */
@@ -24,22 +24,11 @@
 /*                                                                  */
 /*  Module: Seed7 Runtime Library                                   */
 /*  File: seed7/src/bst_rtl.h                                       */
-/*  Changes: 2007, 2010  Thomas Mertes                              */
+/*  Changes: 2007, 2010, 2026  Thomas Mertes                        */
 /*  Content: Primitive actions for the byte string type.            */
 /*                                                                  */
 /********************************************************************/
 
-/**
- *  Macro to compute the hashcode of a bstring.
- *  A corresponding macro is inlined by the compiler. If this macro
- *  is changed the code in the compiler must be changed as well.
- */
-#define bstringHashCode(bstri) (intType) ((bstri)->size == 0 ? 0 : \
-                                             ((memSizeType) (bstri)->mem[0] << 5 ^ \
-                                                            (bstri)->size << 3 ^ \
-                                                            (bstri)->mem[(bstri)->size - 1]))
-
-
 void bstAppend (bstriType *const destination, const_bstriType extension);
 bstriType bstCat (const const_bstriType bstri1, const const_bstriType bstri2);
 intType bstCmp (const const_bstriType bstri1, const const_bstriType bstri2);
@@ -1,7 +1,7 @@
 /********************************************************************/
 /*                                                                  */
 /*  s7   Seed7 interpreter                                          */
-/*  Copyright (C) 1990 - 2019  Thomas Mertes                        */
+/*  Copyright (C) 1990 - 2019, 2026  Thomas Mertes                  */
 /*                                                                  */
 /*  This program is free software; you can redistribute it and/or   */
 /*  modify it under the terms of the GNU General Public License as  */
@@ -21,6 +21,7 @@
 /*  Module: Library                                                 */
 /*  File: seed7/src/bstlib.c                                        */
 /*  Changes: 2007, 2010, 2013, 2015, 2016, 2018  Thomas Mertes      */
+/*           2026  Thomas Mertes                                    */
 /*  Content: All primitive actions for the byte string type.        */
 /*                                                                  */
 /********************************************************************/
@@ -368,7 +369,7 @@ objectType bst_hashcode (listType arguments)
                 printf(")\n"););
     isit_bstri(arg_1(arguments));
     bstri = take_bstri(arg_1(arguments));
-    return bld_int_temp(bstringHashCode(bstri));
+    return bld_int_temp(bstHashCode(bstri));
   } /* bst_hashcode */
 
 
@@ -0,0 +1,631 @@
+/********************************************************************/
+/*                                                                  */
+/*  s7   Seed7 interpreter                                          */
+/*  Copyright (C) 2026  Thomas Mertes                               */
+/*                                                                  */
+/*  This program is free software; you can redistribute it and/or   */
+/*  modify it under the terms of the GNU General Public License as  */
+/*  published by the Free Software Foundation; either version 2 of  */
+/*  the License, or (at your option) any later version.             */
+/*                                                                  */
+/*  This program is distributed in the hope that it will be useful, */
+/*  but WITHOUT ANY WARRANTY; without even the implied warranty of  */
+/*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the   */
+/*  GNU General Public License for more details.                    */
+/*                                                                  */
+/*  You should have received a copy of the GNU General Public       */
+/*  License along with this program; if not, write to the           */
+/*  Free Software Foundation, Inc., 51 Franklin Street,             */
+/*  Fifth Floor, Boston, MA  02110-1301, USA.                       */
+/*                                                                  */
+/*                                                                  */
+/*  Module: Interpreter                                             */
+/*  File: seed7/src/bytecode.c                                      */
+/*  Changes: 2026  Thomas Mertes                                    */
+/*  Content: Execute lowered function bodies.                       */
+/*                                                                  */
+/********************************************************************/
+
+#define LOG_FUNCTIONS 0
+#define VERBOSE_EXCEPTIONS 0
+
+#include "version.h"
+
+#include "stdlib.h"
+#include "stdio.h"
+#include "string.h"
+
+#include "common.h"
+#include "data.h"
+#include "heaputl.h"
+#include "flistutl.h"
+#include "syvarutl.h"
+#include "listutl.h"
+#include "traceutl.h"
+#include "objutl.h"
+#include "runerr.h"
+#include "exec.h"
+
+#undef EXTERN
+#define EXTERN
+#define DO_INIT
+#include "bytecode.h"
+
+
+/**
+ *  The body of a function (blockType) is lowered into a contiguous
+ *  array of instructions, when the function is called the first time.
+ *  The instructions are in postfix order. The parameters of a
+ *  primitive action are pushed to an operand stack and the action
+ *  is called with pre-resolved action pointer. Call-by-name
+ *  parameters (MATCHOBJECT) of the body are lowered also. They are
+ *  found with the hash table matchTable, when evaluate() is called.
+ *  Everything that cannot be lowered is executed with exec_call().
+ *  The lowered code of a block is freed together with the block.
+ */
+typedef enum {
+    BC_CONST,   /* Push an object that is not evaluated. */
+    BC_VAR,     /* Push the value of a parameter or local variable. */
+    BC_CALL,    /* Push the result of exec_call() (not lowered). */
+    BC_ACTION   /* Call a primitive action with numArgs parameters. */
+  } opcodeType;
+
+typedef struct {
+    opcodeType opcode;
+    unsigned int numArgs;
+    objectType object;
+    const_objectType actObject;
+  } instrRecord, *instrType;
+
+typedef const instrRecord *const_instrType;
+
+typedef struct codeStruct {
+    objectType root;
+    struct codeStruct *next;
+    boolType inMatchTable;
+    memSizeType maxDepth;
+    memSizeType length;
+    instrRecord instr[1];
+  } codeRecord, *codeType;
+
+typedef const codeRecord *const_codeType;
+
+typedef struct {
+    instrType instr;
+    memSizeType length;
+    memSizeType capacity;
+    memSizeType depth;
+    memSizeType maxDepth;
+    boolType okay;
+  } lowerRecord, *lowerType;
+
+#define SIZ_CODE(len)        (sizeof(codeRecord) + ((len) - 1) * sizeof(instrRecord))
+#define ALLOC_CODE(var,len)  (ALLOC_HEAP(var, codeType, SIZ_CODE(len))?CNT(CNT1_BYT(SIZ_CODE(len))) TRUE:FALSE)
+#define FREE_CODE(var,len)   (CNT(CNT2_BYT(SIZ_CODE(len))) FREE_HEAP(var, SIZ_CODE(len)))
+
+/* The bits of temp_bits allow at most 32 parameters. */
+#define MAX_LOWERED_ARGS          32
+#define LOCAL_STACK_SIZE          64
+#define LOWER_START_CAPACITY     256
+#define MATCH_TABLE_START_SIZE  1024
+
+/* Marks a block, whose body has been lowered without result. */
+static codeRecord notLowered;
+
+static codeType *matchTable = NULL;
+static memSizeType matchTableSize = 0;
+static memSizeType matchTableUsed = 0;
+
+static lowerRecord lowerBuffer = {NULL, 0, 0, 0, 0, TRUE};
+
+
+
+static inline memSizeType matchHash (const_objectType object)
+
+  { /* matchHash */
+    return ((memSizeType) object >> 4) * (memSizeType) 0x9E3779B1;
+  } /* matchHash */
+
+
+
+static const_codeType findMatchCode (const_objectType object)
+
+  {
+    memSizeType mask;
+    memSizeType pos;
+    codeType code;
+
+  /* findMatchCode */
+    if (matchTable != NULL) {
+      mask = matchTableSize - 1;
+      pos = matchHash(object) & mask;
+      while ((code = matchTable[pos]) != NULL) {
+        if (code->root == object) {
+          return code;
+        } /* if */
+        pos = (pos + 1) & mask;
+      } /* while */
+    } /* if */
+    return NULL;
+  } /* findMatchCode */
+
+
+
+static void insertMatchCode (codeType *table, memSizeType size, codeType code)
+
+  {
+    memSizeType mask;
+    memSizeType pos;
+
+  /* insertMatchCode */
+    mask = size - 1;
+    pos = matchHash(code->root) & mask;
+    while (table[pos] != NULL) {
+      pos = (pos + 1) & mask;
+    } /* while */
+    table[pos] = code;
+  } /* insertMatchCode */
+
+
+
+static boolType enterMatchCode (codeType code)
+
+  {
+    memSizeType newSize;
+    codeType *newTable;
+    memSizeType pos;
+
+  /* enterMatchCode */
+    if (2 * (matchTableUsed + 1) > matchTableSize) {
+      newSize = matchTableSize == 0 ? MATCH_TABLE_START_SIZE : 2 * matchTableSize;
+      if (unlikely(!ALLOC_TABLE(newTable, codeType, newSize))) {
+        return FALSE;
+      } /* if */
+      memset(newTable, 0, newSize * sizeof(codeType));
+      for (pos = 0; pos < matchTableSize; pos++) {
+        if (matchTable[pos] != NULL) {
+          insertMatchCode(newTable, newSize, matchTable[pos]);
+        } /* if */
+      } /* for */
+      if (matchTable != NULL) {
+        FREE_TABLE(matchTable, codeType, matchTableSize);
+      } /* if */
+      matchTable = newTable;
+      matchTableSize = newSize;
+    } /* if */
+    insertMatchCode(matchTable, matchTableSize, code);
+    matchTableUsed++;
+    return TRUE;
+  } /* enterMatchCode */
+
+
+
+static void removeMatchCode (const_codeType code)
+
+  {
+    memSizeType mask;
+    memSizeType pos;
+    memSizeType gap;
+    memSizeType home;
+
+  /* removeMatchCode */
+    mask = matchTableSize - 1;
+    pos = matchHash(code->root) & mask;
+    while (matchTable[pos] != NULL && matchTable[pos] != code) {
+      pos = (pos + 1) & mask;
+    } /* while */
+    if (matchTable[pos] != NULL) {
+      /* Move following entries back, such that no search is interrupted. */
+      gap = pos;
+      pos = (pos + 1) & mask;
+      while (matchTable[pos] != NULL) {
+        home = matchHash(matchTable[pos]->root) & mask;
+        if (((pos - home) & mask) >= ((pos - gap) & mask)) {
+          matchTable[gap] = matchTable[pos];
+          gap = pos;
+        } /* if */
+        pos = (pos + 1) & mask;
+      } /* while */
+      matchTable[gap] = NULL;
+      matchTableUsed--;
+    } /* if */
+  } /* removeMatchCode */
+
+
+
+static void emit (lowerType lower, opcodeType opcode, objectType object,
+    const_objectType actObject, unsigned int numArgs)
+
+  {
+    instrType resized;
+    memSizeType newCapacity;
+
+  /* emit */
+    if (lower->length >= lower->capacity) {
+      newCapacity = lower->capacity == 0 ?
+          LOWER_START_CAPACITY : 2 * lower->capacity;
+      if (lower->instr == NULL) {
+        if (unlikely(!ALLOC_TABLE(resized, instrRecord, newCapacity))) {
+          resized = NULL;
+        } /* if */
+      } else {
+        resized = REALLOC_TABLE(lower->instr, instrRecord,
+                                lower->capacity, newCapacity);
+        if (resized != NULL) {
+          COUNT3_TABLE(instrRecord, lower->capacity, newCapacity);
+        } /* if */
+      } /* if */
+      if (unlikely(resized == NULL)) {
+        lower->okay = FALSE;
+        return;
+      } /* if */
+      lower->instr = resized;
+      lower->capacity = newCapacity;
+    } /* if */
+    lower->instr[lower->length].opcode = opcode;
+    lower->instr[lower->length].numArgs = numArgs;
+    lower->instr[lower->length].object = object;
+    lower->instr[lower->length].actObject = actObject;
+    lower->length++;
+    if (opcode == BC_ACTION) {
+      lower->depth -= numArgs;
+    } /* if */
+    lower->depth++;
+    if (lower->depth > lower->maxDepth) {
+      lower->maxDepth = lower->depth;
+    } /* if */
+  } /* emit */
+
+
+
+static unsigned int numberOfArgs (const_listType argList)
+
+  {
+    unsigned int numArgs = 0;
+
+  /* numberOfArgs */
+    while (argList != NULL && numArgs <= MAX_LOWERED_ARGS) {
+      numArgs++;
+      argList = argList->next;
+    } /* while */
+    return numArgs;
+  } /* numberOfArgs */
+
+
+
+static void lowerCall (lowerType lower, objectType callObject);
+
+
+
+/**
+ *  Lower an actual parameter the same way as exec_object() evaluates it.
+ */
+static void lowerArg (lowerType lower, objectType arg)
+
+  { /* lowerArg */
+    switch (CATEGORY_OF_OBJ(arg)) {
+      case CALLOBJECT:
+        lowerCall(lower, arg);
+        break;
+      case VALUEPARAMOBJECT:
+      case REFPARAMOBJECT:
+      case RESULTOBJECT:
+      case LOCALVOBJECT:
+        emit(lower, BC_VAR, arg, NULL, 0);
+        break;
+      default:
+        emit(lower, BC_CONST, arg, NULL, 0);
+        break;
+    } /* switch */
+  } /* lowerArg */
+
+
+
+/**
+ *  Lower a call the same way as exec_call() executes it.
+ */
+static void lowerCall (lowerType lower, objectType callObject)
+
+  {
+    objectType subroutine;
+    listType argList;
+    unsigned int numArgs;
+
+  /* lowerCall */
+    subroutine = callObject->value.listValue->obj;
+    argList = callObject->value.listValue->next;
+    numArgs = numberOfArgs(argList);
+    if (CATEGORY_OF_OBJ(subroutine) == ACTOBJECT &&
+        numArgs <= MAX_LOWERED_ARGS) {
+      while (argList != NULL && lower->okay) {
+        lowerArg(lower, argList->obj);
+        argList = argList->next;
+      } /* while */
+      emit(lower, BC_ACTION, callObject, subroutine, numArgs);
+    } else {
+      emit(lower, BC_CALL, callObject, NULL, 0);
+    } /* if */
+  } /* lowerCall */
+
+
+
+/**
+ *  Lower the call 'root' into a new code record.
+ *  @return the lowered code, or NULL if lowering is not
+ *          possible or would not save anything.
+ */
+static codeType lowerRoot (objectType root)
+
+  {
+    lowerType lower;
+    codeType code = NULL;
+
+  /* lowerRoot */
+    logFunction(printf("lowerRoot(" FMT_U_MEM ")\n", (memSizeType) root););
+    if ((CATEGORY_OF_OBJ(root) == CALLOBJECT ||
+         CATEGORY_OF_OBJ(root) == MATCHOBJECT) &&
+        root->value.listValue != NULL &&
+        CATEGORY_OF_OBJ(root->value.listValue->obj) == ACTOBJECT) {
+      lower = &lowerBuffer;
+      lower->length = 0;
+      lower->depth = 0;
+      lower->maxDepth = 0;
+      lower->okay = TRUE;
+      lowerCall(lower, root);
+      if (lower->okay && lower->instr[lower->length - 1].opcode == BC_ACTION &&
+          ALLOC_CODE(code, lower->length)) {
+        code->root = root;
+        code->next = NULL;
+        code->inMatchTable = FALSE;
+        code->maxDepth = lower->maxDepth;
+        code->length = lower->length;
+        memcpy(code->instr, lower->instr, lower->length * sizeof(instrRecord));
+      } /* if */
+    } /* if */
+    logFunction(printf("lowerRoot(" FMT_U_MEM ") --> " FMT_U_MEM "\n",
+                       (memSizeType) root, (memSizeType) code););
+    return code;
+  } /* lowerRoot */
+
+
+
+/**
+ *  Lower the call-by-name parameters found in 'object'.
+ *  The expression is traversed like free_expression() does it.
+ *  This way only MATCHOBJECTs owned by the block are entered
+ *  into matchTable and they are removed before they are freed.
+ */
+static void lowerMatchObjects (objectType object, codeType *owned)
+
+  {
+    listType listElem;
+    codeType code;
+
+  /* lowerMatchObjects */
+    switch (CATEGORY_OF_OBJ(object)) {
+      case MATCHOBJECT:
+        if (findMatchCode(object) == NULL) {
+          code = lowerRoot(object);
+          if (code != NULL) {
+            if (enterMatchCode(code)) {
+              code->inMatchTable = TRUE;
+              code->next = *owned;
+              *owned = code;
+            } else {
+              FREE_CODE(code, code->length);
+            } /* if */
+          } /* if */
+        } /* if */
+        /* fall through */
+      case CALLOBJECT:
+        listElem = object->value.listValue;
+        while (listElem != NULL) {
+          if (listElem->obj != NULL) {
+            lowerMatchObjects(listElem->obj, owned);
+          } /* if */
+          listElem = listElem->next;
+        } /* while */
+        break;
+      default:
+        break;
+    } /* switch */
+  } /* lowerMatchObjects */
+
+
+
+static void lowerBlock (blockType block)
+
+  {
+    codeType code;
+    codeType owned = &notLowered;
+
+  /* lowerBlock */
+    logFunction(printf("lowerBlock(" FMT_U_MEM ")\n", (memSizeType) block););
+    if (block->body != NULL) {
+      lowerMatchObjects(block->body, &owned);
+      if (CATEGORY_OF_OBJ(block->body) == CALLOBJECT) {
+        code = lowerRoot(block->body);
+        if (code != NULL) {
+          code->next = owned;
+          owned = code;
+        } /* if */
+      } /* if */
+    } /* if */
+    block->code = owned;
+    logFunction(printf("lowerBlock(" FMT_U_MEM ") -->\n", (memSizeType) block););
+  } /* lowerBlock */
+
+
+
+static void dumpStack (objectType *stack, memSizeType size)
+
+  {
+    memSizeType pos;
+
+  /* dumpStack */
+    for (pos = 0; pos < size; pos++) {
+      if (stack[pos] != NULL && TEMP_OBJECT(stack[pos])) {
+        dump_any_temp(stack[pos]);
+      } /* if */
+    } /* for */
+  } /* dumpStack */
+
+
+
+/**
+ *  Execute lowered code.
+ *  The evaluation order and the handling of temporary values and
+ *  exceptions are the same as with exec_call(), exec_object() and
+ *  exec_action().
+ */
+static objectType runCode (const_codeType code)
+
+  {
+    objectType localStack[LOCAL_STACK_SIZE];
+    objectType *stack;
+    memSizeType sp = 0;
+    const_instrType instr;
+    const_instrType beyond;
+    listType evaluated_act_params;
+    listType *insert_place;
+    uint32Type temp_bits;
+    unsigned int param_num;
+    objectType value;
+    objectType result = NULL;
+
+  /* runCode */
+    logFunction(printf("runCode(" FMT_U_MEM ")\n", (memSizeType) code););
+    if (code->maxDepth <= LOCAL_STACK_SIZE) {
+      stack = localStack;
+    } else if (unlikely(!ALLOC_TABLE(stack, objectType, code->maxDepth))) {
+      return exec_call(code->root);
+    } /* if */
+    beyond = &code->instr[code->length];
+#if CHECK_STACK
+    if (checkStack(FALSE)) {
+      result = raise_with_arguments(SYS_MEM_EXCEPTION,
+                                    code->root->value.listValue->next);
+      beyond = code->instr;
+    } /* if */
+#endif
+    for (instr = code->instr; instr < beyond; instr++) {
+      switch (instr->opcode) {
+        case BC_CONST:
+          stack[sp++] = instr->object;
+          break;
+        case BC_VAR:
+          value = instr->object->value.objValue;
+          stack[sp++] = value != NULL ? value : instr->object;
+          break;
+        case BC_CALL:
+          result = exec_call(instr->object);
+          stack[sp++] = result;
+          if (unlikely(fail_flag)) {
+            dumpStack(stack, sp);
+            result = fail_value;
+            instr = beyond - 1;
+          } /* if */
+          break;
+        case BC_ACTION:
+          sp -= instr->numArgs;
+          evaluated_act_params = NULL;
+          insert_place = &evaluated_act_params;
+          temp_bits = 0;
+          for (param_num = 0; param_num < instr->numArgs; param_num++) {
+            value = stack[sp + param_num];
+            append_to_list(insert_place, value,
+                           instr->object->value.listValue->next);
+            if (value != NULL && TEMP_OBJECT(value)) {
+              temp_bits |= (uint32Type) 1 << param_num;
+            } /* if */
+          } /* for */
+          result = exec_evaluated_action(instr->actObject,
+              evaluated_act_params, temp_bits, instr->object);
+          stack[sp++] = result;
+          if (unlikely(fail_flag) && instr != beyond - 1) {
+            /* The pending parameters are dumped like dump_arg_list() does. */
+            dumpStack(stack, sp);
+            result = fail_value;
+            instr = beyond - 1;
+          } /* if */
+          break;
+      } /* switch */
+    } /* for */
+    if (stack != localStack) {
+      FREE_TABLE(stack, objectType, code->maxDepth);
+    } /* if */
+    logFunction(printf("runCode(" FMT_U_MEM ") -->\n", (memSizeType) code););
+    return result;
+  } /* runCode */
+
+
+
+/**
+ *  Execute the body of 'block'.
+ *  The body is lowered when it is executed the first time.
+ *  @return the result of the body, like exec_call(block->body).
+ */
+objectType exec_bytecode_body (const_blockType block)
+
+  {
+    const_codeType code;
+
+  /* exec_bytecode_body */
+    if (block->code == NULL) {
+      /* Cast to mutable structure */
+      lowerBlock((blockType) block);
+    } /* if */
+    code = block->code;
+    if (code->root == block->body && !code->inMatchTable) {
+      return runCode(code);
+    } else {
+      return exec_call(block->body);
+    } /* if */
+  } /* exec_bytecode_body */
+
+
+
+/**
+ *  Evaluate the call-by-name parameter 'object' (a MATCHOBJECT).
+ *  @return the result of the evaluation, like exec_call(object).
+ */
+objectType exec_bytecode_match (objectType object)
+
+  {
+    const_codeType code;
+
+  /* exec_bytecode_match */
+    code = findMatchCode(object);
+    if (code != NULL) {
+      return runCode(code);
+    } else {
+      return exec_call(object);
+    } /* if */
+  } /* exec_bytecode_match */
+
+
+
+/**
+ *  Free the lowered code of 'block'.
+ *  This must be done before the body of the block is freed.
+ */
+void free_bytecode (blockType block)
+
+  {
+    codeType code;
+    codeType next;
+
+  /* free_bytecode */
+    code = block->code;
+    if (code != NULL) {
+      while (code != &notLowered) {
+        next = code->next;
+        if (code->inMatchTable) {
+          removeMatchCode(code);
+        } /* if */
+        FREE_CODE(code, code->length);
+        code = next;
+      } /* while */
+      block->code = NULL;
+    } /* if */
+  } /* free_bytecode */
@@ -0,0 +1,38 @@
+/********************************************************************/
+/*                                                                  */
+/*  s7   Seed7 interpreter                                          */
+/*  Copyright (C) 2026  Thomas Mertes                               */
+/*                                                                  */
+/*  This program is free software; you can redistribute it and/or   */
+/*  modify it under the terms of the GNU General Public License as  */
+/*  published by the Free Software Foundation; either version 2 of  */
+/*  the License, or (at your option) any later version.             */
+/*                                                                  */
+/*  This program is distributed in the hope that it will be useful, */
+/*  but WITHOUT ANY WARRANTY; without even the implied warranty of  */
+/*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the   */
+/*  GNU General Public License for more details.                    */
+/*                                                                  */
+/*  You should have received a copy of the GNU General Public       */
+/*  License along with this program; if not, write to the           */
+/*  Free Software Foundation, Inc., 51 Franklin Street,             */
+/*  Fifth Floor, Boston, MA  02110-1301, USA.                       */
+/*                                                                  */
+/*                                                                  */
+/*  Module: Interpreter                                             */
+/*  File: seed7/src/bytecode.h                                      */
+/*  Changes: 2026  Thomas Mertes                                    */
+/*  Content: Execute lowered function bodies.                       */
+/*                                                                  */
+/********************************************************************/
+
+#ifdef DO_INIT
+boolType use_bytecode = FALSE;
+#else
+EXTERN boolType use_bytecode;
+#endif
+
+
+objectType exec_bytecode_body (const_blockType block);
+objectType exec_bytecode_match (objectType object);
+void free_bytecode (blockType block);
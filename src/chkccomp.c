@@ -1,7 +1,7 @@
 /********************************************************************/
 /*                                                                  */
 /*  chkccomp.c    Check properties of C compiler and runtime.       */
-/*  Copyright (C) 2010 - 2024  Thomas Mertes                        */
+/*  Copyright (C) 2010 - 2024, 2026  Thomas Mertes                  */
 /*                                                                  */
 /*  This program is free software; you can redistribute it and/or   */
 /*  modify it under the terms of the GNU General Public License as  */
@@ -20,7 +20,7 @@
 /*                                                                  */
 /*  Module: Chkccomp                                                */
 /*  File: seed7/src/chkccomp.c                                      */
-/*  Changes: 2010 - 2024  Thomas Mertes                             */
+/*  Changes: 2010 - 2024, 2026  Thomas Mertes                       */
 /*  Content: Program to Check properties of C compiler and runtime. */
 /*                                                                  */
 /********************************************************************/
@@ -11390,6 +11390,89 @@ static void writeReadBufferEmptyMacro (FILE *versionFile)
 
 
 
+/**
+ *  Write macros to scan and consume the read buffer of a FILE.
+ *  The macro read_buffer_available(fp) returns the number of bytes
+ *  in the read buffer, read_buffer_ptr(fp) points to the next byte
+ *  and read_buffer_skip(fp, n) consumes n bytes. The macros allow
+ *  that line and word readers search delimiters with memchr() instead
+ *  of calling getc() for every character. If the FILE structure is
+ *  unknown no macros are written and the readers use getc().
+ */
+static void writeReadBufferAccessMacros (FILE *versionFile)
+
+  {
+    const char *define_read_buffer_access;
+    char buffer[3 * BUFFER_SIZE];
+
+  /* writeReadBufferAccessMacros */
+    if (compileAndLinkOk("#include<stdio.h>\nint main(int argc,char *argv[])\n"
+                         "{FILE*fp;fp->_IO_read_ptr+=fp->_IO_read_end-fp->_IO_read_ptr;\n"
+                         "return fp->_IO_write_ptr>fp->_IO_write_base;}\n")) {
+      define_read_buffer_access =
+          "#define read_buffer_available(fp) ((fp)->_IO_write_ptr > (fp)->_IO_write_base ? 0 : \\\n"
+          "    (size_t) ((fp)->_IO_read_end - (fp)->_IO_read_ptr))\n"
+          "#define read_buffer_ptr(fp) ((const unsigned char *) (fp)->_IO_read_ptr)\n"
+          "#define read_buffer_skip(fp, n) ((fp)->_IO_read_ptr += (n))";
+    } else if (compileAndLinkOk("#include<stdio.h>\nint main(int argc,char *argv[])\n"
+                                "{FILE*fp;fp->_p+=fp->_r;fp->_r=0;return 0;}\n")) {
+      define_read_buffer_access =
+          "#define read_buffer_available(fp) ((fp)->_r > 0 ? (size_t) (fp)->_r : 0)\n"
+          "#define read_buffer_ptr(fp) ((const unsigned char *) (fp)->_p)\n"
+          "#define read_buffer_skip(fp, n) ((fp)->_p += (n), (fp)->_r -= (int) (n))";
+    } else if (compileAndLinkOk("#include<stdio.h>\n"
+                                "typedef struct {unsigned flags; unsigned char *rpos, *rend;} MY_FILE;\n"
+                                "int main(int argc,char *argv[])\n"
+                                "{FILE*fp;((MY_FILE*)(fp))->rpos+=((MY_FILE*)(fp))->rend-"
+                                "((MY_FILE*)(fp))->rpos;return 0;}\n")) {
+      define_read_buffer_access =
+          "typedef struct {unsigned flags; unsigned char *rpos, *rend;} MY_READ_FILE;\n"
+          "#define read_buffer_available(fp) \\\n"
+          "    ((size_t) (((MY_READ_FILE *) (fp))->rend - ((MY_READ_FILE *) (fp))->rpos))\n"
+          "#define read_buffer_ptr(fp) ((const unsigned char *) ((MY_READ_FILE *) (fp))->rpos)\n"
+          "#define read_buffer_skip(fp, n) (((MY_READ_FILE *) (fp))->rpos += (n))";
+    } else {
+      define_read_buffer_access = NULL;
+    } /* if */
+    if (define_read_buffer_access != NULL) {
+      sprintf(buffer,
+              "#include<stdio.h>\n"
+              "#include<string.h>\n"
+              "%s\n"
+              "int main(int argc,char *argv[]){\n"
+              "FILE *aFile;\n"
+              "int okay = 0;\n"
+              "aFile = fopen(\"ctstfile.txt\", \"w\");\n"
+              "if (aFile != NULL) {\n"
+              "  fputs(\"abcdefghijklmnopqrstuvwxyz\\n\", aFile);\n"
+              "  fclose(aFile);\n"
+              "}\n"
+              "aFile = fopen(\"ctstfile.txt\", \"r\");\n"
+              "if (aFile != NULL) {\n"
+              "  if (getc(aFile) == 'a' && read_buffer_available(aFile) == 26 &&\n"
+              "      memcmp(read_buffer_ptr(aFile), \"bcd\", 3) == 0) {\n"
+              "    read_buffer_skip(aFile, 3);\n"
+              "    okay = read_buffer_available(aFile) == 23 &&\n"
+              "           getc(aFile) == 'e' && ftell(aFile) == 5;\n"
+              "  }\n"
+              "  fclose(aFile);\n"
+              "}\n"
+              "printf(\"%%d\\n\", okay);\n"
+              "return 0;}\n", define_read_buffer_access);
+      if (!compileAndLinkOk(buffer) || doTest() != 1) {
+        fprintf(logFile, "\n *** The read buffer access macros do not work.\n");
+        define_read_buffer_access = NULL;
+      } /* if */
+      doRemove("ctstfile.txt");
+    } /* if */
+    if (define_read_buffer_access != NULL) {
+      fprintf(versionFile, "%s\n", define_read_buffer_access);
+      fprintf(logFile, "\rRead buffer access macros defined.\n");
+    } /* if */
+  } /* writeReadBufferAccessMacros */
+
+
+
 #ifdef OS_STRI_USES_CODE_PAGE
 static int getCodePage (void)
 
@@ -12060,14 +12143,62 @@ int main (int argc, char **argv)
                          "{struct pollfd pollFd[1];\n"
                          "poll(pollFd, 1, 0);\n"
                          "return 0;}\n"));
+    fprintf(versionFile, "#define HAS_EPOLL %d\n",
+        compileAndLinkOk("#include<sys/epoll.h>\n"
+                         "int main(int argc,char *argv[])\n"
+                         "{struct epoll_event events[1];\n"
+                         "int epollFd = epoll_create1(EPOLL_CLOEXEC);\n"
+                         "epoll_wait(epollFd, events, 1, 0);\n"
+                         "return 0;}\n"));
     fprintf(versionFile, "#define HAS_MMAP %d\n",
         compileAndLinkOk("#include<stddef.h>\n#include<sys/mman.h>\n"
                          "int main(int argc,char *argv[])\n"
                          "{mmap(NULL, 12345, PROT_READ, MAP_PRIVATE, 3, 0);\n"
                          "return 0;}\n"));
+    fprintf(versionFile, "#define HAS_COPY_FILE_RANGE %d\n",
+        compileAndLinkOk("#define _GNU_SOURCE\n"
+                         "#include<stddef.h>\n#include<unistd.h>\n"
+                         "int main(int argc,char *argv[])\n"
+                         "{ssize_t bytesCopied;\n"
+                         "bytesCopied = copy_file_range(3, NULL, 4, NULL, 12345, 0);\n"
+                         "return bytesCopied == 0;}\n"));
+    fprintf(versionFile, "#define HAS_SENDFILE %d\n",
+        compileAndLinkOk("#include<stddef.h>\n#include<sys/sendfile.h>\n"
+                         "int main(int argc,char *argv[])\n"
+                         "{ssize_t bytesCopied;\n"
+                         "bytesCopied = sendfile(4, 3, NULL, 12345);\n"
+                         "return bytesCopied == 0;}\n"));
+    fprintf(versionFile, "#define HAS_FICLONE %d\n",
+        compileAndLinkOk("#include<sys/ioctl.h>\n#include<linux/fs.h>\n"
+                         "int main(int argc,char *argv[])\n"
+                         "{return ioctl(4, FICLONE, 3) == 0;}\n"));
+    fprintf(versionFile, "#define HAS_PTHREADS %d\n",
+        compileAndLinkWithOptionsOk("#include<stddef.h>\n#include<pthread.h>\n"
+                                    "static void *run (void *arg) { return arg; }\n"
+                                    "int main(int argc,char *argv[])\n"
+                                    "{pthread_t thread;\n"
+                                    "pthread_mutex_t mutex;\n"
+                                    "pthread_cond_t cond;\n"
+                                    "pthread_mutex_init(&mutex, NULL);\n"
+                                    "pthread_cond_init(&cond, NULL);\n"
+                                    "if (pthread_create(&thread, NULL, run, NULL) == 0)\n"
+                                    "  pthread_join(thread, NULL);\n"
+                                    "return 0;}\n", "", SYSTEM_LIBS));
+    fprintf(versionFile, "#define HAS_SSE2_INTRINSICS %d\n",
+        compileAndLinkOk("#include<stdio.h>\n#include<emmintrin.h>\n"
+                         "int main(int argc,char *argv[])\n"
+                         "{unsigned char in[16] = \"abcdefghijklmno\";\n"
+                         "unsigned char out[16];\n"
+                         "__m128i v = _mm_loadu_si128((const __m128i *) in);\n"
+                         "__m128i w = _mm_unpacklo_epi8(v, _mm_setzero_si128());\n"
+                         "_mm_storeu_si128((__m128i *) out, _mm_packus_epi16(w, w));\n"
+                         "printf(\"%d\\n\", _mm_movemask_epi8(v) == 0 &&\n"
+                         "       out[7] == 'h' && out[15] == 'h');\n"
+                         "return 0;}\n") && doTest() == 1);
     fprintf(logFile, " determined\n");
     determineIncludesAndLibs(versionFile);
     writeReadBufferEmptyMacro(versionFile);
+    writeReadBufferAccessMacros(versionFile);
     cleanUpCompilation("ctest", testNumber);
     removeDoSleep();
     fprintf(versionFile, "#define REMOVE_REATTEMPTS %lu\n", removeReattempts);
@@ -2,7 +2,7 @@
 /********************************************************************/
 /*                                                                  */
 /*  cmd_rtl.c     Directory, file and other system functions.       */
-/*  Copyright (C) 1989 - 2016, 2018 - 2021  Thomas Mertes           */
+/*  Copyright (C) 1989 - 2016, 2018 - 2021, 2026  Thomas Mertes     */
 /*                                                                  */
 /*  This file is part of the Seed7 Runtime Library.                 */
 /*                                                                  */
@@ -25,7 +25,7 @@
 /*                                                                  */
 /*  Module: Seed7 Runtime Library                                   */
 /*  File: seed7/src/cmd_rtl.c                                       */
-/*  Changes: 1994, 2006, 2009, 2018 - 2021  Thomas Mertes           */
+/*  Changes: 1994, 2006, 2009, 2018 - 2021, 2026  Thomas Mertes     */
 /*  Content: Directory, file and other system functions.            */
 /*                                                                  */
 /********************************************************************/
@@ -35,6 +35,10 @@
 
 #include "version.h"
 
+#if HAS_COPY_FILE_RANGE
+#define _GNU_SOURCE
+#endif
+
 #include "stdlib.h"
 #include "stdio.h"
 #include "string.h"
@@ -71,6 +75,16 @@
 #if HAS_MMAP
 #include "sys/mman.h"
 #endif
+#if HAS_SENDFILE
+#include "sys/sendfile.h"
+#endif
+#if HAS_FICLONE
+#include "sys/ioctl.h"
+#include "linux/fs.h"
+#endif
+#if HAS_PTHREADS
+#include "pthread.h"
+#endif
 
 #include "common.h"
 #include "data_rtl.h"
@@ -243,6 +257,18 @@
 #define PRESERVE_SYMLINKS   0x08
 #define PRESERVE_ALL        0xFF
 
+/* Data is copied in chunks of 1 GiB by copy_file_range() and sendfile(). */
+#define MAX_KERNEL_COPY_CHUNK 0x40000000
+
+/* Every queued copy job holds two open files. */
+#define MAX_COPY_WORKERS 4
+#define MAX_COPY_JOBS    (2 * MAX_COPY_WORKERS)
+
+#define COPY_JOB_FREE    0
+#define COPY_JOB_QUEUED  1
+#define COPY_JOB_RUNNING 2
+#define COPY_JOB_DONE    3
+
 #define USR_BITS_NORMAL (S_IRUSR == 0400 && S_IWUSR == 0200 && S_IXUSR == 0100)
 #define GRP_BITS_NORMAL (S_IRGRP == 0040 && S_IWGRP == 0020 && S_IXGRP == 0010)
 #define OTH_BITS_NORMAL (S_IROTH == 0004 && S_IWOTH == 0002 && S_IXOTH == 0001)
@@ -257,6 +283,36 @@
 #define CONFIG_VALUE_BUFFER_SIZE INT_DECIMAL_SIZE + NULL_TERMINATION_LEN
 #endif
 
+typedef struct copyPoolStruct *copyPoolType;
+
+#if HAS_PTHREADS
+typedef struct {
+    int state;
+    FILE *from_file;
+    FILE *to_file;
+    os_striType from_name;
+    os_striType to_name;
+    os_stat_struct from_stat;
+    int flags;
+    errInfoType err_info;
+  } copyJobRecord, *copyJobType;
+
+typedef struct copyPoolStruct {
+    pthread_mutex_t mutex;
+    pthread_cond_t job_queued;
+    pthread_cond_t job_done;
+    boolType terminate;
+    unsigned int numWorkers;
+    pthread_t worker[MAX_COPY_WORKERS];
+    copyJobRecord job[MAX_COPY_JOBS];
+  } copyPoolRecord;
+
+#define ALLOC_COPY_POOL(var) (ALLOC_HEAP(var, copyPoolType, sizeof(copyPoolRecord))? \
+                              CNT(CNT1_BYT(sizeof(copyPoolRecord))) TRUE:FALSE)
+#define FREE_COPY_POOL(var)  (CNT(CNT2_BYT(sizeof(copyPoolRecord))) \
+                              FREE_HEAP(var, sizeof(copyPoolRecord)))
+#endif
+
 #if DECLARE_OS_ENVIRON
 extern os_striType *os_environ;
 #endif
@@ -358,7 +414,7 @@ static void printParameters (const const_rtlArrayType parameters)
 
 static void remove_any_file (const const_os_striType file_name, errInfoType *);
 static void copy_any_file (const const_os_striType from_name,
-    const const_os_striType to_name, int, errInfoType *err_info);
+    const const_os_striType to_name, int, copyPoolType, errInfoType *err_info);
 
 
 
@@ -472,117 +528,525 @@ static void remove_any_file (const const_os_striType file_name, errInfoType *err
 
 
 
-static void copy_file (const const_os_striType from_name,
-    const const_os_striType to_name, errInfoType *err_info)
+#if HAS_FICLONE || HAS_COPY_FILE_RANGE || HAS_SENDFILE
+/**
+ *  Let the kernel copy the content of from_fd to to_fd.
+ *  A reflink (FICLONE) is tried first, which shares the data blocks
+ *  on file systems with copy-on-write support. Otherwise the data is
+ *  copied with copy_file_range() or sendfile() without passing it
+ *  through user space. Both file offsets must be at the beginning.
+ *  @return TRUE if the content has been copied (or if an error occurred
+ *          after some data has been copied), FALSE if nothing has been
+ *          copied and a copy in user space is necessary.
+ */
+static boolType kernel_copy (int from_fd, int to_fd, unsigned_os_off_t file_size,
+    const const_os_striType from_name, const const_os_striType to_name,
+    errInfoType *err_info)
 
   {
-    FILE *from_file;
-    FILE *to_file;
-#if HAS_MMAP
+    unsigned_os_off_t bytes_copied = 0;
+    size_t chunk_size;
+    ssize_t result = -1;
+
+  /* kernel_copy */
+    logFunction(printf("kernel_copy(%d, %d, " FMT_U64 ")\n",
+                       from_fd, to_fd, (uint64Type) file_size););
+#if HAS_FICLONE
+    if (ioctl(to_fd, FICLONE, from_fd) == 0) {
+      bytes_copied = file_size;
+      result = 0;
+    } /* if */
+#endif
+#if HAS_COPY_FILE_RANGE
+    if (result == -1) {
+      do {
+        if (file_size - bytes_copied > MAX_KERNEL_COPY_CHUNK) {
+          chunk_size = MAX_KERNEL_COPY_CHUNK;
+        } else {
+          chunk_size = (size_t) (file_size - bytes_copied);
+        } /* if */
+        result = copy_file_range(from_fd, NULL, to_fd, NULL, chunk_size, 0);
+        if (result > 0) {
+          bytes_copied += (unsigned_os_off_t) result;
+        } /* if */
+        /* A result of 0 means that the file has been truncated. */
+      } while (result > 0 && bytes_copied < file_size);
+    } /* if */
+#endif
+#if HAS_SENDFILE
+    if (result == -1 && bytes_copied == 0) {
+      do {
+        if (file_size - bytes_copied > MAX_KERNEL_COPY_CHUNK) {
+          chunk_size = MAX_KERNEL_COPY_CHUNK;
+        } else {
+          chunk_size = (size_t) (file_size - bytes_copied);
+        } /* if */
+        result = sendfile(to_fd, from_fd, NULL, chunk_size);
+        if (result > 0) {
+          bytes_copied += (unsigned_os_off_t) result;
+        } /* if */
+      } while (result > 0 && bytes_copied < file_size);
+    } /* if */
+#endif
+    if (unlikely(result == -1 && bytes_copied != 0)) {
+      logError(printf("kernel_copy(\"" FMT_S_OS "\", \"" FMT_S_OS "\"): "
+                      "Copy failed after " FMT_U64 " bytes:\n"
+                      "errno=%d\nerror: %s\n",
+                      from_name, to_name, (uint64Type) bytes_copied,
+                      errno, strerror(errno)););
+      *err_info = FILE_ERROR;
+    } /* if */
+    logFunction(printf("kernel_copy(%d, %d, *) --> %d (bytes_copied=" FMT_U64 ")\n",
+                       from_fd, to_fd, result != -1 || bytes_copied != 0,
+                       (uint64Type) bytes_copied););
+    return result != -1 || bytes_copied != 0;
+  } /* kernel_copy */
+#endif
+
+
+
+/**
+ *  Copy the content of from_file to to_file.
+ *  The data is copied by the kernel if possible. Otherwise the
+ *  source file is mapped into memory or it is read with the given
+ *  buffer. The function does not allocate memory from the heap,
+ *  such that it can be used by the threads of a copy pool.
+ */
+static void copy_file_content (FILE *from_file, FILE *to_file,
+    const const_os_striType from_name, const const_os_striType to_name,
+    char *buffer, size_t buffer_size, errInfoType *err_info)
+
+  {
+#if HAS_MMAP || HAS_FICLONE || HAS_COPY_FILE_RANGE || HAS_SENDFILE
     int file_no;
     os_fstat_struct file_stat;
+#endif
+#if HAS_MMAP
     memSizeType file_length;
     ustriType file_content;
-    boolType classic_copy = TRUE;
 #endif
-    char *normal_buffer;
-    char *buffer;
-    size_t buffer_size;
-    char reserve_buffer[SIZE_RESERVE_BUFFER];
+    boolType classic_copy = TRUE;
     size_t bytes_read;
 
-  /* copy_file */
-    logFunction(printf("copy_file(\"" FMT_S_OS "\", \"" FMT_S_OS "\")\n",
-                       from_name, to_name););
-    if ((from_file = os_fopen(from_name, os_mode_rb)) != NULL) {
-      if ((to_file = os_fopen(to_name, os_mode_wb)) != NULL) {
+  /* copy_file_content */
+#if HAS_MMAP || HAS_FICLONE || HAS_COPY_FILE_RANGE || HAS_SENDFILE
+    file_no = os_fileno(from_file);
+    if (file_no != -1 && os_fstat(file_no, &file_stat) == 0 &&
+        S_ISREG(file_stat.st_mode) && file_stat.st_size > 0) {
+#if HAS_FICLONE || HAS_COPY_FILE_RANGE || HAS_SENDFILE
+      /* Files with a size of 0 (e.g. in /proc) are copied classically. */
+      if (kernel_copy(file_no, os_fileno(to_file),
+                      (unsigned_os_off_t) file_stat.st_size,
+                      from_name, to_name, err_info)) {
+        classic_copy = FALSE;
+      } /* if */
+#endif
 #if HAS_MMAP
-        file_no = os_fileno(from_file);
-        if (file_no != -1 && os_fstat(file_no, &file_stat) == 0) {
-          if (file_stat.st_size >= 0 &&
-              (unsigned_os_off_t) file_stat.st_size < MAX_MEMSIZETYPE) {
-            file_length = (memSizeType) file_stat.st_size;
-            if ((file_content = (ustriType) mmap(NULL, file_length,
-                PROT_READ, MAP_PRIVATE, file_no, 0)) != (ustriType) -1) {
-              if (fwrite(file_content, 1, file_length, to_file) != file_length) {
-                logError(printf("copy_file(\"" FMT_S_OS "\", \"" FMT_S_OS "\"): "
-                                "fwrite(*, 1, " FMT_U_MEM ", %d) failed:\n"
-                                "errno=%d\nerror: %s\n",
-                                from_name, to_name, file_length, safe_fileno(to_file),
-                                errno, strerror(errno)););
-                *err_info = FILE_ERROR;
-              } /* if */
-              munmap(file_content, file_length);
-              classic_copy = FALSE;
-            } /* if */
+      if (classic_copy &&
+          (unsigned_os_off_t) file_stat.st_size < MAX_MEMSIZETYPE) {
+        file_length = (memSizeType) file_stat.st_size;
+        if ((file_content = (ustriType) mmap(NULL, file_length,
+            PROT_READ, MAP_PRIVATE, file_no, 0)) != (ustriType) -1) {
+          if (fwrite(file_content, 1, file_length, to_file) != file_length) {
+            logError(printf("copy_file_content(\"" FMT_S_OS "\", \"" FMT_S_OS "\"): "
+                            "fwrite(*, 1, " FMT_U_MEM ", %d) failed:\n"
+                            "errno=%d\nerror: %s\n",
+                            from_name, to_name, file_length, safe_fileno(to_file),
+                            errno, strerror(errno)););
+            *err_info = FILE_ERROR;
           } /* if */
+          munmap(file_content, file_length);
+          classic_copy = FALSE;
         } /* if */
-        if (classic_copy) {
+      } /* if */
 #endif
-          if (ALLOC_BYTES(normal_buffer, SIZE_NORMAL_BUFFER)) {
-            buffer = normal_buffer;
-            buffer_size = SIZE_NORMAL_BUFFER;
-          } else {
-            buffer = reserve_buffer;
-            buffer_size = SIZE_RESERVE_BUFFER;
-          } /* if */
-          while (*err_info == OKAY_NO_ERROR && (bytes_read =
-              fread(buffer, 1, buffer_size, from_file)) != 0) {
-            if (fwrite(buffer, 1, bytes_read, to_file) != bytes_read) {
-              logError(printf("copy_file(\"" FMT_S_OS "\", \"" FMT_S_OS "\"): "
-                              "fwrite(*, 1, " FMT_U_MEM ", %d) failed:\n"
-                              "errno=%d\nerror: %s\n",
-                              from_name, to_name, (memSizeType) bytes_read,
-                              safe_fileno(to_file), errno, strerror(errno)););
-              *err_info = FILE_ERROR;
-            } /* if */
-          } /* while */
-          if (normal_buffer != NULL) {
-            FREE_BYTES(normal_buffer, SIZE_NORMAL_BUFFER);
-          } /* if */
-#if HAS_MMAP
-        } /* if */
+    } /* if */
 #endif
-        if (fclose(from_file) != 0) {
-          logError(printf("copy_file(\"" FMT_S_OS "\", \"" FMT_S_OS "\"): "
-                          "fclose(%d) failed:\n"
-                          "errno=%d\nerror: %s\n",
-                          from_name, to_name, safe_fileno(from_file),
-                          errno, strerror(errno)););
-          *err_info = FILE_ERROR;
-        } /* if */
-        if (fclose(to_file) != 0) {
-          logError(printf("copy_file(\"" FMT_S_OS "\", \"" FMT_S_OS "\"): "
-                          "fclose(%d) failed:\n"
+    if (classic_copy) {
+      while (*err_info == OKAY_NO_ERROR && (bytes_read =
+          fread(buffer, 1, buffer_size, from_file)) != 0) {
+        if (fwrite(buffer, 1, bytes_read, to_file) != bytes_read) {
+          logError(printf("copy_file_content(\"" FMT_S_OS "\", \"" FMT_S_OS "\"): "
+                          "fwrite(*, 1, " FMT_U_MEM ", %d) failed:\n"
                           "errno=%d\nerror: %s\n",
-                          from_name, to_name, safe_fileno(to_file),
-                          errno, strerror(errno)););
+                          from_name, to_name, (memSizeType) bytes_read,
+                          safe_fileno(to_file), errno, strerror(errno)););
           *err_info = FILE_ERROR;
         } /* if */
-        if (unlikely(*err_info != OKAY_NO_ERROR)) {
-          os_remove(to_name);
-        } /* if */
+      } /* while */
+    } /* if */
+  } /* copy_file_content */
+
+
+
+/**
+ *  Close the files of a copy operation.
+ *  If an error occurred the destination file is removed.
+ */
+static void close_copied_file (FILE *from_file, FILE *to_file,
+    const const_os_striType from_name, const const_os_striType to_name,
+    errInfoType *err_info)
+
+  { /* close_copied_file */
+    if (fclose(from_file) != 0) {
+      logError(printf("close_copied_file(\"" FMT_S_OS "\", \"" FMT_S_OS "\"): "
+                      "fclose(%d) failed:\n"
+                      "errno=%d\nerror: %s\n",
+                      from_name, to_name, safe_fileno(from_file),
+                      errno, strerror(errno)););
+      *err_info = FILE_ERROR;
+    } /* if */
+    if (fclose(to_file) != 0) {
+      logError(printf("close_copied_file(\"" FMT_S_OS "\", \"" FMT_S_OS "\"): "
+                      "fclose(%d) failed:\n"
+                      "errno=%d\nerror: %s\n",
+                      from_name, to_name, safe_fileno(to_file),
+                      errno, strerror(errno)););
+      *err_info = FILE_ERROR;
+    } /* if */
+    if (unlikely(*err_info != OKAY_NO_ERROR)) {
+      os_remove(to_name);
+    } /* if */
+  } /* close_copied_file */
+
+
+
+/**
+ *  Open the source and the destination file of a copy operation.
+ *  @return TRUE if both files could be opened, FALSE otherwise.
+ */
+static boolType open_files_to_copy (const const_os_striType from_name,
+    const const_os_striType to_name, FILE **from_file, FILE **to_file,
+    errInfoType *err_info)
+
+  {
+    boolType okay = FALSE;
+
+  /* open_files_to_copy */
+    if ((*from_file = os_fopen(from_name, os_mode_rb)) != NULL) {
+      if ((*to_file = os_fopen(to_name, os_mode_wb)) != NULL) {
+        okay = TRUE;
       } else {
-        logError(printf("copy_file: os_fopen(\"" FMT_S_OS "\", \"" FMT_S_OS "\") failed:\n"
+        logError(printf("open_files_to_copy: "
+                        "os_fopen(\"" FMT_S_OS "\", \"" FMT_S_OS "\") failed:\n"
                         "errno=%d\nerror: %s\n",
                         to_name, os_mode_wb, errno, strerror(errno)););
-        fclose(from_file);
+        fclose(*from_file);
         *err_info = FILE_ERROR;
       } /* if */
     } else {
-      logError(printf("copy_file: os_fopen(\"" FMT_S_OS "\", \"" FMT_S_OS "\") failed:\n"
+      logError(printf("open_files_to_copy: "
+                      "os_fopen(\"" FMT_S_OS "\", \"" FMT_S_OS "\") failed:\n"
                       "errno=%d\nerror: %s\n",
                       from_name, os_mode_rb, errno, strerror(errno)););
       *err_info = FILE_ERROR;
     } /* if */
+    return okay;
+  } /* open_files_to_copy */
+
+
+
+static void copy_file (const const_os_striType from_name,
+    const const_os_striType to_name, errInfoType *err_info)
+
+  {
+    FILE *from_file;
+    FILE *to_file;
+    char *normal_buffer;
+    char reserve_buffer[SIZE_RESERVE_BUFFER];
+
+  /* copy_file */
+    logFunction(printf("copy_file(\"" FMT_S_OS "\", \"" FMT_S_OS "\")\n",
+                       from_name, to_name););
+    if (open_files_to_copy(from_name, to_name, &from_file, &to_file, err_info)) {
+      if (ALLOC_BYTES(normal_buffer, SIZE_NORMAL_BUFFER)) {
+        copy_file_content(from_file, to_file, from_name, to_name,
+                          normal_buffer, SIZE_NORMAL_BUFFER, err_info);
+        FREE_BYTES(normal_buffer, SIZE_NORMAL_BUFFER);
+      } else {
+        copy_file_content(from_file, to_file, from_name, to_name,
+                          reserve_buffer, SIZE_RESERVE_BUFFER, err_info);
+      } /* if */
+      close_copied_file(from_file, to_file, from_name, to_name, err_info);
+    } /* if */
     logFunction(printf("copy_file(\"" FMT_S_OS "\", \"" FMT_S_OS "\", %d) -->\n",
                        from_name, to_name, *err_info););
   } /* copy_file */
 
 
 
+static void preserve_file_attributes (const const_os_striType to_name,
+    const os_stat_struct *from_stat, int flags)
+
+  {
+    os_utimbuf_struct to_utime;
+
+  /* preserve_file_attributes */
+    if (flags & PRESERVE_TIMESTAMPS) {
+      to_utime.actime = from_stat->st_atime;
+      to_utime.modtime = from_stat->st_mtime;
+      /* printf("preserve_file_attributes: st_atime=%ld\n", from_stat->st_atime); */
+      /* printf("preserve_file_attributes: st_mtime=%ld\n", from_stat->st_mtime); */
+      os_utime(to_name, &to_utime);
+    } /* if */
+    if (flags & PRESERVE_MODE) {
+      os_chmod(to_name, from_stat->st_mode);
+    } /* if */
+    if (flags & PRESERVE_OWNERSHIP) {
+      os_chown(to_name, from_stat->st_uid, from_stat->st_gid);
+    } /* if */
+  } /* preserve_file_attributes */
+
+
+
+#if HAS_PTHREADS
+/**
+ *  Worker thread of a copy pool.
+ *  The worker takes queued jobs and copies the file content. Afterwards
+ *  the files are closed and the attributes of the destination file are
+ *  preserved. Memory is neither allocated nor freed by the worker.
+ */
+static void *copy_worker (void *arg)
+
+  {
+    copyPoolType pool;
+    copyJobType job;
+    unsigned int index;
+    char buffer[SIZE_NORMAL_BUFFER];
+
+  /* copy_worker */
+    pool = (copyPoolType) arg;
+    pthread_mutex_lock(&pool->mutex);
+    while (!pool->terminate) {
+      job = NULL;
+      for (index = 0; job == NULL && index < MAX_COPY_JOBS; index++) {
+        if (pool->job[index].state == COPY_JOB_QUEUED) {
+          job = &pool->job[index];
+        } /* if */
+      } /* for */
+      if (job == NULL) {
+        pthread_cond_wait(&pool->job_queued, &pool->mutex);
+      } else {
+        job->state = COPY_JOB_RUNNING;
+        pthread_mutex_unlock(&pool->mutex);
+        copy_file_content(job->from_file, job->to_file, job->from_name,
+                          job->to_name, buffer, SIZE_NORMAL_BUFFER, &job->err_info);
+        close_copied_file(job->from_file, job->to_file, job->from_name,
+                          job->to_name, &job->err_info);
+        if (job->err_info == OKAY_NO_ERROR) {
+          preserve_file_attributes(job->to_name, &job->from_stat, job->flags);
+        } /* if */
+        pthread_mutex_lock(&pool->mutex);
+        job->state = COPY_JOB_DONE;
+        pthread_cond_signal(&pool->job_done);
+      } /* if */
+    } /* while */
+    pthread_mutex_unlock(&pool->mutex);
+    return NULL;
+  } /* copy_worker */
+
+
+
+/**
+ *  Free the names of a finished job and make its slot available.
+ *  The first error of a job is stored in err_info.
+ *  The mutex of the pool must be locked by the caller.
+ */
+static void release_copy_job (copyJobType job, errInfoType *err_info)
+
+  { /* release_copy_job */
+    if (job->err_info != OKAY_NO_ERROR && *err_info == OKAY_NO_ERROR) {
+      *err_info = job->err_info;
+    } /* if */
+    FREE_OS_STRI(job->from_name);
+    FREE_OS_STRI(job->to_name);
+    job->state = COPY_JOB_FREE;
+  } /* release_copy_job */
+
+
+
+/**
+ *  Create a pool of threads to copy the files of a directory tree.
+ *  @return the new pool, or NULL if no thread could be started.
+ */
+static copyPoolType create_copy_pool (void)
+
+  {
+    unsigned int index;
+    copyPoolType pool;
+
+  /* create_copy_pool */
+    if (ALLOC_COPY_POOL(pool)) {
+      memset(pool, 0, sizeof(copyPoolRecord));
+      if (pthread_mutex_init(&pool->mutex, NULL) != 0) {
+        FREE_COPY_POOL(pool);
+        pool = NULL;
+      } else if (pthread_cond_init(&pool->job_queued, NULL) != 0) {
+        pthread_mutex_destroy(&pool->mutex);
+        FREE_COPY_POOL(pool);
+        pool = NULL;
+      } else if (pthread_cond_init(&pool->job_done, NULL) != 0) {
+        pthread_cond_destroy(&pool->job_queued);
+        pthread_mutex_destroy(&pool->mutex);
+        FREE_COPY_POOL(pool);
+        pool = NULL;
+      } else {
+        for (index = 0; index < MAX_COPY_WORKERS; index++) {
+          if (pthread_create(&pool->worker[pool->numWorkers], NULL,
+                             copy_worker, pool) == 0) {
+            pool->numWorkers++;
+          } /* if */
+        } /* for */
+        if (pool->numWorkers == 0) {
+          pthread_cond_destroy(&pool->job_done);
+          pthread_cond_destroy(&pool->job_queued);
+          pthread_mutex_destroy(&pool->mutex);
+          FREE_COPY_POOL(pool);
+          pool = NULL;
+        } /* if */
+      } /* if */
+    } /* if */
+    logFunction(printf("create_copy_pool --> " FMT_U_MEM " (numWorkers=%u)\n",
+                       (memSizeType) pool,
+                       pool != NULL ? pool->numWorkers : 0););
+    return pool;
+  } /* create_copy_pool */
+
+
+
+/**
+ *  Wait until all jobs of the pool are finished.
+ *  If a job failed and err_info is OKAY_NO_ERROR the error of the
+ *  job is stored in err_info.
+ */
+static void drain_copy_pool (copyPoolType pool, errInfoType *err_info)
+
+  {
+    unsigned int index;
+    boolType busy;
+
+  /* drain_copy_pool */
+    pthread_mutex_lock(&pool->mutex);
+    do {
+      busy = FALSE;
+      for (index = 0; index < MAX_COPY_JOBS; index++) {
+        if (pool->job[index].state == COPY_JOB_DONE) {
+          release_copy_job(&pool->job[index], err_info);
+        } else if (pool->job[index].state != COPY_JOB_FREE) {
+          busy = TRUE;
+        } /* if */
+      } /* for */
+      if (busy) {
+        pthread_cond_wait(&pool->job_done, &pool->mutex);
+      } /* if */
+    } while (busy);
+    pthread_mutex_unlock(&pool->mutex);
+  } /* drain_copy_pool */
+
+
+
+/**
+ *  Stop the threads of a pool and free it.
+ *  All jobs of the pool must have been drained before.
+ */
+static void destroy_copy_pool (copyPoolType pool)
+
+  {
+    unsigned int index;
+
+  /* destroy_copy_pool */
+    pthread_mutex_lock(&pool->mutex);
+    pool->terminate = TRUE;
+    pthread_cond_broadcast(&pool->job_queued);
+    pthread_mutex_unlock(&pool->mutex);
+    for (index = 0; index < pool->numWorkers; index++) {
+      pthread_join(pool->worker[index], NULL);
+    } /* for */
+    pthread_cond_destroy(&pool->job_done);
+    pthread_cond_destroy(&pool->job_queued);
+    pthread_mutex_destroy(&pool->mutex);
+    FREE_COPY_POOL(pool);
+  } /* destroy_copy_pool */
+
+
+
+/**
+ *  Open the files and queue a job to copy from_name to to_name.
+ *  If all slots of the pool are in use the function waits until a
+ *  job is finished. If a finished job failed its error is stored in
+ *  err_info and no new job is queued.
+ */
+static void queue_copy_file (copyPoolType pool, const const_os_striType from_name,
+    const const_os_striType to_name, const os_stat_struct *from_stat,
+    int flags, errInfoType *err_info)
+
+  {
+    unsigned int index;
+    copyJobType job = NULL;
+    size_t from_name_size;
+    size_t to_name_size;
+
+  /* queue_copy_file */
+    logFunction(printf("queue_copy_file(\"" FMT_S_OS "\", \"" FMT_S_OS "\")\n",
+                       from_name, to_name););
+    pthread_mutex_lock(&pool->mutex);
+    do {
+      for (index = 0; index < MAX_COPY_JOBS; index++) {
+        if (pool->job[index].state == COPY_JOB_DONE) {
+          release_copy_job(&pool->job[index], err_info);
+        } /* if */
+        if (job == NULL && pool->job[index].state == COPY_JOB_FREE) {
+          job = &pool->job[index];
+        } /* if */
+      } /* for */
+      if (job == NULL) {
+        pthread_cond_wait(&pool->job_done, &pool->mutex);
+      } /* if */
+    } while (job == NULL);
+    pthread_mutex_unlock(&pool->mutex);
+    if (*err_info == OKAY_NO_ERROR) {
+      from_name_size = os_stri_strlen(from_name);
+      to_name_size = os_stri_strlen(to_name);
+      if (unlikely(!ALLOC_OS_STRI(job->from_name, from_name_size))) {
+        *err_info = MEMORY_ERROR;
+      } else if (unlikely(!ALLOC_OS_STRI(job->to_name, to_name_size))) {
+        FREE_OS_STRI(job->from_name);
+        *err_info = MEMORY_ERROR;
+      } else if (!open_files_to_copy(from_name, to_name, &job->from_file,
+                                     &job->to_file, err_info)) {
+        FREE_OS_STRI(job->from_name);
+        FREE_OS_STRI(job->to_name);
+      } else {
+        memcpy(job->from_name, from_name,
+               (from_name_size + 1) * sizeof(os_charType));
+        memcpy(job->to_name, to_name,
+               (to_name_size + 1) * sizeof(os_charType));
+        memcpy(&job->from_stat, from_stat, sizeof(os_stat_struct));
+        job->flags = flags;
+        job->err_info = OKAY_NO_ERROR;
+        pthread_mutex_lock(&pool->mutex);
+        job->state = COPY_JOB_QUEUED;
+        pthread_cond_signal(&pool->job_queued);
+        pthread_mutex_unlock(&pool->mutex);
+      } /* if */
+    } /* if */
+    logFunction(printf("queue_copy_file(\"" FMT_S_OS "\", \"" FMT_S_OS "\", %d) -->\n",
+                       from_name, to_name, *err_info););
+  } /* queue_copy_file */
+#endif
+
+
+
+/**
+ *  Copy a directory tree.
+ *  The files of the tree are copied by the threads of a copy pool
+ *  (if threads are available). The outermost copy_dir creates the
+ *  pool and the nested calls use it. Before copy_dir returns with an
+ *  error all queued jobs are finished.
+ */
 static void copy_dir (const const_os_striType from_name,
-    const const_os_striType to_name, int flags, errInfoType *err_info)
+    const const_os_striType to_name, int flags, copyPoolType pool,
+    errInfoType *err_info)
 
   {
     os_DIR *directory;
@@ -597,6 +1061,7 @@ static void copy_dir (const const_os_striType from_name,
     size_t new_size;
     os_striType resized_path;
     boolType init_path = TRUE;
+    copyPoolType own_pool = NULL;
 
   /* copy_dir */
     logFunction(printf("copy_dir(\"" FMT_S_OS "\", \"" FMT_S_OS "\")\n",
@@ -613,6 +1078,12 @@ static void copy_dir (const const_os_striType from_name,
                         to_name, errno, strerror(errno)););
         *err_info = FILE_ERROR;
       } else {
+#if HAS_PTHREADS
+        if (pool == NULL) {
+          own_pool = create_copy_pool();
+          pool = own_pool;
+        } /* if */
+#endif
         do {
           current_entry = os_readdir(directory);
         } while (current_entry != NULL && current_entry->d_name[0] == '.' &&
@@ -659,7 +1130,7 @@ static void copy_dir (const const_os_striType from_name,
             memcpy(&to_path[to_name_size + 1], current_entry->d_name,
                    d_name_size * sizeof(os_charType));
             to_path[to_name_size + 1 + d_name_size] = '\0';
-            copy_any_file(from_path, to_path, flags, err_info);
+            copy_any_file(from_path, to_path, flags, pool, err_info);
           } else {
             *err_info = MEMORY_ERROR;
           } /* if */
@@ -670,6 +1141,14 @@ static void copy_dir (const const_os_striType from_name,
                     (current_entry->d_name[1] == '.' &&
                      current_entry->d_name[2] == '\0')));
         } /* while */
+#if HAS_PTHREADS
+        if (own_pool != NULL) {
+          drain_copy_pool(own_pool, err_info);
+          destroy_copy_pool(own_pool);
+        } else if (pool != NULL && unlikely(*err_info != OKAY_NO_ERROR)) {
+          drain_copy_pool(pool, err_info);
+        } /* if */
+#endif
         if (unlikely(*err_info != OKAY_NO_ERROR)) {
           remove_dir(to_name, err_info);
         } /* if */
@@ -689,7 +1168,8 @@ static void copy_dir (const const_os_striType from_name,
 
 
 static void copy_any_file (const const_os_striType from_name,
-    const const_os_striType to_name, int flags, errInfoType *err_info)
+    const const_os_striType to_name, int flags, copyPoolType pool,
+    errInfoType *err_info)
 
   {
     os_stat_struct from_stat;
@@ -698,7 +1178,7 @@ static void copy_any_file (const const_os_striType from_name,
     os_striType link_destination;
     ssize_t readlink_result;
 #endif
-    os_utimbuf_struct to_utime;
+    boolType attributes_preserved = FALSE;
 
   /* copy_any_file */
     logFunction(printf("copy_any_file(\"" FMT_S_OS "\", \"" FMT_S_OS "\")\n",
@@ -751,9 +1231,19 @@ static void copy_any_file (const const_os_striType from_name,
         *err_info = FILE_ERROR;
 #endif
       } else if (S_ISREG(from_stat.st_mode)) {
+#if HAS_PTHREADS
+        if (pool != NULL) {
+          /* The worker preserves the attributes after copying. */
+          queue_copy_file(pool, from_name, to_name, &from_stat, flags, err_info);
+          attributes_preserved = TRUE;
+        } else {
+          copy_file(from_name, to_name, err_info);
+        } /* if */
+#else
         copy_file(from_name, to_name, err_info);
+#endif
       } else if (S_ISDIR(from_stat.st_mode)) {
-        copy_dir(from_name, to_name, flags, err_info);
+        copy_dir(from_name, to_name, flags, pool, err_info);
       } else if (S_ISFIFO(from_stat.st_mode)) {
 #if HAS_FIFO_FILES
         if (mkfifo(to_name, (S_IRWXU | S_IRWXG | S_IRWXO)) != 0) {
@@ -765,20 +1255,9 @@ static void copy_any_file (const const_os_striType from_name,
       } else {
         *err_info = FILE_ERROR;
       } /* if */
-      if (*err_info == OKAY_NO_ERROR && !S_ISLNK(from_stat.st_mode)) {
-        if (flags & PRESERVE_TIMESTAMPS) {
-          to_utime.actime = from_stat.st_atime;
-          to_utime.modtime = from_stat.st_mtime;
-          /* printf("copy_any_file: st_atime=%ld\n", from_stat.st_atime); */
-          /* printf("copy_any_file: st_mtime=%ld\n", from_stat.st_mtime); */
-          os_utime(to_name, &to_utime);
-        } /* if */
-        if (flags & PRESERVE_MODE) {
-          os_chmod(to_name, from_stat.st_mode);
-        } /* if */
-        if (flags & PRESERVE_OWNERSHIP) {
-          os_chown(to_name, from_stat.st_uid, from_stat.st_gid);
-        } /* if */
+      if (*err_info == OKAY_NO_ERROR && !S_ISLNK(from_stat.st_mode) &&
+          !attributes_preserved) {
+        preserve_file_attributes(to_name, &from_stat, flags);
       } /* if */
     } /* if */
     logFunction(printf("copy_any_file(\"" FMT_S_OS "\", \"" FMT_S_OS "\", %d) -->\n",
@@ -807,7 +1286,7 @@ static void move_with_copy (const const_os_striType from_name,
                         from_name, temp_name, errno, strerror(errno)););
         *err_info = FILE_ERROR;
       } else {
-        copy_any_file(temp_name, to_name, PRESERVE_ALL, err_info);
+        copy_any_file(temp_name, to_name, PRESERVE_ALL, NULL, err_info);
         if (*err_info == OKAY_NO_ERROR) {
           remove_any_file(temp_name, err_info);
         } else {
@@ -2716,7 +3195,7 @@ void cmdCloneFile (const const_striType sourcePath, const const_striType destPat
                           os_destPath););
           err_info = FILE_ERROR;
         } else {
-          copy_any_file(os_sourcePath, os_destPath, PRESERVE_ALL, &err_info);
+          copy_any_file(os_sourcePath, os_destPath, PRESERVE_ALL, NULL, &err_info);
         } /* if */
         os_stri_free(os_destPath);
       } /* if */
@@ -3109,7 +3588,7 @@ void cmdCopyFile (const const_striType sourcePath, const const_striType destPath
                           os_destPath););
           err_info = FILE_ERROR;
         } else {
-          copy_any_file(os_sourcePath, os_destPath, PRESERVE_NOTHING, &err_info);
+          copy_any_file(os_sourcePath, os_destPath, PRESERVE_NOTHING, NULL, &err_info);
         } /* if */
         os_stri_free(os_destPath);
       } /* if */
@@ -1,7 +1,7 @@
 /********************************************************************/
 /*                                                                  */
 /*  common.h      Basic type definitions and settings.              */
-/*  Copyright (C) 1989 - 2017  Thomas Mertes                        */
+/*  Copyright (C) 1989 - 2017, 2026  Thomas Mertes                  */
 /*                                                                  */
 /*  This file is part of the Seed7 Runtime Library.                 */
 /*                                                                  */
@@ -25,6 +25,7 @@
 /*  Module: Seed7 Runtime Library                                   */
 /*  File: seed7/src/common.h                                        */
 /*  Changes: 1992 - 1994, 2005, 2011, 2013, 2014  Thomas Mertes     */
+/*           2026  Thomas Mertes                                    */
 /*  Content: Basic type definitions and settings.                   */
 /*                                                                  */
 /********************************************************************/
@@ -748,6 +749,8 @@ typedef struct fileStruct {
 typedef struct socketStruct {
     socketNumberType socketNumber;
     uintType usage_count;
+    /* The read buffer is only accessible for the socket driver */
+    struct socketBufferStruct *readBuffer;
   } socketRecord;
 
 typedef struct pollStruct {
@@ -1,7 +1,7 @@
 /********************************************************************/
 /*                                                                  */
 /*  s7   Seed7 interpreter                                          */
-/*  Copyright (C) 1990 - 2005  Thomas Mertes                        */
+/*  Copyright (C) 1990 - 2005, 2026  Thomas Mertes                  */
 /*                                                                  */
 /*  This program is free software; you can redistribute it and/or   */
 /*  modify it under the terms of the GNU General Public License as  */
@@ -21,6 +21,7 @@
 /*  Module: Main                                                    */
 /*  File: seed7/src/data.h                                          */
 /*  Changes: 1990, 1991, 1992, 1993, 1994, 2000  Thomas Mertes      */
+/*           2026  Thomas Mertes                                    */
 /*  Content: Type definitions for general data structures.          */
 /*                                                                  */
 /********************************************************************/
@@ -328,6 +329,7 @@ typedef struct blockStruct {
     locListType local_vars;
     listType local_consts;
     objectType body;
+    struct codeStruct *code;
   } blockRecord;
 
 typedef struct arrayStruct {
@@ -352,6 +354,7 @@ typedef struct emptyArrayStruct {
 typedef struct hashElemStruct {
     hashElemType next_less;
     hashElemType next_greater;
+    unsigned int hashcode;
     objectRecord key;
     objectRecord data;
   } hashElemRecord;
@@ -361,7 +364,7 @@ typedef struct hashStruct {
     unsigned int mask;
     unsigned int table_size;
     memSizeType size;
-    hashElemType table[1];
+    hashElemType *table;
   } hashRecord;
 
 typedef struct structStruct {
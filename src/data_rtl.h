@@ -166,6 +166,7 @@ typedef struct rtlStructStruct {
 typedef struct rtlHashElemStruct {
     rtlHashElemType next_less;
     rtlHashElemType next_greater;
+    unsigned int hashcode;
     rtlObjectType key;
     rtlObjectType data;
   } rtlHashElemRecord;
@@ -175,7 +176,7 @@ typedef struct rtlHashStruct {
     unsigned int mask;
     unsigned int table_size;
     memSizeType size;
-    rtlHashElemType table[1];
+    rtlHashElemType *table;
   } rtlHashRecord;
 
 typedef struct rtlTimeStruct {
@@ -1,7 +1,7 @@
 /********************************************************************/
 /*                                                                  */
 /*  db_lite.h     SQLite interfaces used by Seed7.                  */
-/*  Copyright (C) 1989 - 2020  Thomas Mertes                        */
+/*  Copyright (C) 1989 - 2020, 2026  Thomas Mertes                  */
 /*                                                                  */
 /*  This file is part of the Seed7 Runtime Library.                 */
 /*                                                                  */
@@ -24,7 +24,7 @@
 /*                                                                  */
 /*  Module: Seed7 Runtime Library                                   */
 /*  File: seed7/src/db_lite.h                                       */
-/*  Changes: 2014, 2015, 2019, 2020  Thomas Mertes                  */
+/*  Changes: 2014, 2015, 2019, 2020, 2026  Thomas Mertes            */
 /*  Content: SQLite interfaces used by Seed7.                       */
 /*                                                                  */
 /********************************************************************/
@@ -35,6 +35,7 @@ extern "C" {
 
 typedef void *sqlite3;
 typedef void *sqlite3_stmt;
+typedef void *sqlite3_value;
 
 typedef INT64TYPE sqlite3_int64;
 
@@ -81,6 +82,7 @@ sqlite3_int64 CDECL sqlite3_column_int64 (sqlite3_stmt *pStmt, int iCol);
 const char *CDECL sqlite3_column_name (sqlite3_stmt *pStmt, int N);
 const unsigned char *CDECL sqlite3_column_text (sqlite3_stmt *pStmt, int iCol);
 int CDECL sqlite3_column_type (sqlite3_stmt *pStmt, int iCol);
+sqlite3_value *CDECL sqlite3_column_value (sqlite3_stmt *pStmt, int iCol);
 sqlite3 *CDECL sqlite3_db_handle (sqlite3_stmt *pStmt);
 int CDECL sqlite3_errcode (sqlite3 *db);
 const char *CDECL sqlite3_errmsg (sqlite3 *db);
@@ -99,6 +101,15 @@ int CDECL sqlite3_prepare (sqlite3 *db,
                            const char **pzTail);
 int CDECL sqlite3_reset (sqlite3_stmt *pStmt);
 int CDECL sqlite3_step (sqlite3_stmt *pStmt);
+const void *CDECL sqlite3_value_blob (sqlite3_value *value);
+int CDECL sqlite3_value_bytes (sqlite3_value *value);
+double CDECL sqlite3_value_double (sqlite3_value *value);
+sqlite3_value *CDECL sqlite3_value_dup (const sqlite3_value *value);
+void CDECL sqlite3_value_free (sqlite3_value *value);
+int CDECL sqlite3_value_int (sqlite3_value *value);
+sqlite3_int64 CDECL sqlite3_value_int64 (sqlite3_value *value);
+const unsigned char *CDECL sqlite3_value_text (sqlite3_value *value);
+int CDECL sqlite3_value_type (sqlite3_value *value);
 
 #if defined(__cplusplus) || defined(c_plusplus)
 }
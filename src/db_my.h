@@ -1,7 +1,7 @@
 /********************************************************************/
 /*                                                                  */
 /*  db_my.h       MariaDB and MySQL interfaces used by Seed7.       */
-/*  Copyright (C) 1989 - 2020  Thomas Mertes                        */
+/*  Copyright (C) 1989 - 2020, 2026  Thomas Mertes                  */
 /*                                                                  */
 /*  This file is part of the Seed7 Runtime Library.                 */
 /*                                                                  */
@@ -24,7 +24,7 @@
 /*                                                                  */
 /*  Module: Seed7 Runtime Library                                   */
 /*  File: seed7/src/db_my.h                                         */
-/*  Changes: 2014, 2020  Thomas Mertes                              */
+/*  Changes: 2014, 2020, 2026  Thomas Mertes                        */
 /*  Content: MariaDB and MySQL interfaces used by Seed7.            */
 /*                                                                  */
 /********************************************************************/
@@ -179,6 +179,7 @@ unsigned int STDCALL mysql_stmt_errno (MYSQL_STMT *stmt);
 const char *STDCALL mysql_stmt_error (MYSQL_STMT *stmt);
 int STDCALL mysql_stmt_execute (MYSQL_STMT *stmt);
 int STDCALL mysql_stmt_fetch (MYSQL_STMT *stmt);
+my_bool STDCALL mysql_stmt_free_result (MYSQL_STMT *stmt);
 int STDCALL mysql_stmt_fetch_column (MYSQL_STMT *stmt,
                                      MYSQL_BIND *bnd,
                                      unsigned int column,
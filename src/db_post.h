@@ -1,7 +1,7 @@
 /********************************************************************/
 /*                                                                  */
 /*  db_post.h     PostgreSQL interfaces used by Seed7.              */
-/*  Copyright (C) 1989 - 2014  Thomas Mertes                        */
+/*  Copyright (C) 1989 - 2014, 2026  Thomas Mertes                  */
 /*                                                                  */
 /*  This file is part of the Seed7 Runtime Library.                 */
 /*                                                                  */
@@ -24,7 +24,7 @@
 /*                                                                  */
 /*  Module: Seed7 Runtime Library                                   */
 /*  File: seed7/src/db_post.h                                       */
-/*  Changes: 2014  Thomas Mertes                                    */
+/*  Changes: 2014, 2026  Thomas Mertes                              */
 /*  Content: PostgreSQL interfaces used by Seed7.                   */
 /*                                                                  */
 /********************************************************************/
@@ -46,9 +46,18 @@ typedef enum {
   PGRES_BAD_RESPONSE,
   PGRES_NONFATAL_ERROR,
   PGRES_FATAL_ERROR,
-  PGRES_COPY_BOTH
+  PGRES_COPY_BOTH,
+  PGRES_SINGLE_TUPLE,
+  PGRES_PIPELINE_SYNC,
+  PGRES_PIPELINE_ABORTED,
+  PGRES_TUPLES_CHUNK
 } ExecStatusType;
 
+#ifdef POSTGRESQL_DLL
+/* PQsetChunkedRowsMode is used, if the library provides it. */
+#define LIBPQ_HAS_CHUNK_MODE 1
+#endif
+
 typedef enum {
   CONNECTION_OK,
   CONNECTION_BAD,
@@ -164,6 +173,7 @@ extern char *CDECL PQfname (const PGresult *res, int field_num);
 extern Oid CDECL PQftype (const PGresult *res, int field_num);
 extern int CDECL PQgetisnull (const PGresult *res, int tup_num, int field_num);
 extern int CDECL PQgetlength (const PGresult *res, int tup_num, int field_num);
+extern PGresult *CDECL PQgetResult (PGconn *conn);
 extern char *CDECL PQgetvalue (const PGresult *res, int tup_num, int field_num);
 extern int CDECL PQnfields (const PGresult *res);
 extern int CDECL PQnparams (const PGresult *res);
@@ -176,11 +186,20 @@ extern PGresult *CDECL PQprepare (PGconn *conn, const char *stmtName,
 extern char *CDECL PQresStatus (ExecStatusType status);
 extern char *CDECL PQresultErrorMessage (const PGresult *res);
 extern ExecStatusType CDECL PQresultStatus (const PGresult *res);
+extern int CDECL PQsendQueryPrepared (PGconn *conn,
+                                      const char *stmtName,
+                                      int nParams,
+                                      const char *const * paramValues,
+                                      const int *paramLengths,
+                                      const int *paramFormats,
+                                      int resultFormat);
+extern int CDECL PQsetChunkedRowsMode (PGconn *conn, int chunkSize);
 extern int CDECL PQsetClientEncoding (PGconn *conn, const char *encoding);
 extern PGconn *CDECL PQsetdbLogin (const char *pghost, const char *pgport,
                                    const char *pgoptions, const char *pgtty,
                                    const char *dbName,
                                    const char *login, const char *pwd);
+extern int CDECL PQsetSingleRowMode (PGconn *conn);
 extern ConnStatusType CDECL PQstatus (const PGconn *conn);
 
 #if defined(__cplusplus) || defined(c_plusplus)
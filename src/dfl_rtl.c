@@ -0,0 +1,1411 @@
+/********************************************************************/
+/*                                                                  */
+/*  dfl_rtl.c     Primitive actions for DEFLATE compression.        */
+/*  Copyright (C) 2026  Thomas Mertes                               */
+/*                                                                  */
+/*  This file is part of the Seed7 Runtime Library.                 */
+/*                                                                  */
+/*  The Seed7 Runtime Library is free software; you can             */
+/*  redistribute it and/or modify it under the terms of the GNU     */
+/*  Lesser General Public License as published by the Free Software */
+/*  Foundation; either version 2.1 of the License, or (at your      */
+/*  option) any later version.                                      */
+/*                                                                  */
+/*  The Seed7 Runtime Library is distributed in the hope that it    */
+/*  will be useful, but WITHOUT ANY WARRANTY; without even the      */
+/*  implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR */
+/*  PURPOSE.  See the GNU Lesser General Public License for more    */
+/*  details.                                                        */
+/*                                                                  */
+/*  You should have received a copy of the GNU Lesser General       */
+/*  Public License along with this program; if not, write to the    */
+/*  Free Software Foundation, Inc., 51 Franklin Street,             */
+/*  Fifth Floor, Boston, MA  02110-1301, USA.                       */
+/*                                                                  */
+/*  Module: Seed7 Runtime Library                                   */
+/*  File: seed7/src/dfl_rtl.c                                       */
+/*  Changes: 2026  Thomas Mertes                                    */
+/*  Content: Primitive actions for DEFLATE compression.             */
+/*                                                                  */
+/********************************************************************/
+
+#define LOG_FUNCTIONS 0
+#define VERBOSE_EXCEPTIONS 0
+
+#include "version.h"
+
+#include "stdlib.h"
+#include "stdio.h"
+#include "string.h"
+
+#include "common.h"
+#include "data_rtl.h"
+#include "heaputl.h"
+#include "striutl.h"
+#include "rtl_err.h"
+
+#undef EXTERN
+#define EXTERN
+#include "dfl_rtl.h"
+
+
+#define WINDOW_SIZE            32768
+#define WINDOW_MASK            (WINDOW_SIZE - 1)
+#define HASH_BITS                 15
+#define HASH_SIZE              (1 << HASH_BITS)
+#define MIN_MATCH                  3
+#define MAX_MATCH                258
+#define MAX_CHAIN                128
+#define GOOD_LENGTH                8
+#define LAZY_LENGTH               16
+#define NICE_LENGTH              128
+#define TOO_FAR                 4096
+#define BLOCK_SYMBOLS          16384
+#define STORED_BLOCK_MAX       65535
+#define END_OF_BLOCK             256
+#define NUM_LITERAL_LENGTH_CODES 288
+#define NUM_DISTANCE_CODES        32
+#define NUM_CODE_LENGTH_CODES     19
+#define MAX_CODE_LENGTH           15
+#define MAX_CODE_LENGTH_CODE_SIZE  7
+#define FAST_BITS                 10
+#define FAST_SIZE              (1 << FAST_BITS)
+#define INFLATE_MIN_CAPACITY    1024
+#define INFLATE_MAX_CAPACITY    (1 << 24)
+
+#define HASH_3_ELEMENTS(mem) \
+    ((unsigned int) (((uint32Type) ((mem)[0] | (mem)[1] << 8 | (mem)[2] << 16) * \
+    UINT32_SUFFIX(2654435761)) >> (32 - HASH_BITS)) & (HASH_SIZE - 1))
+
+
+typedef struct {
+    ucharType *buffer;
+    memSizeType size;
+    memSizeType capacity;
+    uint32Type bitBuffer;
+    unsigned int bitCount;
+  } outStreamType;
+
+typedef struct {
+    const strElemType *data;
+    memSizeType size;
+    memSizeType *head;
+    memSizeType *prev;
+    uint16Type *literalOrLength;
+    uint16Type *distance;
+    memSizeType numSymbols;
+    memSizeType blockStart;
+    memSizeType blockEnd;
+    uint32Type literalOrLengthFreq[NUM_LITERAL_LENGTH_CODES];
+    uint32Type distanceFreq[NUM_DISTANCE_CODES];
+    outStreamType out;
+  } deflateStateType;
+
+typedef struct {
+    uint32Type key;
+    uint16Type symbol;
+  } symbolFreqType;
+
+typedef struct {
+    uint16Type fast[FAST_SIZE];
+    uint16Type count[MAX_CODE_LENGTH + 1];
+    uint16Type symbol[NUM_LITERAL_LENGTH_CODES];
+  } huffmanDecoderType;
+
+typedef struct {
+    const strElemType *data;
+    memSizeType size;
+    memSizeType pos;
+    uint32Type bitBuffer;
+    unsigned int bitCount;
+    unsigned int padBits;
+    ucharType *out;
+    memSizeType outSize;
+    memSizeType outCapacity;
+    errInfoType err_info;
+  } inflateStateType;
+
+static const uint16Type lengthBase[] = {
+    3, 4, 5, 6, 7, 8, 9, 10, 11, 13, 15, 17, 19, 23, 27, 31,
+    35, 43, 51, 59, 67, 83, 99, 115, 131, 163, 195, 227, 258};
+static const uint8Type lengthExtraBits[] = {
+    0, 0, 0, 0, 0, 0, 0, 0, 1, 1, 1, 1, 2, 2, 2, 2,
+    3, 3, 3, 3, 4, 4, 4, 4, 5, 5, 5, 5, 0};
+static const uint16Type distanceBase[] = {
+    1, 2, 3, 4, 5, 7, 9, 13, 17, 25, 33, 49, 65, 97, 129, 193,
+    257, 385, 513, 769, 1025, 1537, 2049, 3073, 4097, 6145,
+    8193, 12289, 16385, 24577, 32769, 49153};
+static const uint8Type distanceExtraBits[] = {
+    0, 0, 0, 0, 1, 1, 2, 2, 3, 3, 4, 4, 5, 5, 6, 6,
+    7, 7, 8, 8, 9, 9, 10, 10, 11, 11, 12, 12, 13, 13, 14, 14};
+static const uint8Type codeLengthOrder[] = {
+    16, 17, 18, 0, 8, 7, 9, 6, 10, 5, 11, 4, 12, 3, 13, 2, 14, 1, 15};
+
+static boolType tablesInitialized = FALSE;
+static uint8Type lengthCode[MAX_MATCH - MIN_MATCH + 1];
+static uint8Type distanceCodeTable[512];
+static uint8Type fixedLiteralOrLengthSize[NUM_LITERAL_LENGTH_CODES];
+static uint16Type fixedLiteralOrLengthCode[NUM_LITERAL_LENGTH_CODES];
+static uint8Type fixedDistanceSize[NUM_DISTANCE_CODES];
+static uint16Type fixedDistanceCode[NUM_DISTANCE_CODES];
+static huffmanDecoderType fixedLiteralOrLengthDecoder;
+static huffmanDecoderType fixedDistanceDecoder;
+
+
+
+static inline unsigned int getDistanceCode (unsigned int distance)
+
+  { /* getDistanceCode */
+    distance--;
+    if (distance < 256) {
+      return distanceCodeTable[distance];
+    } else {
+      return distanceCodeTable[256 + (distance >> 7)];
+    } /* if */
+  } /* getDistanceCode */
+
+
+
+static unsigned int reverseBits (unsigned int code, unsigned int length)
+
+  {
+    unsigned int reversed = 0;
+
+  /* reverseBits */
+    while (length != 0) {
+      reversed = (reversed << 1) | (code & 1);
+      code >>= 1;
+      length--;
+    } /* while */
+    return reversed;
+  } /* reverseBits */
+
+
+
+/**
+ *  Assign canonical Huffman codes to the given code lengths.
+ *  The codes are stored bit reversed, since DEFLATE writes
+ *  Huffman codes starting with the most significant bit
+ *  into an LSB first bit stream.
+ */
+static void createCanonicalCodes (const uint8Type *codeSize,
+    unsigned int numSymbols, uint16Type *code)
+
+  {
+    unsigned int sizeCount[MAX_CODE_LENGTH + 1];
+    unsigned int nextCode[MAX_CODE_LENGTH + 1];
+    unsigned int currentCode = 0;
+    unsigned int length;
+    unsigned int symbol;
+
+  /* createCanonicalCodes */
+    memset(sizeCount, 0, sizeof(sizeCount));
+    for (symbol = 0; symbol < numSymbols; symbol++) {
+      sizeCount[codeSize[symbol]]++;
+    } /* for */
+    sizeCount[0] = 0;
+    for (length = 1; length <= MAX_CODE_LENGTH; length++) {
+      currentCode = (currentCode + sizeCount[length - 1]) << 1;
+      nextCode[length] = currentCode;
+    } /* for */
+    for (symbol = 0; symbol < numSymbols; symbol++) {
+      length = codeSize[symbol];
+      if (length != 0) {
+        code[symbol] = (uint16Type) reverseBits(nextCode[length]++, length);
+      } else {
+        code[symbol] = 0;
+      } /* if */
+    } /* for */
+  } /* createCanonicalCodes */
+
+
+
+/**
+ *  Build a decoder for the canonical Huffman code with the given code lengths.
+ *  Codes with up to FAST_BITS bits are decoded with a lookup table.
+ *  Longer codes are decoded with the count and symbol arrays.
+ *  @return TRUE if the code lengths are okay, FALSE if they are
+ *          over-subscribed.
+ */
+static boolType buildDecoder (huffmanDecoderType *decoder,
+    const uint8Type *codeSize, unsigned int numSymbols)
+
+  {
+    uint16Type offset[MAX_CODE_LENGTH + 2];
+    uint16Type code[NUM_LITERAL_LENGTH_CODES];
+    int left = 1;
+    unsigned int length;
+    unsigned int symbol;
+    unsigned int index;
+    uint16Type entry;
+
+  /* buildDecoder */
+    memset(decoder->count, 0, sizeof(decoder->count));
+    for (symbol = 0; symbol < numSymbols; symbol++) {
+      decoder->count[codeSize[symbol]]++;
+    } /* for */
+    decoder->count[0] = 0;
+    for (length = 1; length <= MAX_CODE_LENGTH; length++) {
+      left <<= 1;
+      left -= decoder->count[length];
+      if (left < 0) {
+        return FALSE;
+      } /* if */
+    } /* for */
+    offset[1] = 0;
+    for (length = 1; length <= MAX_CODE_LENGTH; length++) {
+      offset[length + 1] = (uint16Type) (offset[length] + decoder->count[length]);
+    } /* for */
+    for (symbol = 0; symbol < numSymbols; symbol++) {
+      if (codeSize[symbol] != 0) {
+        decoder->symbol[offset[codeSize[symbol]]++] = (uint16Type) symbol;
+      } /* if */
+    } /* for */
+    createCanonicalCodes(codeSize, numSymbols, code);
+    memset(decoder->fast, 0, sizeof(decoder->fast));
+    for (symbol = 0; symbol < numSymbols; symbol++) {
+      length = codeSize[symbol];
+      if (length != 0 && length <= FAST_BITS) {
+        entry = (uint16Type) (length << 9 | symbol);
+        for (index = code[symbol]; index < FAST_SIZE; index += 1U << length) {
+          decoder->fast[index] = entry;
+        } /* for */
+      } /* if */
+    } /* for */
+    return TRUE;
+  } /* buildDecoder */
+
+
+
+static void initTables (void)
+
+  {
+    unsigned int code;
+    unsigned int length;
+    unsigned int distance;
+    uint8Type codeSize[NUM_LITERAL_LENGTH_CODES];
+
+  /* initTables */
+    for (code = 0; code < 28; code++) {
+      for (length = lengthBase[code]; length < lengthBase[code + 1]; length++) {
+        lengthCode[length - MIN_MATCH] = (uint8Type) code;
+      } /* for */
+    } /* for */
+    lengthCode[MAX_MATCH - MIN_MATCH] = 28;
+    for (code = 0; code < 30; code++) {
+      for (distance = distanceBase[code] - 1;
+           distance < distanceBase[code] - 1 + (1U << distanceExtraBits[code]);
+           distance++) {
+        if (distance < 256) {
+          distanceCodeTable[distance] = (uint8Type) code;
+        } else {
+          distanceCodeTable[256 + (distance >> 7)] = (uint8Type) code;
+        } /* if */
+      } /* for */
+    } /* for */
+    for (code = 0; code < NUM_LITERAL_LENGTH_CODES; code++) {
+      if (code < 144) {
+        codeSize[code] = 8;
+      } else if (code < 256) {
+        codeSize[code] = 9;
+      } else if (code < 280) {
+        codeSize[code] = 7;
+      } else {
+        codeSize[code] = 8;
+      } /* if */
+    } /* for */
+    memcpy(fixedLiteralOrLengthSize, codeSize, sizeof(fixedLiteralOrLengthSize));
+    createCanonicalCodes(codeSize, NUM_LITERAL_LENGTH_CODES, fixedLiteralOrLengthCode);
+    buildDecoder(&fixedLiteralOrLengthDecoder, codeSize, NUM_LITERAL_LENGTH_CODES);
+    memset(codeSize, 5, NUM_DISTANCE_CODES);
+    memcpy(fixedDistanceSize, codeSize, sizeof(fixedDistanceSize));
+    createCanonicalCodes(codeSize, NUM_DISTANCE_CODES, fixedDistanceCode);
+    buildDecoder(&fixedDistanceDecoder, codeSize, NUM_DISTANCE_CODES);
+    tablesInitialized = TRUE;
+  } /* initTables */
+
+
+
+static int compareSymbolFreq (const void *elem1, const void *elem2)
+
+  {
+    const symbolFreqType *freq1 = (const symbolFreqType *) elem1;
+    const symbolFreqType *freq2 = (const symbolFreqType *) elem2;
+
+  /* compareSymbolFreq */
+    if (freq1->key != freq2->key) {
+      return freq1->key < freq2->key ? -1 : 1;
+    } else {
+      return (int) freq1->symbol - (int) freq2->symbol;
+    } /* if */
+  } /* compareSymbolFreq */
+
+
+
+/**
+ *  Compute Huffman code lengths in place (Moffat and Katajainen).
+ *  The keys of 'elem' must be sorted in ascending order. Afterwards
+ *  the key of each element contains the length of its code.
+ */
+static void minimumRedundancyLengths (symbolFreqType *elem, int numElems)
+
+  {
+    int root;
+    int leaf;
+    int next;
+    int available;
+    int used;
+    int depth;
+
+  /* minimumRedundancyLengths */
+    if (numElems == 1) {
+      elem[0].key = 1;
+    } else if (numElems > 1) {
+      elem[0].key += elem[1].key;
+      root = 0;
+      leaf = 2;
+      for (next = 1; next < numElems - 1; next++) {
+        if (leaf >= numElems || elem[root].key < elem[leaf].key) {
+          elem[next].key = elem[root].key;
+          elem[root++].key = (uint32Type) next;
+        } else {
+          elem[next].key = elem[leaf++].key;
+        } /* if */
+        if (leaf >= numElems || (root < next && elem[root].key < elem[leaf].key)) {
+          elem[next].key += elem[root].key;
+          elem[root++].key = (uint32Type) next;
+        } else {
+          elem[next].key += elem[leaf++].key;
+        } /* if */
+      } /* for */
+      elem[numElems - 2].key = 0;
+      for (next = numElems - 3; next >= 0; next--) {
+        elem[next].key = elem[elem[next].key].key + 1;
+      } /* for */
+      available = 1;
+      used = 0;
+      depth = 0;
+      root = numElems - 2;
+      next = numElems - 1;
+      while (available > 0) {
+        while (root >= 0 && (int) elem[root].key == depth) {
+          used++;
+          root--;
+        } /* while */
+        while (available > used) {
+          elem[next--].key = (uint32Type) depth;
+          available--;
+        } /* while */
+        available = 2 * used;
+        depth++;
+        used = 0;
+      } /* while */
+    } /* if */
+  } /* minimumRedundancyLengths */
+
+
+
+/**
+ *  Compute the lengths of a Huffman code for the given frequencies.
+ *  Code lengths are limited to 'maxLength'. At least two symbols
+ *  get a code, since some decoders reject a code with one symbol.
+ */
+static void computeCodeSizes (const uint32Type *frequency, unsigned int numSymbols,
+    unsigned int maxLength, uint8Type *codeSize)
+
+  {
+    symbolFreqType elem[NUM_LITERAL_LENGTH_CODES];
+    unsigned int sizeCount[MAX_CODE_LENGTH + 1];
+    unsigned int numElems = 0;
+    unsigned int symbol;
+    unsigned int length;
+    uint32Type total;
+    unsigned int count;
+
+  /* computeCodeSizes */
+    memset(codeSize, 0, numSymbols);
+    for (symbol = 0; symbol < numSymbols; symbol++) {
+      if (frequency[symbol] != 0) {
+        elem[numElems].key = frequency[symbol];
+        elem[numElems].symbol = (uint16Type) symbol;
+        numElems++;
+      } /* if */
+    } /* for */
+    for (symbol = 0; numElems < 2; symbol++) {
+      if (frequency[symbol] == 0) {
+        elem[numElems].key = 1;
+        elem[numElems].symbol = (uint16Type) symbol;
+        numElems++;
+      } /* if */
+    } /* for */
+    qsort(elem, numElems, sizeof(symbolFreqType), compareSymbolFreq);
+    minimumRedundancyLengths(elem, (int) numElems);
+    memset(sizeCount, 0, sizeof(sizeCount));
+    for (symbol = 0; symbol < numElems; symbol++) {
+      if (elem[symbol].key > maxLength) {
+        sizeCount[maxLength]++;
+      } else {
+        sizeCount[elem[symbol].key]++;
+      } /* if */
+    } /* for */
+    total = 0;
+    for (length = maxLength; length >= 1; length--) {
+      total += (uint32Type) sizeCount[length] << (maxLength - length);
+    } /* for */
+    while (total != (uint32Type) 1 << maxLength) {
+      /* The code is over-subscribed, because lengths have been cut. */
+      sizeCount[maxLength]--;
+      for (length = maxLength - 1; length >= 1; length--) {
+        if (sizeCount[length] != 0) {
+          sizeCount[length]--;
+          sizeCount[length + 1] += 2;
+          break;
+        } /* if */
+      } /* for */
+      total--;
+    } /* while */
+    symbol = numElems;
+    for (length = 1; length <= maxLength; length++) {
+      for (count = sizeCount[length]; count > 0; count--) {
+        symbol--;
+        codeSize[elem[symbol].symbol] = (uint8Type) length;
+      } /* for */
+    } /* for */
+  } /* computeCodeSizes */
+
+
+
+static boolType reserveOutput (outStreamType *out, memSizeType extraSize)
+
+  {
+    memSizeType newCapacity;
+    ucharType *resizedBuffer;
+
+  /* reserveOutput */
+    if (out->capacity - out->size < extraSize) {
+      newCapacity = out->capacity * 2;
+      if (newCapacity < out->size + extraSize) {
+        newCapacity = out->size + extraSize;
+      } /* if */
+      resizedBuffer = REALLOC_TABLE(out->buffer, ucharType,
+                                    out->capacity, newCapacity);
+      if (unlikely(resizedBuffer == NULL)) {
+        return FALSE;
+      } /* if */
+      COUNT3_TABLE(ucharType, out->capacity, newCapacity);
+      out->buffer = resizedBuffer;
+      out->capacity = newCapacity;
+    } /* if */
+    return TRUE;
+  } /* reserveOutput */
+
+
+
+static inline void putBits (outStreamType *out, unsigned int bits,
+    unsigned int bitWidth)
+
+  { /* putBits */
+    out->bitBuffer |= (uint32Type) bits << out->bitCount;
+    out->bitCount += bitWidth;
+    while (out->bitCount >= 8) {
+      out->buffer[out->size++] = (ucharType) out->bitBuffer;
+      out->bitBuffer >>= 8;
+      out->bitCount -= 8;
+    } /* while */
+  } /* putBits */
+
+
+
+static void writeStoredBlocks (deflateStateType *state, boolType bfinal)
+
+  {
+    outStreamType *out = &state->out;
+    memSizeType position;
+    memSizeType length;
+    const strElemType *data;
+
+  /* writeStoredBlocks */
+    position = state->blockStart;
+    do {
+      length = state->blockEnd - position;
+      if (length > STORED_BLOCK_MAX) {
+        length = STORED_BLOCK_MAX;
+      } /* if */
+      putBits(out, bfinal && position + length == state->blockEnd, 1);
+      putBits(out, 0, 2);
+      if (out->bitCount != 0) {
+        putBits(out, 0, 8 - out->bitCount);
+      } /* if */
+      putBits(out, (unsigned int) length, 16);
+      putBits(out, (unsigned int) ~length & 0xffff, 16);
+      data = &state->data[position];
+      position += length;
+      while (length != 0) {
+        out->buffer[out->size++] = (ucharType) *data++;
+        length--;
+      } /* while */
+    } while (position < state->blockEnd);
+  } /* writeStoredBlocks */
+
+
+
+static void writeSymbols (deflateStateType *state,
+    const uint8Type *literalOrLengthSize, const uint16Type *literalOrLengthCode,
+    const uint8Type *distanceSize, const uint16Type *distanceCode)
+
+  {
+    outStreamType *out = &state->out;
+    memSizeType index;
+    unsigned int value;
+    unsigned int distance;
+    unsigned int code;
+
+  /* writeSymbols */
+    for (index = 0; index < state->numSymbols; index++) {
+      value = state->literalOrLength[index];
+      distance = state->distance[index];
+      if (distance == 0) {
+        putBits(out, literalOrLengthCode[value], literalOrLengthSize[value]);
+      } else {
+        code = lengthCode[value - MIN_MATCH];
+        putBits(out, literalOrLengthCode[257 + code], literalOrLengthSize[257 + code]);
+        if (lengthExtraBits[code] != 0) {
+          putBits(out, value - lengthBase[code], lengthExtraBits[code]);
+        } /* if */
+        code = getDistanceCode(distance);
+        putBits(out, distanceCode[code], distanceSize[code]);
+        if (distanceExtraBits[code] != 0) {
+          putBits(out, distance - distanceBase[code], distanceExtraBits[code]);
+        } /* if */
+      } /* if */
+    } /* for */
+    putBits(out, literalOrLengthCode[END_OF_BLOCK], literalOrLengthSize[END_OF_BLOCK]);
+  } /* writeSymbols */
+
+
+
+/**
+ *  Write the symbols collected since the last block as one block.
+ *  The block type (stored, fixed Huffman codes or dynamic Huffman
+ *  codes) with the smallest size is used.
+ */
+static boolType writeBlock (deflateStateType *state, boolType bfinal)
+
+  {
+    uint8Type literalOrLengthSize[NUM_LITERAL_LENGTH_CODES];
+    uint16Type literalOrLengthCode[NUM_LITERAL_LENGTH_CODES];
+    uint8Type distanceSize[NUM_DISTANCE_CODES];
+    uint16Type distanceCode[NUM_DISTANCE_CODES];
+    uint8Type combinedSize[NUM_LITERAL_LENGTH_CODES + NUM_DISTANCE_CODES];
+    uint8Type runSymbol[NUM_LITERAL_LENGTH_CODES + NUM_DISTANCE_CODES];
+    uint8Type runExtra[NUM_LITERAL_LENGTH_CODES + NUM_DISTANCE_CODES];
+    uint32Type codeLengthFreq[NUM_CODE_LENGTH_CODES];
+    uint8Type codeLengthSize[NUM_CODE_LENGTH_CODES];
+    uint16Type codeLengthCode[NUM_CODE_LENGTH_CODES];
+    unsigned int numLiteralOrLength = 286;
+    unsigned int numDistance = 30;
+    unsigned int numCodeLengths = NUM_CODE_LENGTH_CODES;
+    unsigned int numCombined;
+    unsigned int numRuns = 0;
+    unsigned int index;
+    unsigned int runLength;
+    unsigned int symbol;
+    memSizeType blockLength;
+    memSizeType numStoredBlocks;
+    memSizeType extraBits = 0;
+    memSizeType fixedBits;
+    memSizeType dynamicBits;
+    memSizeType storedBits;
+    memSizeType maximumBytes;
+    boolType okay = TRUE;
+
+  /* writeBlock */
+    state->literalOrLengthFreq[END_OF_BLOCK] = 1;
+    computeCodeSizes(state->literalOrLengthFreq, 286, MAX_CODE_LENGTH,
+                     literalOrLengthSize);
+    computeCodeSizes(state->distanceFreq, 30, MAX_CODE_LENGTH, distanceSize);
+    while (numLiteralOrLength > 257 && literalOrLengthSize[numLiteralOrLength - 1] == 0) {
+      numLiteralOrLength--;
+    } /* while */
+    while (numDistance > 1 && distanceSize[numDistance - 1] == 0) {
+      numDistance--;
+    } /* while */
+    memcpy(combinedSize, literalOrLengthSize, numLiteralOrLength);
+    memcpy(&combinedSize[numLiteralOrLength], distanceSize, numDistance);
+    numCombined = numLiteralOrLength + numDistance;
+    /* Run length encode the code lengths with the symbols 16, 17 and 18. */
+    memset(codeLengthFreq, 0, sizeof(codeLengthFreq));
+    index = 0;
+    while (index < numCombined) {
+      symbol = combinedSize[index];
+      runLength = 1;
+      while (index + runLength < numCombined &&
+             combinedSize[index + runLength] == symbol) {
+        runLength++;
+      } /* while */
+      index += runLength;
+      if (symbol == 0) {
+        while (runLength >= 11) {
+          runSymbol[numRuns] = 18;
+          runExtra[numRuns] = (uint8Type) ((runLength > 138 ? 138 : runLength) - 11);
+          runLength -= runExtra[numRuns++] + 11U;
+        } /* while */
+        if (runLength >= 3) {
+          runSymbol[numRuns] = 17;
+          runExtra[numRuns++] = (uint8Type) (runLength - 3);
+          runLength = 0;
+        } /* if */
+      } else {
+        runSymbol[numRuns++] = (uint8Type) symbol;
+        runLength--;
+        while (runLength >= 3) {
+          runSymbol[numRuns] = 16;
+          runExtra[numRuns] = (uint8Type) ((runLength > 6 ? 6 : runLength) - 3);
+          runLength -= runExtra[numRuns++] + 3U;
+        } /* while */
+      } /* if */
+      while (runLength != 0) {
+        runSymbol[numRuns++] = (uint8Type) symbol;
+        runLength--;
+      } /* while */
+    } /* while */
+    for (index = 0; index < numRuns; index++) {
+      codeLengthFreq[runSymbol[index]]++;
+    } /* for */
+    computeCodeSizes(codeLengthFreq, NUM_CODE_LENGTH_CODES,
+                     MAX_CODE_LENGTH_CODE_SIZE, codeLengthSize);
+    while (numCodeLengths > 4 &&
+           codeLengthSize[codeLengthOrder[numCodeLengths - 1]] == 0) {
+      numCodeLengths--;
+    } /* while */
+    /* Compute the sizes of the possible block types. */
+    for (index = 0; index < 29; index++) {
+      extraBits += (memSizeType) state->literalOrLengthFreq[257 + index] *
+                   lengthExtraBits[index];
+    } /* for */
+    for (index = 0; index < 30; index++) {
+      extraBits += (memSizeType) state->distanceFreq[index] * distanceExtraBits[index];
+    } /* for */
+    fixedBits = 3 + extraBits;
+    dynamicBits = 3 + 14 + 3 * numCodeLengths + extraBits +
+                  2 * codeLengthFreq[16] + 3 * codeLengthFreq[17] +
+                  7 * codeLengthFreq[18];
+    for (index = 0; index < NUM_CODE_LENGTH_CODES; index++) {
+      dynamicBits += (memSizeType) codeLengthFreq[index] * codeLengthSize[index];
+    } /* for */
+    for (index = 0; index < 286; index++) {
+      fixedBits += (memSizeType) state->literalOrLengthFreq[index] *
+                   fixedLiteralOrLengthSize[index];
+      dynamicBits += (memSizeType) state->literalOrLengthFreq[index] *
+                     literalOrLengthSize[index];
+    } /* for */
+    for (index = 0; index < 30; index++) {
+      fixedBits += (memSizeType) state->distanceFreq[index] * 5;
+      dynamicBits += (memSizeType) state->distanceFreq[index] * distanceSize[index];
+    } /* for */
+    blockLength = state->blockEnd - state->blockStart;
+    numStoredBlocks = blockLength == 0 ? 1 :
+        (blockLength + STORED_BLOCK_MAX - 1) / STORED_BLOCK_MAX;
+    storedBits = numStoredBlocks * (3 + 32) + (numStoredBlocks - 1) * 5 +
+                 (8 - (state->out.bitCount + 3) % 8) % 8 + 8 * blockLength;
+    if (storedBits <= fixedBits && storedBits <= dynamicBits) {
+      maximumBytes = blockLength + 5 * numStoredBlocks + 8;
+    } else {
+      /* Header: 17 + 19 * 3 + 320 * 14 bits. Symbol: 15 + 5 + 15 + 13 bits. */
+      maximumBytes = 6 * state->numSymbols + 1024;
+    } /* if */
+    if (unlikely(!reserveOutput(&state->out, maximumBytes))) {
+      okay = FALSE;
+    } else if (storedBits <= fixedBits && storedBits <= dynamicBits) {
+      writeStoredBlocks(state, bfinal);
+    } else if (fixedBits <= dynamicBits) {
+      putBits(&state->out, bfinal, 1);
+      putBits(&state->out, 1, 2);
+      writeSymbols(state, fixedLiteralOrLengthSize, fixedLiteralOrLengthCode,
+                   fixedDistanceSize, fixedDistanceCode);
+    } else {
+      putBits(&state->out, bfinal, 1);
+      putBits(&state->out, 2, 2);
+      putBits(&state->out, numLiteralOrLength - 257, 5);
+      putBits(&state->out, numDistance - 1, 5);
+      putBits(&state->out, numCodeLengths - 4, 4);
+      for (index = 0; index < numCodeLengths; index++) {
+        putBits(&state->out, codeLengthSize[codeLengthOrder[index]], 3);
+      } /* for */
+      createCanonicalCodes(codeLengthSize, NUM_CODE_LENGTH_CODES, codeLengthCode);
+      for (index = 0; index < numRuns; index++) {
+        symbol = runSymbol[index];
+        putBits(&state->out, codeLengthCode[symbol], codeLengthSize[symbol]);
+        if (symbol == 16) {
+          putBits(&state->out, runExtra[index], 2);
+        } else if (symbol == 17) {
+          putBits(&state->out, runExtra[index], 3);
+        } else if (symbol == 18) {
+          putBits(&state->out, runExtra[index], 7);
+        } /* if */
+      } /* for */
+      createCanonicalCodes(literalOrLengthSize, 286, literalOrLengthCode);
+      createCanonicalCodes(distanceSize, 30, distanceCode);
+      writeSymbols(state, literalOrLengthSize, literalOrLengthCode,
+                   distanceSize, distanceCode);
+    } /* if */
+    memset(state->literalOrLengthFreq, 0, sizeof(state->literalOrLengthFreq));
+    memset(state->distanceFreq, 0, sizeof(state->distanceFreq));
+    state->numSymbols = 0;
+    state->blockStart = state->blockEnd;
+    return okay;
+  } /* writeBlock */
+
+
+
+static inline void insertHash (deflateStateType *state, memSizeType position)
+
+  {
+    unsigned int hash;
+
+  /* insertHash */
+    hash = HASH_3_ELEMENTS(&state->data[position]);
+    state->prev[position & WINDOW_MASK] = state->head[hash];
+    state->head[hash] = position + 1;
+  } /* insertHash */
+
+
+
+/**
+ *  Search the hash chain for the longest match at 'position'.
+ *  The hash of 'position' must already be inserted.
+ *  @return the length of the longest match, if it is longer than
+ *          'prevLength', and MIN_MATCH - 1 otherwise.
+ */
+static unsigned int longestMatch (const deflateStateType *state,
+    memSizeType position, unsigned int prevLength, unsigned int *matchDistance)
+
+  {
+    const strElemType *data = state->data;
+    const strElemType *current = &data[position];
+    const strElemType *candidate;
+    memSizeType candidatePos;
+    unsigned int chainLength;
+    unsigned int maxLength;
+    unsigned int bestLength;
+    unsigned int length;
+
+  /* longestMatch */
+    chainLength = prevLength >= GOOD_LENGTH ? MAX_CHAIN >> 2 : MAX_CHAIN;
+    if (state->size - position < MAX_MATCH) {
+      maxLength = (unsigned int) (state->size - position);
+    } else {
+      maxLength = MAX_MATCH;
+    } /* if */
+    bestLength = prevLength < MIN_MATCH ? MIN_MATCH - 1 : prevLength;
+    if (bestLength >= maxLength) {
+      return MIN_MATCH - 1;
+    } /* if */
+    candidatePos = state->prev[position & WINDOW_MASK];
+    while (candidatePos != 0 && candidatePos - 1 + WINDOW_SIZE > position &&
+           chainLength != 0) {
+      candidatePos--;
+      candidate = &data[candidatePos];
+      if (candidate[bestLength] == current[bestLength] &&
+          candidate[0] == current[0] && candidate[1] == current[1]) {
+        length = 2;
+        while (length < maxLength && candidate[length] == current[length]) {
+          length++;
+        } /* while */
+        if (length > bestLength) {
+          bestLength = length;
+          *matchDistance = (unsigned int) (position - candidatePos);
+          if (length >= NICE_LENGTH || length == maxLength) {
+            break;
+          } /* if */
+        } /* if */
+      } /* if */
+      candidatePos = state->prev[candidatePos & WINDOW_MASK];
+      chainLength--;
+    } /* while */
+    if (bestLength > prevLength && bestLength >= MIN_MATCH) {
+      return bestLength;
+    } else {
+      return MIN_MATCH - 1;
+    } /* if */
+  } /* longestMatch */
+
+
+
+static inline void addLiteral (deflateStateType *state, strElemType literal)
+
+  { /* addLiteral */
+    state->literalOrLength[state->numSymbols] = (uint16Type) literal;
+    state->distance[state->numSymbols] = 0;
+    state->numSymbols++;
+    state->literalOrLengthFreq[literal]++;
+    state->blockEnd++;
+  } /* addLiteral */
+
+
+
+static inline void addMatch (deflateStateType *state, unsigned int length,
+    unsigned int distance)
+
+  { /* addMatch */
+    state->literalOrLength[state->numSymbols] = (uint16Type) length;
+    state->distance[state->numSymbols] = (uint16Type) distance;
+    state->numSymbols++;
+    state->literalOrLengthFreq[257 + lengthCode[length - MIN_MATCH]]++;
+    state->distanceFreq[getDistanceCode(distance)]++;
+    state->blockEnd += length;
+  } /* addMatch */
+
+
+
+/**
+ *  Compress the data with LZ77 and write it as DEFLATE blocks.
+ *  Matches are searched with hash chains. Lazy matching checks,
+ *  if a match at the next position is longer.
+ */
+static boolType compressData (deflateStateType *state)
+
+  {
+    const strElemType *data = state->data;
+    memSizeType size = state->size;
+    memSizeType position = 0;
+    memSizeType matchEnd;
+    unsigned int prevLength = MIN_MATCH - 1;
+    unsigned int prevDistance = 0;
+    unsigned int currLength;
+    unsigned int currDistance = 0;
+    boolType matchAvailable = FALSE;
+    boolType okay = TRUE;
+
+  /* compressData */
+    while (position < size && okay) {
+      currLength = MIN_MATCH - 1;
+      if (size - position >= MIN_MATCH) {
+        insertHash(state, position);
+        if (prevLength < LAZY_LENGTH) {
+          currLength = longestMatch(state, position, prevLength, &currDistance);
+          if (currLength == MIN_MATCH && currDistance > TOO_FAR) {
+            currLength = MIN_MATCH - 1;
+          } /* if */
+        } /* if */
+      } /* if */
+      if (prevLength >= MIN_MATCH && currLength <= prevLength) {
+        addMatch(state, prevLength, prevDistance);
+        matchEnd = position - 1 + prevLength;
+        for (position++; position < matchEnd; position++) {
+          if (size - position >= MIN_MATCH) {
+            insertHash(state, position);
+          } /* if */
+        } /* for */
+        matchAvailable = FALSE;
+        prevLength = MIN_MATCH - 1;
+      } else {
+        if (matchAvailable) {
+          addLiteral(state, data[position - 1]);
+        } /* if */
+        matchAvailable = TRUE;
+        prevLength = currLength;
+        prevDistance = currDistance;
+        position++;
+      } /* if */
+      if (state->numSymbols >= BLOCK_SYMBOLS) {
+        okay = writeBlock(state, FALSE);
+      } /* if */
+    } /* while */
+    if (okay) {
+      if (matchAvailable) {
+        addLiteral(state, data[position - 1]);
+      } /* if */
+      okay = writeBlock(state, TRUE);
+    } /* if */
+    return okay;
+  } /* compressData */
+
+
+
+/**
+ *  Compress a string with the DEFLATE algorithm.
+ *  The result is raw DEFLATE data (RFC 1951) without zlib or gzip
+ *  header. The last byte of the result is padded with zero bits.
+ *  @param uncompressed String of bytes to be compressed.
+ *  @return a string of bytes with the deflated data.
+ *  @exception RANGE_ERROR If 'uncompressed' contains characters
+ *                         beyond '\255;'.
+ *  @exception MEMORY_ERROR Not enough memory to represent the result.
+ */
+striType dflDeflate (const const_striType uncompressed)
+
+  {
+    deflateStateType state;
+    memSizeType index;
+    errInfoType err_info = OKAY_NO_ERROR;
+    striType result = NULL;
+
+  /* dflDeflate */
+    logFunction(printf("dflDeflate(\"%s\")\n",
+                       striAsUnquotedCStri(uncompressed)););
+    for (index = 0; index < uncompressed->size; index++) {
+      if (unlikely(uncompressed->mem[index] > 255)) {
+        logError(printf("dflDeflate: Character '\\" FMT_U32 ";' at position "
+                        FMT_U_MEM " is beyond '\\255;'.\n",
+                        uncompressed->mem[index], index + 1););
+        raise_error(RANGE_ERROR);
+        return NULL;
+      } /* if */
+    } /* for */
+    if (!tablesInitialized) {
+      initTables();
+    } /* if */
+    memset(&state, 0, sizeof(deflateStateType));
+    state.data = uncompressed->mem;
+    state.size = uncompressed->size;
+    state.out.capacity = uncompressed->size / 2 + 64;
+    if (unlikely(!ALLOC_TABLE(state.head, memSizeType, HASH_SIZE))) {
+      err_info = MEMORY_ERROR;
+    } else if (unlikely(!ALLOC_TABLE(state.prev, memSizeType, WINDOW_SIZE))) {
+      err_info = MEMORY_ERROR;
+    } else if (unlikely(!ALLOC_TABLE(state.literalOrLength, uint16Type, BLOCK_SYMBOLS))) {
+      err_info = MEMORY_ERROR;
+    } else if (unlikely(!ALLOC_TABLE(state.distance, uint16Type, BLOCK_SYMBOLS))) {
+      err_info = MEMORY_ERROR;
+    } else if (unlikely(!ALLOC_TABLE(state.out.buffer, ucharType, state.out.capacity))) {
+      err_info = MEMORY_ERROR;
+    } else {
+      memset(state.head, 0, HASH_SIZE * sizeof(memSizeType));
+      if (unlikely(!compressData(&state))) {
+        err_info = MEMORY_ERROR;
+      } else {
+        if (state.out.bitCount != 0) {
+          state.out.buffer[state.out.size++] = (ucharType) state.out.bitBuffer;
+        } /* if */
+        if (unlikely(!ALLOC_STRI_CHECK_SIZE(result, state.out.size))) {
+          err_info = MEMORY_ERROR;
+        } else {
+          result->size = state.out.size;
+          memcpy_to_strelem(result->mem, state.out.buffer, state.out.size);
+        } /* if */
+      } /* if */
+    } /* if */
+    if (state.out.buffer != NULL) {
+      FREE_TABLE(state.out.buffer, ucharType, state.out.capacity);
+    } /* if */
+    if (state.distance != NULL) {
+      FREE_TABLE(state.distance, uint16Type, BLOCK_SYMBOLS);
+    } /* if */
+    if (state.literalOrLength != NULL) {
+      FREE_TABLE(state.literalOrLength, uint16Type, BLOCK_SYMBOLS);
+    } /* if */
+    if (state.prev != NULL) {
+      FREE_TABLE(state.prev, memSizeType, WINDOW_SIZE);
+    } /* if */
+    if (state.head != NULL) {
+      FREE_TABLE(state.head, memSizeType, HASH_SIZE);
+    } /* if */
+    if (unlikely(err_info != OKAY_NO_ERROR)) {
+      raise_error(err_info);
+    } /* if */
+    logFunction(printf("dflDeflate --> \"%s\"\n",
+                       striAsUnquotedCStri(result)););
+    return result;
+  } /* dflDeflate */
+
+
+
+/**
+ *  Fill the bit buffer with at least 25 bits.
+ *  Beyond the end of the data zero bits are added. They are counted
+ *  in 'padBits'. If 'bitCount' drops below 'padBits' the decoder
+ *  has read beyond the end of the data.
+ */
+static inline void fillBits (inflateStateType *state)
+
+  {
+    strElemType ch;
+
+  /* fillBits */
+    while (state->bitCount <= 24) {
+      if (state->pos < state->size) {
+        ch = state->data[state->pos++];
+        if (unlikely(ch > 255)) {
+          state->err_info = RANGE_ERROR;
+          ch = 0;
+        } /* if */
+        state->bitBuffer |= (uint32Type) ch << state->bitCount;
+      } else {
+        state->padBits += 8;
+      } /* if */
+      state->bitCount += 8;
+    } /* while */
+  } /* fillBits */
+
+
+
+static inline unsigned int getBits (inflateStateType *state,
+    unsigned int bitWidth)
+
+  {
+    unsigned int bits;
+
+  /* getBits */
+    fillBits(state);
+    bits = (unsigned int) (state->bitBuffer & ((UINT32_SUFFIX(1) << bitWidth) - 1));
+    state->bitBuffer >>= bitWidth;
+    state->bitCount -= bitWidth;
+    return bits;
+  } /* getBits */
+
+
+
+static inline unsigned int decodeSymbol (inflateStateType *state,
+    const huffmanDecoderType *decoder)
+
+  {
+    unsigned int entry;
+    unsigned int length;
+    int code = 0;
+    int first = 0;
+    int index = 0;
+    int count;
+    uint32Type bits;
+
+  /* decodeSymbol */
+    fillBits(state);
+    entry = decoder->fast[state->bitBuffer & (FAST_SIZE - 1)];
+    if (likely(entry != 0)) {
+      length = entry >> 9;
+      state->bitBuffer >>= length;
+      state->bitCount -= length;
+      return entry & 0x1ff;
+    } else {
+      bits = state->bitBuffer;
+      for (length = 1; length <= MAX_CODE_LENGTH; length++) {
+        code |= (int) (bits & 1);
+        bits >>= 1;
+        count = decoder->count[length];
+        if (code - count < first) {
+          state->bitBuffer >>= length;
+          state->bitCount -= length;
+          return decoder->symbol[index + (code - first)];
+        } /* if */
+        index += count;
+        first += count;
+        first <<= 1;
+        code <<= 1;
+      } /* for */
+      state->err_info = RANGE_ERROR;
+      return END_OF_BLOCK;
+    } /* if */
+  } /* decodeSymbol */
+
+
+
+static boolType reserveInflateOutput (inflateStateType *state,
+    memSizeType extraSize)
+
+  {
+    memSizeType newCapacity;
+    ucharType *resizedBuffer;
+
+  /* reserveInflateOutput */
+    if (state->outCapacity - state->outSize < extraSize) {
+      newCapacity = state->outCapacity * 2;
+      if (newCapacity < state->outSize + extraSize) {
+        newCapacity = state->outSize + extraSize;
+      } /* if */
+      if (unlikely(newCapacity > MAX_STRI_LEN)) {
+        state->err_info = MEMORY_ERROR;
+        return FALSE;
+      } /* if */
+      resizedBuffer = REALLOC_TABLE(state->out, ucharType,
+                                    state->outCapacity, newCapacity);
+      if (unlikely(resizedBuffer == NULL)) {
+        state->err_info = MEMORY_ERROR;
+        return FALSE;
+      } /* if */
+      COUNT3_TABLE(ucharType, state->outCapacity, newCapacity);
+      state->out = resizedBuffer;
+      state->outCapacity = newCapacity;
+    } /* if */
+    return TRUE;
+  } /* reserveInflateOutput */
+
+
+
+static void inflateStoredBlock (inflateStateType *state)
+
+  {
+    memSizeType length;
+    memSizeType index;
+    const strElemType *data;
+    ucharType *out;
+
+  /* inflateStoredBlock */
+    if (unlikely(state->bitCount < state->padBits)) {
+      state->err_info = RANGE_ERROR;
+      return;
+    } /* if */
+    /* Skip the rest of the current byte and put back the unused bytes. */
+    state->pos -= (state->bitCount - state->padBits) >> 3;
+    state->bitBuffer = 0;
+    state->bitCount = 0;
+    state->padBits = 0;
+    if (unlikely(state->size - state->pos < 4)) {
+      state->err_info = RANGE_ERROR;
+    } else {
+      data = &state->data[state->pos];
+      if (unlikely((data[0] | data[1] | data[2] | data[3]) > 255 ||
+                   (data[0] ^ data[2]) != 255 || (data[1] ^ data[3]) != 255)) {
+        state->err_info = RANGE_ERROR;
+      } else {
+        length = (memSizeType) data[0] | (memSizeType) data[1] << 8;
+        state->pos += 4;
+        if (unlikely(state->size - state->pos < length)) {
+          state->err_info = RANGE_ERROR;
+        } else if (reserveInflateOutput(state, length)) {
+          data = &state->data[state->pos];
+          out = &state->out[state->outSize];
+          for (index = 0; index < length; index++) {
+            if (unlikely(data[index] > 255)) {
+              state->err_info = RANGE_ERROR;
+            } /* if */
+            out[index] = (ucharType) data[index];
+          } /* for */
+          state->pos += length;
+          state->outSize += length;
+        } /* if */
+      } /* if */
+    } /* if */
+  } /* inflateStoredBlock */
+
+
+
+static void inflateHuffmanBlock (inflateStateType *state,
+    const huffmanDecoderType *literalOrLengthDecoder,
+    const huffmanDecoderType *distanceDecoder, boolType deflate64)
+
+  {
+    unsigned int symbol;
+    memSizeType length;
+    memSizeType distance;
+    ucharType *dest;
+    const ucharType *source;
+
+  /* inflateHuffmanBlock */
+    do {
+      symbol = decodeSymbol(state, literalOrLengthDecoder);
+      if (symbol < END_OF_BLOCK) {
+        if (unlikely(state->outSize == state->outCapacity) &&
+            !reserveInflateOutput(state, 1)) {
+          return;
+        } /* if */
+        state->out[state->outSize++] = (ucharType) symbol;
+      } else if (symbol != END_OF_BLOCK) {
+        symbol -= 257;
+        if (unlikely(symbol >= 29)) {
+          state->err_info = RANGE_ERROR;
+          return;
+        } else if (deflate64 && symbol == 28) {
+          length = 3 + getBits(state, 16);
+        } else {
+          length = lengthBase[symbol] + getBits(state, lengthExtraBits[symbol]);
+        } /* if */
+        symbol = decodeSymbol(state, distanceDecoder);
+        if (unlikely(symbol >= (deflate64 ? 32U : 30U))) {
+          state->err_info = RANGE_ERROR;
+          return;
+        } /* if */
+        distance = distanceBase[symbol] + getBits(state, distanceExtraBits[symbol]);
+        if (unlikely(distance > state->outSize)) {
+          state->err_info = RANGE_ERROR;
+          return;
+        } /* if */
+        if (unlikely(state->outCapacity - state->outSize < length) &&
+            !reserveInflateOutput(state, length)) {
+          return;
+        } /* if */
+        dest = &state->out[state->outSize];
+        source = dest - distance;
+        state->outSize += length;
+        if (distance >= length) {
+          memcpy(dest, source, length);
+        } else {
+          while (length != 0) {
+            *dest++ = *source++;
+            length--;
+          } /* while */
+        } /* if */
+      } /* if */
+      if (unlikely(state->bitCount < state->padBits)) {
+        /* Read beyond the end of the data. */
+        state->err_info = RANGE_ERROR;
+      } /* if */
+    } while (symbol != END_OF_BLOCK && state->err_info == OKAY_NO_ERROR);
+  } /* inflateHuffmanBlock */
+
+
+
+static void inflateDynamicBlock (inflateStateType *state, boolType deflate64)
+
+  {
+    huffmanDecoderType literalOrLengthDecoder;
+    huffmanDecoderType distanceDecoder;
+    uint8Type codeSize[NUM_LITERAL_LENGTH_CODES + NUM_DISTANCE_CODES];
+    unsigned int numLiteralOrLength;
+    unsigned int numDistance;
+    unsigned int numCodeLengths;
+    unsigned int index;
+    unsigned int symbol;
+    unsigned int repeat;
+    uint8Type previous;
+
+  /* inflateDynamicBlock */
+    numLiteralOrLength = getBits(state, 5) + 257;
+    numDistance = getBits(state, 5) + 1;
+    numCodeLengths = getBits(state, 4) + 4;
+    memset(codeSize, 0, NUM_CODE_LENGTH_CODES);
+    for (index = 0; index < numCodeLengths; index++) {
+      codeSize[codeLengthOrder[index]] = (uint8Type) getBits(state, 3);
+    } /* for */
+    if (unlikely(!buildDecoder(&literalOrLengthDecoder, codeSize,
+                               NUM_CODE_LENGTH_CODES))) {
+      state->err_info = RANGE_ERROR;
+    } else {
+      index = 0;
+      while (index < numLiteralOrLength + numDistance &&
+             state->err_info == OKAY_NO_ERROR) {
+        symbol = decodeSymbol(state, &literalOrLengthDecoder);
+        if (symbol < 16) {
+          codeSize[index++] = (uint8Type) symbol;
+        } else {
+          if (symbol == 16) {
+            if (unlikely(index == 0)) {
+              state->err_info = RANGE_ERROR;
+              return;
+            } /* if */
+            previous = codeSize[index - 1];
+            repeat = 3 + getBits(state, 2);
+          } else if (symbol == 17) {
+            previous = 0;
+            repeat = 3 + getBits(state, 3);
+          } else {
+            previous = 0;
+            repeat = 11 + getBits(state, 7);
+          } /* if */
+          if (unlikely(index + repeat > numLiteralOrLength + numDistance)) {
+            state->err_info = RANGE_ERROR;
+            return;
+          } /* if */
+          memset(&codeSize[index], previous, repeat);
+          index += repeat;
+        } /* if */
+      } /* while */
+      if (unlikely(state->err_info != OKAY_NO_ERROR ||
+                   codeSize[END_OF_BLOCK] == 0 ||
+                   !buildDecoder(&literalOrLengthDecoder, codeSize,
+                                 numLiteralOrLength) ||
+                   !buildDecoder(&distanceDecoder, &codeSize[numLiteralOrLength],
+                                 numDistance))) {
+        state->err_info = RANGE_ERROR;
+      } else {
+        inflateHuffmanBlock(state, &literalOrLengthDecoder,
+                            &distanceDecoder, deflate64);
+      } /* if */
+    } /* if */
+  } /* inflateDynamicBlock */
+
+
+
+/**
+ *  Decompress DEFLATE (or DEFLATE64) data from a string.
+ *  The compressed data is read directly from 'compressed' starting
+ *  at the index 'position'. Afterwards 'position' refers to the
+ *  first byte after the compressed data.
+ *  @param compressed String of bytes with compressed data.
+ *  @param position Start position of the compressed data. Afterwards
+ *                  the position after the compressed data.
+ *  @param deflate64 TRUE if the data is compressed with DEFLATE64.
+ *  @return the uncompressed string.
+ *  @exception INDEX_ERROR If 'position' is not in the range
+ *                         1 .. length(compressed) + 1.
+ *  @exception RANGE_ERROR If 'compressed' is not in DEFLATE format
+ *                         or if the compressed data is truncated.
+ *  @exception MEMORY_ERROR Not enough memory to represent the result.
+ */
+striType dflInflate (const const_striType compressed, intType *const position,
+    boolType deflate64)
+
+  {
+    inflateStateType state;
+    unsigned int bfinal;
+    unsigned int btype;
+    huffmanDecoderType *literalOrLengthDecoder;
+    huffmanDecoderType *distanceDecoder;
+    striType result = NULL;
+
+  /* dflInflate */
+    logFunction(printf("dflInflate(\"%s\", " FMT_D ", %d)\n",
+                       striAsUnquotedCStri(compressed), *position, deflate64););
+    if (unlikely(*position < 1 ||
+                 (uintType) *position - 1 > (uintType) compressed->size)) {
+      logError(printf("dflInflate: Position " FMT_D " not in range 1 .. "
+                      FMT_U_MEM ".\n", *position, compressed->size + 1););
+      raise_error(INDEX_ERROR);
+      return NULL;
+    } /* if */
+    if (!tablesInitialized) {
+      initTables();
+    } /* if */
+    memset(&state, 0, sizeof(inflateStateType));
+    state.data = compressed->mem;
+    state.size = compressed->size;
+    state.pos = (memSizeType) *position - 1;
+    state.outCapacity = 4 * (state.size - state.pos);
+    if (state.outCapacity < INFLATE_MIN_CAPACITY) {
+      state.outCapacity = INFLATE_MIN_CAPACITY;
+    } else if (state.outCapacity > INFLATE_MAX_CAPACITY) {
+      state.outCapacity = INFLATE_MAX_CAPACITY;
+    } /* if */
+    if (unlikely(!ALLOC_TABLE(state.out, ucharType, state.outCapacity))) {
+      raise_error(MEMORY_ERROR);
+      return NULL;
+    } /* if */
+    do {
+      bfinal = getBits(&state, 1);
+      btype = getBits(&state, 2);
+      if (btype == 0) {
+        inflateStoredBlock(&state);
+      } else if (btype == 1) {
+        literalOrLengthDecoder = &fixedLiteralOrLengthDecoder;
+        distanceDecoder = &fixedDistanceDecoder;
+        inflateHuffmanBlock(&state, literalOrLengthDecoder,
+                            distanceDecoder, deflate64);
+      } else if (btype == 2) {
+        inflateDynamicBlock(&state, deflate64);
+      } else {
+        state.err_info = RANGE_ERROR;
+      } /* if */
+      if (unlikely(state.bitCount < state.padBits)) {
+        state.err_info = RANGE_ERROR;
+      } /* if */
+    } while (!bfinal && state.err_info == OKAY_NO_ERROR);
+    if (state.err_info == OKAY_NO_ERROR) {
+      if (unlikely(!ALLOC_STRI_CHECK_SIZE(result, state.outSize))) {
+        state.err_info = MEMORY_ERROR;
+      } else {
+        result->size = state.outSize;
+        memcpy_to_strelem(result->mem, state.out, state.outSize);
+        /* Unused whole bytes in the bit buffer are not consumed. */
+        *position = (intType) (state.pos -
+            ((state.bitCount - state.padBits) >> 3)) + 1;
+      } /* if */
+    } /* if */
+    FREE_TABLE(state.out, ucharType, state.outCapacity);
+    if (unlikely(state.err_info != OKAY_NO_ERROR)) {
+      logError(printf("dflInflate: Data not in %s format.\n",
+                      deflate64 ? "DEFLATE64" : "DEFLATE"););
+      raise_error(state.err_info);
+    } /* if */
+    logFunction(printf("dflInflate --> \"%s\" (position: " FMT_D ")\n",
+                       striAsUnquotedCStri(result), *position););
+    return result;
+  } /* dflInflate */
@@ -2,7 +2,7 @@
 /*                                                                  */
 /*  s7   Seed7 interpreter                                          */
 /*  Copyright (C) 1990 - 2004, 2011 - 2015, 2017  Thomas Mertes     */
-/*                2019 - 2021  Thomas Mertes                        */
+/*                2019 - 2021, 2026  Thomas Mertes                  */
 /*                                                                  */
 /*  This program is free software; you can redistribute it and/or   */
 /*  modify it under the terms of the GNU General Public License as  */
@@ -22,7 +22,7 @@
 /*  Module: Interpreter                                             */
 /*  File: seed7/src/exec.c                                          */
 /*  Changes: 1999, 2000, 2004, 2011 - 2015, 2017  Thomas Mertes     */
-/*           2019 - 2021  Thomas Mertes                             */
+/*           2019 - 2021, 2026  Thomas Mertes                       */
 /*  Content: Main interpreter functions.                            */
 /*                                                                  */
 /********************************************************************/
@@ -52,6 +52,8 @@
 #include "runerr.h"
 #include "match.h"
 #include "prclib.h"
+#include "bytecode.h"
+#include "profutl.h"
 
 #undef EXTERN
 #define EXTERN
@@ -495,6 +497,7 @@ static objectType exec_lambda (const_blockType block,
     listType backup_form_params;
     objectType backup_block_result;
     listType backup_loc_var;
+    boolType profiled;
 
   /* exec_lambda */
     logFunction(printf("exec_lambda\n"););
@@ -511,7 +514,20 @@ static objectType exec_lambda (const_blockType block,
         result = fail_value;
       } else {
         if (res_init(&block->result, &backup_block_result)) {
-          result = exec_call(block->body);
+          profiled = profile_active;
+          if (unlikely(profiled)) {
+            /* The time to evaluate the parameters is not counted. */
+            profEnter(CATEGORY_OF_OBJ(object) == BLOCKOBJECT ?
+                      object : object->value.listValue->obj);
+          } /* if */
+          if (use_bytecode) {
+            result = exec_bytecode_body(block);
+          } else {
+            result = exec_call(block->body);
+          } /* if */
+          if (unlikely(profiled)) {
+            profLeave();
+          } /* if */
           if (fail_flag) {
             errInfoType ignored_err_info;
 
@@ -588,23 +604,20 @@ static void dump_arg_list (listType evaluated_act_params, uint32Type temp_bits)
 
 
 
-static objectType exec_action (const_objectType act_object,
-    listType act_param_list, objectType object)
+/**
+ *  Call the primitive action 'act_object' with already evaluated parameters.
+ *  Afterwards the temporary values among the parameters (marked
+ *  in 'temp_bits') are freed together with 'evaluated_act_params'.
+ */
+objectType exec_evaluated_action (const_objectType act_object,
+    listType evaluated_act_params, uint32Type temp_bits, objectType object)
 
   {
-    listType evaluated_act_params;
-    uint32Type temp_bits;
     objectType result;
 
-  /* exec_action */
-    logFunction(printf("exec_action(%s)\n",
+  /* exec_evaluated_action */
+    logFunction(printf("exec_evaluated_action(%s)\n",
                        getActEntry(act_object->value.actValue)->name););
-#if CHECK_STACK
-    if (checkStack(FALSE)) {
-      return raise_with_arguments(SYS_MEM_EXCEPTION, act_param_list);
-    } /* if */
-#endif
-    evaluated_act_params = eval_arg_list(act_param_list, &temp_bits);
     if (interrupt_flag) {
       if (!fail_flag) {
         curr_exec_object = object;
@@ -614,7 +627,7 @@ static objectType exec_action (const_objectType act_object,
       if (fail_flag) {
         dump_arg_list(evaluated_act_params, temp_bits);
         result = fail_value;
-        logFunction(printf("exec_action fail_flag=%d -->\n", fail_flag););
+        logFunction(printf("exec_evaluated_action fail_flag=%d -->\n", fail_flag););
         return result;
       } /* if */
     } /* if */
@@ -701,8 +714,30 @@ static objectType exec_action (const_objectType act_object,
     } /* if */
 #endif
     dump_arg_list(evaluated_act_params, temp_bits);
-    logFunction(printf("exec_action fail_flag=%d -->\n", fail_flag););
+    logFunction(printf("exec_evaluated_action fail_flag=%d -->\n", fail_flag););
     return result;
+  } /* exec_evaluated_action */
+
+
+
+static objectType exec_action (const_objectType act_object,
+    listType act_param_list, objectType object)
+
+  {
+    listType evaluated_act_params;
+    uint32Type temp_bits;
+
+  /* exec_action */
+    logFunction(printf("exec_action(%s)\n",
+                       getActEntry(act_object->value.actValue)->name););
+#if CHECK_STACK
+    if (checkStack(FALSE)) {
+      return raise_with_arguments(SYS_MEM_EXCEPTION, act_param_list);
+    } /* if */
+#endif
+    evaluated_act_params = eval_arg_list(act_param_list, &temp_bits);
+    return exec_evaluated_action(act_object, evaluated_act_params,
+                                 temp_bits, object);
   } /* exec_action */
 
 
@@ -909,7 +944,11 @@ objectType evaluate (objectType object)
 #endif
     switch (CATEGORY_OF_OBJ(object)) {
       case MATCHOBJECT:
-        result = exec_call(object);
+        if (use_bytecode) {
+          result = exec_bytecode_match(object);
+        } else {
+          result = exec_call(object);
+        } /* if */
         break;
       case VALUEPARAMOBJECT:
       case REFPARAMOBJECT:
@@ -1,7 +1,7 @@
 /********************************************************************/
 /*                                                                  */
 /*  s7   Seed7 interpreter                                          */
-/*  Copyright (C) 1990 - 2000  Thomas Mertes                        */
+/*  Copyright (C) 1990 - 2000, 2026  Thomas Mertes                  */
 /*                                                                  */
 /*  This program is free software; you can redistribute it and/or   */
 /*  modify it under the terms of the GNU General Public License as  */
@@ -20,7 +20,7 @@
 /*                                                                  */
 /*  Module: Interpreter                                             */
 /*  File: seed7/src/exec.h                                          */
-/*  Changes: 1999  Thomas Mertes                                    */
+/*  Changes: 1999, 2026  Thomas Mertes                              */
 /*  Content: Main interpreter functions.                            */
 /*                                                                  */
 /********************************************************************/
@@ -35,6 +35,8 @@ EXTERN volatile int signal_number;
 
 void doSuspendInterpreter (int signalNum);
 objectType exec_object (register objectType object);
+objectType exec_evaluated_action (const_objectType act_object,
+    listType evaluated_act_params, uint32Type temp_bits, objectType object);
 objectType exec_call (objectType object);
 objectType do_exec_call (objectType object, errInfoType *err_info);
 objectType evaluate (objectType object);
@@ -25,7 +25,7 @@
 /*                                                                  */
 /*  Module: Seed7 Runtime Library                                   */
 /*  File: seed7/src/fil_rtl.c                                       */
-/*  Changes: 1992 - 1994, 2009 - 2021, 2023 - 2025  Thomas Mertes   */
+/*  Changes: 1992 - 1994, 2009 - 2021, 2023 - 2026  Thomas Mertes   */
 /*  Content: Primitive actions for the C library file type.         */
 /*                                                                  */
 /********************************************************************/
@@ -99,7 +99,6 @@ extern int _chsize (int fd, long size);
 #define BUFFER_SIZE             4096
 #define GETS_DEFAULT_SIZE    1048576
 #define READ_STRI_INIT_SIZE      256
-#define READ_STRI_SIZE_DELTA    2048
 
 
 
@@ -596,6 +595,164 @@ bigIntType getBigFileLengthUsingSeek (cFileType aFile)
 
 
 
+/**
+ *  Read bytes from 'inFile' until a delimiter or EOF is found.
+ *  If 'delimiter' is READ_WORD_DELIMITERS leading spaces and tabs are
+ *  skipped and the bytes are read until ' ', '\t', '\n' or EOF is found.
+ *  If 'delimiter' is EOF the rest of the file is read. The delimiter
+ *  is consumed but not copied into the result. If the read buffer of
+ *  the FILE is accessible it is searched with memchr() and whole runs
+ *  of bytes are copied at once. Otherwise getc_unlocked() is used.
+ *  @param termCh Variable to receive the delimiter found or EOF.
+ *  @param err_info Unchanged if the function succeeds, and
+ *                  MEMORY_ERROR if there is not enough memory, and
+ *                  FILE_ERROR if a system function returns an error.
+ *  @return the bytes read, or NULL if an error occurred.
+ */
+bstriType readDelimitedBytes (cFileType inFile, int delimiter,
+    int *termCh, errInfoType *err_info)
+
+  {
+    boolType searching = TRUE;
+    int ch = EOF;
+    memSizeType position = 0;
+    memSizeType memlength = READ_STRI_INIT_SIZE;
+    memSizeType newmemlength;
+    size_t runLength = 1;
+#ifdef read_buffer_skip
+    const unsigned char *run;
+    const unsigned char *found;
+    size_t available;
+#endif
+    bstriType resized_buffer;
+    bstriType buffer;
+
+  /* readDelimitedBytes */
+    logFunction(printf("readDelimitedBytes(%d, %d, *, *)\n",
+                       safe_fileno(inFile), delimiter););
+    if (unlikely(!ALLOC_BSTRI_SIZE_OK(buffer, memlength))) {
+      *err_info = MEMORY_ERROR;
+    } else {
+      flockfile(inFile);
+      if (delimiter == READ_WORD_DELIMITERS) {
+        do {
+          ch = getc_unlocked(inFile);
+        } while (ch == ' ' || ch == '\t');
+        if (ch == '\n' || ch == EOF) {
+          searching = FALSE;
+        } else {
+          buffer->mem[position++] = (ucharType) ch;
+        } /* if */
+      } /* if */
+      while (searching) {
+#ifdef read_buffer_skip
+        available = read_buffer_available(inFile);
+        if (available != 0) {
+          run = read_buffer_ptr(inFile);
+          if (delimiter == READ_WORD_DELIMITERS) {
+            found = run;
+            while (found < &run[available] &&
+                   *found != ' ' && *found != '\t' && *found != '\n') {
+              found++;
+            } /* while */
+            if (found == &run[available]) {
+              found = NULL;
+            } /* if */
+          } else if (delimiter == EOF) {
+            found = NULL;
+          } else {
+            found = (const unsigned char *) memchr(run, delimiter, available);
+          } /* if */
+          if (found != NULL) {
+            runLength = (size_t) (found - run);
+          } else {
+            runLength = available;
+          } /* if */
+        } else {
+          run = NULL;
+          runLength = 1;
+        } /* if */
+#else
+        ch = getc_unlocked(inFile);
+#endif
+        if (position + runLength > memlength) {
+          newmemlength = 2 * memlength;
+          if (newmemlength < position + runLength) {
+            newmemlength = position + runLength;
+          } /* if */
+          REALLOC_BSTRI_CHECK_SIZE(resized_buffer, buffer, memlength, newmemlength);
+          if (unlikely(resized_buffer == NULL)) {
+            *err_info = MEMORY_ERROR;
+            searching = FALSE;
+          } else {
+            buffer = resized_buffer;
+            COUNT3_BSTRI(memlength, newmemlength);
+            memlength = newmemlength;
+          } /* if */
+        } /* if */
+        if (searching) {
+#ifdef read_buffer_skip
+          if (run != NULL) {
+            memcpy(&buffer->mem[position], run, runLength);
+            position += runLength;
+            if (found != NULL) {
+              ch = *found;
+              read_buffer_skip(inFile, runLength + 1);
+              searching = FALSE;
+            } else {
+              read_buffer_skip(inFile, runLength);
+            } /* if */
+          } else {
+            /* The read buffer is empty: getc_unlocked() refills it. */
+            ch = getc_unlocked(inFile);
+#endif
+            if (ch == EOF || ch == delimiter ||
+                (delimiter == READ_WORD_DELIMITERS &&
+                 (ch == ' ' || ch == '\t' || ch == '\n'))) {
+              searching = FALSE;
+            } else {
+              buffer->mem[position++] = (ucharType) ch;
+            } /* if */
+#ifdef read_buffer_skip
+          } /* if */
+#endif
+        } /* if */
+      } /* while */
+      funlockfile(inFile);
+      if (unlikely(*err_info != OKAY_NO_ERROR)) {
+        FREE_BSTRI(buffer, memlength);
+        buffer = NULL;
+      } else if (unlikely(ch == EOF && position == 0 && ferror(inFile))) {
+        logError(printf("readDelimitedBytes(%d, %d, *, *): "
+                        "getc_unlocked(%d) failed:\n"
+                        "errno=%d\nerror: %s\n",
+                        safe_fileno(inFile), delimiter,
+                        safe_fileno(inFile), errno, strerror(errno)););
+        FREE_BSTRI(buffer, memlength);
+        *err_info = FILE_ERROR;
+        buffer = NULL;
+      } else {
+        REALLOC_BSTRI_SIZE_OK(resized_buffer, buffer, memlength, position);
+        if (unlikely(resized_buffer == NULL)) {
+          FREE_BSTRI(buffer, memlength);
+          *err_info = MEMORY_ERROR;
+          buffer = NULL;
+        } else {
+          buffer = resized_buffer;
+          COUNT3_BSTRI(memlength, position);
+          buffer->size = position;
+          *termCh = ch;
+        } /* if */
+      } /* if */
+    } /* if */
+    logFunction(printf("readDelimitedBytes(%d, %d, %d, %d) --> " FMT_U_MEM "\n",
+                       safe_fileno(inFile), delimiter, *termCh, *err_info,
+                       buffer != NULL ? buffer->size : 0););
+    return buffer;
+  } /* readDelimitedBytes */
+
+
+
 /**
  *  Read a string, if we do not know how many bytes are available.
  *  This function reads data into a list of buffers. This is done
@@ -1739,12 +1896,10 @@ striType filLineRead (const const_fileType inFile,
 
   {
     cFileType cInFile;
-    register int ch;
-    register memSizeType position;
-    strElemType *memory;
-    memSizeType memlength;
-    memSizeType newmemlength;
-    striType resized_result;
+    int ch;
+    bstriType buffer;
+    memSizeType length;
+    errInfoType err_info = OKAY_NO_ERROR;
     striType result;
 
   /* filLineRead */
@@ -1768,54 +1923,23 @@ striType filLineRead (const const_fileType inFile,
       result = NULL;
 #endif
     } else {
-      memlength = READ_STRI_INIT_SIZE;
-      if (unlikely(!ALLOC_STRI_SIZE_OK(result, memlength))) {
-        raise_error(MEMORY_ERROR);
+      buffer = readDelimitedBytes(cInFile, '\n', &ch, &err_info);
+      if (unlikely(buffer == NULL)) {
+        raise_error(err_info);
+        result = NULL;
       } else {
-        memory = result->mem;
-        position = 0;
-        flockfile(cInFile);
-        while ((ch = getc_unlocked(cInFile)) != '\n' && ch != EOF) {
-          if (position >= memlength) {
-            newmemlength = memlength + READ_STRI_SIZE_DELTA;
-            REALLOC_STRI_CHECK_SIZE2(resized_result, result, memlength, newmemlength);
-            if (unlikely(resized_result == NULL)) {
-              FREE_STRI2(result, memlength);
-              funlockfile(cInFile);
-              raise_error(MEMORY_ERROR);
-              return NULL;
-            } /* if */
-            result = resized_result;
-            memory = result->mem;
-            memlength = newmemlength;
-          } /* if */
-          memory[position++] = (strElemType) ch;
-        } /* while */
-        funlockfile(cInFile);
-        if (ch == '\n' && position != 0 && memory[position - 1] == '\r') {
-          position--;
+        length = buffer->size;
+        if (ch == '\n' && length != 0 && buffer->mem[length - 1] == '\r') {
+          length--;
         } /* if */
-        if (unlikely(ch == EOF && position == 0 && ferror(cInFile))) {
-          FREE_STRI2(result, memlength);
-          logError(printf("filLineRead(%d, '\\" FMT_U32 ";'): "
-                          "getc_unlocked(%d) failed:\n"
-                          "errno=%d\nerror: %s\n",
-                          safe_fileno(cInFile), *terminationChar,
-                          safe_fileno(cInFile), errno, strerror(errno)););
-          raise_error(FILE_ERROR);
-          result = NULL;
+        if (unlikely(!ALLOC_STRI_CHECK_SIZE(result, length))) {
+          raise_error(MEMORY_ERROR);
         } else {
-          REALLOC_STRI_SIZE_SMALLER2(resized_result, result, memlength, position);
-          if (unlikely(resized_result == NULL)) {
-            FREE_STRI2(result, memlength);
-            raise_error(MEMORY_ERROR);
-            result = NULL;
-          } else {
-            result = resized_result;
-            result->size = position;
-            *terminationChar = (charType) ch;
-          } /* if */
+          memcpy_to_strelem(result->mem, buffer->mem, length);
+          result->size = length;
+          *terminationChar = (charType) ch;
         } /* if */
+        FREE_BSTRI(buffer, buffer->size);
       } /* if */
     } /* if */
     logFunction(printf("filLineRead(%d, '\\" FMT_U32 ";') --> \"%s\"\n",
@@ -2535,13 +2659,11 @@ striType filTerminatedRead (const const_fileType inFile,
 
   {
     cFileType cInFile;
-    register int termCh;
-    register int ch;
-    register memSizeType position;
-    strElemType *memory;
-    memSizeType memlength;
-    memSizeType newmemlength;
-    striType resized_result;
+    int termCh;
+    int ch;
+    bstriType buffer;
+    memSizeType length;
+    errInfoType err_info = OKAY_NO_ERROR;
     striType result;
 
   /* filTerminatedRead */
@@ -2569,51 +2691,20 @@ striType filTerminatedRead (const const_fileType inFile,
       result = NULL;
 #endif
     } else {
-      memlength = READ_STRI_INIT_SIZE;
-      if (unlikely(!ALLOC_STRI_SIZE_OK(result, memlength))) {
-        raise_error(MEMORY_ERROR);
+      buffer = readDelimitedBytes(cInFile, termCh, &ch, &err_info);
+      if (unlikely(buffer == NULL)) {
+        raise_error(err_info);
+        result = NULL;
       } else {
-        memory = result->mem;
-        position = 0;
-        flockfile(cInFile);
-        while ((ch = getc_unlocked(cInFile)) != termCh && ch != EOF) {
-          if (position >= memlength) {
-            newmemlength = memlength + READ_STRI_SIZE_DELTA;
-            REALLOC_STRI_CHECK_SIZE2(resized_result, result, memlength, newmemlength);
-            if (unlikely(resized_result == NULL)) {
-              FREE_STRI2(result, memlength);
-              funlockfile(cInFile);
-              raise_error(MEMORY_ERROR);
-              return NULL;
-            } /* if */
-            result = resized_result;
-            memory = result->mem;
-            memlength = newmemlength;
-          } /* if */
-          memory[position++] = (strElemType) ch;
-        } /* while */
-        funlockfile(cInFile);
-        if (unlikely(ch == EOF && position == 0 && ferror(cInFile))) {
-          FREE_STRI2(result, memlength);
-          logError(printf("filTerminatedRead(%d, '\\" FMT_U32 ";', '\\" FMT_U32 ";'): "
-                          "getc_unlocked(%d) failed:\n"
-                          "errno=%d\nerror: %s\n",
-                          safe_fileno(cInFile), terminator, *terminationChar,
-                          safe_fileno(cInFile), errno, strerror(errno)););
-          raise_error(FILE_ERROR);
-          result = NULL;
+        length = buffer->size;
+        if (unlikely(!ALLOC_STRI_CHECK_SIZE(result, length))) {
+          raise_error(MEMORY_ERROR);
         } else {
-          REALLOC_STRI_SIZE_SMALLER2(resized_result, result, memlength, position);
-          if (unlikely(resized_result == NULL)) {
-            FREE_STRI2(result, memlength);
-            raise_error(MEMORY_ERROR);
-            result = NULL;
-          } else {
-            result = resized_result;
-            result->size = position;
-            *terminationChar = (charType) ch;
-          } /* if */
+          memcpy_to_strelem(result->mem, buffer->mem, length);
+          result->size = length;
+          *terminationChar = (charType) ch;
         } /* if */
+        FREE_BSTRI(buffer, buffer->size);
       } /* if */
     } /* if */
     logFunction(printf("filTerminatedRead(%d, '\\" FMT_U32 ";', '\\" FMT_U32 ";') --> \"%s\"\n",
@@ -2722,12 +2813,10 @@ striType filWordRead (const const_fileType inFile,
 
   {
     cFileType cInFile;
-    register int ch;
-    register memSizeType position;
-    strElemType *memory;
-    memSizeType memlength;
-    memSizeType newmemlength;
-    striType resized_result;
+    int ch;
+    bstriType buffer;
+    memSizeType length;
+    errInfoType err_info = OKAY_NO_ERROR;
     striType result;
 
   /* filWordRead */
@@ -2751,59 +2840,23 @@ striType filWordRead (const const_fileType inFile,
       result = NULL;
 #endif
     } else {
-      memlength = READ_STRI_INIT_SIZE;
-      if (unlikely(!ALLOC_STRI_SIZE_OK(result, memlength))) {
-        raise_error(MEMORY_ERROR);
+      buffer = readDelimitedBytes(cInFile, READ_WORD_DELIMITERS, &ch, &err_info);
+      if (unlikely(buffer == NULL)) {
+        raise_error(err_info);
+        result = NULL;
       } else {
-        memory = result->mem;
-        position = 0;
-        flockfile(cInFile);
-        do {
-          ch = getc_unlocked(cInFile);
-        } while (ch == ' ' || ch == '\t');
-        while (ch != ' ' && ch != '\t' &&
-            ch != '\n' && ch != EOF) {
-          if (position >= memlength) {
-            newmemlength = memlength + READ_STRI_SIZE_DELTA;
-            REALLOC_STRI_CHECK_SIZE2(resized_result, result, memlength, newmemlength);
-            if (unlikely(resized_result == NULL)) {
-              FREE_STRI2(result, memlength);
-              funlockfile(cInFile);
-              raise_error(MEMORY_ERROR);
-              return NULL;
-            } /* if */
-            result = resized_result;
-            memory = result->mem;
-            memlength = newmemlength;
-          } /* if */
-          memory[position++] = (strElemType) ch;
-          ch = getc_unlocked(cInFile);
-        } /* while */
-        funlockfile(cInFile);
-        if (ch == '\n' && position != 0 && memory[position - 1] == '\r') {
-          position--;
+        length = buffer->size;
+        if (ch == '\n' && length != 0 && buffer->mem[length - 1] == '\r') {
+          length--;
         } /* if */
-        if (unlikely(ch == EOF && position == 0 && ferror(cInFile))) {
-          FREE_STRI2(result, memlength);
-          logError(printf("filWordRead(%d, '\\" FMT_U32 ";'): "
-                          "getc_unlocked(%d) failed:\n"
-                          "errno=%d\nerror: %s\n",
-                          safe_fileno(cInFile), *terminationChar,
-                          safe_fileno(cInFile), errno, strerror(errno)););
-          raise_error(FILE_ERROR);
-          result = NULL;
+        if (unlikely(!ALLOC_STRI_CHECK_SIZE(result, length))) {
+          raise_error(MEMORY_ERROR);
         } else {
-          REALLOC_STRI_SIZE_SMALLER2(resized_result, result, memlength, position);
-          if (unlikely(resized_result == NULL)) {
-            FREE_STRI2(result, memlength);
-            raise_error(MEMORY_ERROR);
-            result = NULL;
-          } else {
-            result = resized_result;
-            result->size = position;
-            *terminationChar = (charType) ch;
-          } /* if */
+          memcpy_to_strelem(result->mem, buffer->mem, length);
+          result->size = length;
+          *terminationChar = (charType) ch;
         } /* if */
+        FREE_BSTRI(buffer, buffer->size);
       } /* if */
     } /* if */
     logFunction(printf("filWordRead(%d, '\\" FMT_U32 ";') --> \"%s\"\n",
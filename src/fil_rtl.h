@@ -1,7 +1,7 @@
 /********************************************************************/
 /*                                                                  */
 /*  fil_rtl.h     Primitive actions for the C library file type.    */
-/*  Copyright (C) 1989 - 2009  Thomas Mertes                        */
+/*  Copyright (C) 1989 - 2009, 2026  Thomas Mertes                  */
 /*                                                                  */
 /*  This file is part of the Seed7 Runtime Library.                 */
 /*                                                                  */
@@ -24,7 +24,7 @@
 /*                                                                  */
 /*  Module: Seed7 Runtime Library                                   */
 /*  File: seed7/src/fil_rtl.h                                       */
-/*  Changes: 1992, 1993, 1994, 2009  Thomas Mertes                  */
+/*  Changes: 1992, 1993, 1994, 2009, 2026  Thomas Mertes            */
 /*  Content: Primitive actions for the C library file type.         */
 /*                                                                  */
 /********************************************************************/
@@ -53,11 +53,16 @@ EXTERN fileRecord stderrFileRecord;
     (aFile)->writingAllowed = (writingOkay); \
     (aFile)->isPopenPipe = TRUE;
 
+/* Delimiter of readDelimitedBytes() to read a word. */
+#define READ_WORD_DELIMITERS (-2)
+
 int offsetSeek (cFileType aFile, const os_off_t anOffset,
                 const int origin);
 memSizeType remainingBytesInFile (cFileType aFile);
 intType getFileLengthUsingSeek (cFileType aFile);
 bigIntType getBigFileLengthUsingSeek (cFileType aFile);
+bstriType readDelimitedBytes (cFileType inFile, int delimiter,
+                              int *termCh, errInfoType *err_info);
 bigIntType filBigLng (const const_fileType aFile);
 void filBigSeek (const const_fileType aFile,
                  const const_bigIntType big_position);
@@ -183,6 +183,8 @@ EXTERN memSizeType hs;
 #define ARR_SUB(len)           count.array--, count.arr_elems -= (memSizeType) (len)
 #define HSH_ADD(len)           count.hash++,  count.hsh_elems += (memSizeType) (len)
 #define HSH_SUB(len)           count.hash--,  count.hsh_elems -= (memSizeType) (len)
+#define HSH_TAB_ADD(len)       count.hsh_elems += (memSizeType) (len)
+#define HSH_TAB_SUB(len)       count.hsh_elems -= (memSizeType) (len)
 #define SET_ADD(len)           count.set++,   count.set_elems += (memSizeType) (len)
 #define SET_SUB(len)           count.set--,   count.set_elems -= (memSizeType) (len)
 #define SCT_ADD(len)           count.stru++,  count.sct_elems += (memSizeType) (len)
@@ -201,6 +203,8 @@ EXTERN memSizeType hs;
 #define RTL_ARR_SUB(len)       count.rtl_array--, count.rtl_arr_elems -= (memSizeType) (len)
 #define RTL_HSH_ADD(len)       count.rtl_hash++,  count.rtl_hsh_elems += (memSizeType) (len)
 #define RTL_HSH_SUB(len)       count.rtl_hash--,  count.rtl_hsh_elems -= (memSizeType) (len)
+#define RTL_HSH_TAB_ADD(len)   count.rtl_hsh_elems += (memSizeType) (len)
+#define RTL_HSH_TAB_SUB(len)   count.rtl_hsh_elems -= (memSizeType) (len)
 #else
 #define USTRI_ADD(len,cnt,byt)
 #define USTRI_SUB(len,cnt,byt)
@@ -212,6 +216,8 @@ EXTERN memSizeType hs;
 #define ARR_SUB(len)
 #define HSH_ADD(len)
 #define HSH_SUB(len)
+#define HSH_TAB_ADD(len)
+#define HSH_TAB_SUB(len)
 #define SET_ADD(len)
 #define SET_SUB(len)
 #define SCT_ADD(len)
@@ -230,6 +236,8 @@ EXTERN memSizeType hs;
 #define RTL_ARR_SUB(len)
 #define RTL_HSH_ADD(len)
 #define RTL_HSH_SUB(len)
+#define RTL_HSH_TAB_ADD(len)
+#define RTL_HSH_TAB_SUB(len)
 #endif
 
 
@@ -258,7 +266,8 @@ EXTERN memSizeType hs;
 #define SIZ_STRI(len)    ((sizeof(striRecord)     - sizeof(strElemType))  + (len) * sizeof(strElemType))
 #define SIZ_BSTRI(len)   ((sizeof(bstriRecord)    - sizeof(ucharType))    + (len) * sizeof(ucharType))
 #define SIZ_ARR(len)     ((sizeof(arrayRecord)    - sizeof(objectRecord)) + (len) * sizeof(objectRecord))
-#define SIZ_HSH(len)     ((sizeof(hashRecord)     - sizeof(hashElemType)) + (len) * sizeof(hashElemType))
+#define SIZ_HSH(len)     (sizeof(hashRecord)      + (len) * sizeof(hashElemType))
+#define SIZ_HSH_TAB(len) ((len) * sizeof(hashElemType))
 #define SIZ_SET(len)     ((sizeof(setRecord)      - sizeof(bitSetType))   + (len) * sizeof(bitSetType))
 #define SIZ_SCT(len)     ((sizeof(structRecord)   - sizeof(objectRecord)) + (len) * sizeof(objectRecord))
 #define SIZ_BIG(len)     ((sizeof_bigIntRecord    - sizeof_bigDigitType)  + (len) * sizeof_bigDigitType)
@@ -266,7 +275,8 @@ EXTERN memSizeType hs;
 #define SIZ_TAB(tp, nr)  (sizeof(tp) * (nr))
 #define SIZ_RTL_L_ELEM   (sizeof(rtlListRecord))
 #define SIZ_RTL_ARR(len) ((sizeof(rtlArrayRecord) - sizeof(rtlObjectType))   + (len) * sizeof(rtlObjectType))
-#define SIZ_RTL_HSH(len) ((sizeof(rtlHashRecord)  - sizeof(rtlHashElemType)) + (len) * sizeof(rtlHashElemType))
+#define SIZ_RTL_HSH(len) (sizeof(rtlHashRecord)   + (len) * sizeof(rtlHashElemType))
+#define SIZ_RTL_HSH_TAB(len) ((len) * sizeof(rtlHashElemType))
 
 #define SIZ_STRI_0       (sizeof(emptyStriRecord))
 #define SIZ_BSTRI_0      (sizeof(emptyBStriRecord))
@@ -316,6 +326,8 @@ EXTERN memSizeType hs;
 #define CNT2_ARR(len,size)     CALC_HS(HS_SUB(size), ARR_SUB(len)     H_LOG2(size))
 #define CNT1_HSH(len,size)     CALC_HS(HS_ADD(size), HSH_ADD(len)     H_LOG1(size))
 #define CNT2_HSH(len,size)     CALC_HS(HS_SUB(size), HSH_SUB(len)     H_LOG2(size))
+#define CNT1_HSH_TAB(len,size) CALC_HS(HS_ADD(size), HSH_TAB_ADD(len) H_LOG1(size))
+#define CNT2_HSH_TAB(len,size) CALC_HS(HS_SUB(size), HSH_TAB_SUB(len) H_LOG2(size))
 #define CNT1_SET(len,size)     CALC_HS(HS_ADD(size), SET_ADD(len)     H_LOG1(size))
 #define CNT2_SET(len,size)     CALC_HS(HS_SUB(size), SET_SUB(len)     H_LOG2(size))
 #define CNT1_SCT(len,size)     CALC_HS(HS_ADD(size), SCT_ADD(len)     H_LOG1(size))
@@ -334,6 +346,8 @@ EXTERN memSizeType hs;
 #define CNT2_RTL_ARR(len,size) CALC_HS(HS_SUB(size), RTL_ARR_SUB(len) H_LOG2(size))
 #define CNT1_RTL_HSH(len,size) CALC_HS(HS_ADD(size), RTL_HSH_ADD(len) H_LOG1(size))
 #define CNT2_RTL_HSH(len,size) CALC_HS(HS_SUB(size), RTL_HSH_SUB(len) H_LOG2(size))
+#define CNT1_RTL_HSH_TAB(len,size) CALC_HS(HS_ADD(size), RTL_HSH_TAB_ADD(len) H_LOG1(size))
+#define CNT2_RTL_HSH_TAB(len,size) CALC_HS(HS_SUB(size), RTL_HSH_TAB_SUB(len) H_LOG2(size))
 
 
 #define ALLOC_HEAP(var,tp,byt)     ((var = (tp) MALLOC(byt)) != NULL)
@@ -572,16 +586,16 @@ EXTERN unsigned int sflist_allowed;
 #define COUNT3_RTL_ARRAY(cap1,cap2)    CNT3(CNT2_RTL_ARR(cap1, SIZ_RTL_ARR(cap1)), CNT1_RTL_ARR(cap2, SIZ_RTL_ARR(cap2)))
 
 
-#define ALLOC_HASH(var,len)        (ALLOC_HEAP(var, hashType, SIZ_HSH(len))?CNT(CNT1_HSH(len, SIZ_HSH(len))) TRUE:FALSE)
-#define FREE_HASH(var,len)         (CNT(CNT2_HSH(len, SIZ_HSH(len))) FREE_HEAP(var, SIZ_HSH(len)))
-#define REALLOC_HASH(var,ln1,ln2)  REALLOC_HEAP(var, hashType, SIZ_HSH(ln2))
-#define COUNT3_HASH(len1,len2)     CNT3(CNT2_HSH(len1, SIZ_HSH(len1)), CNT1_HSH(len2, SIZ_HSH(len2)))
+#define ALLOC_HASH(var)            (ALLOC_HEAP(var, hashType, SIZ_HSH(0))?CNT(CNT1_HSH(0, SIZ_HSH(0))) TRUE:FALSE)
+#define FREE_HASH(var)             (CNT(CNT2_HSH(0, SIZ_HSH(0))) FREE_HEAP(var, SIZ_HSH(0)))
+#define ALLOC_HASH_TABLE(var,len)  (ALLOC_HEAP(var, hashElemType *, SIZ_HSH_TAB(len))?CNT(CNT1_HSH_TAB(len, SIZ_HSH_TAB(len))) TRUE:FALSE)
+#define FREE_HASH_TABLE(var,len)   (CNT(CNT2_HSH_TAB(len, SIZ_HSH_TAB(len))) FREE_HEAP(var, SIZ_HSH_TAB(len)))
 
 
-#define ALLOC_RTL_HASH(var,len)       (ALLOC_HEAP(var, rtlHashType, SIZ_RTL_HSH(len))?CNT(CNT1_RTL_HSH(len, SIZ_RTL_HSH(len))) TRUE:FALSE)
-#define FREE_RTL_HASH(var,len)        (CNT(CNT2_RTL_HSH(len, SIZ_RTL_HSH(len))) FREE_HEAP(var, SIZ_RTL_HSH(len)))
-#define REALLOC_RTL_HASH(var,ln1,ln2) REALLOC_HEAP(var, rtlHashType, SIZ_RTL_HSH(ln2))
-#define COUNT3_RTL_HASH(len1,len2)    CNT3(CNT2_RTL_HSH(len1, SIZ_RTL_HSH(len1)), CNT1_RTL_HSH(len2, SIZ_RTL_HSH(len2)))
+#define ALLOC_RTL_HASH(var)            (ALLOC_HEAP(var, rtlHashType, SIZ_RTL_HSH(0))?CNT(CNT1_RTL_HSH(0, SIZ_RTL_HSH(0))) TRUE:FALSE)
+#define FREE_RTL_HASH(var)             (CNT(CNT2_RTL_HSH(0, SIZ_RTL_HSH(0))) FREE_HEAP(var, SIZ_RTL_HSH(0)))
+#define ALLOC_RTL_HASH_TABLE(var,len)  (ALLOC_HEAP(var, rtlHashElemType *, SIZ_RTL_HSH_TAB(len))?CNT(CNT1_RTL_HSH_TAB(len, SIZ_RTL_HSH_TAB(len))) TRUE:FALSE)
+#define FREE_RTL_HASH_TABLE(var,len)   (CNT(CNT2_RTL_HSH_TAB(len, SIZ_RTL_HSH_TAB(len))) FREE_HEAP(var, SIZ_RTL_HSH_TAB(len)))
 
 
 #define ALLOC_SET(var,len)         (ALLOC_HEAP(var, setType, SIZ_SET(len))?CNT(CNT1_SET(len, SIZ_SET(len))) TRUE:FALSE)
@@ -2,7 +2,7 @@
 /*                                                                  */
 /*  hsh_rtl.c     Primitive actions for the hash map type.          */
 /*  Copyright (C) 1989 - 2011, 2013 - 2016, 2018  Thomas Mertes     */
-/*                2021, 2024  Thomas Mertes                         */
+/*                2021, 2024, 2026  Thomas Mertes                   */
 /*                                                                  */
 /*  This file is part of the Seed7 Runtime Library.                 */
 /*                                                                  */
@@ -26,7 +26,7 @@
 /*  Module: Seed7 Runtime Library                                   */
 /*  File: seed7/src/hsh_rtl.c                                       */
 /*  Changes: 2005, 2006, 2007, 2013, 2016, 2018  Thomas Mertes      */
-/*           2021, 2024  Thomas Mertes                              */
+/*           2021, 2024, 2026  Thomas Mertes                        */
 /*  Content: Primitive actions for the hash map type.               */
 /*                                                                  */
 /*  The functions from this file should only be used in compiled    */
@@ -61,9 +61,11 @@
 #include "hsh_rtl.h"
 
 
-#define TABLE_BITS 10
+#define INITIAL_TABLE_BITS 4
+#define MAX_TABLE_BITS 30
 #define TABLE_SIZE(bits) ((unsigned int) 1 << (bits))
 #define TABLE_MASK(bits) (TABLE_SIZE(bits)-1)
+#define TABLE_NEEDS_TO_GROW(hash) ((hash)->size > (hash)->table_size)
 
 
 
@@ -129,7 +131,8 @@ static void free_hash (const const_rtlHashType old_hash,
                                 key_destr_func, data_destr_func);
         } while (to_free != 0);
       } /* if */
-      FREE_RTL_HASH(old_hash, old_hash->table_size);
+      FREE_RTL_HASH_TABLE(old_hash->table, old_hash->table_size);
+      FREE_RTL_HASH(old_hash);
     } /* if */
     logFunction(printf("free_hash -->\n"););
   } /* free_hash */
@@ -137,7 +140,7 @@ static void free_hash (const const_rtlHashType old_hash,
 
 
 static rtlHashElemType new_helem_generic (genericType key, genericType data,
-    errInfoType *err_info)
+    intType hashcode, errInfoType *err_info)
 
   {
     rtlHashElemType helem;
@@ -151,6 +154,7 @@ static rtlHashElemType new_helem_generic (genericType key, genericType data,
       helem->data.value.genericValue = data;
       helem->next_less = NULL;
       helem->next_greater = NULL;
+      helem->hashcode = (unsigned int) hashcode;
       /* printf("new_helem_generic(" FMT_U_GEN ", " FMT_U_GEN ")\n",
           helem->key.value.genericValue,
           helem->data.value.genericValue); */
@@ -161,8 +165,8 @@ static rtlHashElemType new_helem_generic (genericType key, genericType data,
 
 
 static rtlHashElemType new_helem (rtlValueUnion key, rtlValueUnion data,
-    const createFuncType key_create_func, const createFuncType data_create_func,
-    errInfoType *err_info)
+    intType hashcode, const createFuncType key_create_func,
+    const createFuncType data_create_func, errInfoType *err_info)
 
   {
     rtlHashElemType helem;
@@ -176,6 +180,7 @@ static rtlHashElemType new_helem (rtlValueUnion key, rtlValueUnion data,
       helem->data.value = data_create_func(data);
       helem->next_less = NULL;
       helem->next_greater = NULL;
+      helem->hashcode = (unsigned int) hashcode;
       /* printf("new_helem(" FMT_U_GEN ", " FMT_U_GEN ")\n",
           helem->key.value.genericValue,
           helem->data.value.genericValue); */
@@ -192,12 +197,17 @@ static rtlHashType new_hash (unsigned int bits)
 
   /* new_hash */
     logFunction(printf("new_hash(%u)\n", bits););
-    if (likely(ALLOC_RTL_HASH(hash, TABLE_SIZE(bits)))) {
-      hash->bits = bits;
-      hash->mask = TABLE_MASK(bits);
-      hash->table_size = TABLE_SIZE(bits);
-      hash->size = 0;
-      memset(hash->table, 0, hash->table_size * sizeof(rtlHashElemType));
+    if (likely(ALLOC_RTL_HASH(hash))) {
+      if (unlikely(!ALLOC_RTL_HASH_TABLE(hash->table, TABLE_SIZE(bits)))) {
+        FREE_RTL_HASH(hash);
+        hash = NULL;
+      } else {
+        hash->bits = bits;
+        hash->mask = TABLE_MASK(bits);
+        hash->table_size = TABLE_SIZE(bits);
+        hash->size = 0;
+        memset(hash->table, 0, hash->table_size * sizeof(rtlHashElemType));
+      } /* if */
     } /* if */
     logFunction(printf("new_hash(%u) --> " FMT_X_MEM "\n",
                        bits, (memSizeType) hash););
@@ -206,6 +216,120 @@ static rtlHashType new_hash (unsigned int bits)
 
 
 
+/**
+ *  Move the elements of the tree 'curr_helem' to lists in 'table'.
+ *  The elements are visited in reverse order and inserted at the head
+ *  of the list for their new bucket. Afterwards every list in 'table'
+ *  contains its elements in the order of the original trees. The lists
+ *  are linked with next_greater.
+ */
+static void distribute_helem (rtlHashElemType *const table,
+    const unsigned int mask, rtlHashElemType curr_helem)
+
+  {
+    rtlHashElemType next_helem;
+    rtlHashElemType *list_head;
+
+  /* distribute_helem */
+    do {
+      if (curr_helem->next_greater != NULL) {
+        distribute_helem(table, mask, curr_helem->next_greater);
+      } /* if */
+      next_helem = curr_helem->next_less;
+      list_head = &table[curr_helem->hashcode & mask];
+      curr_helem->next_less = NULL;
+      curr_helem->next_greater = *list_head;
+      *list_head = curr_helem;
+      curr_helem = next_helem;
+    } while (curr_helem != NULL);
+  } /* distribute_helem */
+
+
+
+/**
+ *  Build a balanced tree from the first 'length' elements of '*list'.
+ *  The list is linked with next_greater and '*list' is advanced
+ *  behind the elements used.
+ */
+static rtlHashElemType list_to_helem_tree (rtlHashElemType *list,
+    memSizeType length)
+
+  {
+    memSizeType less_length;
+    rtlHashElemType less_tree;
+    rtlHashElemType root;
+
+  /* list_to_helem_tree */
+    if (length == 0) {
+      root = NULL;
+    } else {
+      less_length = length >> 1;
+      less_tree = list_to_helem_tree(list, less_length);
+      root = *list;
+      *list = root->next_greater;
+      root->next_less = less_tree;
+      root->next_greater = list_to_helem_tree(list, length - less_length - 1);
+    } /* if */
+    return root;
+  } /* list_to_helem_tree */
+
+
+
+/**
+ *  Double the number of buckets of 'aHashMap'.
+ *  The elements are redistributed with their stored hashcode. Within a
+ *  bucket the order defined by the compare function is kept, so no
+ *  compare function is needed. The trees of the new buckets are
+ *  balanced. If there is not enough memory the hash map is left
+ *  unchanged, since a small table just makes searching slower.
+ */
+static void grow_hash (const rtlHashType aHashMap)
+
+  {
+    unsigned int new_bits;
+    unsigned int new_table_size;
+    unsigned int new_mask;
+    rtlHashElemType *new_table;
+    rtlHashElemType list;
+    rtlHashElemType helem;
+    memSizeType length;
+    unsigned int number;
+
+  /* grow_hash */
+    logFunction(printf("grow_hash(" FMT_X_MEM ") bits=%u, size=" FMT_U_MEM "\n",
+                       (memSizeType) aHashMap, aHashMap->bits, aHashMap->size););
+    new_bits = aHashMap->bits + 1;
+    new_table_size = TABLE_SIZE(new_bits);
+    if (new_bits <= MAX_TABLE_BITS &&
+        ALLOC_RTL_HASH_TABLE(new_table, new_table_size)) {
+      new_mask = TABLE_MASK(new_bits);
+      memset(new_table, 0, new_table_size * sizeof(rtlHashElemType));
+      for (number = 0; number < aHashMap->table_size; number++) {
+        if (aHashMap->table[number] != NULL) {
+          distribute_helem(new_table, new_mask, aHashMap->table[number]);
+        } /* if */
+      } /* for */
+      for (number = 0; number < new_table_size; number++) {
+        list = new_table[number];
+        if (list != NULL) {
+          length = 0;
+          for (helem = list; helem != NULL; helem = helem->next_greater) {
+            length++;
+          } /* for */
+          new_table[number] = list_to_helem_tree(&list, length);
+        } /* if */
+      } /* for */
+      FREE_RTL_HASH_TABLE(aHashMap->table, aHashMap->table_size);
+      aHashMap->bits = new_bits;
+      aHashMap->mask = new_mask;
+      aHashMap->table_size = new_table_size;
+      aHashMap->table = new_table;
+    } /* if */
+    logFunction(printf("grow_hash -->\n"););
+  } /* grow_hash */
+
+
+
 static rtlHashElemType create_helem (const const_rtlHashElemType source_helem,
     const createFuncType key_create_func, const createFuncType data_create_func,
     errInfoType *err_info)
@@ -217,6 +341,7 @@ static rtlHashElemType create_helem (const const_rtlHashElemType source_helem,
     if (unlikely(!ALLOC_RECORD(dest_helem, rtlHashElemRecord, count.rtl_helem))) {
       *err_info = MEMORY_ERROR;
     } else {
+      dest_helem->hashcode = source_helem->hashcode;
       dest_helem->key.value =
           key_create_func(source_helem->key.value);
       dest_helem->data.value =
@@ -257,7 +382,11 @@ static rtlHashType create_hash (const const_rtlHashType source_hash,
                        (memSizeType) key_create_func,
                        (memSizeType) data_create_func, *err_info););
     table_size = source_hash->table_size;
-    if (unlikely(!ALLOC_RTL_HASH(dest_hash, table_size))) {
+    if (unlikely(!ALLOC_RTL_HASH(dest_hash))) {
+      *err_info = MEMORY_ERROR;
+    } else if (unlikely(!ALLOC_RTL_HASH_TABLE(dest_hash->table, table_size))) {
+      FREE_RTL_HASH(dest_hash);
+      dest_hash = NULL;
       *err_info = MEMORY_ERROR;
     } else {
       dest_hash->bits = source_hash->bits;
@@ -551,7 +680,7 @@ boolType hashAdd (const rtlHashType aHashMap, const rtlValueUnion aKey,
     hashelem = aHashMap->table[(unsigned int) hashcode & aHashMap->mask];
     if (hashelem == NULL) {
       aHashMap->table[(unsigned int) hashcode & aHashMap->mask] = new_helem(
-          aKey, data, key_create_func, data_create_func, &err_info);
+          aKey, data, hashcode, key_create_func, data_create_func, &err_info);
       /*
       hashelem = aHashMap->table[(unsigned int) hashcode & aHashMap->mask];
       printf("aKey=%llX\n", (unsigned long long) aKey);
@@ -565,7 +694,7 @@ boolType hashAdd (const rtlHashType aHashMap, const rtlValueUnion aKey,
         cmp = cmp_func(hashelem->key.value, aKey);
         if (cmp < 0) {
           if (hashelem->next_less == NULL) {
-            hashelem->next_less = new_helem(aKey, data,
+            hashelem->next_less = new_helem(aKey, data, hashcode,
                 key_create_func, data_create_func, &err_info);
             aHashMap->size++;
             hashelem = NULL;
@@ -578,7 +707,7 @@ boolType hashAdd (const rtlHashType aHashMap, const rtlValueUnion aKey,
           hashelem = NULL;
         } else {
           if (hashelem->next_greater == NULL) {
-            hashelem->next_greater = new_helem(aKey, data,
+            hashelem->next_greater = new_helem(aKey, data, hashcode,
                 key_create_func, data_create_func, &err_info);
             aHashMap->size++;
             hashelem = NULL;
@@ -592,6 +721,8 @@ boolType hashAdd (const rtlHashType aHashMap, const rtlValueUnion aKey,
       if (err_info == MEMORY_ERROR) {
         aHashMap->size--;
       } /* if */
+    } else if (TABLE_NEEDS_TO_GROW(aHashMap)) {
+      grow_hash(aHashMap);
     } /* if */
     logFunction(printf("hashAdd(" FMT_X_MEM ", " FMT_U_GEN ", "
                        FMT_U_GEN ", " FMT_U ") size=" FMT_U_MEM " --> %d\n",
@@ -817,7 +948,7 @@ rtlHashType hshEmpty (void)
 
   /* hshEmpty */
     logFunction(printf("hshEmpty()\n"););
-    result = new_hash(TABLE_BITS);
+    result = new_hash(INITIAL_TABLE_BITS);
     if (unlikely(result == NULL)) {
       raise_error(MEMORY_ERROR);
     } /* if */
@@ -955,7 +1086,7 @@ rtlHashType hshGenHash (rtlHashElemType keyValuePairs,
   /* hshGenHash */
     logFunction(printf("hshGenHash(" FMT_X_MEM ", ...)\n",
                        (memSizeType) keyValuePairs););
-    aHashMap = new_hash(TABLE_BITS);
+    aHashMap = new_hash(INITIAL_TABLE_BITS);
     if (unlikely(aHashMap == NULL)) {
       raise_error(MEMORY_ERROR);
     } else {
@@ -966,6 +1097,7 @@ rtlHashType hshGenHash (rtlHashElemType keyValuePairs,
         currentKeyValue->next_greater = NULL;
         hashCode = (unsigned int) key_hash_code_func(
             currentKeyValue->key.value);
+        currentKeyValue->hashcode = hashCode;
         hashElem = aHashMap->table[hashCode & aHashMap->mask];
         if (hashElem == NULL) {
           aHashMap->table[hashCode & aHashMap->mask] = currentKeyValue;
@@ -1000,6 +1132,9 @@ rtlHashType hshGenHash (rtlHashElemType keyValuePairs,
             } /* if */
           } while (hashElem != NULL);
         } /* if */
+        if (TABLE_NEEDS_TO_GROW(aHashMap)) {
+          grow_hash(aHashMap);
+        } /* if */
       } /* while */
       if (unlikely(err_info != OKAY_NO_ERROR)) {
         free_hash(aHashMap, key_destr_func, data_destr_func);
@@ -1025,6 +1160,7 @@ rtlHashElemType hshGenKeyValue (const rtlValueUnion aKey, const rtlValueUnion aV
     } else {
       keyValue->next_less = NULL;
       keyValue->next_greater = NULL;
+      keyValue->hashcode = 0;
       keyValue->key.value = aKey;
       keyValue->data.value = aValue;
     } /* if */
@@ -1242,7 +1378,7 @@ genericType hshIdxEnterGeneric (const rtlHashType aHashMap,
                        (memSizeType) aHashMap, aKey, defaultData, hashcode););
     hashelem = aHashMap->table[(unsigned int) hashcode & aHashMap->mask];
     if (hashelem == NULL) {
-      result_hashelem = new_helem_generic(aKey, defaultData, &err_info);
+      result_hashelem = new_helem_generic(aKey, defaultData, hashcode, &err_info);
       aHashMap->table[(unsigned int) hashcode & aHashMap->mask] = result_hashelem;
       aHashMap->size++;
     } else {
@@ -1250,7 +1386,7 @@ genericType hshIdxEnterGeneric (const rtlHashType aHashMap,
         if (hashelem->key.value.genericValue < aKey) {
           if (hashelem->next_less == NULL) {
             result_hashelem = new_helem_generic(aKey, defaultData,
-                                                &err_info);
+                                                hashcode, &err_info);
             hashelem->next_less = result_hashelem;
             aHashMap->size++;
             hashelem = NULL;
@@ -1263,7 +1399,7 @@ genericType hshIdxEnterGeneric (const rtlHashType aHashMap,
         } else {
           if (hashelem->next_greater == NULL) {
             result_hashelem = new_helem_generic(aKey, defaultData,
-                                                &err_info);
+                                                hashcode, &err_info);
             hashelem->next_greater = result_hashelem;
             aHashMap->size++;
             hashelem = NULL;
@@ -1279,6 +1415,9 @@ genericType hshIdxEnterGeneric (const rtlHashType aHashMap,
       result = 0;
     } else {
       result = result_hashelem->data.value.genericValue;
+      if (TABLE_NEEDS_TO_GROW(aHashMap)) {
+        grow_hash(aHashMap);
+      } /* if */
     } /* if */
     logFunction(printf("hshIdxEnterGeneric(" FMT_X_MEM ", " FMT_U_GEN ", "
                        FMT_U_GEN ", " FMT_U ") --> " FMT_U_GEN "\n",
@@ -1443,7 +1582,7 @@ void hshIncl (const rtlHashType aHashMap, const rtlValueUnion aKey,
     hashelem = aHashMap->table[(unsigned int) hashcode & aHashMap->mask];
     if (hashelem == NULL) {
       aHashMap->table[(unsigned int) hashcode & aHashMap->mask] = new_helem(
-          aKey, data, key_create_func, data_create_func, &err_info);
+          aKey, data, hashcode, key_create_func, data_create_func, &err_info);
       /*
       hashelem = aHashMap->table[(unsigned int) hashcode & aHashMap->mask];
       printf("aKey=%llX\n", (unsigned long long) aKey);
@@ -1457,7 +1596,7 @@ void hshIncl (const rtlHashType aHashMap, const rtlValueUnion aKey,
         cmp = cmp_func(hashelem->key.value, aKey);
         if (cmp < 0) {
           if (hashelem->next_less == NULL) {
-            hashelem->next_less = new_helem(aKey, data,
+            hashelem->next_less = new_helem(aKey, data, hashcode,
                 key_create_func, data_create_func, &err_info);
             aHashMap->size++;
             hashelem = NULL;
@@ -1469,7 +1608,7 @@ void hshIncl (const rtlHashType aHashMap, const rtlValueUnion aKey,
           hashelem = NULL;
         } else {
           if (hashelem->next_greater == NULL) {
-            hashelem->next_greater = new_helem(aKey, data,
+            hashelem->next_greater = new_helem(aKey, data, hashcode,
                 key_create_func, data_create_func, &err_info);
             aHashMap->size++;
             hashelem = NULL;
@@ -1482,6 +1621,8 @@ void hshIncl (const rtlHashType aHashMap, const rtlValueUnion aKey,
     if (unlikely(err_info != OKAY_NO_ERROR)) {
       aHashMap->size--;
       raise_error(MEMORY_ERROR);
+    } else if (TABLE_NEEDS_TO_GROW(aHashMap)) {
+      grow_hash(aHashMap);
     } /* if */
     logFunction(printf("hshIncl(" FMT_X_MEM ", " FMT_U_GEN ", "
                        FMT_U_GEN ", " FMT_U ") size=" FMT_U_MEM " -->\n",
@@ -1572,7 +1713,7 @@ rtlValueUnion hshUpdate (const rtlHashType aHashMap, const rtlValueUnion aKey,
     hashelem = aHashMap->table[(unsigned int) hashcode & aHashMap->mask];
     if (hashelem == NULL) {
       aHashMap->table[(unsigned int) hashcode & aHashMap->mask] = new_helem(
-          aKey, data, key_create_func, data_create_func, &err_info);
+          aKey, data, hashcode, key_create_func, data_create_func, &err_info);
       aHashMap->size++;
       result = data;
     } else {
@@ -1580,7 +1721,7 @@ rtlValueUnion hshUpdate (const rtlHashType aHashMap, const rtlValueUnion aKey,
         cmp = cmp_func(hashelem->key.value, aKey);
         if (cmp < 0) {
           if (hashelem->next_less == NULL) {
-            hashelem->next_less = new_helem(aKey, data,
+            hashelem->next_less = new_helem(aKey, data, hashcode,
                 key_create_func, data_create_func, &err_info);
             aHashMap->size++;
             result = data;
@@ -1594,7 +1735,7 @@ rtlValueUnion hshUpdate (const rtlHashType aHashMap, const rtlValueUnion aKey,
           hashelem = NULL;
         } else {
           if (hashelem->next_greater == NULL) {
-            hashelem->next_greater = new_helem(aKey, data,
+            hashelem->next_greater = new_helem(aKey, data, hashcode,
                 key_create_func, data_create_func, &err_info);
             aHashMap->size++;
             result = data;
@@ -1608,6 +1749,8 @@ rtlValueUnion hshUpdate (const rtlHashType aHashMap, const rtlValueUnion aKey,
     if (unlikely(err_info != OKAY_NO_ERROR)) {
       aHashMap->size--;
       raise_error(MEMORY_ERROR);
+    } else if (TABLE_NEEDS_TO_GROW(aHashMap)) {
+      grow_hash(aHashMap);
     } /* if */
     logFunction(printf("hshUpdate(" FMT_X_MEM ", " FMT_U_GEN ", "
                        FMT_U_GEN ", " FMT_U ") size=" FMT_U_MEM " -->\n",
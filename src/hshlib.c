@@ -2,6 +2,7 @@
 /*                                                                  */
 /*  s7   Seed7 interpreter                                          */
 /*  Copyright (C) 1990 - 2019, 2021, 2022, 2024  Thomas Mertes      */
+/*                2026  Thomas Mertes                               */
 /*                                                                  */
 /*  This program is free software; you can redistribute it and/or   */
 /*  modify it under the terms of the GNU General Public License as  */
@@ -21,7 +22,7 @@
 /*  Module: Library                                                 */
 /*  File: seed7/src/hshlib.c                                        */
 /*  Changes: 2005, 2013, 2016, 2018, 2021, 2022  Thomas Mertes      */
-/*           2024  Thomas Mertes                                    */
+/*           2024, 2026  Thomas Mertes                              */
 /*  Content: All primitive actions for hash types.                  */
 /*                                                                  */
 /********************************************************************/
@@ -54,11 +55,11 @@
 #include "hshlib.h"
 
 
-#define TABLE_BITS 10
+#define INITIAL_TABLE_BITS 4
+#define MAX_TABLE_BITS 30
 #define TABLE_SIZE(bits) ((unsigned int) 1 << (bits))
 #define TABLE_MASK(bits) (TABLE_SIZE(bits)-1)
-
-typedef struct hashElemStruct *const hashElemType_const;
+#define TABLE_NEEDS_TO_GROW(hash) ((hash)->size > (hash)->table_size)
 
 
 
@@ -115,14 +116,15 @@ static void free_hash (hashType old_hash, objectType key_destr_func,
           to_free -= free_helem(table[number], key_destr_func, data_destr_func);
         } while (to_free != 0);
       } /* if */
-      FREE_HASH(old_hash, old_hash->table_size);
+      FREE_HASH_TABLE(old_hash->table, old_hash->table_size);
+      FREE_HASH(old_hash);
     } /* if */
     logFunction(printf("free_hash -->\n"););
   } /* free_hash */
 
 
 
-static hashElemType new_helem (objectType key, objectType data,
+static hashElemType new_helem (objectType key, objectType data, intType hashcode,
     objectType key_create_func, objectType data_create_func, errInfoType *err_info)
 
   {
@@ -142,6 +144,7 @@ static hashElemType new_helem (objectType key, objectType data,
       param3_call(data_create_func, &helem->data, SYS_CREA_OBJECT, data);
       helem->next_less = NULL;
       helem->next_greater = NULL;
+      helem->hashcode = (unsigned int) hashcode;
     } /* if */
     return helem;
   } /* new_helem */
@@ -154,18 +157,137 @@ static hashType new_hash (unsigned int bits)
     hashType hash;
 
   /* new_hash */
-    if (likely(ALLOC_HASH(hash, TABLE_SIZE(bits)))) {
-      hash->bits = bits;
-      hash->mask = TABLE_MASK(bits);
-      hash->table_size = TABLE_SIZE(bits);
-      hash->size = 0;
-      memset(hash->table, 0, hash->table_size * sizeof(hashElemType));
+    if (likely(ALLOC_HASH(hash))) {
+      if (unlikely(!ALLOC_HASH_TABLE(hash->table, TABLE_SIZE(bits)))) {
+        FREE_HASH(hash);
+        hash = NULL;
+      } else {
+        hash->bits = bits;
+        hash->mask = TABLE_MASK(bits);
+        hash->table_size = TABLE_SIZE(bits);
+        hash->size = 0;
+        memset(hash->table, 0, hash->table_size * sizeof(hashElemType));
+      } /* if */
     } /* if */
     return hash;
   } /* new_hash */
 
 
 
+/**
+ *  Move the elements of the tree 'curr_helem' to lists in 'table'.
+ *  The elements are visited in reverse order and inserted at the head
+ *  of the list for their new bucket. Afterwards every list in 'table'
+ *  contains its elements in the order of the original trees. The lists
+ *  are linked with next_greater.
+ */
+static void distribute_helem (hashElemType *const table,
+    const unsigned int mask, hashElemType curr_helem)
+
+  {
+    hashElemType next_helem;
+    hashElemType *list_head;
+
+  /* distribute_helem */
+    do {
+      if (curr_helem->next_greater != NULL) {
+        distribute_helem(table, mask, curr_helem->next_greater);
+      } /* if */
+      next_helem = curr_helem->next_less;
+      list_head = &table[curr_helem->hashcode & mask];
+      curr_helem->next_less = NULL;
+      curr_helem->next_greater = *list_head;
+      *list_head = curr_helem;
+      curr_helem = next_helem;
+    } while (curr_helem != NULL);
+  } /* distribute_helem */
+
+
+
+/**
+ *  Build a balanced tree from the first 'length' elements of '*list'.
+ *  The list is linked with next_greater and '*list' is advanced
+ *  behind the elements used.
+ */
+static hashElemType list_to_helem_tree (hashElemType *list,
+    memSizeType length)
+
+  {
+    memSizeType less_length;
+    hashElemType less_tree;
+    hashElemType root;
+
+  /* list_to_helem_tree */
+    if (length == 0) {
+      root = NULL;
+    } else {
+      less_length = length >> 1;
+      less_tree = list_to_helem_tree(list, less_length);
+      root = *list;
+      *list = root->next_greater;
+      root->next_less = less_tree;
+      root->next_greater = list_to_helem_tree(list, length - less_length - 1);
+    } /* if */
+    return root;
+  } /* list_to_helem_tree */
+
+
+
+/**
+ *  Double the number of buckets of 'aHashMap'.
+ *  The elements are redistributed with their stored hashcode. Within a
+ *  bucket the order defined by the compare function is kept, so no
+ *  compare function is needed. The trees of the new buckets are
+ *  balanced. If there is not enough memory the hash map is left
+ *  unchanged, since a small table just makes searching slower.
+ */
+static void grow_hash (const hashType aHashMap)
+
+  {
+    unsigned int new_bits;
+    unsigned int new_table_size;
+    unsigned int new_mask;
+    hashElemType *new_table;
+    hashElemType list;
+    hashElemType helem;
+    memSizeType length;
+    unsigned int number;
+
+  /* grow_hash */
+    logFunction(printf("grow_hash(" FMT_X_MEM ") bits=%u, size=" FMT_U_MEM "\n",
+                       (memSizeType) aHashMap, aHashMap->bits, aHashMap->size););
+    new_bits = aHashMap->bits + 1;
+    new_table_size = TABLE_SIZE(new_bits);
+    if (new_bits <= MAX_TABLE_BITS &&
+        ALLOC_HASH_TABLE(new_table, new_table_size)) {
+      new_mask = TABLE_MASK(new_bits);
+      memset(new_table, 0, new_table_size * sizeof(hashElemType));
+      for (number = 0; number < aHashMap->table_size; number++) {
+        if (aHashMap->table[number] != NULL) {
+          distribute_helem(new_table, new_mask, aHashMap->table[number]);
+        } /* if */
+      } /* for */
+      for (number = 0; number < new_table_size; number++) {
+        list = new_table[number];
+        if (list != NULL) {
+          length = 0;
+          for (helem = list; helem != NULL; helem = helem->next_greater) {
+            length++;
+          } /* for */
+          new_table[number] = list_to_helem_tree(&list, length);
+        } /* if */
+      } /* for */
+      FREE_HASH_TABLE(aHashMap->table, aHashMap->table_size);
+      aHashMap->bits = new_bits;
+      aHashMap->mask = new_mask;
+      aHashMap->table_size = new_table_size;
+      aHashMap->table = new_table;
+    } /* if */
+    logFunction(printf("grow_hash -->\n"););
+  } /* grow_hash */
+
+
+
 static hashElemType create_helem (hashElemType source_helem,
     objectType key_create_func, objectType data_create_func,
     errInfoType *err_info)
@@ -177,6 +299,7 @@ static hashElemType create_helem (hashElemType source_helem,
     if (unlikely(!ALLOC_RECORD(dest_helem, hashElemRecord, count.helem))) {
       *err_info = MEMORY_ERROR;
     } else {
+      dest_helem->hashcode = source_helem->hashcode;
       memcpy(&dest_helem->key.descriptor, &source_helem->key.descriptor,
              sizeof(descriptorUnion));
       INIT_CATEGORY_OF_VAR(&dest_helem->key, DECLAREDOBJECT);
@@ -220,7 +343,11 @@ static hashType create_hash (hashType source_hash,
 
   /* create_hash */
     table_size = source_hash->table_size;
-    if (unlikely(!ALLOC_HASH(dest_hash, table_size))) {
+    if (unlikely(!ALLOC_HASH(dest_hash))) {
+      *err_info = MEMORY_ERROR;
+    } else if (unlikely(!ALLOC_HASH_TABLE(dest_hash->table, table_size))) {
+      FREE_HASH(dest_hash);
+      dest_hash = NULL;
       *err_info = MEMORY_ERROR;
     } else {
       dest_hash->bits = source_hash->bits;
@@ -458,17 +585,16 @@ static void for_hash (objectType for_variable, hashType curr_hash,
 
   {
     unsigned int number;
-    hashElemType_const *table_elem;
 
   /* for_hash */
-    number = curr_hash->table_size;
-    table_elem = curr_hash->table;
-    while (number != 0) {
-      if (*table_elem != NULL) {
-        for_helem(for_variable, *table_elem, statement, data_copy_func);
+    /* The table is accessed via curr_hash in every step, since */
+    /* the statement might add elements and grow the table.     */
+    number = 0;
+    while (number < curr_hash->table_size) {
+      if (curr_hash->table[number] != NULL) {
+        for_helem(for_variable, curr_hash->table[number], statement, data_copy_func);
       } /* if */
-      number--;
-      table_elem++;
+      number++;
     } /* while */
   } /* for_hash */
 
@@ -495,17 +621,14 @@ static void for_key_hash (objectType key_variable, hashType curr_hash,
 
   {
     unsigned int number;
-    hashElemType_const *table_elem;
 
   /* for_key_hash */
-    number = curr_hash->table_size;
-    table_elem = curr_hash->table;
-    while (number != 0) {
-      if (*table_elem != NULL) {
-        for_key_helem(key_variable, *table_elem, statement, key_copy_func);
+    number = 0;
+    while (number < curr_hash->table_size) {
+      if (curr_hash->table[number] != NULL) {
+        for_key_helem(key_variable, curr_hash->table[number], statement, key_copy_func);
       } /* if */
-      number--;
-      table_elem++;
+      number++;
     } /* while */
   } /* for_key_hash */
 
@@ -537,18 +660,15 @@ static void for_data_key_hash (objectType for_variable, objectType key_variable,
 
   {
     unsigned int number;
-    hashElemType_const *table_elem;
 
   /* for_data_key_hash */
-    number = curr_hash->table_size;
-    table_elem = curr_hash->table;
-    while (number != 0) {
-      if (*table_elem != NULL) {
-        for_data_key_helem(for_variable, key_variable, *table_elem, statement,
+    number = 0;
+    while (number < curr_hash->table_size) {
+      if (curr_hash->table[number] != NULL) {
+        for_data_key_helem(for_variable, key_variable, curr_hash->table[number], statement,
             data_copy_func, key_copy_func);
       } /* if */
-      number--;
-      table_elem++;
+      number++;
     } /* while */
   } /* for_data_key_hash */
 
@@ -839,7 +959,7 @@ objectType hsh_empty (listType arguments)
     hashType result;
 
   /* hsh_empty */
-    result = new_hash(TABLE_BITS);
+    result = new_hash(INITIAL_TABLE_BITS);
     if (unlikely(result == NULL)) {
       return raise_exception(SYS_MEM_EXCEPTION);
     } else {
@@ -1055,7 +1175,7 @@ objectType hsh_gen_hash (listType arguments)
       logError(printf("hsh_gen_hash: The keyValuePairs must be temporary.\n"););
       return raise_exception(SYS_ACT_ILLEGAL_EXCEPTION);
     } /* if */
-    aHashMap = new_hash(TABLE_BITS);
+    aHashMap = new_hash(INITIAL_TABLE_BITS);
     if (unlikely(aHashMap == NULL)) {
       return raise_exception(SYS_MEM_EXCEPTION);
     } else {
@@ -1069,6 +1189,7 @@ objectType hsh_gen_hash (listType arguments)
         isit_int(hashCodeObj);
         hashCode = (unsigned int) take_int(hashCodeObj);
         FREE_OBJECT(hashCodeObj);
+        currentKeyValue->hashcode = hashCode;
         hashElem = aHashMap->table[hashCode & aHashMap->mask];
         if (hashElem == NULL) {
           aHashMap->table[hashCode & aHashMap->mask] = currentKeyValue;
@@ -1106,6 +1227,9 @@ objectType hsh_gen_hash (listType arguments)
             } /* if */
           } while (hashElem != NULL);
         } /* if */
+        if (TABLE_NEEDS_TO_GROW(aHashMap)) {
+          grow_hash(aHashMap);
+        } /* if */
       } /* while */
       logFunction(printf("hsh_gen_hash -->\n"););
       if (unlikely(err_info != OKAY_NO_ERROR)) {
@@ -1149,6 +1273,7 @@ objectType hsh_gen_key_value (listType arguments)
     } else {
       keyValue->next_less = NULL;
       keyValue->next_greater = NULL;
+      keyValue->hashcode = 0;
       if (TEMP_OBJECT(aKey)) {
         CLEAR_TEMP_FLAG(aKey);
         SET_VAR_FLAG(aKey);
@@ -1429,7 +1554,7 @@ objectType hsh_incl (listType arguments)
                        (memSizeType) data_create_func, (memSizeType) data_copy_func););
     hashelem = aHashMap->table[(unsigned int) hashcode & aHashMap->mask];
     if (hashelem == NULL) {
-      aHashMap->table[(unsigned int) hashcode & aHashMap->mask] = new_helem(aKey, data,
+      aHashMap->table[(unsigned int) hashcode & aHashMap->mask] = new_helem(aKey, data, hashcode,
           key_create_func, data_create_func, &err_info);
       aHashMap->size++;
     } else if (unlikely(cmp_func == NULL)) {
@@ -1444,7 +1569,7 @@ objectType hsh_incl (listType arguments)
         FREE_OBJECT(cmp_obj);
         if (cmp < 0) {
           if (hashelem->next_less == NULL) {
-            hashelem->next_less = new_helem(aKey, data,
+            hashelem->next_less = new_helem(aKey, data, hashcode,
                 key_create_func, data_create_func, &err_info);
             aHashMap->size++;
             hashelem = NULL;
@@ -1456,7 +1581,7 @@ objectType hsh_incl (listType arguments)
           hashelem = NULL;
         } else {
           if (hashelem->next_greater == NULL) {
-            hashelem->next_greater = new_helem(aKey, data,
+            hashelem->next_greater = new_helem(aKey, data, hashcode,
                 key_create_func, data_create_func, &err_info);
             aHashMap->size++;
             hashelem = NULL;
@@ -1471,6 +1596,9 @@ objectType hsh_incl (listType arguments)
       return raise_with_obj_and_args(SYS_MEM_EXCEPTION,
                                      hash_exec_object, arguments);
     } else {
+      if (TABLE_NEEDS_TO_GROW(aHashMap)) {
+        grow_hash(aHashMap);
+      } /* if */
       return SYS_EMPTY_OBJECT;
     } /* if */
   } /* hsh_incl */
@@ -1628,7 +1756,7 @@ objectType hsh_update (listType arguments)
                        (memSizeType) data_create_func););
     hashelem = aHashMap->table[(unsigned int) hashcode & aHashMap->mask];
     if (hashelem == NULL) {
-      aHashMap->table[(unsigned int) hashcode & aHashMap->mask] = new_helem(aKey, data,
+      aHashMap->table[(unsigned int) hashcode & aHashMap->mask] = new_helem(aKey, data, hashcode,
           key_create_func, data_create_func, &err_info);
       aHashMap->size++;
     } else if (unlikely(cmp_func == NULL)) {
@@ -1643,7 +1771,7 @@ objectType hsh_update (listType arguments)
         FREE_OBJECT(cmp_obj);
         if (cmp < 0) {
           if (hashelem->next_less == NULL) {
-            hashelem->next_less = new_helem(aKey, data,
+            hashelem->next_less = new_helem(aKey, data, hashcode,
                 key_create_func, data_create_func, &err_info);
             aHashMap->size++;
             hashelem = NULL;
@@ -1657,7 +1785,7 @@ objectType hsh_update (listType arguments)
           hashelem = NULL;
         } else {
           if (hashelem->next_greater == NULL) {
-            hashelem->next_greater = new_helem(aKey, data,
+            hashelem->next_greater = new_helem(aKey, data, hashcode,
                 key_create_func, data_create_func, &err_info);
             aHashMap->size++;
             hashelem = NULL;
@@ -1671,6 +1799,8 @@ objectType hsh_update (listType arguments)
       aHashMap->size--;
       return raise_with_obj_and_args(SYS_MEM_EXCEPTION,
                                      hash_exec_object, arguments);
+    } else if (TABLE_NEEDS_TO_GROW(aHashMap)) {
+      grow_hash(aHashMap);
     } /* if */
     /* printf("hsh_update -> ");
     trace1(data);
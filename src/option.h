@@ -1,7 +1,7 @@
 /********************************************************************/
 /*                                                                  */
 /*  s7   Seed7 interpreter                                          */
-/*  Copyright (C) 1990 - 2000, 2015  Thomas Mertes                  */
+/*  Copyright (C) 1990 - 2000, 2015, 2026  Thomas Mertes            */
 /*                                                                  */
 /*  This program is free software; you can redistribute it and/or   */
 /*  modify it under the terms of the GNU General Public License as  */
@@ -20,7 +20,7 @@
 /*                                                                  */
 /*  Module: Main                                                    */
 /*  File: seed7/src/option.h                                        */
-/*  Changes: 1994, 2015  Thomas Mertes                              */
+/*  Changes: 1994, 2015, 2026  Thomas Mertes                        */
 /*  Content: Reads and interprets the command line options.         */
 /*                                                                  */
 /********************************************************************/
@@ -38,10 +38,12 @@
 #define WRITE_LINE_NUMBERS    1024
 #define SHOW_IDENT_TABLE      2048
 #define SHOW_STATISTICS       4096
+#define EXEC_BYTECODE         8192
 
 typedef struct optionStruct {
     striType          sourceFileArgument;
     const_striType    protFileName;
+    const_striType    profileName;
     boolType          writeHelp;
     boolType          analyzeOnly;
     boolType          executeAlways;
@@ -0,0 +1,1087 @@
+/********************************************************************/
+/*                                                                  */
+/*  pol_epoll.c   Poll type and function using Linux epoll.         */
+/*  Copyright (C) 2026  Thomas Mertes                               */
+/*                                                                  */
+/*  This file is part of the Seed7 Runtime Library.                 */
+/*                                                                  */
+/*  The Seed7 Runtime Library is free software; you can             */
+/*  redistribute it and/or modify it under the terms of the GNU     */
+/*  Lesser General Public License as published by the Free Software */
+/*  Foundation; either version 2.1 of the License, or (at your      */
+/*  option) any later version.                                      */
+/*                                                                  */
+/*  The Seed7 Runtime Library is distributed in the hope that it    */
+/*  will be useful, but WITHOUT ANY WARRANTY; without even the      */
+/*  implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR */
+/*  PURPOSE.  See the GNU Lesser General Public License for more    */
+/*  details.                                                        */
+/*                                                                  */
+/*  You should have received a copy of the GNU Lesser General       */
+/*  Public License along with this program; if not, write to the    */
+/*  Free Software Foundation, Inc., 51 Franklin Street,             */
+/*  Fifth Floor, Boston, MA  02110-1301, USA.                       */
+/*                                                                  */
+/*  Module: Seed7 Runtime Library                                   */
+/*  File: seed7/src/pol_epoll.c                                     */
+/*  Changes: 2026  Thomas Mertes                                    */
+/*  Content: Poll type and function using Linux epoll.              */
+/*                                                                  */
+/********************************************************************/
+
+#define LOG_FUNCTIONS 0
+#define VERBOSE_EXCEPTIONS 0
+
+#include "version.h"
+
+#if defined POLL_WITH_EPOLL && HAS_EPOLL
+#include "stdlib.h"
+#include "stdio.h"
+#include "string.h"
+#include "sys/epoll.h"
+#include "errno.h"
+
+#if UNISTD_H_PRESENT
+#include "unistd.h"
+#endif
+
+#include "common.h"
+#include "os_decls.h"
+#include "data_rtl.h"
+#include "heaputl.h"
+#include "hsh_rtl.h"
+#include "soc_rtl.h"
+#include "rtl_err.h"
+
+#undef EXTERN
+#define EXTERN
+#define DO_INIT
+#include "pol_drv.h"
+
+
+typedef enum {
+    ITER_EMPTY,
+    ITER_CHECKS_IN, ITER_CHECKS_OUT, ITER_CHECKS_INOUT,
+    ITER_FINDINGS_IN, ITER_FINDINGS_OUT, ITER_FINDINGS_INOUT
+  } iteratorType;
+
+typedef struct {
+    socketNumberType fd;
+    uint32Type checkedEvents;
+    uint32Type eventFindings;
+    rtlValueUnion file;
+  } checkRecord, *checkType;
+
+typedef const checkRecord *const_checkType;
+
+/**
+ *  The checks are stored in a dense array. The 'indexHash' maps
+ *  a socket number to its position in 'checks'. After epoll_wait()
+ *  the sockets with eventFindings are listed in 'findings'. This
+ *  way the iteration over the eventFindings does not need to look
+ *  at sockets without findings.
+ */
+typedef struct {
+    int epollFd;
+    memSizeType size;
+    memSizeType capacity;
+    iteratorType iteratorMode;
+    memSizeType iterPos;
+    checkType checks;
+    rtlHashType indexHash;
+    memSizeType numOfFindings;
+    socketNumberType *findings;
+    struct epoll_event *events;
+    memSizeType bufferedCapacity;
+    socketNumberType *buffered;
+  } epoll_based_pollRecord, *epoll_based_pollType;
+
+typedef const epoll_based_pollRecord *const_epoll_based_pollType;
+
+#if DO_HEAP_STATISTIC
+size_t sizeof_pollRecord = sizeof(epoll_based_pollRecord);
+#endif
+
+#define conv(genericPollData) ((const_epoll_based_pollType) (genericPollData))
+#define var_conv(genericPollData) ((epoll_based_pollType) (genericPollData))
+
+
+#define TABLE_START_SIZE    256
+#define TABLE_INCREMENT    1024
+
+/**
+ *  With edge triggered mode epoll_wait() reports a socket only
+ *  when new data arrives. A program must read or write until the
+ *  operation would block, before it polls again.
+ */
+#ifndef EPOLL_EDGE_TRIGGERED
+#define EPOLL_EDGE_TRIGGERED 0
+#endif
+
+#if EPOLL_EDGE_TRIGGERED
+#define EPOLL_MODE_FLAGS EPOLLET
+#else
+#define EPOLL_MODE_FLAGS 0
+#endif
+
+
+
+void initPollOperations (const createFuncType incrUsageCount,
+    const destrFuncType decrUsageCount)
+
+  { /* initPollOperations */
+    fileObjectOps.incrUsageCount = incrUsageCount;
+    fileObjectOps.decrUsageCount = decrUsageCount;
+  } /* initPollOperations */
+
+
+
+static inline memSizeType checkPos (const const_epoll_based_pollType pollData,
+    const socketNumberType aSocket)
+
+  { /* checkPos */
+    return (memSizeType) hshIdxWithDefaultGeneric(pollData->indexHash,
+        (genericType) (usocketType) aSocket,
+        (genericType) pollData->size, (intType) aSocket);
+  } /* checkPos */
+
+
+
+static int epollControl (const int epollFd, int operation,
+    const socketNumberType aSocket, uint32Type events)
+
+  {
+    struct epoll_event event;
+    int result;
+
+  /* epollControl */
+    memset(&event, 0, sizeof(struct epoll_event));
+    event.events = events | EPOLL_MODE_FLAGS;
+    event.data.fd = (int) aSocket;
+    result = epoll_ctl(epollFd, operation, (int) aSocket, &event);
+    if (result != 0 && errno == ENOENT && operation == EPOLL_CTL_MOD) {
+      /* The socket has been closed and its number has been reused. */
+      result = epoll_ctl(epollFd, EPOLL_CTL_ADD, (int) aSocket, &event);
+    } /* if */
+    return result;
+  } /* epollControl */
+
+
+
+static boolType growTables (const epoll_based_pollType pollData)
+
+  {
+    memSizeType newCapacity;
+    checkType resizedChecks;
+    socketNumberType *resizedFindings;
+    struct epoll_event *resizedEvents;
+
+  /* growTables */
+    newCapacity = pollData->capacity + TABLE_INCREMENT;
+    resizedChecks = REALLOC_TABLE(pollData->checks, checkRecord,
+                                  pollData->capacity, newCapacity);
+    if (resizedChecks == NULL) {
+      return FALSE;
+    } /* if */
+    pollData->checks = resizedChecks;
+    COUNT3_TABLE(checkRecord, pollData->capacity, newCapacity);
+    resizedFindings = REALLOC_TABLE(pollData->findings, socketNumberType,
+                                    pollData->capacity, newCapacity);
+    if (resizedFindings == NULL) {
+      return FALSE;
+    } /* if */
+    pollData->findings = resizedFindings;
+    COUNT3_TABLE(socketNumberType, pollData->capacity, newCapacity);
+    resizedEvents = REALLOC_TABLE(pollData->events, struct epoll_event,
+                                  pollData->capacity, newCapacity);
+    if (resizedEvents == NULL) {
+      return FALSE;
+    } /* if */
+    pollData->events = resizedEvents;
+    COUNT3_TABLE(struct epoll_event, pollData->capacity, newCapacity);
+    /* The capacity is only increased if all tables have been resized. */
+    pollData->capacity = newCapacity;
+    return TRUE;
+  } /* growTables */
+
+
+
+static void addCheck (const epoll_based_pollType pollData, uint32Type eventsToCheck,
+    const socketNumberType aSocket, const rtlValueUnion fileObj)
+
+  {
+    memSizeType pos;
+    checkType aCheck;
+
+  /* addCheck */
+    pos = checkPos(pollData, aSocket);
+    if (pos == pollData->size) {
+      if (pollData->size >= pollData->capacity && !growTables(pollData)) {
+        raise_error(MEMORY_ERROR);
+      } else if (unlikely(epollControl(pollData->epollFd, EPOLL_CTL_ADD,
+                                       aSocket, eventsToCheck) != 0)) {
+        logError(printf("addCheck: epoll_ctl(%d, EPOLL_CTL_ADD, %d, *) failed:\n"
+                        "%s=%d\nerror: %s\n",
+                        pollData->epollFd, aSocket, ERROR_INFORMATION););
+        raise_error(FILE_ERROR);
+      } else {
+        hshIdxEnterGeneric(pollData->indexHash,
+            (genericType) (usocketType) aSocket, (genericType) pos,
+            (intType) aSocket);
+        aCheck = &pollData->checks[pos];
+        aCheck->fd = aSocket;
+        aCheck->checkedEvents = eventsToCheck;
+        aCheck->eventFindings = 0;
+        logMessage(printf("addCheck: incrUsageCount(" FMT_U_GEN ")\n",
+                           fileObj.genericValue););
+        aCheck->file = fileObjectOps.incrUsageCount(fileObj);
+        pollData->size++;
+      } /* if */
+    } else {
+      aCheck = &pollData->checks[pos];
+      if ((aCheck->checkedEvents | eventsToCheck) != aCheck->checkedEvents) {
+        if (unlikely(epollControl(pollData->epollFd, EPOLL_CTL_MOD, aSocket,
+                                  aCheck->checkedEvents | eventsToCheck) != 0)) {
+          logError(printf("addCheck: epoll_ctl(%d, EPOLL_CTL_MOD, %d, *) failed:\n"
+                          "%s=%d\nerror: %s\n",
+                          pollData->epollFd, aSocket, ERROR_INFORMATION););
+          raise_error(FILE_ERROR);
+        } else {
+          aCheck->checkedEvents |= eventsToCheck;
+        } /* if */
+      } /* if */
+    } /* if */
+  } /* addCheck */
+
+
+
+static void moveCheck (const epoll_based_pollType pollData, memSizeType destPos,
+    memSizeType sourcePos)
+
+  { /* moveCheck */
+    memcpy(&pollData->checks[destPos], &pollData->checks[sourcePos],
+           sizeof(checkRecord));
+    hshSetGeneric(pollData->indexHash,
+                  (genericType) (usocketType) pollData->checks[destPos].fd,
+                  (intType) pollData->checks[destPos].fd,
+                  (genericType) destPos);
+  } /* moveCheck */
+
+
+
+static void removeCheck (const epoll_based_pollType pollData, uint32Type eventsToCheck,
+    const socketNumberType aSocket)
+
+  {
+    memSizeType pos;
+    checkType aCheck;
+
+  /* removeCheck */
+    pos = checkPos(pollData, aSocket);
+    if (pos != pollData->size) {
+      aCheck = &pollData->checks[pos];
+      aCheck->checkedEvents &= ~eventsToCheck;
+      aCheck->eventFindings &= ~eventsToCheck;
+      if (aCheck->checkedEvents != 0) {
+        if (unlikely(epollControl(pollData->epollFd, EPOLL_CTL_MOD, aSocket,
+                                  aCheck->checkedEvents) != 0)) {
+          logError(printf("removeCheck: epoll_ctl(%d, EPOLL_CTL_MOD, %d, *) failed:\n"
+                          "%s=%d\nerror: %s\n",
+                          pollData->epollFd, aSocket, ERROR_INFORMATION););
+          raise_error(FILE_ERROR);
+        } /* if */
+      } else {
+        /* A closed socket is already removed from the epoll set. */
+        epoll_ctl(pollData->epollFd, EPOLL_CTL_DEL, (int) aSocket, NULL);
+        logMessage(printf("removeCheck: decrUsageCount(" FMT_U_GEN ")\n",
+                           aCheck->file.genericValue););
+        fileObjectOps.decrUsageCount(aCheck->file);
+        if (pollData->iteratorMode >= ITER_CHECKS_IN &&
+            pollData->iteratorMode <= ITER_CHECKS_INOUT &&
+            pos + 1 <= pollData->iterPos) {
+          /* Keep the checks that have not been iterated yet. */
+          pollData->iterPos--;
+          if (pos < pollData->iterPos) {
+            moveCheck(pollData, pos, pollData->iterPos);
+            pos = pollData->iterPos;
+          } /* if */
+        } /* if */
+        pollData->size--;
+        if (pos < pollData->size) {
+          moveCheck(pollData, pos, pollData->size);
+        } /* if */
+        hshExclGeneric(pollData->indexHash,
+                       (genericType) (usocketType) aSocket,
+                       (intType) aSocket);
+      } /* if */
+    } /* if */
+  } /* removeCheck */
+
+
+
+static void addFinding (const epoll_based_pollType pollData,
+    const socketNumberType aSocket, uint32Type events)
+
+  {
+    memSizeType pos;
+    checkType aCheck;
+
+  /* addFinding */
+    pos = checkPos(pollData, aSocket);
+    if (pos != pollData->size) {
+      aCheck = &pollData->checks[pos];
+      if ((events & (EPOLLERR | EPOLLHUP)) != 0) {
+        /* The next read or write reports the error or EOF. */
+        events |= aCheck->checkedEvents;
+      } /* if */
+      events &= aCheck->checkedEvents;
+      if (events != 0) {
+        if (aCheck->eventFindings == 0) {
+          pollData->findings[pollData->numOfFindings] = aSocket;
+          pollData->numOfFindings++;
+        } /* if */
+        aCheck->eventFindings |= events;
+      } /* if */
+    } /* if */
+  } /* addFinding */
+
+
+
+static void clearFindings (const epoll_based_pollType pollData)
+
+  {
+    memSizeType index;
+    memSizeType pos;
+
+  /* clearFindings */
+    for (index = 0; index < pollData->numOfFindings; index++) {
+      pos = checkPos(pollData, pollData->findings[index]);
+      if (pos != pollData->size) {
+        pollData->checks[pos].eventFindings = 0;
+      } /* if */
+    } /* for */
+    pollData->numOfFindings = 0;
+  } /* clearFindings */
+
+
+
+/**
+ *  Determine the sockets whose read buffer contains unconsumed bytes.
+ *  @return the number of such sockets (stored in pollData->buffered).
+ */
+static memSizeType getBufferedSockets (const epoll_based_pollType pollData)
+
+  {
+    memSizeType numBuffered;
+    socketNumberType *resizedBuffered;
+
+  /* getBufferedSockets */
+    numBuffered = socBufferedInputSockets(pollData->buffered,
+                                          pollData->bufferedCapacity);
+    if (numBuffered > pollData->bufferedCapacity) {
+      resizedBuffered = REALLOC_TABLE(pollData->buffered, socketNumberType,
+                                      pollData->bufferedCapacity, numBuffered);
+      if (unlikely(resizedBuffered == NULL)) {
+        numBuffered = pollData->bufferedCapacity;
+      } else {
+        COUNT3_TABLE(socketNumberType, pollData->bufferedCapacity, numBuffered);
+        pollData->buffered = resizedBuffered;
+        pollData->bufferedCapacity = numBuffered;
+        numBuffered = socBufferedInputSockets(pollData->buffered,
+                                              pollData->bufferedCapacity);
+      } /* if */
+    } /* if */
+    return numBuffered;
+  } /* getBufferedSockets */
+
+
+
+static boolType hasNextCheck (const epoll_based_pollType pollData,
+    uint32Type eventsToCheck)
+
+  {
+    memSizeType pos;
+    boolType hasNext;
+
+  /* hasNextCheck */
+    pos = pollData->iterPos;
+    while (pos < pollData->size &&
+           (pollData->checks[pos].checkedEvents & eventsToCheck) == 0) {
+      pos++;
+    } /* while */
+    hasNext = pos < pollData->size;
+    pollData->iterPos = pos;
+    return hasNext;
+  } /* hasNextCheck */
+
+
+
+static boolType hasNextFinding (const epoll_based_pollType pollData,
+    uint32Type eventsToCheck)
+
+  {
+    memSizeType index;
+    memSizeType pos;
+    boolType hasNext = FALSE;
+
+  /* hasNextFinding */
+    index = pollData->iterPos;
+    while (index < pollData->numOfFindings && !hasNext) {
+      pos = checkPos(pollData, pollData->findings[index]);
+      if (pos != pollData->size &&
+          (pollData->checks[pos].eventFindings & eventsToCheck) != 0) {
+        hasNext = TRUE;
+      } else {
+        index++;
+      } /* if */
+    } /* while */
+    pollData->iterPos = index;
+    return hasNext;
+  } /* hasNextFinding */
+
+
+
+static rtlValueUnion nextCheck (const epoll_based_pollType pollData,
+    uint32Type eventsToCheck, const rtlValueUnion nullFile)
+
+  {
+    rtlValueUnion checkFile;
+
+  /* nextCheck */
+    if (hasNextCheck(pollData, eventsToCheck)) {
+      checkFile = pollData->checks[pollData->iterPos].file;
+      pollData->iterPos++;
+    } else {
+      checkFile = nullFile;
+    } /* if */
+    logFunction(printf("nextCheck -> " FMT_U_GEN "\n",
+                       checkFile.genericValue););
+    return checkFile;
+  } /* nextCheck */
+
+
+
+static rtlValueUnion nextFinding (const epoll_based_pollType pollData,
+    uint32Type eventsToCheck, const rtlValueUnion nullFile)
+
+  {
+    rtlValueUnion resultFile;
+
+  /* nextFinding */
+    if (hasNextFinding(pollData, eventsToCheck)) {
+      resultFile = pollData->checks[checkPos(pollData,
+          pollData->findings[pollData->iterPos])].file;
+      pollData->iterPos++;
+    } else {
+      resultFile = nullFile;
+    } /* if */
+    logFunction(printf("nextFinding -> " FMT_U_GEN "\n",
+                       resultFile.genericValue););
+    return resultFile;
+  } /* nextFinding */
+
+
+
+static intType eventsToPollMode (uint32Type events)
+
+  {
+    intType pollMode;
+
+  /* eventsToPollMode */
+    if ((events & EPOLLIN) != 0) {
+      if ((events & EPOLLOUT) != 0) {
+        pollMode = POLL_INOUT;
+      } else {
+        pollMode = POLL_IN;
+      } /* if */
+    } else if ((events & EPOLLOUT) != 0) {
+      pollMode = POLL_OUT;
+    } else {
+      pollMode = POLL_NOTHING;
+    } /* if */
+    return pollMode;
+  } /* eventsToPollMode */
+
+
+
+/**
+ *  Add 'eventsToCheck' for 'aSocket' to 'pollData'.
+ *  'EventsToCheck' can have one of the following values:
+ *  - POLLIN check if data can be read from the corresponding socket.
+ *  - POLLOUT check if data can be written to the corresponding socket.
+ *  - POLLINOUT check if data can be read or written (POLLIN or POLLOUT).
+ *
+ *  @param pollData Poll data to which the event checks are added.
+ *  @param aSocket Socket for which the events should be checked.
+ *  @param eventsToCheck Events to be added to the checkedEvents
+ *         field of 'pollData'.
+ *  @param fileObj File to be returned, if the iterator returns
+ *         files in 'pollData'.
+ *  @exception RANGE_ERROR Illegal value for 'eventsToCheck'.
+ *  @exception MEMORY_ERROR An out of memory situation occurred.
+ *  @exception FILE_ERROR The system function returns an error.
+ */
+void polAddCheck (const pollType pollData, const socketType aSocket,
+    intType eventsToCheck, const rtlValueUnion fileObj)
+
+  { /* polAddCheck */
+    logFunction(printf("polAddCheck(" FMT_U_MEM ", %d, " FMT_X ", "
+                       FMT_U_GEN ")\n",
+                       (memSizeType) pollData,
+                       aSocket != NULL ? aSocket->socketNumber : 0,
+                       eventsToCheck, fileObj.genericValue););
+    if (unlikely(aSocket->socketNumber == EMPTY_SOCKET)) {
+      logError(printf("polAddCheck(" FMT_U_MEM ", %d, " FMT_X ", "
+                      FMT_U_GEN "): Attempt to use a closed socket.\n",
+                      (memSizeType) pollData, aSocket->socketNumber,
+                      eventsToCheck, fileObj.genericValue););
+      raise_error(FILE_ERROR);
+    } else {
+      switch (castIntTypeForSwitch(eventsToCheck)) {
+        case POLL_IN:
+          addCheck(var_conv(pollData), EPOLLIN,
+                   aSocket->socketNumber, fileObj);
+          break;
+        case POLL_OUT:
+          addCheck(var_conv(pollData), EPOLLOUT,
+                   aSocket->socketNumber, fileObj);
+          break;
+        case POLL_INOUT:
+          addCheck(var_conv(pollData), EPOLLIN | EPOLLOUT,
+                   aSocket->socketNumber, fileObj);
+          break;
+        default:
+          raise_error(RANGE_ERROR);
+          break;
+      } /* switch */
+    } /* if */
+  } /* polAddCheck */
+
+
+
+/**
+ *  Clears 'pollData'.
+ *  All sockets and all events are removed from 'pollData' and
+ *  the iterator is reset, such that polHasNext() returns FALSE.
+ */
+void polClear (const pollType pollData)
+
+  {
+    memSizeType pos;
+
+  /* polClear */
+    for (pos = 0; pos < conv(pollData)->size; pos++) {
+      epoll_ctl(conv(pollData)->epollFd, EPOLL_CTL_DEL,
+                (int) conv(pollData)->checks[pos].fd, NULL);
+      logMessage(printf("polClear: decrUsageCount(" FMT_U_GEN ")\n",
+                         conv(pollData)->checks[pos].file.genericValue););
+      fileObjectOps.decrUsageCount(conv(pollData)->checks[pos].file);
+    } /* for */
+    var_conv(pollData)->size = 0;
+    var_conv(pollData)->iteratorMode = ITER_EMPTY;
+    var_conv(pollData)->iterPos = 0;
+    var_conv(pollData)->numOfFindings = 0;
+    hshDestr(conv(pollData)->indexHash, (destrFuncType) &valueDestr,
+             (destrFuncType) &valueDestr);
+    var_conv(pollData)->indexHash = hshEmpty();
+  } /* polClear */
+
+
+
+/**
+ *  Assign source to dest.
+ *  A copy function assumes that dest contains a legal value.
+ *  @exception MEMORY_ERROR Not enough memory to create dest.
+ */
+void polCpy (const pollType dest, const const_pollType source)
+
+  {
+    memSizeType pos;
+    memSizeType index;
+    memSizeType destPos;
+    const_checkType sourceCheck;
+
+  /* polCpy */
+    logFunction(printf("polCpy(" FMT_U_MEM ", " FMT_U_MEM ")\n",
+                       (memSizeType) dest, (memSizeType) source););
+    if (dest != source) {
+      polClear(dest);
+      for (pos = 0; pos < conv(source)->size; pos++) {
+        sourceCheck = &conv(source)->checks[pos];
+        addCheck(var_conv(dest), sourceCheck->checkedEvents,
+                 sourceCheck->fd, sourceCheck->file);
+      } /* for */
+      if (conv(dest)->size == conv(source)->size) {
+        for (index = 0; index < conv(source)->numOfFindings; index++) {
+          pos = checkPos(conv(source), conv(source)->findings[index]);
+          if (pos != conv(source)->size) {
+            destPos = checkPos(conv(dest), conv(source)->findings[index]);
+            var_conv(dest)->checks[destPos].eventFindings =
+                conv(source)->checks[pos].eventFindings;
+          } /* if */
+          var_conv(dest)->findings[index] = conv(source)->findings[index];
+        } /* for */
+        var_conv(dest)->numOfFindings = conv(source)->numOfFindings;
+        var_conv(dest)->iteratorMode = conv(source)->iteratorMode;
+        var_conv(dest)->iterPos = conv(source)->iterPos;
+      } /* if */
+    } /* if */
+    logFunction(printf("polCpy -->\n"););
+  } /* polCpy */
+
+
+
+/**
+ *  Return a copy of source, that can be assigned to a new destination.
+ *  It is assumed that the destination of the assignment is undefined.
+ *  Create functions can be used to initialize Seed7 constants.
+ *  @return a copy of source.
+ *  @exception MEMORY_ERROR Not enough memory to represent the result.
+ */
+pollType polCreate (const const_pollType source)
+
+  {
+    pollType result;
+
+  /* polCreate */
+    logFunction(printf("polCreate(" FMT_U_MEM ")\n",
+                       (memSizeType) source););
+    result = polEmpty();
+    if (result != NULL) {
+      polCpy(result, source);
+    } /* if */
+    logFunction(printf("polCreate --> " FMT_U_MEM "\n",
+                       (memSizeType) result););
+    return result;
+  } /* polCreate */
+
+
+
+/**
+ *  Free the memory referred by 'oldPollData'.
+ *  After polDestr is left 'oldPollData' refers to not existing memory.
+ *  The memory where 'oldPollData' is stored can be freed afterwards.
+ */
+void polDestr (const pollType oldPollData)
+
+  {
+    memSizeType pos;
+
+  /* polDestr */
+    if (oldPollData != NULL) {
+      for (pos = 0; pos < conv(oldPollData)->size; pos++) {
+        logMessage(printf("polDestr: decrUsageCount(" FMT_U_GEN ")\n",
+                           conv(oldPollData)->checks[pos].file.genericValue););
+        fileObjectOps.decrUsageCount(conv(oldPollData)->checks[pos].file);
+      } /* for */
+      close(conv(oldPollData)->epollFd);
+      FREE_TABLE(conv(oldPollData)->checks, checkRecord,
+                 conv(oldPollData)->capacity);
+      FREE_TABLE(conv(oldPollData)->findings, socketNumberType,
+                 conv(oldPollData)->capacity);
+      FREE_TABLE(conv(oldPollData)->events, struct epoll_event,
+                 conv(oldPollData)->capacity);
+      if (conv(oldPollData)->buffered != NULL) {
+        FREE_TABLE(conv(oldPollData)->buffered, socketNumberType,
+                   conv(oldPollData)->bufferedCapacity);
+      } /* if */
+      hshDestr(conv(oldPollData)->indexHash, (destrFuncType) &valueDestr,
+               (destrFuncType) &valueDestr);
+      FREE_RECORD(var_conv(oldPollData), epoll_based_pollRecord, count.polldata);
+    } /* if */
+  } /* polDestr */
+
+
+
+/**
+ *  Create an empty poll data value.
+ *  @return an empty poll data value.
+ *  @exception MEMORY_ERROR Not enough memory for the result.
+ *  @exception FILE_ERROR The system function returns an error.
+ */
+pollType polEmpty (void)
+
+  {
+    epoll_based_pollType result;
+
+  /* polEmpty */
+    if (unlikely(!ALLOC_RECORD(result, epoll_based_pollRecord, count.polldata))) {
+      raise_error(MEMORY_ERROR);
+    } else {
+      memset(result, 0, sizeof(epoll_based_pollRecord));
+      if (unlikely(!ALLOC_TABLE(result->checks, checkRecord, TABLE_START_SIZE) ||
+                   !ALLOC_TABLE(result->findings, socketNumberType, TABLE_START_SIZE) ||
+                   !ALLOC_TABLE(result->events, struct epoll_event, TABLE_START_SIZE))) {
+        if (result->checks != NULL) {
+          FREE_TABLE(result->checks, checkRecord, TABLE_START_SIZE);
+        } /* if */
+        if (result->findings != NULL) {
+          FREE_TABLE(result->findings, socketNumberType, TABLE_START_SIZE);
+        } /* if */
+        FREE_RECORD(result, epoll_based_pollRecord, count.polldata);
+        raise_error(MEMORY_ERROR);
+        result = NULL;
+      } else {
+        result->epollFd = epoll_create1(EPOLL_CLOEXEC);
+        if (unlikely(result->epollFd == -1)) {
+          logError(printf("polEmpty: epoll_create1(EPOLL_CLOEXEC) failed:\n"
+                          "%s=%d\nerror: %s\n",
+                          ERROR_INFORMATION););
+          FREE_TABLE(result->checks, checkRecord, TABLE_START_SIZE);
+          FREE_TABLE(result->findings, socketNumberType, TABLE_START_SIZE);
+          FREE_TABLE(result->events, struct epoll_event, TABLE_START_SIZE);
+          FREE_RECORD(result, epoll_based_pollRecord, count.polldata);
+          raise_error(FILE_ERROR);
+          result = NULL;
+        } else {
+          result->indexHash = hshEmpty();
+          result->capacity = TABLE_START_SIZE;
+          result->iteratorMode = ITER_EMPTY;
+        } /* if */
+      } /* if */
+    } /* if */
+    logFunction(printf("polEmpty --> " FMT_U_MEM "\n",
+                       (memSizeType) result););
+    return (pollType) result;
+  } /* polEmpty */
+
+
+
+/**
+ *  Return the checkedEvents field from 'pollData' for 'aSocket'.
+ *  The polPoll function uses the checkedEvents as input.
+ *  The following checkedEvents can be returned:
+ *  - POLLNOTHING no data can be read or written.
+ *  - POLLIN data can be read from the corresponding socket.
+ *  - POLLOUT data can be written to the corresponding socket.
+ *  - POLLINOUT data can be read and written (POLLIN and POLLOUT).
+ *
+ *  @return POLLNOTHING, POLLIN, POLLOUT or POLLINOUT, depending on
+ *          the events added and removed for 'aSocket' with
+ *          'addCheck' and 'removeCheck'.
+ */
+intType polGetCheck (const const_pollType pollData, const socketType aSocket)
+
+  {
+    memSizeType pos;
+    intType result;
+
+  /* polGetCheck */
+    logFunction(printf("polGetCheck(" FMT_U_MEM ", %d)\n",
+                       (memSizeType) pollData,
+                       aSocket != NULL ?
+                           aSocket->socketNumber : 0););
+    if (unlikely(aSocket->socketNumber == EMPTY_SOCKET)) {
+      logError(printf("polGetCheck(" FMT_U_MEM ", %d)\n",
+                       (memSizeType) pollData,
+                       aSocket->socketNumber););
+      raise_error(FILE_ERROR);
+      result = 0;
+    } else {
+      pos = checkPos(conv(pollData), aSocket->socketNumber);
+      if (pos == conv(pollData)->size) {
+        result = POLL_NOTHING;
+      } else {
+        result = eventsToPollMode(conv(pollData)->checks[pos].checkedEvents);
+      } /* if */
+    } /* if */
+    return result;
+  } /* polGetCheck */
+
+
+
+/**
+ *  Return the eventFindings field from 'pollData' for 'aSocket'.
+ *  The polPoll function assigns the
+ *  eventFindings for 'aSocket' to 'pollData'. The following
+ *  eventFindings can be returned:
+ *  - POLLNOTHING no data can be read or written.
+ *  - POLLIN data can be read from the corresponding socket.
+ *  - POLLOUT data can be written to the corresponding socket.
+ *  - POLLINOUT data can be read and written (POLLIN and POLLOUT).
+ *
+ *  @return POLLNOTHING, POLLIN, POLLOUT or POLLINOUT, depending on
+ *          the findings of polPoll concerning 'aSocket'.
+ */
+intType polGetFinding (const const_pollType pollData, const socketType aSocket)
+
+  {
+    memSizeType pos;
+    intType result;
+
+  /* polGetFinding */
+    logFunction(printf("polGetFinding(" FMT_U_MEM ", %d)\n",
+                       (memSizeType) pollData,
+                       aSocket != NULL ?
+                           aSocket->socketNumber : 0););
+    if (unlikely(aSocket->socketNumber == EMPTY_SOCKET)) {
+      logError(printf("polGetFinding(" FMT_U_MEM ", %d)\n",
+                       (memSizeType) pollData,
+                       aSocket->socketNumber););
+      raise_error(FILE_ERROR);
+      result = 0;
+    } else {
+      pos = checkPos(conv(pollData), aSocket->socketNumber);
+      if (pos == conv(pollData)->size) {
+        result = POLL_NOTHING;
+      } else {
+        result = eventsToPollMode(conv(pollData)->checks[pos].eventFindings);
+      } /* if */
+    } /* if */
+    return result;
+  } /* polGetFinding */
+
+
+
+/**
+ *  Determine if the 'pollData' iterator can deliver another file.
+ *  @return TRUE if 'nextFile' would return another file from the
+ *          'pollData' iterator, FALSE otherwise.
+ */
+boolType polHasNext (const pollType pollData)
+
+  { /* polHasNext */
+    switch (conv(pollData)->iteratorMode) {
+      case ITER_CHECKS_IN:
+        return hasNextCheck(var_conv(pollData), EPOLLIN);
+      case ITER_CHECKS_OUT:
+        return hasNextCheck(var_conv(pollData), EPOLLOUT);
+      case ITER_CHECKS_INOUT:
+        return hasNextCheck(var_conv(pollData), EPOLLIN | EPOLLOUT);
+      case ITER_FINDINGS_IN:
+        return hasNextFinding(var_conv(pollData), EPOLLIN);
+      case ITER_FINDINGS_OUT:
+        return hasNextFinding(var_conv(pollData), EPOLLOUT);
+      case ITER_FINDINGS_INOUT:
+        return hasNextFinding(var_conv(pollData), EPOLLIN | EPOLLOUT);
+      case ITER_EMPTY:
+      default:
+        return FALSE;
+    } /* switch */
+  } /* polHasNext */
+
+
+
+/**
+ *  Reset the 'pollData' iterator to process checkedEvents.
+ *  The following calls of 'hasNext' and 'nextFile' refer to
+ *  the checkedEvents of the given 'pollMode'. 'PollMode'
+ *  can have one of the following values:
+ *  - POLLNOTHING don't iterate ('hasNext' returns FALSE).
+ *  - POLLIN data can be read from the corresponding socket.
+ *  - POLLOUT data can be written to the corresponding socket.
+ *  - POLLINOUT data can be read or written (POLLIN and POLLOUT).
+ *
+ *  @exception RANGE_ERROR Illegal value for 'pollMode'.
+ */
+void polIterChecks (const pollType pollData, intType pollMode)
+
+  { /* polIterChecks */
+    switch (castIntTypeForSwitch(pollMode)) {
+      case POLL_NOTHING:
+        var_conv(pollData)->iteratorMode = ITER_EMPTY;
+        break;
+      case POLL_IN:
+        var_conv(pollData)->iteratorMode = ITER_CHECKS_IN;
+        break;
+      case POLL_OUT:
+        var_conv(pollData)->iteratorMode = ITER_CHECKS_OUT;
+        break;
+      case POLL_INOUT:
+        var_conv(pollData)->iteratorMode = ITER_CHECKS_INOUT;
+        break;
+      default:
+        raise_error(RANGE_ERROR);
+        break;
+    } /* switch */
+    var_conv(pollData)->iterPos = 0;
+  } /* polIterChecks */
+
+
+
+/**
+ *  Reset the 'pollData' iterator to process eventFindings.
+ *  The following calls of 'hasNext' and 'nextFile' refer to
+ *  the eventFindings of the given 'pollMode'. 'PollMode'
+ *  can have one of the following values:
+ *  - POLLNOTHING don't iterate ('hasNext' returns FALSE).
+ *  - POLLIN data can be read from the corresponding socket.
+ *  - POLLOUT data can be written to the corresponding socket.
+ *  - POLLINOUT data can be read or written (POLLIN and POLLOUT).
+ *
+ *  @exception RANGE_ERROR Illegal value for 'pollMode'.
+ */
+void polIterFindings (const pollType pollData, intType pollMode)
+
+  { /* polIterFindings */
+    switch (castIntTypeForSwitch(pollMode)) {
+      case POLL_NOTHING:
+        var_conv(pollData)->iteratorMode = ITER_EMPTY;
+        break;
+      case POLL_IN:
+        var_conv(pollData)->iteratorMode = ITER_FINDINGS_IN;
+        break;
+      case POLL_OUT:
+        var_conv(pollData)->iteratorMode = ITER_FINDINGS_OUT;
+        break;
+      case POLL_INOUT:
+        var_conv(pollData)->iteratorMode = ITER_FINDINGS_INOUT;
+        break;
+      default:
+        raise_error(RANGE_ERROR);
+        break;
+    } /* switch */
+    var_conv(pollData)->iterPos = 0;
+  } /* polIterFindings */
+
+
+
+/**
+ *  Get the next file from the 'pollData' iterator.
+ *  Successive calls of 'nextFile' return all files from the 'pollData'
+ *  iterator. The file returned by 'nextFile' is determined with the
+ *  function 'addCheck'. The files covered by the 'pollData' iterator
+ *  are determined with 'iterChecks' or 'iterFindings'.
+ *  @return the next file from the 'pollData' iterator, or
+ *          STD_NULL if no file from the 'pollData' iterator is available.
+ */
+rtlValueUnion polNextFile (const pollType pollData, const rtlValueUnion nullFile)
+
+  {
+    rtlValueUnion nextFile;
+
+  /* polNextFile */
+    switch (conv(pollData)->iteratorMode) {
+      case ITER_CHECKS_IN:
+        nextFile = nextCheck(var_conv(pollData), EPOLLIN, nullFile);
+        break;
+      case ITER_CHECKS_OUT:
+        nextFile = nextCheck(var_conv(pollData), EPOLLOUT, nullFile);
+        break;
+      case ITER_CHECKS_INOUT:
+        nextFile = nextCheck(var_conv(pollData), EPOLLIN | EPOLLOUT, nullFile);
+        break;
+      case ITER_FINDINGS_IN:
+        nextFile = nextFinding(var_conv(pollData), EPOLLIN, nullFile);
+        break;
+      case ITER_FINDINGS_OUT:
+        nextFile = nextFinding(var_conv(pollData), EPOLLOUT, nullFile);
+        break;
+      case ITER_FINDINGS_INOUT:
+        nextFile = nextFinding(var_conv(pollData), EPOLLIN | EPOLLOUT, nullFile);
+        break;
+      case ITER_EMPTY:
+      default:
+        nextFile = nullFile;
+        break;
+    } /* switch */
+    return nextFile;
+  } /* polNextFile */
+
+
+
+/**
+ *  Waits for one or more of the checkedEvents from 'pollData'.
+ *  polPoll waits until one of the checkedEvents for a
+ *  corresponding socket occurs. If a checked event occurs
+ *  the eventFindings field is assigned a value. The following
+ *  eventFindings values are assigned:
+ *  - POLLIN data can be read from the corresponding socket.
+ *  - POLLOUT data can be written to the corresponding socket.
+ *  - POLLINOUT data can be read and written (POLLIN and POLLOUT).
+ *
+ *  @exception FILE_ERROR The system function returns an error.
+ */
+void polPoll (const pollType pollData)
+
+  {
+    epoll_based_pollType epollData;
+    memSizeType numBuffered = 0;
+    memSizeType index;
+    int numEvents;
+
+  /* polPoll */
+    logFunction(printf("polPoll\n"););
+    epollData = var_conv(pollData);
+    clearFindings(epollData);
+    if (socBufferedInputPending()) {
+      /* Data in the read buffer of a socket is not seen by epoll. */
+      numBuffered = getBufferedSockets(epollData);
+    } /* if */
+    do {
+      numEvents = epoll_wait(epollData->epollFd, epollData->events,
+                             (int) epollData->capacity,
+                             numBuffered != 0 ? 0 : -1);
+    } while (unlikely(numEvents == -1 && errno == EINTR));
+    if (unlikely(numEvents < 0)) {
+      logError(printf("polPoll: epoll_wait(%d, *, " FMT_U_MEM ", -1) failed:\n"
+                      "%s=%d\nerror: %s\n",
+                      epollData->epollFd, epollData->capacity,
+                      ERROR_INFORMATION););
+      raise_error(FILE_ERROR);
+    } else {
+      for (index = 0; index < (memSizeType) numEvents; index++) {
+        addFinding(epollData,
+                   (socketNumberType) epollData->events[index].data.fd,
+                   epollData->events[index].events);
+      } /* for */
+      for (index = 0; index < numBuffered; index++) {
+        addFinding(epollData, epollData->buffered[index], EPOLLIN);
+      } /* for */
+      epollData->iteratorMode = ITER_EMPTY;
+      epollData->iterPos = 0;
+    } /* if */
+    logFunction(printf("polPoll --> " FMT_U_MEM " findings\n",
+                       epollData->numOfFindings););
+  } /* polPoll */
+
+
+
+/**
+ *  Remove 'eventsToCheck' for 'aSocket' from 'pollData'.
+ *  'EventsToCheck' can have one of the following values:
+ *  - POLLIN check if data can be read from the corresponding socket.
+ *  - POLLOUT check if data can be written to the corresponding socket.
+ *  - POLLINOUT check if data can be read or written (POLLIN or POLLOUT).
+ *
+ *  @param pollData Poll data from which the event checks are removed.
+ *  @param aSocket Socket for which the events should not be checked.
+ *  @param eventsToCheck Events to be removed from the checkedEvents
+ *         field of 'pollData'.
+ *  @exception RANGE_ERROR Illegal value for 'eventsToCheck'.
+ */
+void polRemoveCheck (const pollType pollData, const socketType aSocket,
+    intType eventsToCheck)
+
+  { /* polRemoveCheck */
+    logFunction(printf("polRemoveCheck(" FMT_U_MEM ", %d, " FMT_X ")\n",
+                       (memSizeType) pollData,
+                       aSocket != NULL ? aSocket->socketNumber : 0,
+                       eventsToCheck););
+    if (unlikely(aSocket->socketNumber == EMPTY_SOCKET)) {
+      logError(printf("polRemoveCheck(" FMT_U_MEM ", %d, " FMT_X ")\n",
+                       (memSizeType) pollData, aSocket->socketNumber,
+                       eventsToCheck););
+      raise_error(FILE_ERROR);
+    } else {
+      switch (castIntTypeForSwitch(eventsToCheck)) {
+        case POLL_IN:
+          removeCheck(var_conv(pollData), EPOLLIN,
+                      aSocket->socketNumber);
+          break;
+        case POLL_OUT:
+          removeCheck(var_conv(pollData), EPOLLOUT,
+                      aSocket->socketNumber);
+          break;
+        case POLL_INOUT:
+          removeCheck(var_conv(pollData), EPOLLIN | EPOLLOUT,
+                      aSocket->socketNumber);
+          break;
+        default:
+          raise_error(RANGE_ERROR);
+          break;
+      } /* switch */
+    } /* if */
+  } /* polRemoveCheck */
+
+#endif
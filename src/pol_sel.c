@@ -1,7 +1,7 @@
 /********************************************************************/
 /*                                                                  */
 /*  pol_sel.c     Poll type and function based on select function.  */
-/*  Copyright (C) 1989 - 2013  Thomas Mertes                        */
+/*  Copyright (C) 1989 - 2013, 2026  Thomas Mertes                  */
 /*                                                                  */
 /*  This file is part of the Seed7 Runtime Library.                 */
 /*                                                                  */
@@ -24,7 +24,7 @@
 /*                                                                  */
 /*  Module: Seed7 Runtime Library                                   */
 /*  File: seed7/src/pol_sel.c                                       */
-/*  Changes: 2011, 2013  Thomas Mertes                              */
+/*  Changes: 2011, 2013, 2026  Thomas Mertes                        */
 /*  Content: Poll type and function based on select function.       */
 /*                                                                  */
 /********************************************************************/
@@ -485,10 +485,10 @@ static void doPoll (const pollType pollData, struct timeval *timeout)
     int nfds = 0;
     fd_set *readFds;
     fd_set *writeFds;
-#if !USE_PREPARED_FD_SET
     memSizeType pos;
     os_socketType sock;
-#endif
+    memSizeType numBuffered = 0;
+    struct timeval noWait;
     int select_result;
 
   /* doPoll */
@@ -534,6 +534,20 @@ static void doPoll (const pollType pollData, struct timeval *timeout)
 #endif
     } /* for */
 #endif
+    if (socBufferedInputPending()) {
+      /* Data in the read buffer of a socket is not seen by select(). */
+      for (pos = 0; pos < conv(pollData)->readTest.size; pos++) {
+        sock = conv(pollData)->readTest.files[pos].fd;
+        if (socHasBufferedInput((socketNumberType) sock)) {
+          numBuffered++;
+        } /* if */
+      } /* for */
+      if (numBuffered != 0) {
+        noWait.tv_sec = 0;
+        noWait.tv_usec = 0;
+        timeout = &noWait;
+      } /* if */
+    } /* if */
     /* printf("doPoll %lx: nfds=%d\n", pollData, nfds); */
     do {
       select_result = select(nfds, readFds, writeFds, NULL, timeout);
@@ -544,6 +558,16 @@ static void doPoll (const pollType pollData, struct timeval *timeout)
                       nfds, (memSizeType) timeout, ERROR_INFORMATION););
       raise_error(FILE_ERROR);
     } else {
+      if (numBuffered != 0) {
+        for (pos = 0; pos < conv(pollData)->readTest.size; pos++) {
+          sock = conv(pollData)->readTest.files[pos].fd;
+          if (socHasBufferedInput((socketNumberType) sock) &&
+              !FD_ISSET(sock, readFds)) {
+            FD_SET(sock, readFds);
+            select_result++;
+          } /* if */
+        } /* for */
+      } /* if */
       var_conv(pollData)->readTest.iterPos = 0;
       var_conv(pollData)->writeTest.iterPos = 0;
       var_conv(pollData)->numOfEvents = (memSizeType) select_result;
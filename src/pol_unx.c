@@ -1,7 +1,7 @@
 /********************************************************************/
 /*                                                                  */
 /*  pol_unx.c     Poll type and function using UNIX capabilities.   */
-/*  Copyright (C) 1989 - 2013  Thomas Mertes                        */
+/*  Copyright (C) 1989 - 2013, 2026  Thomas Mertes                  */
 /*                                                                  */
 /*  This file is part of the Seed7 Runtime Library.                 */
 /*                                                                  */
@@ -24,7 +24,7 @@
 /*                                                                  */
 /*  Module: Seed7 Runtime Library                                   */
 /*  File: seed7/src/pol_unx.c                                       */
-/*  Changes: 2011, 2013  Thomas Mertes                              */
+/*  Changes: 2011, 2013, 2026  Thomas Mertes                        */
 /*  Content: Poll type and function using UNIX capabilities.        */
 /*                                                                  */
 /********************************************************************/
@@ -34,6 +34,7 @@
 
 #include "version.h"
 
+#if !(defined POLL_WITH_EPOLL && HAS_EPOLL)
 #include "stdlib.h"
 #include "stdio.h"
 #include "string.h"
@@ -934,14 +935,40 @@ rtlValueUnion polNextFile (const pollType pollData, const rtlValueUnion nullFile
 void polPoll (const pollType pollData)
 
   {
+    memSizeType pos;
+    struct pollfd *aPollFd;
+    memSizeType numBuffered = 0;
     int poll_result;
 
   /* polPoll */
     logFunction(printf("polPoll\n");
                 dumpPoll(pollData););
+    if (socBufferedInputPending()) {
+      /* Data in the read buffer of a socket is not seen by poll(). */
+      for (pos = 0; pos < conv(pollData)->size; pos++) {
+        aPollFd = &conv(pollData)->pollFds[pos];
+        if ((aPollFd->events & POLLIN) != 0 &&
+            socHasBufferedInput((socketNumberType) aPollFd->fd)) {
+          numBuffered++;
+        } /* if */
+      } /* for */
+    } /* if */
     do {
-      poll_result = os_poll(conv(pollData)->pollFds, conv(pollData)->size, -1); /* &timeout); */
+      poll_result = os_poll(conv(pollData)->pollFds, conv(pollData)->size,
+                            numBuffered != 0 ? 0 : -1);
     } while (unlikely(poll_result == -1 && errno == EINTR));
+    if (numBuffered != 0 && poll_result >= 0) {
+      for (pos = 0; pos < conv(pollData)->size; pos++) {
+        aPollFd = &conv(pollData)->pollFds[pos];
+        if ((aPollFd->events & POLLIN) != 0 &&
+            socHasBufferedInput((socketNumberType) aPollFd->fd)) {
+          if (aPollFd->revents == 0) {
+            poll_result++;
+          } /* if */
+          aPollFd->revents |= POLLIN;
+        } /* if */
+      } /* for */
+    } /* if */
     if (unlikely(poll_result < 0)) {
       logError(printf("polPoll: poll(*, " FMT_U_MEM ", -1) failed:\n"
                       "%s=%d\nerror: %s\n",
@@ -1003,3 +1030,5 @@ void polRemoveCheck (const pollType pollData, const socketType aSocket,
       } /* switch */
     } /* if */
   } /* polRemoveCheck */
+
+#endif
@@ -2,7 +2,7 @@
 /*                                                                  */
 /*  s7   Seed7 interpreter                                          */
 /*  Copyright (C) 1991 - 1994, 2007, 2009, 2010  Thomas Mertes      */
-/*  Copyright (C) 2012, 2013, 2015 - 2025  Thomas Mertes            */
+/*  Copyright (C) 2012, 2013, 2015 - 2026  Thomas Mertes            */
 /*                                                                  */
 /*  This program is free software; you can redistribute it and/or   */
 /*  modify it under the terms of the GNU General Public License as  */
@@ -22,7 +22,7 @@
 /*  Module: Library                                                 */
 /*  File: seed7/src/prclib.c                                        */
 /*  Changes: 1991 - 1994, 2007, 2009, 2010, 2012  Thomas Mertes     */
-/*           2013, 2015 - 2025  Thomas Mertes                       */
+/*           2013, 2015 - 2026  Thomas Mertes                       */
 /*  Content: Primitive actions to implement simple statements.      */
 /*                                                                  */
 /********************************************************************/
@@ -58,6 +58,7 @@
 #include "match.h"
 #include "name.h"
 #include "exec.h"
+#include "profutl.h"
 #include "runerr.h"
 #include "blockutl.h"
 #include "actutl.h"
@@ -1092,6 +1093,7 @@ objectType prc_exit (listType arguments)
                       status, INT_MIN, INT_MAX););
       return raise_exception(SYS_RNG_EXCEPTION);
     } else {
+      profFinish();
       shutDrivers();
       os_exit((int) status);
     } /* if */
@@ -2,6 +2,7 @@
 /*                                                                  */
 /*  s7   Seed7 interpreter                                          */
 /*  Copyright (C) 1991 - 1994, 2008, 2013, 2015  Thomas Mertes      */
+/*                2026  Thomas Mertes                               */
 /*  Copyright (C) 2016, 2021, 2025  Thomas Mertes                   */
 /*                                                                  */
 /*  This program is free software; you can redistribute it and/or   */
@@ -22,7 +23,7 @@
 /*  Module: Seed7 compiler library                                  */
 /*  File: seed7/src/prg_comp.c                                      */
 /*  Changes: 1991 - 1994, 2008, 2013, 2015, 2016 Thomas Mertes      */
-/*           2021, 2025  Thomas Mertes                              */
+/*           2021, 2025, 2026  Thomas Mertes                        */
 /*  Content: Primitive actions for the program type.                */
 /*                                                                  */
 /********************************************************************/
@@ -56,6 +57,7 @@
 #include "error.h"
 #include "name.h"
 #include "exec.h"
+#include "bytecode.h"
 #include "option.h"
 #include "match.h"
 #include "objutl.h"
@@ -270,6 +272,7 @@ void interpret (const const_progType currentProg, const const_rtlArrayType argv,
                             (options & TRACE_SIGNALS) != 0,
                             FALSE, FALSE, doSuspendInterpreter);
         set_trace(prog->option_flags);
+        use_bytecode = (options & EXEC_BYTECODE) != 0;
         set_protfile_name(protFileName);
         if (prog->arg_v != NULL) {
           free_args(prog->arg_v);
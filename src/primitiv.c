@@ -1,7 +1,7 @@
 /********************************************************************/
 /*                                                                  */
 /*  s7   Seed7 interpreter                                          */
-/*  Copyright (C) 1990 - 2021  Thomas Mertes                        */
+/*  Copyright (C) 1990 - 2021, 2026  Thomas Mertes                  */
 /*                                                                  */
 /*  This program is free software; you can redistribute it and/or   */
 /*  modify it under the terms of the GNU General Public License as  */
@@ -20,7 +20,7 @@
 /*                                                                  */
 /*  Module: Main                                                    */
 /*  File: seed7/src/primitiv.c                                      */
-/*  Changes: 1992, 1993, 1994, 2004 - 2021  Thomas Mertes           */
+/*  Changes: 1992, 1993, 1994, 2004 - 2021, 2026  Thomas Mertes     */
 /*  Content: Table definitions for all primitive actions.           */
 /*                                                                  */
 /********************************************************************/
@@ -97,6 +97,7 @@ static const objectCategory p_op_op_any[]            = {SYMBOLOBJECT, SYMBOLOBJE
 static const objectCategory p_op_int_op_any[]        = {SYMBOLOBJECT, INTOBJECT, SYMBOLOBJECT, ILLEGALOBJECT};
 static const objectCategory p_big[]                  = {BIGINTOBJECT};
 static const objectCategory p_big_big[]              = {BIGINTOBJECT, BIGINTOBJECT};
+static const objectCategory p_big_big_big[]          = {BIGINTOBJECT, BIGINTOBJECT, BIGINTOBJECT};
 static const objectCategory p_big_bln[]              = {BIGINTOBJECT, BOOLOBJECT};
 static const objectCategory p_big_op_big[]           = {BIGINTOBJECT, SYMBOLOBJECT, BIGINTOBJECT};
 static const objectCategory p_big_op_int[]           = {BIGINTOBJECT, SYMBOLOBJECT, INTOBJECT};
@@ -126,6 +127,7 @@ static const objectCategory p_op_chr[]               = {SYMBOLOBJECT, CHAROBJECT
 static const objectCategory p_dbs[]                  = {DATABASEOBJECT};
 static const objectCategory p_dbs_dbs[]              = {DATABASEOBJECT, DATABASEOBJECT};
 static const objectCategory p_dbs_bln[]              = {DATABASEOBJECT, BOOLOBJECT};
+static const objectCategory p_dbs_int[]              = {DATABASEOBJECT, INTOBJECT};
 static const objectCategory p_dbs_str[]              = {DATABASEOBJECT, STRIOBJECT};
 static const objectCategory p_dbs_op_dbs[]           = {DATABASEOBJECT, SYMBOLOBJECT, DATABASEOBJECT};
 static const objectCategory p_enu[]                  = {ENUMOBJECT};
@@ -262,6 +264,7 @@ static const objectCategory p_soc_str_int_int[]      = {SOCKETOBJECT, STRIOBJECT
 static const objectCategory p_soc_str_int_int_bst[]  = {SOCKETOBJECT, STRIOBJECT, INTOBJECT, INTOBJECT, BSTRIOBJECT};
 static const objectCategory p_soc_op_soc[]           = {SOCKETOBJECT, SYMBOLOBJECT, SOCKETOBJECT};
 static const objectCategory p_sqs[]                  = {SQLSTMTOBJECT};
+static const objectCategory p_sqs_bln[]              = {SQLSTMTOBJECT, BOOLOBJECT};
 static const objectCategory p_sqs_sqs[]              = {SQLSTMTOBJECT, SQLSTMTOBJECT};
 static const objectCategory p_sqs_int[]              = {SQLSTMTOBJECT, INTOBJECT};
 static const objectCategory p_sqs_int_big[]          = {SQLSTMTOBJECT, INTOBJECT, BIGINTOBJECT};
@@ -382,6 +385,7 @@ static const objectCategory p_op_op_op_typ_op_exp_op_any_op_prc_op_exp[] = {SYMB
 #define par_op_int_op_any        argCountAndArgs(p_op_int_op_any)
 #define par_big                  argCountAndArgs(p_big)
 #define par_big_big              argCountAndArgs(p_big_big)
+#define par_big_big_big          argCountAndArgs(p_big_big_big)
 #define par_big_bln              argCountAndArgs(p_big_bln)
 #define par_big_op_big           argCountAndArgs(p_big_op_big)
 #define par_big_op_int           argCountAndArgs(p_big_op_int)
@@ -411,6 +415,7 @@ static const objectCategory p_op_op_op_typ_op_exp_op_any_op_prc_op_exp[] = {SYMB
 #define par_dbs                  argCountAndArgs(p_dbs)
 #define par_dbs_dbs              argCountAndArgs(p_dbs_dbs)
 #define par_dbs_bln              argCountAndArgs(p_dbs_bln)
+#define par_dbs_int              argCountAndArgs(p_dbs_int)
 #define par_dbs_str              argCountAndArgs(p_dbs_str)
 #define par_dbs_op_dbs           argCountAndArgs(p_dbs_op_dbs)
 #define par_enu                  argCountAndArgs(p_enu)
@@ -547,6 +552,7 @@ static const objectCategory p_op_op_op_typ_op_exp_op_any_op_prc_op_exp[] = {SYMB
 #define par_soc_str_int_int_bst  argCountAndArgs(p_soc_str_int_int_bst)
 #define par_soc_op_soc           argCountAndArgs(p_soc_op_soc)
 #define par_sqs                  argCountAndArgs(p_sqs)
+#define par_sqs_bln              argCountAndArgs(p_sqs_bln)
 #define par_sqs_sqs              argCountAndArgs(p_sqs_sqs)
 #define par_sqs_int              argCountAndArgs(p_sqs_int)
 #define par_sqs_int_big          argCountAndArgs(p_sqs_int_big)
@@ -684,6 +690,7 @@ static const actEntryRecord actEntryTable[] = {
     { "ARR_REMOVE_ARRAY",             arr_remove_array,             ARRAYOBJECT,       par_arr_int_int},
     { "ARR_SORT",                     arr_sort,                     ARRAYOBJECT,       par_arr},
     { "ARR_SORT_REVERSE",             arr_sort_reverse,             ARRAYOBJECT,       par_arr},
+    { "ARR_SORT_STABLE",              arr_sort_stable,              ARRAYOBJECT,       par_arr},
     { "ARR_SUBARR",                   arr_subarr,                   ARRAYOBJECT,       par_arr_op_int_op_int},
     { "ARR_TAIL",                     arr_tail,                     ARRAYOBJECT,       par_arr_op_int},
     { "ARR_TIMES",                    arr_times,                    ARRAYOBJECT,       par_int_op_any},
@@ -720,6 +727,7 @@ static const actEntryRecord actEntryTable[] = {
     { "BIG_LT",                       big_lt,                       BOOLOBJECT,        par_big_op_big},
     { "BIG_MDIV",                     big_mdiv,                     BIGINTOBJECT,      par_big_op_big},
     { "BIG_MOD",                      big_mod,                      BIGINTOBJECT,      par_big_op_big},
+    { "BIG_MODPOW",                   big_modpow,                   BIGINTOBJECT,      par_big_big_big},
     { "BIG_MULT",                     big_mult,                     BIGINTOBJECT,      par_big_op_big},
     { "BIG_MULT_ASSIGN",              big_mult_assign,              VOIDOBJECT,        par_big_op_big},
     { "BIG_NE",                       big_ne,                       BOOLOBJECT,        par_big_op_big},
@@ -1515,6 +1523,12 @@ static const actEntryRecord actEntryTable[] = {
     { "SOC_WRITE",                    soc_write,                    VOIDOBJECT,        par_soc_str},
 
 #if WITH_SQL
+    { "SQL_BATCH_FLOAT",              sql_batch_float,              ARRAYOBJECT,       par_sqs_int},
+    { "SQL_BATCH_INT",                sql_batch_int,                ARRAYOBJECT,       par_sqs_int},
+    { "SQL_BATCH_IS_NULL",            sql_batch_is_null,            BSTRIOBJECT,       par_sqs_int},
+    { "SQL_BATCH_SELECT_ROW",         sql_batch_select_row,         VOIDOBJECT,        par_sqs_int},
+    { "SQL_BATCH_SIZE",               sql_batch_size,               INTOBJECT,         par_sqs},
+    { "SQL_BATCH_STRI",               sql_batch_stri,               ARRAYOBJECT,       par_sqs_int},
     { "SQL_BIND_BIGINT",              sql_bind_bigint,              VOIDOBJECT,        par_sqs_int_big},
     { "SQL_BIND_BIGRAT",              sql_bind_bigrat,              VOIDOBJECT,        par_sqs_int_big_big},
     { "SQL_BIND_BOOL",                sql_bind_bool,                VOIDOBJECT,        par_sqs_int_bln},
@@ -1556,6 +1570,7 @@ static const actEntryRecord actEntryTable[] = {
     { "SQL_ERR_MESSAGE",              sql_err_message,              STRIOBJECT,        par_no_args},
     { "SQL_EXECUTE",                  sql_execute,                  VOIDOBJECT,        par_sqs},
     { "SQL_FETCH",                    sql_fetch,                    BOOLOBJECT,        par_sqs},
+    { "SQL_FETCH_BATCH",              sql_fetch_batch,              INTOBJECT,         par_sqs_int},
     { "SQL_GET_AUTO_COMMIT",          sql_get_auto_commit,          BOOLOBJECT,        par_dbs},
     { "SQL_IS_NULL",                  sql_is_null,                  BOOLOBJECT,        par_sqs_int},
     { "SQL_NE_DB",                    sql_ne_db,                    BOOLOBJECT,        par_dbs_op_dbs},
@@ -1573,6 +1588,10 @@ static const actEntryRecord actEntryTable[] = {
     { "SQL_PREPARE",                  sql_prepare,                  SQLSTMTOBJECT,     par_dbs_str},
     { "SQL_ROLLBACK",                 sql_rollback,                 VOIDOBJECT,        par_dbs},
     { "SQL_SET_AUTO_COMMIT",          sql_set_auto_commit,          VOIDOBJECT,        par_dbs_bln},
+    { "SQL_SET_STMT_CACHE",           sql_set_stmt_cache,           VOIDOBJECT,        par_dbs_int},
+    { "SQL_SET_STREAMING",            sql_set_streaming,            VOIDOBJECT,        par_sqs_bln},
+    { "SQL_STMT_CACHE_HITS",          sql_stmt_cache_hits,          INTOBJECT,         par_dbs},
+    { "SQL_STMT_CACHE_MISSES",        sql_stmt_cache_misses,        INTOBJECT,         par_dbs},
     { "SQL_STMT_COLUMN_COUNT",        sql_stmt_column_count,        INTOBJECT,         par_sqs},
     { "SQL_STMT_COLUMN_NAME",         sql_stmt_column_name,         STRIOBJECT,        par_sqs_int},
 #endif
@@ -1586,6 +1605,7 @@ static const actEntryRecord actEntryTable[] = {
     { "STR_CPY",                      str_cpy,                      VOIDOBJECT,        par_str_op_str},
     { "STR_CREATE",                   str_create,                   VOIDOBJECT,        par_str_op_str},
     { "STR_C_LITERAL",                str_c_literal,                STRIOBJECT,        par_str},
+    { "STR_DEFLATE",                  str_deflate,                  STRIOBJECT,        par_str},
     { "STR_DESTR",                    str_destr,                    VOIDOBJECT,        par_str},
     { "STR_ELEMCPY",                  str_elemcpy,                  VOIDOBJECT,        par_str_op_op_int_op_chr},
     { "STR_EQ",                       str_eq,                       BOOLOBJECT,        par_str_op_str},
@@ -1598,6 +1618,8 @@ static const actEntryRecord actEntryTable[] = {
     { "STR_HASHCODE",                 str_hashcode,                 INTOBJECT,         par_str},
     { "STR_HEAD",                     str_head,                     STRIOBJECT,        par_str_op_op_int},
     { "STR_IDX",                      str_idx,                      CHAROBJECT,        par_str_op_int},
+    { "STR_INFLATE",                  str_inflate,                  STRIOBJECT,        par_str_int},
+    { "STR_INFLATE64",                str_inflate64,                STRIOBJECT,        par_str_int},
     { "STR_IPOS",                     str_ipos,                     INTOBJECT,         par_str_str_int},
     { "STR_LE",                       str_le,                       BOOLOBJECT,        par_str_op_str},
     { "STR_LITERAL",                  str_literal,                  STRIOBJECT,        par_str},
@@ -0,0 +1,765 @@
+/********************************************************************/
+/*                                                                  */
+/*  s7   Seed7 interpreter                                          */
+/*  Copyright (C) 2026  Thomas Mertes                               */
+/*                                                                  */
+/*  This program is free software; you can redistribute it and/or   */
+/*  modify it under the terms of the GNU General Public License as  */
+/*  published by the Free Software Foundation; either version 2 of  */
+/*  the License, or (at your option) any later version.             */
+/*                                                                  */
+/*  This program is distributed in the hope that it will be useful, */
+/*  but WITHOUT ANY WARRANTY; without even the implied warranty of  */
+/*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the   */
+/*  GNU General Public License for more details.                    */
+/*                                                                  */
+/*  You should have received a copy of the GNU General Public       */
+/*  License along with this program; if not, write to the           */
+/*  Free Software Foundation, Inc., 51 Franklin Street,             */
+/*  Fifth Floor, Boston, MA  02110-1301, USA.                       */
+/*                                                                  */
+/*                                                                  */
+/*  Module: Interpreter                                             */
+/*  File: seed7/src/profutl.c                                       */
+/*  Changes: 2026  Thomas Mertes                                    */
+/*  Content: Profiler for interpreted functions.                    */
+/*                                                                  */
+/********************************************************************/
+
+#define LOG_FUNCTIONS 0
+#define VERBOSE_EXCEPTIONS 0
+
+#include "version.h"
+
+#include "stdlib.h"
+#include "stdio.h"
+#include "string.h"
+
+#include "common.h"
+#include "data.h"
+#include "os_decls.h"
+#include "heaputl.h"
+#include "striutl.h"
+#include "datautl.h"
+#include "infile.h"
+#include "tim_drv.h"
+
+#undef EXTERN
+#define EXTERN
+#define DO_INIT
+#include "profutl.h"
+
+
+/**
+ *  The profiler is activated with the s7 option -r. Every call of a
+ *  function defined in Seed7 (a BLOCKOBJECT) is surrounded by
+ *  profEnter() and profLeave(). These functions maintain a shadow
+ *  stack of the active functions and accumulate call counts and the
+ *  inclusive and exclusive time of every function. Every
+ *  PROFILE_SAMPLE_USECS microseconds the shadow stack is sampled.
+ *  The samples are taken, when a function is entered or left. They
+ *  are stored in a tree of call paths. At the end profFinish() writes
+ *  a report sorted by exclusive time and the sampled call paths as
+ *  folded stacks (one line per call path), which can be processed
+ *  with flame graph tools.
+ */
+
+#define PROFILE_SAMPLE_USECS   1000
+#define FUNC_TABLE_START_SIZE  1024
+#define FRAME_START_CAPACITY    256
+#define NODE_START_CAPACITY    1024
+
+typedef struct {
+    const_objectType function;
+    uintType calls;
+    uintType depth;
+    uintType samples;
+    intType inclusiveTime;
+    intType exclusiveTime;
+  } profFuncRecord, *profFuncType;
+
+typedef const profFuncRecord *const_profFuncType;
+
+typedef struct {
+    memSizeType funcIndex;
+    intType startTime;
+    intType childTime;
+  } frameRecord, *frameType;
+
+typedef struct {
+    memSizeType funcIndex;
+    memSizeType parent;
+    memSizeType firstChild;
+    memSizeType nextSibling;
+    uintType samples;
+  } pathNodeRecord, *pathNodeType;
+
+static striType profileBaseName = NULL;
+static intType profileStartTime;
+static intType nextSampleTime;
+static uintType totalSamples;
+
+/* Functions seen so far and a hash table with their index plus one. */
+static profFuncType funcs = NULL;
+static memSizeType funcsUsed = 0;
+static memSizeType funcsCapacity = 0;
+static memSizeType *funcTable = NULL;
+static memSizeType funcTableSize = 0;
+
+/* Shadow stack of the active functions. */
+static frameType frames = NULL;
+static memSizeType framesUsed = 0;
+static memSizeType framesCapacity = 0;
+
+/* After an allocation failed no frames are pushed anymore. */
+static boolType profileIncomplete;
+static memSizeType framesLost;
+
+/* Tree of sampled call paths. Node 0 is the root. */
+static pathNodeType nodes = NULL;
+static memSizeType nodesUsed = 0;
+static memSizeType nodesCapacity = 0;
+
+
+
+static inline memSizeType funcHash (const_objectType function)
+
+  { /* funcHash */
+    return ((memSizeType) function >> 4) * (memSizeType) 0x9E3779B1;
+  } /* funcHash */
+
+
+
+static boolType growFuncTable (void)
+
+  {
+    memSizeType newSize;
+    memSizeType *newTable;
+    memSizeType mask;
+    memSizeType index;
+    memSizeType pos;
+
+  /* growFuncTable */
+    newSize = funcTableSize == 0 ? FUNC_TABLE_START_SIZE : 2 * funcTableSize;
+    if (unlikely(!ALLOC_TABLE(newTable, memSizeType, newSize))) {
+      return FALSE;
+    } /* if */
+    memset(newTable, 0, newSize * sizeof(memSizeType));
+    mask = newSize - 1;
+    for (index = 0; index < funcsUsed; index++) {
+      pos = funcHash(funcs[index].function) & mask;
+      while (newTable[pos] != 0) {
+        pos = (pos + 1) & mask;
+      } /* while */
+      newTable[pos] = index + 1;
+    } /* for */
+    if (funcTable != NULL) {
+      FREE_TABLE(funcTable, memSizeType, funcTableSize);
+    } /* if */
+    funcTable = newTable;
+    funcTableSize = newSize;
+    return TRUE;
+  } /* growFuncTable */
+
+
+
+/**
+ *  Determine the index of 'function' in the funcs array.
+ *  A new entry is created, when 'function' is called the first time.
+ *  @return the index or funcsUsed, when an allocation failed.
+ */
+static memSizeType findFunc (const_objectType function)
+
+  {
+    memSizeType mask;
+    memSizeType pos;
+    memSizeType index;
+    profFuncType resized;
+    memSizeType newCapacity;
+
+  /* findFunc */
+    if (funcTableSize != 0) {
+      mask = funcTableSize - 1;
+      pos = funcHash(function) & mask;
+      while (funcTable[pos] != 0) {
+        if (funcs[funcTable[pos] - 1].function == function) {
+          return funcTable[pos] - 1;
+        } /* if */
+        pos = (pos + 1) & mask;
+      } /* while */
+    } /* if */
+    if (funcsUsed >= funcsCapacity) {
+      newCapacity = funcsCapacity == 0 ?
+          FUNC_TABLE_START_SIZE / 2 : 2 * funcsCapacity;
+      if (funcs == NULL) {
+        if (unlikely(!ALLOC_TABLE(resized, profFuncRecord, newCapacity))) {
+          resized = NULL;
+        } /* if */
+      } else {
+        resized = REALLOC_TABLE(funcs, profFuncRecord,
+                                funcsCapacity, newCapacity);
+        if (resized != NULL) {
+          COUNT3_TABLE(profFuncRecord, funcsCapacity, newCapacity);
+        } /* if */
+      } /* if */
+      if (unlikely(resized == NULL)) {
+        return funcsUsed;
+      } /* if */
+      funcs = resized;
+      funcsCapacity = newCapacity;
+    } /* if */
+    if (2 * (funcsUsed + 1) > funcTableSize && unlikely(!growFuncTable())) {
+      return funcsUsed;
+    } /* if */
+    index = funcsUsed;
+    memset(&funcs[index], 0, sizeof(profFuncRecord));
+    funcs[index].function = function;
+    funcsUsed++;
+    mask = funcTableSize - 1;
+    pos = funcHash(function) & mask;
+    while (funcTable[pos] != 0) {
+      pos = (pos + 1) & mask;
+    } /* while */
+    funcTable[pos] = index + 1;
+    return index;
+  } /* findFunc */
+
+
+
+/**
+ *  Determine the child of the call path 'node', which calls 'funcIndex'.
+ *  A new node is created, when the call path was not sampled before.
+ *  @return the index of the child node or 0, when an allocation failed.
+ */
+static memSizeType childNode (memSizeType node, memSizeType funcIndex)
+
+  {
+    memSizeType child;
+    pathNodeType resized;
+    memSizeType newCapacity;
+
+  /* childNode */
+    child = nodes[node].firstChild;
+    while (child != 0) {
+      if (nodes[child].funcIndex == funcIndex) {
+        return child;
+      } /* if */
+      child = nodes[child].nextSibling;
+    } /* while */
+    if (nodesUsed >= nodesCapacity) {
+      newCapacity = 2 * nodesCapacity;
+      resized = REALLOC_TABLE(nodes, pathNodeRecord, nodesCapacity, newCapacity);
+      if (unlikely(resized == NULL)) {
+        return 0;
+      } /* if */
+      COUNT3_TABLE(pathNodeRecord, nodesCapacity, newCapacity);
+      nodes = resized;
+      nodesCapacity = newCapacity;
+    } /* if */
+    child = nodesUsed;
+    nodesUsed++;
+    nodes[child].funcIndex = funcIndex;
+    nodes[child].parent = node;
+    nodes[child].firstChild = 0;
+    nodes[child].nextSibling = nodes[node].firstChild;
+    nodes[child].samples = 0;
+    nodes[node].firstChild = child;
+    return child;
+  } /* childNode */
+
+
+
+/**
+ *  Record the current shadow stack for all sample periods up to 'now'.
+ */
+static void takeSample (intType now)
+
+  {
+    uintType count;
+    memSizeType node = 0;
+    memSizeType index;
+
+  /* takeSample */
+    count = (uintType) ((now - nextSampleTime) / PROFILE_SAMPLE_USECS) + 1;
+    nextSampleTime += (intType) count * PROFILE_SAMPLE_USECS;
+    totalSamples += count;
+    if (framesUsed != 0) {
+      index = 0;
+      do {
+        node = childNode(node, frames[index].funcIndex);
+        index++;
+      } while (index < framesUsed && node != 0);
+      if (node != 0) {
+        nodes[node].samples += count;
+      } else {
+        profileIncomplete = TRUE;
+      } /* if */
+      funcs[frames[framesUsed - 1].funcIndex].samples += count;
+    } /* if */
+  } /* takeSample */
+
+
+
+static void closeFrame (intType now)
+
+  {
+    frameType frame;
+    profFuncType func;
+    intType elapsed;
+
+  /* closeFrame */
+    framesUsed--;
+    frame = &frames[framesUsed];
+    elapsed = now - frame->startTime;
+    func = &funcs[frame->funcIndex];
+    func->exclusiveTime += elapsed - frame->childTime;
+    func->depth--;
+    if (func->depth == 0) {
+      func->inclusiveTime += elapsed;
+    } /* if */
+    if (framesUsed != 0) {
+      frames[framesUsed - 1].childTime += elapsed;
+    } /* if */
+  } /* closeFrame */
+
+
+
+/**
+ *  Start profiling. The report is written to baseName.txt and the
+ *  folded stacks are written to baseName.folded.
+ */
+void profStart (const const_striType baseName)
+
+  { /* profStart */
+    logFunction(printf("profStart(\"%s\")\n",
+                       striAsUnquotedCStri(baseName)););
+    if (!profile_active && baseName != NULL) {
+      if (ALLOC_TABLE(frames, frameRecord, FRAME_START_CAPACITY)) {
+        if (ALLOC_TABLE(nodes, pathNodeRecord, NODE_START_CAPACITY)) {
+          framesCapacity = FRAME_START_CAPACITY;
+          nodesCapacity = NODE_START_CAPACITY;
+          memset(&nodes[0], 0, sizeof(pathNodeRecord));
+          nodesUsed = 1;
+          framesUsed = 0;
+          framesLost = 0;
+          funcsUsed = 0;
+          totalSamples = 0;
+          profileIncomplete = FALSE;
+          profileBaseName = copy_stri(baseName);
+          if (profileBaseName != NULL) {
+            profileStartTime = timMicroSec();
+            nextSampleTime = profileStartTime + PROFILE_SAMPLE_USECS;
+            profile_active = TRUE;
+          } else {
+            FREE_TABLE(nodes, pathNodeRecord, nodesCapacity);
+            FREE_TABLE(frames, frameRecord, framesCapacity);
+          } /* if */
+        } else {
+          FREE_TABLE(frames, frameRecord, FRAME_START_CAPACITY);
+        } /* if */
+      } /* if */
+    } /* if */
+    logFunction(printf("profStart --> (profile_active=%d)\n",
+                       profile_active););
+  } /* profStart */
+
+
+
+/**
+ *  Enter the Seed7 function 'function'.
+ *  Must be followed by a corresponding call of profLeave().
+ */
+void profEnter (const_objectType function)
+
+  {
+    intType now;
+    memSizeType funcIndex;
+    frameType resized;
+    memSizeType newCapacity;
+
+  /* profEnter */
+    now = timMicroSec();
+    if (now >= nextSampleTime) {
+      takeSample(now);
+    } /* if */
+    if (framesLost != 0) {
+      framesLost++;
+    } else {
+      if (framesUsed >= framesCapacity) {
+        newCapacity = 2 * framesCapacity;
+        resized = REALLOC_TABLE(frames, frameRecord,
+                                framesCapacity, newCapacity);
+        if (unlikely(resized == NULL)) {
+          profileIncomplete = TRUE;
+          framesLost++;
+          return;
+        } /* if */
+        COUNT3_TABLE(frameRecord, framesCapacity, newCapacity);
+        frames = resized;
+        framesCapacity = newCapacity;
+      } /* if */
+      funcIndex = findFunc(function);
+      if (unlikely(funcIndex == funcsUsed)) {
+        profileIncomplete = TRUE;
+        framesLost++;
+      } else {
+        frames[framesUsed].funcIndex = funcIndex;
+        frames[framesUsed].startTime = now;
+        frames[framesUsed].childTime = 0;
+        framesUsed++;
+        funcs[funcIndex].calls++;
+        funcs[funcIndex].depth++;
+      } /* if */
+    } /* if */
+  } /* profEnter */
+
+
+
+/**
+ *  Leave the function entered with the last call of profEnter().
+ */
+void profLeave (void)
+
+  {
+    intType now;
+
+  /* profLeave */
+    if (framesLost != 0) {
+      framesLost--;
+    } else if (framesUsed != 0) {
+      now = timMicroSec();
+      if (now >= nextSampleTime) {
+        takeSample(now);
+      } /* if */
+      closeFrame(now);
+    } /* if */
+  } /* profLeave */
+
+
+
+static void writeName (FILE *outFile, const_cstriType name, boolType folded)
+
+  { /* writeName */
+    if (folded) {
+      /* Semicolons separate the frames of a folded stack. */
+      while (*name != '\0') {
+        fputc(*name == ';' ? ':' : *name, outFile);
+        name++;
+      } /* while */
+    } else {
+      fputs(name, outFile);
+    } /* if */
+  } /* writeName */
+
+
+
+static void writeTypeName (FILE *outFile, const_typeType aType)
+
+  { /* writeTypeName */
+    if (aType == NULL) {
+      fputs("?", outFile);
+    } else if (aType->name != NULL) {
+      fputs(id_string(aType->name), outFile);
+    } else if (aType->result_type != NULL) {
+      fputs(aType->is_varfunc_type ? "varfunc " : "func ", outFile);
+      writeTypeName(outFile, aType->result_type);
+    } else {
+      fputs("?", outFile);
+    } /* if */
+  } /* writeTypeName */
+
+
+
+/**
+ *  Write the name of 'function' followed by the types of its parameters.
+ *  E.g.: "fib (integer)" or "(string) & (char)".
+ */
+static void writeFunctionName (FILE *outFile, const_objectType function,
+    boolType folded)
+
+  {
+    const_listType param;
+    const_listType paramEnd;
+    const_objectType paramObj;
+
+  /* writeFunctionName */
+    if (HAS_PROPERTY(function) &&
+        function->descriptor.property->params != NULL) {
+      param = function->descriptor.property->params;
+      paramEnd = param;
+      while (paramEnd->next != NULL) {
+        paramEnd = paramEnd->next;
+      } /* while */
+      /* Like prot_params() a prefix name is written in front. */
+      if (param->obj != NULL && paramEnd->obj != NULL &&
+          CATEGORY_OF_OBJ(param->obj) != SYMBOLOBJECT &&
+          CATEGORY_OF_OBJ(paramEnd->obj) == SYMBOLOBJECT &&
+          HAS_ENTITY(paramEnd->obj) &&
+          GET_ENTITY(paramEnd->obj)->ident != NULL &&
+          GET_ENTITY(paramEnd->obj)->ident->infix_priority == 0) {
+        writeName(outFile, id_string(GET_ENTITY(paramEnd->obj)->ident),
+                  folded);
+        fputs(" ", outFile);
+      } else {
+        paramEnd = NULL;
+      } /* if */
+      while (param != paramEnd) {
+        paramObj = param->obj;
+        if (paramObj == NULL) {
+          fputs("?", outFile);
+        } else {
+          switch (CATEGORY_OF_OBJ(paramObj)) {
+            case VALUEPARAMOBJECT:
+            case REFPARAMOBJECT:
+              fputs("(", outFile);
+              writeTypeName(outFile, paramObj->type_of);
+              fputs(")", outFile);
+              break;
+            case TYPEOBJECT:
+              fputs("(attr ", outFile);
+              writeTypeName(outFile, paramObj->value.typeValue);
+              fputs(")", outFile);
+              break;
+            default:
+              if (HAS_ENTITY(paramObj) &&
+                  GET_ENTITY(paramObj)->ident != NULL) {
+                writeName(outFile, id_string(GET_ENTITY(paramObj)->ident),
+                          folded);
+              } else {
+                fputs("?", outFile);
+              } /* if */
+              break;
+          } /* switch */
+        } /* if */
+        param = param->next;
+        if (param != paramEnd) {
+          fputs(" ", outFile);
+        } /* if */
+      } /* while */
+    } else if (HAS_ENTITY(function) && GET_ENTITY(function)->ident != NULL) {
+      writeName(outFile, id_string(GET_ENTITY(function)->ident), folded);
+    } else {
+      fputs("?", outFile);
+    } /* if */
+  } /* writeFunctionName */
+
+
+
+static void writePlace (FILE *outFile, const_objectType function)
+
+  {
+    striType fileName;
+    cstriType cFileName;
+    errInfoType err_info = OKAY_NO_ERROR;
+
+  /* writePlace */
+    fileName = objectFileName(function);
+    cFileName = stri_to_cstri8(fileName, &err_info);
+    if (cFileName != NULL) {
+      fputs(cFileName, outFile);
+      free_cstri8(cFileName, fileName);
+    } else {
+      fputs("?", outFile);
+    } /* if */
+    fprintf(outFile, "(" FMT_U ")", HAS_PROPERTY(function) ?
+            (uintType) PROPERTY_LINE_NUM(function) : (uintType) 0);
+  } /* writePlace */
+
+
+
+static FILE *openOutput (const char *extension)
+
+  {
+    striType fileName;
+    memSizeType length;
+    memSizeType pos;
+    os_striType os_fileName;
+    static const os_charType os_mode[] = {'w', 0};
+    int path_info = PATH_IS_NORMAL;
+    errInfoType err_info = OKAY_NO_ERROR;
+    FILE *outFile = NULL;
+
+  /* openOutput */
+    length = strlen(extension);
+    if (ALLOC_STRI_CHECK_SIZE(fileName, profileBaseName->size + length)) {
+      memcpy(fileName->mem, profileBaseName->mem,
+             profileBaseName->size * sizeof(strElemType));
+      for (pos = 0; pos < length; pos++) {
+        fileName->mem[profileBaseName->size + pos] =
+            (strElemType) (unsigned char) extension[pos];
+      } /* for */
+      fileName->size = profileBaseName->size + length;
+      os_fileName = cp_to_os_path(fileName, &path_info, &err_info);
+      if (os_fileName != NULL) {
+        outFile = os_fopen(os_fileName, os_mode);
+        os_stri_free(os_fileName);
+      } /* if */
+      if (outFile == NULL) {
+        printf("\n*** Cannot write profile to \"%s\".\n",
+               striAsUnquotedCStri(fileName));
+      } /* if */
+      FREE_STRI(fileName);
+    } /* if */
+    return outFile;
+  } /* openOutput */
+
+
+
+/**
+ *  Write one line for every sampled call path. The frames are
+ *  separated with semicolons and are followed by the number of samples.
+ */
+static void writeFoldedStacks (FILE *outFile)
+
+  {
+    memSizeType node;
+    memSizeType depth;
+    memSizeType pathNode;
+    memSizeType *path;
+    memSizeType maxDepth = 0;
+
+  /* writeFoldedStacks */
+    for (node = 1; node < nodesUsed; node++) {
+      depth = 0;
+      for (pathNode = node; pathNode != 0; pathNode = nodes[pathNode].parent) {
+        depth++;
+      } /* for */
+      if (depth > maxDepth) {
+        maxDepth = depth;
+      } /* if */
+    } /* for */
+    if (maxDepth != 0 && ALLOC_TABLE(path, memSizeType, maxDepth)) {
+      for (node = 1; node < nodesUsed; node++) {
+        if (nodes[node].samples != 0) {
+          depth = 0;
+          for (pathNode = node; pathNode != 0;
+               pathNode = nodes[pathNode].parent) {
+            path[depth] = pathNode;
+            depth++;
+          } /* for */
+          while (depth != 0) {
+            depth--;
+            writeFunctionName(outFile,
+                funcs[nodes[path[depth]].funcIndex].function, TRUE);
+            if (depth != 0) {
+              fputs(";", outFile);
+            } /* if */
+          } /* while */
+          fprintf(outFile, " " FMT_U "\n", nodes[node].samples);
+        } /* if */
+      } /* for */
+      FREE_TABLE(path, memSizeType, maxDepth);
+    } /* if */
+  } /* writeFoldedStacks */
+
+
+
+static int cmpExclusiveTime (const void *elem1, const void *elem2)
+
+  {
+    const_profFuncType func1 = (const_profFuncType) elem1;
+    const_profFuncType func2 = (const_profFuncType) elem2;
+    int signumValue;
+
+  /* cmpExclusiveTime */
+    if (func1->exclusiveTime > func2->exclusiveTime) {
+      signumValue = -1;
+    } else if (func1->exclusiveTime < func2->exclusiveTime) {
+      signumValue = 1;
+    } else if (func1->calls > func2->calls) {
+      signumValue = -1;
+    } else if (func1->calls < func2->calls) {
+      signumValue = 1;
+    } else {
+      signumValue = 0;
+    } /* if */
+    return signumValue;
+  } /* cmpExclusiveTime */
+
+
+
+/**
+ *  Write the functions sorted by exclusive time (most expensive first).
+ */
+static void writeReport (FILE *outFile, intType totalTime)
+
+  {
+    memSizeType index;
+
+  /* writeReport */
+    fprintf(outFile, "usecs: " FMT_D "\tsamples: " FMT_U
+            "\tsample period: %d usecs\n",
+            totalTime, totalSamples, PROFILE_SAMPLE_USECS);
+    if (profileIncomplete) {
+      fprintf(outFile, "*** The profile is incomplete: Not enough memory.\n");
+    } /* if */
+    fprintf(outFile, "\nself usecs\tusecs\tcalls\tsamples\tplace\tname\n");
+    qsort(funcs, funcsUsed, sizeof(profFuncRecord), &cmpExclusiveTime);
+    for (index = 0; index < funcsUsed; index++) {
+      fprintf(outFile, FMT_D "\t" FMT_D "\t" FMT_U "\t" FMT_U "\t",
+              funcs[index].exclusiveTime, funcs[index].inclusiveTime,
+              funcs[index].calls, funcs[index].samples);
+      writePlace(outFile, funcs[index].function);
+      fputs("\t", outFile);
+      writeFunctionName(outFile, funcs[index].function, FALSE);
+      fputs("\n", outFile);
+    } /* for */
+  } /* writeReport */
+
+
+
+/**
+ *  Stop profiling and write the profile.
+ *  Functions that are still active are left at the current time.
+ *  This is done when the program terminates normally or with exit().
+ */
+void profFinish (void)
+
+  {
+    intType now;
+    FILE *outFile;
+
+  /* profFinish */
+    logFunction(printf("profFinish\n"););
+    if (profile_active) {
+      profile_active = FALSE;
+      now = timMicroSec();
+      if (now >= nextSampleTime) {
+        takeSample(now);
+      } /* if */
+      while (framesUsed != 0) {
+        closeFrame(now);
+      } /* while */
+      outFile = openOutput(".folded");
+      if (outFile != NULL) {
+        writeFoldedStacks(outFile);
+        fclose(outFile);
+      } /* if */
+      /* The report is written last, since it sorts the funcs array. */
+      outFile = openOutput(".txt");
+      if (outFile != NULL) {
+        writeReport(outFile, now - profileStartTime);
+        fclose(outFile);
+      } /* if */
+      FREE_TABLE(frames, frameRecord, framesCapacity);
+      FREE_TABLE(nodes, pathNodeRecord, nodesCapacity);
+      if (funcs != NULL) {
+        FREE_TABLE(funcs, profFuncRecord, funcsCapacity);
+        funcs = NULL;
+        funcsCapacity = 0;
+      } /* if */
+      if (funcTable != NULL) {
+        FREE_TABLE(funcTable, memSizeType, funcTableSize);
+        funcTable = NULL;
+        funcTableSize = 0;
+      } /* if */
+      frames = NULL;
+      nodes = NULL;
+      framesCapacity = 0;
+      nodesCapacity = 0;
+      funcsUsed = 0;
+      FREE_STRI(profileBaseName);
+      profileBaseName = NULL;
+    } /* if */
+    logFunction(printf("profFinish -->\n"););
+  } /* profFinish */
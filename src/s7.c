@@ -21,7 +21,7 @@
 /*  Module: Main                                                    */
 /*  File: seed7/src/s7.c                                            */
 /*  Changes: 1990 - 1994, 2010, 2011, 2013, 2015  Thomas Mertes     */
-/*           2021  Thomas Mertes                                    */
+/*           2021, 2026  Thomas Mertes                              */
 /*  Content: Main program of the Seed7 interpreter.                 */
 /*                                                                  */
 /********************************************************************/
@@ -57,6 +57,7 @@
 #include "objutl.h"
 #include "traceutl.h"
 #include "exec.h"
+#include "profutl.h"
 #include "option.h"
 #include "runerr.h"
 #include "level.h"
@@ -108,6 +109,8 @@ static void writeHelp (void)
     printf("Options:\n");
     printf("  -? or -h  Write Seed7 interpreter usage.\n");
     printf("  -a   Analyze only and suppress the execution phase.\n");
+    printf("  -b   Execute function bodies as bytecode. Function bodies are lowered\n");
+    printf("       to compact instruction arrays, when they are called the first time.\n");
     printf("  -dx  Set compile time trace level to x. Where x is a string consisting of:\n");
     printf("         a Trace primitive actions\n");
     printf("         c Do action check\n");
@@ -119,6 +122,8 @@ static void writeHelp (void)
     printf("  -i   Show the identifier table after the analysis phase.\n");
     printf("  -l   Add a directory to the include library search path (e.g.: -l ../lib).\n");
     printf("  -p   Specify a protocol file, for trace output (e.g.: -p prot.txt).\n");
+    printf("  -r   Profile the execution and write the profile to the files\n");
+    printf("       name.txt and name.folded (e.g.: -r prof).\n");
     printf("  -q   Compile quiet. Line and file information and compilation\n");
     printf("       statistics are suppressed.\n");
     printf("  -s   Deactivate signal handlers.\n");
@@ -175,6 +180,7 @@ static void printOptions (const optionType option)
     printf("sourceFileArgument: \"%s\"\n",
            striAsUnquotedCStri(option->sourceFileArgument));
     printf("protFileName:       \"%s\"\n", striAsUnquotedCStri(option->protFileName));
+    printf("profileName:        \"%s\"\n", striAsUnquotedCStri(option->profileName));
     printf("writeHelp:          %s\n", option->writeHelp ? "TRUE" : "FALSE");
     printf("analyzeOnly:        %s\n", option->analyzeOnly ? "TRUE" : "FALSE");
     printf("executeAlways:      %s\n", option->executeAlways ? "TRUE" : "FALSE");
@@ -194,6 +200,7 @@ void freeOptions (optionType option)
   { /* freeOptions */
     strDestr(option->sourceFileArgument);
     strDestr(option->protFileName);
+    strDestr(option->profileName);
     freeStringArray(option->libraryDirs);
   } /* freeOptions */
 
@@ -228,6 +235,9 @@ static void processOptions (rtlArrayType arg_v, const optionType option)
             case 'a':
               option->analyzeOnly = TRUE;
               break;
+            case 'b':
+              option->execOptions |= EXEC_BYTECODE;
+              break;
             case 'd':
               if (ALLOC_STRI_SIZE_OK(traceLevel, 1)) {
                 traceLevel->mem[0] = 'a';
@@ -254,6 +264,17 @@ static void processOptions (rtlArrayType arg_v, const optionType option)
                 opt = NULL;
               } /* if */
               break;
+            case 'r':
+              if (position < arg_v->max_position - 1) {
+                arg_v->arr[position].value.striValue = NULL;
+                FREE_STRI(opt);
+                position++;
+                opt = arg_v->arr[position].value.striValue;
+                option->profileName = stri_to_standard_path(opt);
+                arg_v->arr[position].value.striValue = NULL;
+                opt = NULL;
+              } /* if */
+              break;
             case 'q':
               verbosity_level = 0;
               break;
@@ -389,6 +410,7 @@ int main (int argc, char **argv)
     optionRecord option = {
         NULL,  /* sourceFileArgument */
         NULL,  /* protFileName       */
+        NULL,  /* profileName        */
         FALSE, /* writeHelp          */
         FALSE, /* analyzeOnly        */
         FALSE, /* executeAlways      */
@@ -455,8 +477,12 @@ int main (int argc, char **argv)
                     CATEGORY_OF_OBJ(currentProg->main_object) == FORWARDOBJECT) {
                   printf("*** Declaration for main missing\n");
                 } else {
+                  if (option.profileName != NULL) {
+                    profStart(option.profileName);
+                  } /* if */
                   interpret(currentProg, option.argv, option.argvStart,
                             option.execOptions, option.protFileName);
+                  profFinish();
                 } /* if */
                 if (fail_flag) {
                   returnCode = 1;
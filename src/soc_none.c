@@ -1,7 +1,7 @@
 /********************************************************************/
 /*                                                                  */
 /*  soc_none.c    Dummy functions for the socket type.              */
-/*  Copyright (C) 1989 - 2018  Thomas Mertes                        */
+/*  Copyright (C) 1989 - 2018, 2026  Thomas Mertes                  */
 /*                                                                  */
 /*  This file is part of the Seed7 Runtime Library.                 */
 /*                                                                  */
@@ -24,7 +24,7 @@
 /*                                                                  */
 /*  Module: Seed7 Runtime Library                                   */
 /*  File: seed7/src/soc_none.c                                      */
-/*  Changes: 2011, 2018  Thomas Mertes                              */
+/*  Changes: 2011, 2018, 2026  Thomas Mertes                        */
 /*  Content: Dummy functions for the socket type.                   */
 /*                                                                  */
 /********************************************************************/
@@ -99,6 +99,23 @@ void socBind (const const_socketType listenerSocket,
 
 
 
+boolType socBufferedInputPending (void)
+
+  { /* socBufferedInputPending */
+    return FALSE;
+  } /* socBufferedInputPending */
+
+
+
+memSizeType socBufferedInputSockets (socketNumberType *sockets,
+    memSizeType capacity)
+
+  { /* socBufferedInputSockets */
+    return 0;
+  } /* socBufferedInputSockets */
+
+
+
 void socClose (const socketType aSocket)
 
   { /* socClose */
@@ -232,6 +249,14 @@ bstriType socGetPeerAddr (const const_socketType aSocket)
 
 
 
+boolType socHasBufferedInput (const socketNumberType aSocket)
+
+  { /* socHasBufferedInput */
+    return FALSE;
+  } /* socHasBufferedInput */
+
+
+
 boolType socHasNext (const const_socketType inSocket)
 
   { /* socHasNext */
@@ -1,7 +1,7 @@
 /********************************************************************/
 /*                                                                  */
 /*  soc_rtl.c     Primitive actions for the socket type.            */
-/*  Copyright (C) 1989 - 2015, 2018 - 2021  Thomas Mertes           */
+/*  Copyright (C) 1989 - 2015, 2018 - 2021, 2026  Thomas Mertes     */
 /*                                                                  */
 /*  This file is part of the Seed7 Runtime Library.                 */
 /*                                                                  */
@@ -25,6 +25,7 @@
 /*  Module: Seed7 Runtime Library                                   */
 /*  File: seed7/src/soc_rtl.c                                       */
 /*  Changes: 2007, 2011, 2013 - 2015, 2018 - 2020  Thomas Mertes    */
+/*           2026  Thomas Mertes                                    */
 /*  Content: Primitive actions for the socket type.                 */
 /*                                                                  */
 /********************************************************************/
@@ -121,6 +122,27 @@ static boolType initialized = FALSE;
 #define MAX_SOCK_ADDRESS_LEN \
     STRLEN("[0123:4567:89ab:cdef:0123:4567:89ab:cdef]:") + UINT16TYPE_DECIMAL_SIZE
 
+#ifndef SOCKET_READ_BUFFER_SIZE
+#define SOCKET_READ_BUFFER_SIZE   16384
+#endif
+
+/**
+ *  Read buffer of a socket.
+ *  The bytes from data[pos] to data[end - 1] have been received,
+ *  but not consumed. Buffers with unconsumed bytes are linked
+ *  together, such that the poll functions can find them.
+ */
+typedef struct socketBufferStruct {
+    memSizeType pos;
+    memSizeType end;
+    socketNumberType socketNumber;
+    struct socketBufferStruct *prevPending;
+    struct socketBufferStruct *nextPending;
+    ucharType data[SOCKET_READ_BUFFER_SIZE];
+  } *socketBufferType;
+
+static socketBufferType pendingBuffers = NULL;
+
 
 
 #if ANY_LOG_ACTIVE
@@ -517,6 +539,145 @@ static boolType socketInputReady (socketNumberType inSocket, intType seconds,
 
 
 
+static void unlinkPending (const socketBufferType readBuffer)
+
+  { /* unlinkPending */
+    if (readBuffer->prevPending == NULL) {
+      pendingBuffers = readBuffer->nextPending;
+    } else {
+      readBuffer->prevPending->nextPending = readBuffer->nextPending;
+    } /* if */
+    if (readBuffer->nextPending != NULL) {
+      readBuffer->nextPending->prevPending = readBuffer->prevPending;
+    } /* if */
+  } /* unlinkPending */
+
+
+
+/**
+ *  Get the read buffer of 'inSocket'.
+ *  The buffer is allocated when it is requested for the first time.
+ *  @return the read buffer, or NULL if there is not enough memory.
+ */
+static socketBufferType getReadBuffer (const const_socketType inSocket)
+
+  {
+    socketBufferType readBuffer;
+
+  /* getReadBuffer */
+    readBuffer = inSocket->readBuffer;
+    if (readBuffer == NULL) {
+      readBuffer = (socketBufferType) malloc(sizeof(struct socketBufferStruct));
+      if (unlikely(readBuffer == NULL)) {
+        logError(printf("getReadBuffer(%d): malloc(" FMT_U_MEM ") failed.\n",
+                        inSocket->socketNumber,
+                        sizeof(struct socketBufferStruct)););
+      } else {
+        readBuffer->pos = 0;
+        readBuffer->end = 0;
+        readBuffer->socketNumber = inSocket->socketNumber;
+        /* The read buffer is not part of the value of the socket. */
+        ((socketType) inSocket)->readBuffer = readBuffer;
+      } /* if */
+    } /* if */
+    return readBuffer;
+  } /* getReadBuffer */
+
+
+
+static void freeReadBuffer (const socketType aSocket)
+
+  {
+    socketBufferType readBuffer;
+
+  /* freeReadBuffer */
+    readBuffer = aSocket->readBuffer;
+    if (readBuffer != NULL) {
+      if (readBuffer->pos != readBuffer->end) {
+        unlinkPending(readBuffer);
+      } /* if */
+      free(readBuffer);
+      aSocket->readBuffer = NULL;
+    } /* if */
+  } /* freeReadBuffer */
+
+
+
+/**
+ *  Receive data into an empty read buffer.
+ *  Like recv() this function waits until at least one byte is
+ *  available. It does not wait until the buffer is full.
+ *  @return the number of bytes received, or 0 at EOF or error.
+ */
+static memSizeType fillReadBuffer (const socketBufferType readBuffer)
+
+  {
+    memSizeType bytes_received;
+
+  /* fillReadBuffer */
+    bytes_received = (memSizeType) recv((os_socketType) readBuffer->socketNumber,
+                                        cast_send_recv_data(readBuffer->data),
+                                        cast_buffer_len(SOCKET_READ_BUFFER_SIZE), 0);
+    logMessage(printf("fillReadBuffer: bytes_received=" FMT_U_MEM "\n",
+                      bytes_received););
+    if (unlikely(bytes_received == (memSizeType) -1)) {
+      logError(printf("fillReadBuffer: "
+                      "recv(%d, *, " FMT_U_MEM ", 0) failed:\n"
+                      "%s=%d\nerror: %s\n",
+                      readBuffer->socketNumber,
+                      (memSizeType) SOCKET_READ_BUFFER_SIZE,
+                      ERROR_INFORMATION););
+      bytes_received = 0;
+    } /* if */
+    readBuffer->pos = 0;
+    readBuffer->end = bytes_received;
+    if (bytes_received != 0) {
+      readBuffer->prevPending = NULL;
+      readBuffer->nextPending = pendingBuffers;
+      if (pendingBuffers != NULL) {
+        pendingBuffers->prevPending = readBuffer;
+      } /* if */
+      pendingBuffers = readBuffer;
+    } /* if */
+    return bytes_received;
+  } /* fillReadBuffer */
+
+
+
+static inline void consumeReadBuffer (const socketBufferType readBuffer,
+    memSizeType length)
+
+  { /* consumeReadBuffer */
+    readBuffer->pos += length;
+    if (readBuffer->pos == readBuffer->end && length != 0) {
+      unlinkPending(readBuffer);
+    } /* if */
+  } /* consumeReadBuffer */
+
+
+
+/**
+ *  Read a byte from the read buffer and refill it if necessary.
+ *  @return the byte read, or EOF.
+ */
+static int readBufferGetc (const socketBufferType readBuffer)
+
+  {
+    int ch;
+
+  /* readBufferGetc */
+    if (readBuffer->pos == readBuffer->end &&
+        fillReadBuffer(readBuffer) == 0) {
+      ch = EOF;
+    } else {
+      ch = readBuffer->data[readBuffer->pos];
+      consumeReadBuffer(readBuffer, 1);
+    } /* if */
+    return ch;
+  } /* readBufferGetc */
+
+
+
 /**
  *  Read a string, if we do not know how many bytes are available.
  *  This function reads data into a list of buffers. This is done
@@ -740,6 +901,7 @@ socketType socAccept (const const_socketType listenerSocket,
             (*address)->size = (memSizeType) addrlen;
             acceptedSocket->socketNumber = (socketNumberType) acceptedSockNum;
             acceptedSocket->usage_count = 1;
+            acceptedSocket->readBuffer = NULL;
           } /* if */
         } /* if */
       } /* if */
@@ -958,6 +1120,47 @@ void socBind (const const_socketType listenerSocket,
   } /* socBind */
 
 
+
+/**
+ *  Determine if at least one socket has unconsumed buffered input.
+ *  The poll functions use this to avoid calling socHasBufferedInput
+ *  for every socket.
+ *  @return TRUE if some read buffer contains unconsumed bytes.
+ */
+boolType socBufferedInputPending (void)
+
+  { /* socBufferedInputPending */
+    return pendingBuffers != NULL;
+  } /* socBufferedInputPending */
+
+
+
+/**
+ *  Get the sockets that have unconsumed buffered input.
+ *  At most 'capacity' socket numbers are copied to 'sockets'.
+ *  @return the number of sockets with buffered input. If this is
+ *          greater than 'capacity' the function should be called
+ *          again with a larger 'sockets' array.
+ */
+memSizeType socBufferedInputSockets (socketNumberType *sockets,
+    memSizeType capacity)
+
+  {
+    socketBufferType readBuffer;
+    memSizeType numSockets = 0;
+
+  /* socBufferedInputSockets */
+    for (readBuffer = pendingBuffers; readBuffer != NULL;
+         readBuffer = readBuffer->nextPending) {
+      if (numSockets < capacity) {
+        sockets[numSockets] = readBuffer->socketNumber;
+      } /* if */
+      numSockets++;
+    } /* for */
+    return numSockets;
+  } /* socBufferedInputSockets */
+
+
 /**
  *  Close the socket 'aSocket'.
  *  @exception FILE_ERROR A system function returns an error.
@@ -980,6 +1183,7 @@ void socClose (const socketType aSocket)
     } else {
       socketClose(aSocket->socketNumber);
       aSocket->socketNumber = EMPTY_SOCKET;
+      freeReadBuffer(aSocket);
     } /* if */
     logFunction(printf("socClose(" FMT_U_MEM " %d (usage=" FMT_U ")) -->\n",
                        (memSizeType) aSocket, aSocket->socketNumber,
@@ -1167,6 +1371,7 @@ void socFree (const socketType oldSocket)
     if (oldSocket->socketNumber != EMPTY_SOCKET) {
       socketClose(oldSocket->socketNumber);
     } /* if */
+    freeReadBuffer(oldSocket);
     FREE_RECORD(oldSocket, socketRecord, count.sockets);
   } /* socFree */
 
@@ -1180,8 +1385,8 @@ charType socGetc (const const_socketType inSocket,
     charType *const eofIndicator)
 
   {
-    unsigned char ch;
-    memSizeType bytes_received;
+    socketBufferType readBuffer;
+    int ch;
     charType result;
 
   /* socGetc */
@@ -1198,15 +1403,18 @@ charType socGetc (const const_socketType inSocket,
       raise_error(FILE_ERROR);
       result = 0;
     } else {
-      bytes_received = (memSizeType) recv((os_socketType) inSocket->socketNumber,
-                                          cast_send_recv_data(&ch), 1, 0);
-      logMessage(printf("socGetc: bytes_received=" FMT_U_MEM "\n",
-                        bytes_received););
-      if (bytes_received != 1) {
-        *eofIndicator = (charType) EOF;
-        result = (charType) EOF;
+      readBuffer = getReadBuffer(inSocket);
+      if (unlikely(readBuffer == NULL)) {
+        raise_error(MEMORY_ERROR);
+        result = 0;
       } else {
-        result = (charType) ch;
+        ch = readBufferGetc(readBuffer);
+        if (ch == EOF) {
+          *eofIndicator = (charType) EOF;
+          result = (charType) EOF;
+        } else {
+          result = (charType) ch;
+        } /* if */
       } /* if */
     } /* if */
     logFunction(printf("socGetc (%d, '\\" FMT_U32 ";') "
@@ -1230,6 +1438,7 @@ striType socGets (const const_socketType inSocket, intType length,
   {
     memSizeType chars_requested;
     memSizeType result_size;
+    socketBufferType readBuffer;
     errInfoType err_info = OKAY_NO_ERROR;
     striType resized_result;
     striType result;
@@ -1269,21 +1478,18 @@ striType socGets (const const_socketType inSocket, intType length,
       } else {
         chars_requested = (memSizeType) length;
       } /* if */
-      if (chars_requested <= BUFFER_SIZE) {
-        ucharType buffer[BUFFER_SIZE];
-
-        result_size = (memSizeType) recv((os_socketType) inSocket->socketNumber,
-                                         cast_send_recv_data(buffer),
-                                         cast_buffer_len(chars_requested), 0);
-        logMessage(printf("socGets: result_size=" FMT_U_MEM "\n",
-                          result_size););
-        if (unlikely(result_size == (memSizeType) -1)) {
-          logError(printf("socGets: "
-                          "recv(%d, *, " FMT_U_MEM ", 0) failed:\n"
-                          "%s=%d\nerror: %s\n",
-                          inSocket->socketNumber, chars_requested,
-                          ERROR_INFORMATION););
-          result_size = 0;
+      readBuffer = getReadBuffer(inSocket);
+      if (unlikely(readBuffer == NULL)) {
+        raise_error(MEMORY_ERROR);
+        result = NULL;
+      } else if (readBuffer->pos != readBuffer->end ||
+                 chars_requested < SOCKET_READ_BUFFER_SIZE) {
+        if (readBuffer->pos == readBuffer->end) {
+          fillReadBuffer(readBuffer);
+        } /* if */
+        result_size = readBuffer->end - readBuffer->pos;
+        if (result_size > chars_requested) {
+          result_size = chars_requested;
         } /* if */
         if (unlikely(!ALLOC_STRI_CHECK_SIZE(result, result_size))) {
           logError(printf("socGets(%d, " FMT_D ", *): "
@@ -1292,7 +1498,9 @@ striType socGets (const const_socketType inSocket, intType length,
           raise_error(MEMORY_ERROR);
           result = NULL;
         } else {
-          memcpy_to_strelem(result->mem, buffer, result_size);
+          memcpy_to_strelem(result->mem, &readBuffer->data[readBuffer->pos],
+                            result_size);
+          consumeReadBuffer(readBuffer, result_size);
           result->size = result_size;
           if (result_size == 0) {
             *eofIndicator = (charType) EOF;
@@ -1508,18 +1716,37 @@ bstriType socGetPeerAddr (const const_socketType aSocket)
 
 
 
+/**
+ *  Determine if the read buffer of 'aSocket' contains unconsumed bytes.
+ *  Such bytes are not seen by poll() or select() of the socket.
+ *  @return TRUE if bytes can be read without a system call.
+ */
+boolType socHasBufferedInput (const socketNumberType aSocket)
+
+  {
+    socketBufferType readBuffer;
+
+  /* socHasBufferedInput */
+    readBuffer = pendingBuffers;
+    while (readBuffer != NULL && readBuffer->socketNumber != aSocket) {
+      readBuffer = readBuffer->nextPending;
+    } /* while */
+    return readBuffer != NULL;
+  } /* socHasBufferedInput */
+
+
+
 /**
  *  Determine if at least one character can be read successfully.
  *  This function allows a socket to be handled like an iterator.
- *  Since socHasNext peeks the next character from the socket
- *  it may block.
+ *  If the read buffer of the socket is empty socHasNext receives
+ *  data into it. Because of that it may block.
  *  @return FALSE if socGetc would return EOF, TRUE otherwise.
  */
 boolType socHasNext (const const_socketType inSocket)
 
   {
-    unsigned char next_char;
-    memSizeType bytes_received;
+    socketBufferType readBuffer;
     boolType hasNext;
 
   /* socHasNext */
@@ -1532,16 +1759,13 @@ boolType socHasNext (const const_socketType inSocket)
       raise_error(FILE_ERROR);
       hasNext = FALSE;
     } else {
-      bytes_received = (memSizeType) recv((os_socketType) inSocket->socketNumber,
-                                          cast_send_recv_data(&next_char),
-                                          1, MSG_PEEK);
-      if (bytes_received != 1) {
-        logMessage(printf("socHasNext: bytes_received=" FMT_U_MEM "\n",
-                          bytes_received););
+      readBuffer = getReadBuffer(inSocket);
+      if (unlikely(readBuffer == NULL)) {
+        raise_error(MEMORY_ERROR);
         hasNext = FALSE;
       } else {
-        logMessage(printf("socHasNext: next_char=%d\n", next_char););
-        hasNext = TRUE;
+        hasNext = readBuffer->pos != readBuffer->end ||
+                  fillReadBuffer(readBuffer) != 0;
       } /* if */
     } /* if */
     logFunction(printf("socHasNext(%d) --> %d\n",
@@ -1979,6 +2203,9 @@ boolType socInputReady (const const_socketType inSocket,
                       seconds, micro_seconds););
       raise_error(FILE_ERROR);
       inputReady = FALSE;
+    } else if (inSocket->readBuffer != NULL &&
+               inSocket->readBuffer->pos != inSocket->readBuffer->end) {
+      inputReady = TRUE;
     } else {
       inputReady = socketInputReady(inSocket->socketNumber,
                                     seconds, micro_seconds);
@@ -1991,9 +2218,6 @@ boolType socInputReady (const const_socketType inSocket,
 
 
 
-#define BUFFER_START_SIZE 256
-#define BUFFER_DELTA_SIZE 256
-
 /**
  *  Read a line from 'inSocket'.
  *  The function accepts lines ending with "\n", "\r\n" or EOF.
@@ -2007,16 +2231,15 @@ striType socLineRead (const const_socketType inSocket,
     charType *const terminationChar)
 
   {
-    os_socketType inSocketNumber;
-    memSizeType bytes_received;
-    memSizeType bytes_requested;
+    socketBufferType readBuffer;
+    const_ustriType chunk_start;
+    const_ustriType nlPos;
+    memSizeType chunk_size;
     memSizeType result_size;
-    memSizeType old_result_size;
-    memSizeType result_pos;
-    ucharType *nlPos;
-    ucharType buffer[BUFFER_SIZE];
+    memSizeType result_pos = 0;
+    boolType lineEnded = FALSE;
     striType resized_result;
-    striType result;
+    striType result = NULL;
 
   /* socLineRead */
     logFunction(printf("socLineRead(%d, '\\" FMT_U32 ";')\n",
@@ -2029,187 +2252,62 @@ striType socLineRead (const const_socketType inSocket,
                       "Attempt to read from closed socket.\n",
                       inSocket->socketNumber, *terminationChar););
       raise_error(FILE_ERROR);
-      result = NULL;
+    } else if (unlikely((readBuffer = getReadBuffer(inSocket)) == NULL)) {
+      raise_error(MEMORY_ERROR);
     } else {
-      inSocketNumber = (os_socketType) inSocket->socketNumber;
-      bytes_received = (memSizeType) recv(inSocketNumber,
-                                          cast_send_recv_data(buffer),
-                                          cast_buffer_len(BUFFER_START_SIZE),
-                                          MSG_PEEK);
-      logMessage(printf("socLineRead: bytes_received=" FMT_U_MEM "\n",
-                        bytes_received););
-      if (unlikely(bytes_received == (memSizeType) -1)) {
-        logError(printf("socLineRead: "
-                        "recv(%d, *, " FMT_U_MEM ", MSG_PEEK) failed:\n"
-                        "%s=%d\nerror: %s\n",
-                        inSocketNumber, (memSizeType) BUFFER_START_SIZE,
-                        ERROR_INFORMATION););
-        bytes_received = 0;
-      } /* if */
-      if (bytes_received == 0) {
-        emptyStriType emptyStri;
-
-        if (unlikely(!ALLOC_EMPTY_STRI(emptyStri))) {
-          raise_error(MEMORY_ERROR);
-        } else {
-          emptyStri->size = 0;
-          *terminationChar = (charType) EOF;
+      result_size = 0;
+      do {
+        chunk_start = &readBuffer->data[readBuffer->pos];
+        chunk_size = readBuffer->end - readBuffer->pos;
+        nlPos = (const_ustriType) memchr(chunk_start, '\n', chunk_size);
+        if (nlPos != NULL) {
+          chunk_size = (memSizeType) (nlPos - chunk_start);
         } /* if */
-        result = (striType) emptyStri;
-      } else {
-        nlPos = (ucharType *) memchr(buffer, '\n', bytes_received);
+        if (result == NULL) {
+          /* Usually the whole line is already in the read buffer. */
+          result_size = chunk_size;
+          if (unlikely(!ALLOC_STRI_CHECK_SIZE(result, result_size))) {
+            raise_error(MEMORY_ERROR);
+            return NULL;
+          } /* if */
+        } else if (result_pos + chunk_size > result_size) {
+          REALLOC_STRI_CHECK_SIZE2(resized_result, result, result_size,
+                                   result_pos + chunk_size);
+          if (unlikely(resized_result == NULL)) {
+            FREE_STRI2(result, result_size);
+            raise_error(MEMORY_ERROR);
+            return NULL;
+          } /* if */
+          result = resized_result;
+          result_size = result_pos + chunk_size;
+        } /* if */
+        memcpy_to_strelem(&result->mem[result_pos], chunk_start, chunk_size);
+        result_pos += chunk_size;
         if (nlPos != NULL) {
-          bytes_requested = (memSizeType) (nlPos - buffer) + 1;
-          /* This should overwrite the buffer with identical data up to '\n'. */
-          bytes_received = (memSizeType) recv(inSocketNumber,
-                                              cast_send_recv_data(buffer),
-                                              cast_buffer_len(bytes_requested), 0);
-          /* bytes_received should always be identical to bytes_requested. */
-          if (unlikely(bytes_received != bytes_requested)) {
-            logError(printf("socLineRead: "
-                            "recv(%d, *, " FMT_U_MEM ") failed:\n"
-                            "%s=%d\nerror: %s\n",
-                            inSocketNumber, bytes_requested,
-                            ERROR_INFORMATION););
-            raise_error(FILE_ERROR);
-            result = NULL;
-          } else {
-            result_size = bytes_requested - 1;
-            if (nlPos != buffer && nlPos[-1] == '\r') {
-              result_size--;
-            } /* if */
-            if (unlikely(!ALLOC_STRI_CHECK_SIZE(result, result_size))) {
-              raise_error(MEMORY_ERROR);
-              result = NULL;
-            } else {
-              memcpy_to_strelem(result->mem, buffer, result_size);
-              result->size = result_size;
-              *terminationChar = '\n';
-            } /* if */
+          consumeReadBuffer(readBuffer, chunk_size + 1);
+          *terminationChar = '\n';
+          lineEnded = TRUE;
+          if (result_pos != 0 && result->mem[result_pos - 1] == '\r') {
+            result_pos--;
           } /* if */
         } else {
-          result_size = bytes_received;
-          old_result_size = 0;
-          result_pos = 0;
-          result = NULL;
-          do {
-            bytes_requested = bytes_received;
-            /* This should overwrite the buffer with identical data. */
-            bytes_received = (memSizeType) recv(inSocketNumber,
-                                                cast_send_recv_data(buffer),
-                                                cast_buffer_len(bytes_requested), 0);
-            /* bytes_received should always be identical to bytes_requested. */
-            if (unlikely(bytes_received != bytes_requested)) {
-              logError(printf("socLineRead: "
-                              "recv(%d, *, " FMT_U_MEM ") failed:\n"
-                              "%s=%d\nerror: %s\n",
-                              inSocketNumber, bytes_requested,
-                              ERROR_INFORMATION););
-              if (result != NULL) {
-                FREE_STRI2(result, old_result_size);
-              } /* if */
-              raise_error(FILE_ERROR);
-              result = NULL;
-            } else {
-              result_size += BUFFER_DELTA_SIZE;
-              /* printf("A result=%08lx, old_result_size=%d, result_size=%d\n",
-                  (unsigned long) result, old_result_size, result_size); */
-              REALLOC_STRI_CHECK_SIZE2(resized_result, result, old_result_size, result_size);
-              /* printf("B result=%08lx, resized_result=%08lx\n",
-                  (unsigned long) result, (unsigned long) resized_result); */
-              if (unlikely(resized_result == NULL)) {
-                if (result != NULL) {
-                  FREE_STRI2(result, old_result_size);
-                } /* if */
-                raise_error(MEMORY_ERROR);
-                result = NULL;
-              } else {
-                result = resized_result;
-                old_result_size = result_size;
-                /* printf("a result[%d], size=%d\n", result_pos, bytes_requested); */
-                memcpy_to_strelem(&result->mem[result_pos], buffer, bytes_requested);
-                result_pos += bytes_requested;
-                bytes_received = (memSizeType) recv(inSocketNumber,
-                                                    cast_send_recv_data(buffer),
-                                                    cast_buffer_len(BUFFER_DELTA_SIZE),
-                                                    MSG_PEEK);
-                if (unlikely(bytes_received == (memSizeType) -1)) {
-                  logError(printf("socLineRead: "
-                                  "recv(%d, *, " FMT_U_MEM ", MSG_PEEK) failed:\n"
-                                  "%s=%d\nerror: %s\n",
-                                  inSocketNumber, (memSizeType) BUFFER_DELTA_SIZE,
-                                  ERROR_INFORMATION););
-                  bytes_received = 0;
-                } /* if */
-                if (bytes_received == 0) {
-                  REALLOC_STRI_CHECK_SIZE2(resized_result, result, result_size, result_pos);
-                  if (unlikely(resized_result == NULL)) {
-                    FREE_STRI2(result, result_size);
-                    raise_error(MEMORY_ERROR);
-                    result = NULL;
-                  } else {
-                    result = resized_result;
-                    result->size = result_pos;
-                    *terminationChar = (charType) EOF;
-                  } /* if */
-                } else {
-                  nlPos = (ucharType *) memchr(buffer, '\n', bytes_received);
-                } /* if */
-              } /* if */
-            } /* if */
-          } while (result != NULL && bytes_received != 0 && nlPos == NULL);
-          if (result != NULL && nlPos != NULL) {
-            bytes_requested = (memSizeType) (nlPos - buffer) + 1;
-            /* This should overwrite the buffer with identical data up to '\n'. */
-            bytes_received = (memSizeType) recv(inSocketNumber,
-                                                cast_send_recv_data(buffer),
-                                                cast_buffer_len(bytes_requested), 0);
-            /* bytes_received should always be identical to bytes_requested. */
-            if (unlikely(bytes_received != bytes_requested)) {
-              logError(printf("socLineRead: "
-                              "recv(%d, *, " FMT_U_MEM ") failed:\n"
-                              "%s=%d\nerror: %s\n",
-                              inSocketNumber, bytes_requested,
-                              ERROR_INFORMATION););
-              FREE_STRI2(result, old_result_size);
-              raise_error(FILE_ERROR);
-              result = NULL;
-            } else {
-              bytes_requested--;
-              if (nlPos == buffer) {
-                /* The first character of the read buffer is a newline. */
-                /* Note that this place can only be reached after at    */
-                /* least one character has been successfully read.      */
-                /* Because of that result_pos >= 1 holds.               */
-                if (result->mem[result_pos - 1] == '\r') {
-                  /* If the last character in result->mem is a carriage */
-                  /* return it is removed by decrementing result_pos.   */
-                  result_pos--;
-                } /* if */
-              } else if (nlPos[-1] == '\r') {
-                bytes_requested--;
-              } /* if */
-              old_result_size = result_size;
-              result_size = result_pos + bytes_requested;
-              /* printf("C result=%08lx, old_result_size=%d, result_size=%d\n",
-                  (unsigned long) result, old_result_size, result_size); */
-              REALLOC_STRI_CHECK_SIZE2(resized_result, result, old_result_size, result_size);
-              /* printf("D result=%08lx, resized_result=%08lx\n",
-                  (unsigned long) result, (unsigned long) resized_result); */
-              if (unlikely(resized_result == NULL)) {
-                FREE_STRI2(result, old_result_size);
-                raise_error(MEMORY_ERROR);
-                result = NULL;
-              } else {
-                result = resized_result;
-                /* printf("e result[%d], size=%d\n", result_pos, bytes_requested); */
-                memcpy_to_strelem(&result->mem[result_pos], buffer, bytes_requested);
-                result->size = result_size;
-                *terminationChar = '\n';
-              } /* if */
-            } /* if */
+          consumeReadBuffer(readBuffer, chunk_size);
+          if (fillReadBuffer(readBuffer) == 0) {
+            *terminationChar = (charType) EOF;
+            lineEnded = TRUE;
           } /* if */
         } /* if */
+      } while (!lineEnded);
+      result->size = result_pos;
+      if (result_pos != result_size) {
+        REALLOC_STRI_SIZE_SMALLER2(resized_result, result, result_size, result_pos);
+        if (unlikely(resized_result == NULL)) {
+          FREE_STRI2(result, result_size);
+          raise_error(MEMORY_ERROR);
+          result = NULL;
+        } else {
+          result = resized_result;
+        } /* if */
       } /* if */
     } /* if */
     logFunction(printf("socLineRead(%d, '\\" FMT_U32 ";') --> \"%s\"\n",
@@ -2274,6 +2372,7 @@ intType socRecv (const const_socketType inSocket, striType *const stri,
     intType length, intType flags)
 
   {
+    socketBufferType readBuffer;
     striType resized_stri;
     memSizeType bytes_requested;
     memSizeType old_stri_size;
@@ -2313,11 +2412,27 @@ intType socRecv (const const_socketType inSocket, striType *const stri,
         *stri = resized_stri;
         old_stri_size = bytes_requested;
       } /* if */
-      new_stri_size = (memSizeType) recv((os_socketType) inSocket->socketNumber,
-                                         cast_send_recv_data((*stri)->mem),
-                                         cast_buffer_len(bytes_requested), (int) flags);
+      readBuffer = inSocket->readBuffer;
+      if (readBuffer != NULL && readBuffer->pos != readBuffer->end) {
+        /* Bytes in the read buffer have been received before. */
+        new_stri_size = readBuffer->end - readBuffer->pos;
+        if (new_stri_size > bytes_requested) {
+          new_stri_size = bytes_requested;
+        } /* if */
+        memcpy_to_strelem((*stri)->mem, &readBuffer->data[readBuffer->pos],
+                          new_stri_size);
+        if ((flags & MSG_PEEK) == 0) {
+          consumeReadBuffer(readBuffer, new_stri_size);
+        } /* if */
+      } else {
+        new_stri_size = (memSizeType) recv((os_socketType) inSocket->socketNumber,
+                                           cast_send_recv_data((*stri)->mem),
+                                           cast_buffer_len(bytes_requested), (int) flags);
+        if (likely(new_stri_size != (memSizeType) -1)) {
+          memcpy_to_strelem((*stri)->mem, (ustriType) (*stri)->mem, new_stri_size);
+        } /* if */
+      } /* if */
       if (likely(new_stri_size != (memSizeType) -1)) {
-        memcpy_to_strelem((*stri)->mem, (ustriType) (*stri)->mem, new_stri_size);
         (*stri)->size = new_stri_size;
         if (new_stri_size < old_stri_size) {
           REALLOC_STRI_SIZE_OK2(resized_stri, *stri, old_stri_size, new_stri_size);
@@ -2637,6 +2752,7 @@ socketType socSocket (intType domain, intType type, intType protocol)
       } else {
         newSocket->socketNumber = (socketNumberType) socketNumber;
         newSocket->usage_count = 1;
+        newSocket->readBuffer = NULL;
       } /* if */
     } /* if */
     logFunction(printf("socSocket(" FMT_D ", " FMT_D ", " FMT_D ") "
@@ -2665,9 +2781,9 @@ striType socWordRead (const const_socketType inSocket,
     charType *const terminationChar)
 
   {
-    unsigned char ch;
+    socketBufferType readBuffer;
+    int ch;
     register memSizeType position;
-    register memSizeType bytes_received;
     strElemType *memory;
     memSizeType memlength = READ_STRI_INIT_SIZE;
     memSizeType newmemlength;
@@ -2686,16 +2802,17 @@ striType socWordRead (const const_socketType inSocket,
                       inSocket->socketNumber, *terminationChar););
       raise_error(FILE_ERROR);
       result = NULL;
-    } else if (unlikely(!ALLOC_STRI_SIZE_OK(result, memlength))) {
+    } else if (unlikely((readBuffer = getReadBuffer(inSocket)) == NULL ||
+                        !ALLOC_STRI_SIZE_OK(result, memlength))) {
       raise_error(MEMORY_ERROR);
+      result = NULL;
     } else {
       memory = result->mem;
       position = 0;
       do {
-        bytes_received = (memSizeType) recv((os_socketType) inSocket->socketNumber,
-                                            cast_send_recv_data(&ch), 1, 0);
-      } while (bytes_received == 1 && (ch == ' ' || ch == '\t'));
-      while (bytes_received == 1 &&
+        ch = readBufferGetc(readBuffer);
+      } while (ch == ' ' || ch == '\t');
+      while (ch != EOF &&
           ch != ' ' && ch != '\t' && ch != '\n') {
         if (position >= memlength) {
           newmemlength = memlength + READ_STRI_SIZE_DELTA;
@@ -2710,10 +2827,9 @@ striType socWordRead (const const_socketType inSocket,
           memlength = newmemlength;
         } /* if */
         memory[position++] = (strElemType) ch;
-        bytes_received = (memSizeType) recv((os_socketType) inSocket->socketNumber,
-                                            cast_send_recv_data(&ch), 1, 0);
+        ch = readBufferGetc(readBuffer);
       } /* while */
-      if (bytes_received == 1 && ch == '\n' &&
+      if (ch == '\n' &&
           position != 0 && memory[position - 1] == '\r') {
         position--;
       } /* if */
@@ -2725,11 +2841,7 @@ striType socWordRead (const const_socketType inSocket,
       } else {
         result = resized_result;
         result->size = position;
-        if (bytes_received != 1) {
-          *terminationChar = (charType) EOF;
-        } else {
-          *terminationChar = (charType) ch;
-        } /* if */
+        *terminationChar = (charType) ch;
       } /* if */
     } /* if */
     logFunction(printf("socWordRead(%d, '\\" FMT_U32 ";') --> \"%s\"\n",
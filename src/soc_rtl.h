@@ -1,7 +1,7 @@
 /********************************************************************/
 /*                                                                  */
 /*  soc_rtl.h     Primitive actions for the socket type.            */
-/*  Copyright (C) 1989 - 2007  Thomas Mertes                        */
+/*  Copyright (C) 1989 - 2007, 2026  Thomas Mertes                  */
 /*                                                                  */
 /*  This file is part of the Seed7 Runtime Library.                 */
 /*                                                                  */
@@ -24,13 +24,13 @@
 /*                                                                  */
 /*  Module: Seed7 Runtime Library                                   */
 /*  File: seed7/src/soc_rtl.h                                       */
-/*  Changes: 2007  Thomas Mertes                                    */
+/*  Changes: 2007, 2026  Thomas Mertes                              */
 /*  Content: Primitive actions for the socket type.                 */
 /*                                                                  */
 /********************************************************************/
 
 #ifdef DO_INIT
-socketRecord emptySocketRecord = {(socketNumberType) -1, 0};
+socketRecord emptySocketRecord = {(socketNumberType) -1, 0, NULL};
 #else
 EXTERN socketRecord emptySocketRecord;
 #endif
@@ -55,6 +55,9 @@ striType socAddrNumeric (const const_bstriType address);
 striType socAddrService (const const_bstriType address);
 void socBind (const const_socketType listenerSocket,
               const const_bstriType address);
+boolType socBufferedInputPending (void);
+memSizeType socBufferedInputSockets (socketNumberType *sockets,
+                                     memSizeType capacity);
 void socClose (const socketType aSocket);
 void socConnect (const const_socketType aSocket,
                  const const_bstriType address);
@@ -69,6 +72,7 @@ striType socGets (const const_socketType inSocket, intType length,
 striType socGetHostname (void);
 bstriType socGetLocalAddr (const const_socketType aSocket);
 bstriType socGetPeerAddr (const const_socketType aSocket);
+boolType socHasBufferedInput (const socketNumberType aSocket);
 boolType socHasNext (const const_socketType inSocket);
 bstriType socInetAddr (const const_striType hostName, intType port);
 bstriType socInetLocalAddr (intType port);
@@ -24,7 +24,7 @@
 /*                                                                  */
 /*  Module: Seed7 Runtime Library                                   */
 /*  File: seed7/src/sql_cli.c                                       */
-/*  Changes: 2014, 2015, 2017 - 2020, 2022  Thomas Mertes           */
+/*  Changes: 2014, 2015, 2017 - 2020, 2022, 2026  Thomas Mertes     */
 /*  Content: Database access functions for ODBC/CLI interface.      */
 /*                                                                  */
 /********************************************************************/
@@ -37,6 +37,7 @@ typedef struct {
     sqlFuncType  sqlFunc;
     int          driver;
     int          dbCategory;
+    stmtCacheType stmtCache;
     SQLHENV      sql_environment;
     SQLHDBC      connection;
     boolType     wideCharsSupported;
@@ -99,6 +100,9 @@ typedef struct {
     boolType        executeSuccessful;
     boolType        fetchOkay;
     boolType        fetchFinished;
+    fetchDataType  *batchFetch;
+    memSizeType     batchCapacity;
+    intType         batchSize;
   } preparedStmtRecordCli, *preparedStmtType;
 
 static sqlFuncType sqlFunc = NULL;
@@ -796,6 +800,24 @@ static void freeFetch (preparedStmtType preparedStmt, fetchDataType fetchData)
 
 
 
+static void freeBatch (preparedStmtType preparedStmt)
+
+  {
+    intType pos;
+
+  /* freeBatch */
+    if (preparedStmt->batchSize != 0) {
+      for (pos = 0; pos < preparedStmt->batchSize; pos++) {
+        freeFetch(preparedStmt, preparedStmt->batchFetch[pos]);
+      } /* for */
+      preparedStmt->batchSize = 0;
+      /* The current row was a row of the batch. */
+      preparedStmt->currentFetch = NULL;
+    } /* if */
+  } /* freeBatch */
+
+
+
 static void freePrefetched (preparedStmtType preparedStmt)
 
   {
@@ -803,6 +825,7 @@ static void freePrefetched (preparedStmtType preparedStmt)
     fetchDataType oldFetchData;
 
   /* freePrefetched */
+    freeBatch(preparedStmt);
     prefetched = preparedStmt->prefetched;
     while (prefetched != NULL) {
       oldFetchData = prefetched;
@@ -837,6 +860,9 @@ static void freePreparedStmt (sqlStmtType sqlStatement)
       FREE_TABLE(preparedStmt->result_descr_array, resultDataRecordCli, preparedStmt->result_array_size);
     } /* if */
     freePrefetched(preparedStmt);
+    if (preparedStmt->batchFetch != NULL) {
+      FREE_TABLE(preparedStmt->batchFetch, fetchDataType, preparedStmt->batchCapacity);
+    } /* if */
     freeFetchData(preparedStmt, &preparedStmt->fetchRecord);
     if (preparedStmt->db->connection != SQL_NULL_HANDLE) {
       if (preparedStmt->executeSuccessful) {
@@ -3370,6 +3396,40 @@ static errInfoType doFetch (preparedStmtType preparedStmt, fetchDataType boundFe
 
 
 
+static void sqlBatchSelectRow (sqlStmtType sqlStatement, intType row)
+
+  {
+    preparedStmtType preparedStmt;
+
+  /* sqlBatchSelectRow */
+    logFunction(printf("sqlBatchSelectRow(" FMT_U_MEM ", " FMT_D ")\n",
+                       (memSizeType) sqlStatement, row););
+    preparedStmt = (preparedStmtType) sqlStatement;
+    if (unlikely(row < 1 || row > preparedStmt->batchSize)) {
+      logError(printf("sqlBatchSelectRow: row: " FMT_D ", batch size: " FMT_D ".\n",
+                      row, preparedStmt->batchSize););
+      raise_error(RANGE_ERROR);
+    } else {
+      preparedStmt->currentFetch = preparedStmt->batchFetch[row - 1];
+      preparedStmt->fetchOkay = TRUE;
+    } /* if */
+    logFunction(printf("sqlBatchSelectRow -->\n"););
+  } /* sqlBatchSelectRow */
+
+
+
+static intType sqlBatchSize (sqlStmtType sqlStatement)
+
+  { /* sqlBatchSize */
+    logFunction(printf("sqlBatchSize(" FMT_U_MEM ")\n",
+                       (memSizeType) sqlStatement););
+    logFunction(printf("sqlBatchSize --> " FMT_D "\n",
+                       ((preparedStmtType) sqlStatement)->batchSize););
+    return ((preparedStmtType) sqlStatement)->batchSize;
+  } /* sqlBatchSize */
+
+
+
 static void sqlBindBigInt (sqlStmtType sqlStatement, intType pos,
     const const_bigIntType value)
 
@@ -5971,6 +6031,7 @@ static boolType sqlFetch (sqlStmtType sqlStatement)
     logFunction(printf("sqlFetch(" FMT_U_MEM ")\n",
                        (memSizeType) sqlStatement););
     preparedStmt = (preparedStmtType) sqlStatement;
+    freeBatch(preparedStmt);
     if (unlikely(!preparedStmt->executeSuccessful)) {
       dbLibError("sqlFetch", "SQLExecute",
                  "Execute was not successful.\n");
@@ -6004,6 +6065,9 @@ static boolType sqlFetch (sqlStmtType sqlStatement)
           /* Errors of SQLFetch() have already been handled. */
         } /* if */
       } /* if */
+    } else {
+      /* The fetchOkay flag of a batch row is not valid anymore. */
+      preparedStmt->fetchOkay = FALSE;
     } /* if */
     logFunction(printf("sqlFetch --> %d\n", preparedStmt->fetchOkay););
     return preparedStmt->fetchOkay;
@@ -6011,6 +6075,126 @@ static boolType sqlFetch (sqlStmtType sqlStatement)
 
 
 
+/**
+ *  Make room for 'minCapacity' rows in the batch of 'preparedStmt'.
+ */
+static errInfoType reserveBatch (preparedStmtType preparedStmt,
+    memSizeType minCapacity)
+
+  {
+    memSizeType newCapacity;
+    fetchDataType *resizedBatch;
+    errInfoType err_info = OKAY_NO_ERROR;
+
+  /* reserveBatch */
+    if (preparedStmt->batchCapacity < minCapacity) {
+      newCapacity = preparedStmt->batchCapacity * 2;
+      if (newCapacity < minCapacity) {
+        newCapacity = minCapacity;
+      } /* if */
+      if (unlikely(newCapacity > MAX_MEMSIZETYPE / sizeof(fetchDataType))) {
+        err_info = MEMORY_ERROR;
+      } else if (preparedStmt->batchFetch == NULL) {
+        if (unlikely(!ALLOC_TABLE(preparedStmt->batchFetch, fetchDataType,
+                                  newCapacity))) {
+          err_info = MEMORY_ERROR;
+        } else {
+          preparedStmt->batchCapacity = newCapacity;
+        } /* if */
+      } else {
+        resizedBatch = REALLOC_TABLE(preparedStmt->batchFetch, fetchDataType,
+                                     preparedStmt->batchCapacity, newCapacity);
+        if (unlikely(resizedBatch == NULL)) {
+          err_info = MEMORY_ERROR;
+        } else {
+          COUNT3_TABLE(fetchDataType, preparedStmt->batchCapacity, newCapacity);
+          preparedStmt->batchFetch = resizedBatch;
+          preparedStmt->batchCapacity = newCapacity;
+        } /* if */
+      } /* if */
+    } /* if */
+    return err_info;
+  } /* reserveBatch */
+
+
+
+/**
+ *  Fetch up to 'maxRows' rows into the batch of 'sqlStatement'.
+ *  Every row is copied from the bound result buffers into its own
+ *  fetch data (like it is done for prefetched rows). Rows, which
+ *  have already been prefetched, are moved to the batch.
+ */
+static intType sqlFetchBatch (sqlStmtType sqlStatement, intType maxRows)
+
+  {
+    preparedStmtType preparedStmt;
+    fetchDataType fetchData;
+    errInfoType err_info = OKAY_NO_ERROR;
+
+  /* sqlFetchBatch */
+    logFunction(printf("sqlFetchBatch(" FMT_U_MEM ", " FMT_D ")\n",
+                       (memSizeType) sqlStatement, maxRows););
+    preparedStmt = (preparedStmtType) sqlStatement;
+    freeBatch(preparedStmt);
+    if (unlikely(!preparedStmt->executeSuccessful)) {
+      dbLibError("sqlFetchBatch", "SQLExecute",
+                 "Execute was not successful.\n");
+      logError(printf("sqlFetchBatch: Execute was not successful.\n"););
+      preparedStmt->fetchOkay = FALSE;
+      raise_error(DATABASE_ERROR);
+    } else if (preparedStmt->result_array_size == 0 ||
+               preparedStmt->fetchFinished) {
+      preparedStmt->fetchOkay = FALSE;
+    } else {
+      if (preparedStmt->currentFetch != NULL &&
+          preparedStmt->currentFetch != &preparedStmt->fetchRecord) {
+        freeFetch(preparedStmt, preparedStmt->currentFetch);
+      } /* if */
+      preparedStmt->currentFetch = NULL;
+      while (preparedStmt->batchSize < maxRows && !preparedStmt->fetchFinished &&
+             err_info == OKAY_NO_ERROR) {
+        if (preparedStmt->prefetched != NULL) {
+          fetchData = preparedStmt->prefetched;
+          preparedStmt->prefetched = fetchData->next;
+          fetchData->next = NULL;
+        } else {
+          fetchData = prefetchOne(preparedStmt, &preparedStmt->fetchRecord, &err_info);
+        } /* if */
+        if (fetchData != NULL) {
+          if (fetchData->fetch_result == SQL_SUCCESS) {
+            err_info = reserveBatch(preparedStmt,
+                                    (memSizeType) preparedStmt->batchSize + 1);
+            if (unlikely(err_info != OKAY_NO_ERROR)) {
+              freeFetch(preparedStmt, fetchData);
+            } else {
+              preparedStmt->batchFetch[preparedStmt->batchSize] = fetchData;
+              preparedStmt->batchSize++;
+            } /* if */
+          } else {
+            /* SQL_NO_DATA */
+            freeFetch(preparedStmt, fetchData);
+            preparedStmt->fetchFinished = TRUE;
+          } /* if */
+        } /* if */
+      } /* while */
+      if (unlikely(err_info != OKAY_NO_ERROR)) {
+        freeBatch(preparedStmt);
+        preparedStmt->fetchOkay = FALSE;
+        preparedStmt->fetchFinished = TRUE;
+        raise_error(err_info);
+      } else if (preparedStmt->batchSize != 0) {
+        sqlBatchSelectRow(sqlStatement, preparedStmt->batchSize);
+      } else {
+        preparedStmt->fetchOkay = FALSE;
+      } /* if */
+    } /* if */
+    logFunction(printf("sqlFetchBatch --> " FMT_D "\n",
+                       preparedStmt->batchSize););
+    return preparedStmt->batchSize;
+  } /* sqlFetchBatch */
+
+
+
 static boolType sqlGetAutoCommit (databaseType database)
 
   {
@@ -6373,6 +6557,8 @@ static boolType setupFuncTable (void)
         memset(sqlFunc, 0, sizeof(sqlFuncRecord));
         sqlFunc->freeDatabase       = &freeDatabase;
         sqlFunc->freePreparedStmt   = &freePreparedStmt;
+        sqlFunc->sqlBatchSelectRow  = &sqlBatchSelectRow;
+        sqlFunc->sqlBatchSize       = &sqlBatchSize;
         sqlFunc->sqlBindBigInt      = &sqlBindBigInt;
         sqlFunc->sqlBindBigRat      = &sqlBindBigRat;
         sqlFunc->sqlBindBool        = &sqlBindBool;
@@ -6396,6 +6582,7 @@ static boolType setupFuncTable (void)
         sqlFunc->sqlCommit          = &sqlCommit;
         sqlFunc->sqlExecute         = &sqlExecute;
         sqlFunc->sqlFetch           = &sqlFetch;
+        sqlFunc->sqlFetchBatch      = &sqlFetchBatch;
         sqlFunc->sqlGetAutoCommit   = &sqlGetAutoCommit;
         sqlFunc->sqlIsNull          = &sqlIsNull;
         sqlFunc->sqlPrepare         = &sqlPrepare;
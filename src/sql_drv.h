@@ -1,7 +1,7 @@
 /********************************************************************/
 /*                                                                  */
 /*  sql_drv.h     Prototypes for database access functions.         */
-/*  Copyright (C) 1989 - 2014  Thomas Mertes                        */
+/*  Copyright (C) 1989 - 2014, 2026  Thomas Mertes                  */
 /*                                                                  */
 /*  This file is part of the Seed7 Runtime Library.                 */
 /*                                                                  */
@@ -24,14 +24,18 @@
 /*                                                                  */
 /*  Module: Seed7 Runtime Library                                   */
 /*  File: seed7/src/sql_drv.h                                       */
-/*  Changes: 2013, 2014  Thomas Mertes                              */
+/*  Changes: 2013, 2014, 2026  Thomas Mertes                        */
 /*  Content: Prototypes for database access functions.              */
 /*                                                                  */
 /********************************************************************/
 
+typedef struct stmtCacheStruct *stmtCacheType;
+
 typedef struct {
     void (*freeDatabase) (databaseType database);
     void (*freePreparedStmt) (sqlStmtType sqlStatement);
+    void (*sqlBatchSelectRow) (sqlStmtType sqlStatement, intType row);
+    intType (*sqlBatchSize) (sqlStmtType sqlStatement);
     void (*sqlBindBigInt) (sqlStmtType sqlStatement, intType pos,
                            const const_bigIntType value);
     void (*sqlBindBigRat) (sqlStmtType sqlStatement, intType pos,
@@ -71,12 +75,15 @@ typedef struct {
     void (*sqlCommit) (databaseType database);
     void (*sqlExecute) (sqlStmtType sqlStatement);
     boolType (*sqlFetch) (sqlStmtType sqlStatement);
+    intType (*sqlFetchBatch) (sqlStmtType sqlStatement, intType maxRows);
     boolType (*sqlGetAutoCommit) (databaseType database);
     boolType (*sqlIsNull) (sqlStmtType sqlStatement, intType column);
     sqlStmtType (*sqlPrepare) (databaseType database,
                                const const_striType sqlStatementStri);
+    void (*sqlResetStmt) (sqlStmtType sqlStatement);
     void (*sqlRollback) (databaseType database);
     void (*sqlSetAutoCommit) (databaseType database, boolType autoCommit);
+    void (*sqlSetStreaming) (sqlStmtType sqlStatement, boolType streaming);
     intType (*sqlStmtColumnCount) (sqlStmtType sqlStatement);
     striType (*sqlStmtColumnName) (sqlStmtType sqlStatement, intType column);
   } sqlFuncRecord, *sqlFuncType;
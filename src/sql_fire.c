@@ -1,7 +1,7 @@
 /********************************************************************/
 /*                                                                  */
 /*  sql_fire.c    Database access functions for Firebird/InterBase. */
-/*  Copyright (C) 1989 - 2019  Thomas Mertes                        */
+/*  Copyright (C) 1989 - 2019, 2026  Thomas Mertes                  */
 /*                                                                  */
 /*  This file is part of the Seed7 Runtime Library.                 */
 /*                                                                  */
@@ -24,7 +24,7 @@
 /*                                                                  */
 /*  Module: Seed7 Runtime Library                                   */
 /*  File: seed7/src/sql_fire.c                                      */
-/*  Changes: 2018, 2019  Thomas Mertes                              */
+/*  Changes: 2018, 2019, 2026  Thomas Mertes                        */
 /*  Content: Database access functions for Firebird/InterBase.      */
 /*                                                                  */
 /********************************************************************/
@@ -67,6 +67,7 @@ typedef struct {
     sqlFuncType   sqlFunc;
     int           driver;
     int           dbCategory;
+    stmtCacheType stmtCache;
     isc_db_handle connection;
     isc_tr_handle trans_handle;
     boolType      autoCommit;
@@ -1,7 +1,7 @@
 /********************************************************************/
 /*                                                                  */
 /*  sql_lite.c    Database access functions for SQLite.             */
-/*  Copyright (C) 1989 - 2020  Thomas Mertes                        */
+/*  Copyright (C) 1989 - 2020, 2026  Thomas Mertes                  */
 /*                                                                  */
 /*  This file is part of the Seed7 Runtime Library.                 */
 /*                                                                  */
@@ -24,7 +24,7 @@
 /*                                                                  */
 /*  Module: Seed7 Runtime Library                                   */
 /*  File: seed7/src/sql_lite.c                                      */
-/*  Changes: 2013, 2014, 2015, 2017 - 2020  Thomas Mertes           */
+/*  Changes: 2013, 2014, 2015, 2017 - 2020, 2026  Thomas Mertes     */
 /*  Content: Database access functions for SQLite.                  */
 /*                                                                  */
 /********************************************************************/
@@ -68,6 +68,7 @@ typedef struct {
     sqlFuncType  sqlFunc;
     int          driver;
     int          dbCategory;
+    stmtCacheType stmtCache;
     sqlite3     *connection;
   } dbRecordLite, *dbType;
 
@@ -88,6 +89,10 @@ typedef struct {
     boolType      storedFetchResult;
     boolType      fetchOkay;
     boolType      fetchFinished;
+    sqlite3_value **batchValues;
+    memSizeType   batchCapacity;
+    intType       batchSize;
+    sqlite3_value **batchRow;
   } preparedStmtRecordLite, *preparedStmtType;
 
 static sqlFuncType sqlFunc = NULL;
@@ -135,6 +140,7 @@ typedef sqlite3_int64 (CDECL *tp_sqlite3_column_int64) (sqlite3_stmt *pStmt, int
 typedef const char *(CDECL *tp_sqlite3_column_name) (sqlite3_stmt *pStmt, int N);
 typedef const unsigned char *(CDECL *tp_sqlite3_column_text) (sqlite3_stmt *pStmt, int iCol);
 typedef int (CDECL *tp_sqlite3_column_type) (sqlite3_stmt *pStmt, int iCol);
+typedef sqlite3_value *(CDECL *tp_sqlite3_column_value) (sqlite3_stmt *pStmt, int iCol);
 typedef sqlite3 *(CDECL *tp_sqlite3_db_handle) (sqlite3_stmt *pStmt);
 typedef int (CDECL *tp_sqlite3_errcode) (sqlite3 *db);
 typedef const char *(CDECL *tp_sqlite3_errmsg) (sqlite3 *db);
@@ -153,6 +159,15 @@ typedef int (CDECL *tp_sqlite3_prepare) (sqlite3 *db,
                                          const char **pzTail);
 typedef int (CDECL *tp_sqlite3_reset) (sqlite3_stmt *pStmt);
 typedef int (CDECL *tp_sqlite3_step) (sqlite3_stmt *pStmt);
+typedef const void *(CDECL *tp_sqlite3_value_blob) (sqlite3_value *value);
+typedef int (CDECL *tp_sqlite3_value_bytes) (sqlite3_value *value);
+typedef double (CDECL *tp_sqlite3_value_double) (sqlite3_value *value);
+typedef sqlite3_value *(CDECL *tp_sqlite3_value_dup) (const sqlite3_value *value);
+typedef void (CDECL *tp_sqlite3_value_free) (sqlite3_value *value);
+typedef int (CDECL *tp_sqlite3_value_int) (sqlite3_value *value);
+typedef sqlite3_int64 (CDECL *tp_sqlite3_value_int64) (sqlite3_value *value);
+typedef const unsigned char *(CDECL *tp_sqlite3_value_text) (sqlite3_value *value);
+typedef int (CDECL *tp_sqlite3_value_type) (sqlite3_value *value);
 
 static tp_sqlite3_bind_blob            ptr_sqlite3_bind_blob;
 static tp_sqlite3_bind_double          ptr_sqlite3_bind_double;
@@ -171,6 +186,7 @@ static tp_sqlite3_column_int64         ptr_sqlite3_column_int64;
 static tp_sqlite3_column_name          ptr_sqlite3_column_name;
 static tp_sqlite3_column_text          ptr_sqlite3_column_text;
 static tp_sqlite3_column_type          ptr_sqlite3_column_type;
+static tp_sqlite3_column_value         ptr_sqlite3_column_value;
 static tp_sqlite3_db_handle            ptr_sqlite3_db_handle;
 static tp_sqlite3_errcode              ptr_sqlite3_errcode;
 static tp_sqlite3_errmsg               ptr_sqlite3_errmsg;
@@ -181,6 +197,15 @@ static tp_sqlite3_open                 ptr_sqlite3_open;
 static tp_sqlite3_prepare              ptr_sqlite3_prepare;
 static tp_sqlite3_reset                ptr_sqlite3_reset;
 static tp_sqlite3_step                 ptr_sqlite3_step;
+static tp_sqlite3_value_blob           ptr_sqlite3_value_blob;
+static tp_sqlite3_value_bytes          ptr_sqlite3_value_bytes;
+static tp_sqlite3_value_double         ptr_sqlite3_value_double;
+static tp_sqlite3_value_dup            ptr_sqlite3_value_dup;
+static tp_sqlite3_value_free           ptr_sqlite3_value_free;
+static tp_sqlite3_value_int            ptr_sqlite3_value_int;
+static tp_sqlite3_value_int64          ptr_sqlite3_value_int64;
+static tp_sqlite3_value_text           ptr_sqlite3_value_text;
+static tp_sqlite3_value_type           ptr_sqlite3_value_type;
 
 #define sqlite3_bind_blob            ptr_sqlite3_bind_blob
 #define sqlite3_bind_double          ptr_sqlite3_bind_double
@@ -199,6 +224,7 @@ static tp_sqlite3_step                 ptr_sqlite3_step;
 #define sqlite3_column_name          ptr_sqlite3_column_name
 #define sqlite3_column_text          ptr_sqlite3_column_text
 #define sqlite3_column_type          ptr_sqlite3_column_type
+#define sqlite3_column_value         ptr_sqlite3_column_value
 #define sqlite3_db_handle            ptr_sqlite3_db_handle
 #define sqlite3_errcode              ptr_sqlite3_errcode
 #define sqlite3_errmsg               ptr_sqlite3_errmsg
@@ -209,6 +235,15 @@ static tp_sqlite3_step                 ptr_sqlite3_step;
 #define sqlite3_prepare              ptr_sqlite3_prepare
 #define sqlite3_reset                ptr_sqlite3_reset
 #define sqlite3_step                 ptr_sqlite3_step
+#define sqlite3_value_blob           ptr_sqlite3_value_blob
+#define sqlite3_value_bytes          ptr_sqlite3_value_bytes
+#define sqlite3_value_double         ptr_sqlite3_value_double
+#define sqlite3_value_dup            ptr_sqlite3_value_dup
+#define sqlite3_value_free           ptr_sqlite3_value_free
+#define sqlite3_value_int            ptr_sqlite3_value_int
+#define sqlite3_value_int64          ptr_sqlite3_value_int64
+#define sqlite3_value_text           ptr_sqlite3_value_text
+#define sqlite3_value_type           ptr_sqlite3_value_type
 
 
 
@@ -250,6 +285,21 @@ static boolType setupDll (const char *dllName)
             (sqlite3_reset                = (tp_sqlite3_reset)                dllFunc(dbDll, "sqlite3_reset"))                == NULL ||
             (sqlite3_step                 = (tp_sqlite3_step)                 dllFunc(dbDll, "sqlite3_step"))                 == NULL) {
           dbDll = NULL;
+        } else {
+          /* The functions to copy column values are optional. */
+          /* Without them sqlFetchBatch fetches single rows.   */
+          if ((sqlite3_column_value         = (tp_sqlite3_column_value)         dllFunc(dbDll, "sqlite3_column_value"))         == NULL ||
+              (sqlite3_value_blob           = (tp_sqlite3_value_blob)           dllFunc(dbDll, "sqlite3_value_blob"))           == NULL ||
+              (sqlite3_value_bytes          = (tp_sqlite3_value_bytes)          dllFunc(dbDll, "sqlite3_value_bytes"))          == NULL ||
+              (sqlite3_value_double         = (tp_sqlite3_value_double)         dllFunc(dbDll, "sqlite3_value_double"))         == NULL ||
+              (sqlite3_value_dup            = (tp_sqlite3_value_dup)            dllFunc(dbDll, "sqlite3_value_dup"))            == NULL ||
+              (sqlite3_value_free           = (tp_sqlite3_value_free)           dllFunc(dbDll, "sqlite3_value_free"))           == NULL ||
+              (sqlite3_value_int            = (tp_sqlite3_value_int)            dllFunc(dbDll, "sqlite3_value_int"))            == NULL ||
+              (sqlite3_value_int64          = (tp_sqlite3_value_int64)          dllFunc(dbDll, "sqlite3_value_int64"))          == NULL ||
+              (sqlite3_value_text           = (tp_sqlite3_value_text)           dllFunc(dbDll, "sqlite3_value_text"))           == NULL ||
+              (sqlite3_value_type           = (tp_sqlite3_value_type)           dllFunc(dbDll, "sqlite3_value_type"))           == NULL) {
+            sqlite3_value_dup = NULL;
+          } /* if */
         } /* if */
       } /* if */
     } /* if */
@@ -277,9 +327,13 @@ static boolType findDll (void)
     return found;
   } /* findDll */
 
+
+#define BATCH_FUNCTIONS_PRESENT (sqlite3_value_dup != NULL)
+
 #else
 
 #define findDll() TRUE
+#define BATCH_FUNCTIONS_PRESENT 1
 
 #endif
 
@@ -322,6 +376,30 @@ static void freeDatabase (databaseType database)
 
 
 
+/**
+ *  Free the column values of the current batch.
+ *  Afterwards the column functions use the row of the statement again.
+ */
+static void freeBatch (preparedStmtType preparedStmt)
+
+  {
+    memSizeType numValues;
+    memSizeType pos;
+
+  /* freeBatch */
+    if (preparedStmt->batchSize != 0) {
+      numValues = (memSizeType) preparedStmt->batchSize *
+                  preparedStmt->result_column_count;
+      for (pos = 0; pos < numValues; pos++) {
+        sqlite3_value_free(preparedStmt->batchValues[pos]);
+      } /* for */
+      preparedStmt->batchSize = 0;
+    } /* if */
+    preparedStmt->batchRow = NULL;
+  } /* freeBatch */
+
+
+
 /**
  *  Closes a prepared statement and frees the memory used by it.
  */
@@ -337,6 +415,11 @@ static void freePreparedStmt (sqlStmtType sqlStatement)
     if (preparedStmt->param_array != NULL) {
       FREE_TABLE(preparedStmt->param_array, bindDataRecordLite, preparedStmt->param_array_size);
     } /* if */
+    if (preparedStmt->batchValues != NULL) {
+      freeBatch(preparedStmt);
+      FREE_TABLE(preparedStmt->batchValues, sqlite3_value *,
+                 preparedStmt->batchCapacity * preparedStmt->result_column_count);
+    } /* if */
     sqlite3_finalize(preparedStmt->ppStmt);
     if (preparedStmt->db != NULL &&
         preparedStmt->db->usage_count != 0) {
@@ -486,6 +569,131 @@ static memSizeType decimalPrecision (const const_ustriType decimal,
 
 
 
+/**
+ *  The column functions below read the current row. This is either
+ *  the row of the statement or a row of the batch (see sqlFetchBatch).
+ */
+static int columnType (preparedStmtType preparedStmt, int iCol)
+
+  { /* columnType */
+    if (preparedStmt->batchRow != NULL) {
+      return sqlite3_value_type(preparedStmt->batchRow[iCol]);
+    } else {
+      return sqlite3_column_type(preparedStmt->ppStmt, iCol);
+    } /* if */
+  } /* columnType */
+
+
+
+static int columnInt (preparedStmtType preparedStmt, int iCol)
+
+  { /* columnInt */
+    if (preparedStmt->batchRow != NULL) {
+      return sqlite3_value_int(preparedStmt->batchRow[iCol]);
+    } else {
+      return sqlite3_column_int(preparedStmt->ppStmt, iCol);
+    } /* if */
+  } /* columnInt */
+
+
+
+static sqlite3_int64 columnInt64 (preparedStmtType preparedStmt, int iCol)
+
+  { /* columnInt64 */
+    if (preparedStmt->batchRow != NULL) {
+      return sqlite3_value_int64(preparedStmt->batchRow[iCol]);
+    } else {
+      return sqlite3_column_int64(preparedStmt->ppStmt, iCol);
+    } /* if */
+  } /* columnInt64 */
+
+
+
+static double columnDouble (preparedStmtType preparedStmt, int iCol)
+
+  { /* columnDouble */
+    if (preparedStmt->batchRow != NULL) {
+      return sqlite3_value_double(preparedStmt->batchRow[iCol]);
+    } else {
+      return sqlite3_column_double(preparedStmt->ppStmt, iCol);
+    } /* if */
+  } /* columnDouble */
+
+
+
+static const void *columnBlob (preparedStmtType preparedStmt, int iCol)
+
+  { /* columnBlob */
+    if (preparedStmt->batchRow != NULL) {
+      return sqlite3_value_blob(preparedStmt->batchRow[iCol]);
+    } else {
+      return sqlite3_column_blob(preparedStmt->ppStmt, iCol);
+    } /* if */
+  } /* columnBlob */
+
+
+
+static int columnBytes (preparedStmtType preparedStmt, int iCol)
+
+  { /* columnBytes */
+    if (preparedStmt->batchRow != NULL) {
+      return sqlite3_value_bytes(preparedStmt->batchRow[iCol]);
+    } else {
+      return sqlite3_column_bytes(preparedStmt->ppStmt, iCol);
+    } /* if */
+  } /* columnBytes */
+
+
+
+static const unsigned char *columnText (preparedStmtType preparedStmt, int iCol)
+
+  { /* columnText */
+    if (preparedStmt->batchRow != NULL) {
+      return sqlite3_value_text(preparedStmt->batchRow[iCol]);
+    } else {
+      return sqlite3_column_text(preparedStmt->ppStmt, iCol);
+    } /* if */
+  } /* columnText */
+
+
+
+static void sqlBatchSelectRow (sqlStmtType sqlStatement, intType row)
+
+  {
+    preparedStmtType preparedStmt;
+
+  /* sqlBatchSelectRow */
+    logFunction(printf("sqlBatchSelectRow(" FMT_U_MEM ", " FMT_D ")\n",
+                       (memSizeType) sqlStatement, row););
+    preparedStmt = (preparedStmtType) sqlStatement;
+    if (unlikely(row < 1 || row > preparedStmt->batchSize)) {
+      logError(printf("sqlBatchSelectRow: row: " FMT_D ", batch size: " FMT_D ".\n",
+                      row, preparedStmt->batchSize););
+      raise_error(RANGE_ERROR);
+    } else {
+      if (preparedStmt->result_column_count != 0) {
+        preparedStmt->batchRow = &preparedStmt->batchValues[
+            (memSizeType) (row - 1) * preparedStmt->result_column_count];
+      } /* if */
+      preparedStmt->fetchOkay = TRUE;
+    } /* if */
+    logFunction(printf("sqlBatchSelectRow -->\n"););
+  } /* sqlBatchSelectRow */
+
+
+
+static intType sqlBatchSize (sqlStmtType sqlStatement)
+
+  { /* sqlBatchSize */
+    logFunction(printf("sqlBatchSize(" FMT_U_MEM ")\n",
+                       (memSizeType) sqlStatement););
+    logFunction(printf("sqlBatchSize --> " FMT_D "\n",
+                       ((preparedStmtType) sqlStatement)->batchSize););
+    return ((preparedStmtType) sqlStatement)->batchSize;
+  } /* sqlBatchSize */
+
+
+
 static void sqlBindBigInt (sqlStmtType sqlStatement, intType pos,
     const const_bigIntType value)
 
@@ -1242,20 +1450,19 @@ static bigIntType sqlColumnBigInt (sqlStmtType sqlStatement, intType column)
       columnValue = NULL;
     } else {
       logMessage(printf("buffer_type: %s\n",
-                        nameOfBufferType(sqlite3_column_type(preparedStmt->ppStmt,
-                                                             (int) column - 1))););
-      switch (sqlite3_column_type(preparedStmt->ppStmt, (int) column - 1)) {
+                        nameOfBufferType(columnType(preparedStmt, (int) column - 1))););
+      switch (columnType(preparedStmt, (int) column - 1)) {
         case SQLITE_NULL:
           logMessage(printf("Column is NULL -> Use default value: 0\n"););
           columnValue = bigZero();
           break;
         case SQLITE_INTEGER:
-          columnValue64 = sqlite3_column_int64(preparedStmt->ppStmt, (int) column - 1);
+          columnValue64 = columnInt64(preparedStmt, (int) column - 1);
           columnValue = bigFromInt64(columnValue64);
           break;
         case SQLITE_BLOB:
-          blob = sqlite3_column_blob(preparedStmt->ppStmt, (int) column - 1);
-          length = sqlite3_column_bytes(preparedStmt->ppStmt, (int) column - 1);
+          blob = columnBlob(preparedStmt, (int) column - 1);
+          length = columnBytes(preparedStmt, (int) column - 1);
           if (unlikely(blob == NULL || length < 0)) {
             dbInconsistent("sqlColumnBigInt", "sqlite3_column_bytes");
             logError(printf("sqlColumnBigInt: Column " FMT_D ": Blob " FMT_U_MEM
@@ -1274,7 +1481,7 @@ static bigIntType sqlColumnBigInt (sqlStmtType sqlStatement, intType column)
         default:
           logError(printf("sqlColumnBigInt: Column " FMT_D " has the unknown type %s.\n",
                           column, nameOfBufferType(
-                          sqlite3_column_type(preparedStmt->ppStmt, (int) column - 1))););
+                          columnType(preparedStmt, (int) column - 1))););
           raise_error(RANGE_ERROR);
           columnValue = NULL;
           break;
@@ -1308,27 +1515,26 @@ static void sqlColumnBigRat (sqlStmtType sqlStatement, intType column,
       raise_error(RANGE_ERROR);
     } else {
       logMessage(printf("buffer_type: %s\n",
-                        nameOfBufferType(sqlite3_column_type(preparedStmt->ppStmt,
-                                                             (int) column - 1))););
-      switch (sqlite3_column_type(preparedStmt->ppStmt, (int) column - 1)) {
+                        nameOfBufferType(columnType(preparedStmt, (int) column - 1))););
+      switch (columnType(preparedStmt, (int) column - 1)) {
         case SQLITE_NULL:
           logMessage(printf("Column is NULL -> Use default value: 0\n"););
           *numerator = bigZero();
           *denominator = bigFromInt32(1);
           break;
         case SQLITE_INTEGER:
-          columnValue64 = sqlite3_column_int64(preparedStmt->ppStmt, (int) column - 1);
+          columnValue64 = columnInt64(preparedStmt, (int) column - 1);
           *numerator = bigFromInt64(columnValue64);
           *denominator = bigFromInt32(1);
           break;
         case SQLITE_FLOAT:
           *numerator = roundDoubleToBigRat(
-              sqlite3_column_double(preparedStmt->ppStmt, (int) column - 1),
+              columnDouble(preparedStmt, (int) column - 1),
               TRUE, denominator);
           break;
         case SQLITE_BLOB:
-          blob = sqlite3_column_blob(preparedStmt->ppStmt, (int) column - 1);
-          length = sqlite3_column_bytes(preparedStmt->ppStmt, (int) column - 1);
+          blob = columnBlob(preparedStmt, (int) column - 1);
+          length = columnBytes(preparedStmt, (int) column - 1);
           if (unlikely(blob == NULL || length < 0)) {
             dbInconsistent("sqlColumnBigRat", "sqlite3_column_bytes");
             logError(printf("sqlColumnBigRat: Column " FMT_D ": Blob " FMT_U_MEM
@@ -1346,7 +1552,7 @@ static void sqlColumnBigRat (sqlStmtType sqlStatement, intType column,
         default:
           logError(printf("sqlColumnBigRat: Column " FMT_D " has the unknown type %s.\n",
                           column, nameOfBufferType(
-                          sqlite3_column_type(preparedStmt->ppStmt, (int) column - 1))););
+                          columnType(preparedStmt, (int) column - 1))););
           raise_error(RANGE_ERROR);
           break;
       } /* switch */
@@ -1379,22 +1585,21 @@ static boolType sqlColumnBool (sqlStmtType sqlStatement, intType column)
       columnValue = 0;
     } else {
       logMessage(printf("buffer_type: %s\n",
-                        nameOfBufferType(sqlite3_column_type(preparedStmt->ppStmt,
-                                                             (int) column - 1))););
-      switch (sqlite3_column_type(preparedStmt->ppStmt, (int) column - 1)) {
+                        nameOfBufferType(columnType(preparedStmt, (int) column - 1))););
+      switch (columnType(preparedStmt, (int) column - 1)) {
         case SQLITE_NULL:
           logMessage(printf("Column is NULL -> Use default value: 0\n"););
           columnValue = 0;
           break;
         case SQLITE_INTEGER:
-          columnValue = sqlite3_column_int(preparedStmt->ppStmt, (int) column - 1);
+          columnValue = columnInt(preparedStmt, (int) column - 1);
           break;
         case SQLITE_TEXT:
-          stri = sqlite3_column_text(preparedStmt->ppStmt, (int) column - 1);
+          stri = columnText(preparedStmt, (int) column - 1);
           if (stri == NULL) {
             columnValue = 0;
           } else {
-            if (unlikely(sqlite3_column_bytes(preparedStmt->ppStmt, (int) column - 1) != 1)) {
+            if (unlikely(columnBytes(preparedStmt, (int) column - 1) != 1)) {
               logError(printf("sqlColumnBool: Column " FMT_D ": "
                               "The size of a boolean field must be 1.\n", column););
               raise_error(RANGE_ERROR);
@@ -1407,7 +1612,7 @@ static boolType sqlColumnBool (sqlStmtType sqlStatement, intType column)
         default:
           logError(printf("sqlColumnBool: Column " FMT_D " has the unknown type %s.\n",
                           column, nameOfBufferType(
-                          sqlite3_column_type(preparedStmt->ppStmt, (int) column - 1))););
+                          columnType(preparedStmt, (int) column - 1))););
           raise_error(RANGE_ERROR);
           columnValue = 0;
           break;
@@ -1449,9 +1654,8 @@ static bstriType sqlColumnBStri (sqlStmtType sqlStatement, intType column)
       columnValue = NULL;
     } else {
       logMessage(printf("buffer_type: %s\n",
-                        nameOfBufferType(sqlite3_column_type(preparedStmt->ppStmt,
-                                                             (int) column - 1))););
-      switch (sqlite3_column_type(preparedStmt->ppStmt, (int) column - 1)) {
+                        nameOfBufferType(columnType(preparedStmt, (int) column - 1))););
+      switch (columnType(preparedStmt, (int) column - 1)) {
         case SQLITE_NULL:
           {
             emptyBStriType emptyBStri;
@@ -1466,7 +1670,7 @@ static bstriType sqlColumnBStri (sqlStmtType sqlStatement, intType column)
           }
           break;
         case SQLITE_BLOB:
-          blob = (const_ustriType) sqlite3_column_blob(preparedStmt->ppStmt, (int) column - 1);
+          blob = (const_ustriType) columnBlob(preparedStmt, (int) column - 1);
           if (blob == NULL) {
             emptyBStriType emptyBStri;
 
@@ -1477,7 +1681,7 @@ static bstriType sqlColumnBStri (sqlStmtType sqlStatement, intType column)
             } /* if */
             columnValue = (bstriType) emptyBStri;
           } else {
-            length = sqlite3_column_bytes(preparedStmt->ppStmt, (int) column - 1);
+            length = columnBytes(preparedStmt, (int) column - 1);
             if (unlikely(length < 0)) {
               dbInconsistent("sqlColumnBStri", "sqlite3_column_bytes");
               logError(printf("sqlColumnBStri: Column " FMT_D ": "
@@ -1494,7 +1698,7 @@ static bstriType sqlColumnBStri (sqlStmtType sqlStatement, intType column)
           } /* if */
           break;
         case SQLITE_TEXT:
-          stri8 = sqlite3_column_text(preparedStmt->ppStmt, (int) column - 1);
+          stri8 = columnText(preparedStmt, (int) column - 1);
           if (stri8 == NULL) {
             emptyBStriType emptyBStri;
 
@@ -1505,7 +1709,7 @@ static bstriType sqlColumnBStri (sqlStmtType sqlStatement, intType column)
             } /* if */
             columnValue = (bstriType) emptyBStri;
           } else {
-            length = sqlite3_column_bytes(preparedStmt->ppStmt, (int) column - 1);
+            length = columnBytes(preparedStmt, (int) column - 1);
             if (unlikely(length < 0)) {
               dbInconsistent("sqlColumnBStri", "sqlite3_column_bytes");
               logError(printf("sqlColumnBStri: Column " FMT_D ": "
@@ -1532,7 +1736,7 @@ static bstriType sqlColumnBStri (sqlStmtType sqlStatement, intType column)
         default:
           logError(printf("sqlColumnBStri: Column " FMT_D " has the unknown type %s.\n",
                           column, nameOfBufferType(
-                          sqlite3_column_type(preparedStmt->ppStmt, (int) column - 1))););
+                          columnType(preparedStmt, (int) column - 1))););
           raise_error(RANGE_ERROR);
           columnValue = NULL;
           break;
@@ -1565,9 +1769,8 @@ static void sqlColumnDuration (sqlStmtType sqlStatement, intType column,
       raise_error(RANGE_ERROR);
     } else {
       logMessage(printf("buffer_type: %s\n",
-                        nameOfBufferType(sqlite3_column_type(preparedStmt->ppStmt,
-                                                             (int) column - 1))););
-      isoDuration = sqlite3_column_text(preparedStmt->ppStmt, (int) column - 1);
+                        nameOfBufferType(columnType(preparedStmt, (int) column - 1))););
+      isoDuration = columnText(preparedStmt, (int) column - 1);
       /* printf("isoDuration: %lx\n", (unsigned long int) isoDuration); */
       if (isoDuration == NULL) {
         logMessage(printf("Column is NULL -> Use default value: PT0S\n"););
@@ -1621,22 +1824,21 @@ static floatType sqlColumnFloat (sqlStmtType sqlStatement, intType column)
       columnValue = 0.0;
     } else {
       logMessage(printf("buffer_type: %s\n",
-                        nameOfBufferType(sqlite3_column_type(preparedStmt->ppStmt,
-                                                             (int) column - 1))););
-      switch (sqlite3_column_type(preparedStmt->ppStmt, (int) column - 1)) {
+                        nameOfBufferType(columnType(preparedStmt, (int) column - 1))););
+      switch (columnType(preparedStmt, (int) column - 1)) {
         case SQLITE_NULL:
           logMessage(printf("Column is NULL -> Use default value: 0.0\n"););
           columnValue = 0.0;
           break;
         case SQLITE_INTEGER:
-          columnValue = (floatType) sqlite3_column_int64(preparedStmt->ppStmt, (int) column - 1);
+          columnValue = (floatType) columnInt64(preparedStmt, (int) column - 1);
           break;
         case SQLITE_FLOAT:
-          columnValue = sqlite3_column_double(preparedStmt->ppStmt, (int) column - 1);
+          columnValue = columnDouble(preparedStmt, (int) column - 1);
           break;
         case SQLITE_BLOB:
-          blob = (const_ustriType) sqlite3_column_blob(preparedStmt->ppStmt, (int) column - 1);
-          length = sqlite3_column_bytes(preparedStmt->ppStmt, (int) column - 1);
+          blob = (const_ustriType) columnBlob(preparedStmt, (int) column - 1);
+          length = columnBytes(preparedStmt, (int) column - 1);
           if (unlikely(blob == NULL || length < 0)) {
             dbInconsistent("sqlColumnFloat", "sqlite3_column_bytes");
             logError(printf("sqlColumnFloat: Column " FMT_D ": Blob " FMT_U_MEM
@@ -1651,7 +1853,7 @@ static floatType sqlColumnFloat (sqlStmtType sqlStatement, intType column)
         default:
           logError(printf("sqlColumnFloat: Column " FMT_D " has the unknown type %s.\n",
                           column, nameOfBufferType(
-                          sqlite3_column_type(preparedStmt->ppStmt, (int) column - 1))););
+                          columnType(preparedStmt, (int) column - 1))););
           raise_error(RANGE_ERROR);
           columnValue = 0.0;
           break;
@@ -1684,26 +1886,25 @@ static intType sqlColumnInt (sqlStmtType sqlStatement, intType column)
       columnValue = 0;
     } else {
       logMessage(printf("buffer_type: %s\n",
-                        nameOfBufferType(sqlite3_column_type(preparedStmt->ppStmt,
-                                                             (int) column - 1))););
-      switch (sqlite3_column_type(preparedStmt->ppStmt, (int) column - 1)) {
+                        nameOfBufferType(columnType(preparedStmt, (int) column - 1))););
+      switch (columnType(preparedStmt, (int) column - 1)) {
         case SQLITE_NULL:
           logMessage(printf("Column is NULL -> Use default value: 0\n"););
           columnValue = 0;
           break;
         case SQLITE_INTEGER:
 #if INTTYPE_SIZE == 32
-          columnValue = sqlite3_column_int(preparedStmt->ppStmt, (int) column - 1);
+          columnValue = columnInt(preparedStmt, (int) column - 1);
 #elif INTTYPE_SIZE == 64
-          columnValue = sqlite3_column_int64(preparedStmt->ppStmt, (int) column - 1);
+          columnValue = columnInt64(preparedStmt, (int) column - 1);
 #else
 #error "INTTYPE_SIZE is neither 32 nor 64."
           raise_error(RANGE_ERROR);
 #endif
           break;
         case SQLITE_BLOB:
-          blob = sqlite3_column_blob(preparedStmt->ppStmt, (int) column - 1);
-          length = sqlite3_column_bytes(preparedStmt->ppStmt, (int) column - 1);
+          blob = columnBlob(preparedStmt, (int) column - 1);
+          length = columnBytes(preparedStmt, (int) column - 1);
           if (unlikely(blob == NULL || length < 0)) {
             dbInconsistent("sqlColumnInt", "sqlite3_column_bytes");
             logError(printf("sqlColumnInt: Column " FMT_D ": Blob " FMT_U_MEM
@@ -1720,7 +1921,7 @@ static intType sqlColumnInt (sqlStmtType sqlStatement, intType column)
         default:
           logError(printf("sqlColumnInt: Column " FMT_D " has the unknown type %s.\n",
                           column, nameOfBufferType(
-                          sqlite3_column_type(preparedStmt->ppStmt, (int) column - 1))););
+                          columnType(preparedStmt, (int) column - 1))););
           raise_error(RANGE_ERROR);
           columnValue = 0;
           break;
@@ -1755,19 +1956,18 @@ static striType sqlColumnStri (sqlStmtType sqlStatement, intType column)
       columnValue = NULL;
     } else {
       logMessage(printf("buffer_type: %s\n",
-                        nameOfBufferType(sqlite3_column_type(preparedStmt->ppStmt,
-                                                             (int) column - 1))););
-      switch (sqlite3_column_type(preparedStmt->ppStmt, (int) column - 1)) {
+                        nameOfBufferType(columnType(preparedStmt, (int) column - 1))););
+      switch (columnType(preparedStmt, (int) column - 1)) {
         case SQLITE_NULL:
           logMessage(printf("Column is NULL -> Use default value: \"\"\n"););
           columnValue = strEmpty();
           break;
         case SQLITE_TEXT:
-          stri8 = sqlite3_column_text(preparedStmt->ppStmt, (int) column - 1);
+          stri8 = columnText(preparedStmt, (int) column - 1);
           if (stri8 == NULL) {
             columnValue = strEmpty();
           } else {
-            length = sqlite3_column_bytes(preparedStmt->ppStmt, (int) column - 1);
+            length = columnBytes(preparedStmt, (int) column - 1);
             if (unlikely(length < 0)) {
               dbInconsistent("sqlColumnStri", "sqlite3_column_bytes");
               logError(printf("sqlColumnStri: Column " FMT_D ": "
@@ -1785,11 +1985,11 @@ static striType sqlColumnStri (sqlStmtType sqlStatement, intType column)
           } /* if */
           break;
         case SQLITE_BLOB:
-          blob = (const_ustriType) sqlite3_column_blob(preparedStmt->ppStmt, (int) column - 1);
+          blob = (const_ustriType) columnBlob(preparedStmt, (int) column - 1);
           if (blob == NULL) {
             columnValue = strEmpty();
           } else {
-            length = sqlite3_column_bytes(preparedStmt->ppStmt, (int) column - 1);
+            length = columnBytes(preparedStmt, (int) column - 1);
             if (unlikely(length < 0)) {
               dbInconsistent("sqlColumnStri", "sqlite3_column_bytes");
               logError(printf("sqlColumnStri: Column " FMT_D ": "
@@ -1808,7 +2008,7 @@ static striType sqlColumnStri (sqlStmtType sqlStatement, intType column)
         default:
           logError(printf("sqlColumnStri: Column " FMT_D " has the unknown type %s.\n",
                           column, nameOfBufferType(
-                          sqlite3_column_type(preparedStmt->ppStmt, (int) column - 1))););
+                          columnType(preparedStmt, (int) column - 1))););
           raise_error(RANGE_ERROR);
           columnValue = NULL;
           break;
@@ -1843,10 +2043,8 @@ static void sqlColumnTime (sqlStmtType sqlStatement, intType column,
       raise_error(RANGE_ERROR);
     } else {
       logMessage(printf("buffer_type: %s\n",
-                        nameOfBufferType(sqlite3_column_type(preparedStmt->ppStmt,
-                                                             (int) column - 1))););
-      isoDate = (const_cstriType) sqlite3_column_text(preparedStmt->ppStmt,
-                                                      (int) column - 1);
+                        nameOfBufferType(columnType(preparedStmt, (int) column - 1))););
+      isoDate = (const_cstriType) columnText(preparedStmt, (int) column - 1);
       /* printf("isoDate: %lx\n", (unsigned long int) isoDate); */
       if (isoDate == NULL) {
         logMessage(printf("Column is NULL -> Use default value: 0-01-01 00:00:00\n"););
@@ -1922,6 +2120,7 @@ static void sqlExecute (sqlStmtType sqlStatement)
     logFunction(printf("sqlExecute(" FMT_U_MEM ")\n",
                        (memSizeType) sqlStatement););
     preparedStmt = (preparedStmtType) sqlStatement;
+    freeBatch(preparedStmt);
     if (unlikely(!allParametersBound(preparedStmt))) {
       dbLibError("sqlExecute", "SQLExecute",
                  "Unbound statement parameter(s).\n");
@@ -1980,6 +2179,9 @@ static boolType sqlFetch (sqlStmtType sqlStatement)
     logFunction(printf("sqlFetch(" FMT_U_MEM ")\n",
                        (memSizeType) sqlStatement););
     preparedStmt = (preparedStmtType) sqlStatement;
+    if (preparedStmt->batchRow != NULL) {
+      freeBatch(preparedStmt);
+    } /* if */
     if (unlikely(!preparedStmt->executeSuccessful)) {
       dbLibError("sqlFetch", "sqlite3_step",
                  "Execute was not successful.\n");
@@ -2006,6 +2208,9 @@ static boolType sqlFetch (sqlStmtType sqlStatement)
         preparedStmt->fetchFinished = TRUE;
         raise_error(DATABASE_ERROR);
       } /* if */
+    } else {
+      /* The fetchOkay flag of a batch row is not valid anymore. */
+      preparedStmt->fetchOkay = FALSE;
     } /* if */
     logFunction(printf("sqlFetch --> %d\n", preparedStmt->fetchOkay););
     return preparedStmt->fetchOkay;
@@ -2013,6 +2218,113 @@ static boolType sqlFetch (sqlStmtType sqlStatement)
 
 
 
+/**
+ *  Make room for 'minCapacity' rows in the batch of 'preparedStmt'.
+ */
+static errInfoType reserveBatch (preparedStmtType preparedStmt,
+    memSizeType minCapacity)
+
+  {
+    memSizeType columnCount;
+    memSizeType newCapacity;
+    sqlite3_value **resizedValues;
+    errInfoType err_info = OKAY_NO_ERROR;
+
+  /* reserveBatch */
+    columnCount = preparedStmt->result_column_count;
+    if (preparedStmt->batchCapacity < minCapacity) {
+      newCapacity = preparedStmt->batchCapacity * 2;
+      if (newCapacity < minCapacity) {
+        newCapacity = minCapacity;
+      } /* if */
+      if (unlikely(newCapacity > MAX_MEMSIZETYPE / sizeof(sqlite3_value *) / columnCount)) {
+        err_info = MEMORY_ERROR;
+      } else if (preparedStmt->batchValues == NULL) {
+        if (unlikely(!ALLOC_TABLE(preparedStmt->batchValues, sqlite3_value *,
+                                  newCapacity * columnCount))) {
+          err_info = MEMORY_ERROR;
+        } else {
+          preparedStmt->batchCapacity = newCapacity;
+        } /* if */
+      } else {
+        resizedValues = REALLOC_TABLE(preparedStmt->batchValues, sqlite3_value *,
+                                      preparedStmt->batchCapacity * columnCount,
+                                      newCapacity * columnCount);
+        if (unlikely(resizedValues == NULL)) {
+          err_info = MEMORY_ERROR;
+        } else {
+          COUNT3_TABLE(sqlite3_value *, preparedStmt->batchCapacity * columnCount,
+                       newCapacity * columnCount);
+          preparedStmt->batchValues = resizedValues;
+          preparedStmt->batchCapacity = newCapacity;
+        } /* if */
+      } /* if */
+    } /* if */
+    return err_info;
+  } /* reserveBatch */
+
+
+
+/**
+ *  Fetch up to 'maxRows' rows into the batch of 'sqlStatement'.
+ *  The column values of each row are copied with sqlite3_value_dup(),
+ *  because sqlite3_step() invalidates the values of the previous row.
+ */
+static intType sqlFetchBatch (sqlStmtType sqlStatement, intType maxRows)
+
+  {
+    preparedStmtType preparedStmt;
+    memSizeType columnCount;
+    memSizeType column;
+    sqlite3_value **rowValues;
+    errInfoType err_info = OKAY_NO_ERROR;
+
+  /* sqlFetchBatch */
+    logFunction(printf("sqlFetchBatch(" FMT_U_MEM ", " FMT_D ")\n",
+                       (memSizeType) sqlStatement, maxRows););
+    preparedStmt = (preparedStmtType) sqlStatement;
+    freeBatch(preparedStmt);
+    columnCount = preparedStmt->result_column_count;
+    while (preparedStmt->batchSize < maxRows && err_info == OKAY_NO_ERROR &&
+           sqlFetch(sqlStatement)) {
+      if (columnCount != 0) {
+        err_info = reserveBatch(preparedStmt,
+                                (memSizeType) preparedStmt->batchSize + 1);
+        if (likely(err_info == OKAY_NO_ERROR)) {
+          rowValues = &preparedStmt->batchValues[
+              (memSizeType) preparedStmt->batchSize * columnCount];
+          for (column = 0; column < columnCount &&
+               err_info == OKAY_NO_ERROR; column++) {
+            rowValues[column] = sqlite3_value_dup(
+                sqlite3_column_value(preparedStmt->ppStmt, (int) column));
+            if (unlikely(rowValues[column] == NULL)) {
+              while (column != 0) {
+                column--;
+                sqlite3_value_free(rowValues[column]);
+              } /* while */
+              err_info = MEMORY_ERROR;
+            } /* if */
+          } /* for */
+        } /* if */
+      } /* if */
+      if (likely(err_info == OKAY_NO_ERROR)) {
+        preparedStmt->batchSize++;
+      } /* if */
+    } /* while */
+    if (unlikely(err_info != OKAY_NO_ERROR)) {
+      freeBatch(preparedStmt);
+      preparedStmt->fetchOkay = FALSE;
+      raise_error(err_info);
+    } else if (preparedStmt->batchSize != 0) {
+      sqlBatchSelectRow(sqlStatement, preparedStmt->batchSize);
+    } /* if */
+    logFunction(printf("sqlFetchBatch --> " FMT_D "\n",
+                       preparedStmt->batchSize););
+    return preparedStmt->batchSize;
+  } /* sqlFetchBatch */
+
+
+
 static boolType sqlGetAutoCommit (databaseType database)
 
   {
@@ -2055,7 +2367,7 @@ static boolType sqlIsNull (sqlStmtType sqlStatement, intType column)
       raise_error(RANGE_ERROR);
       isNull = FALSE;
     } else {
-      isNull = sqlite3_column_type(preparedStmt->ppStmt, (int) column - 1) == SQLITE_NULL;
+      isNull = columnType(preparedStmt, (int) column - 1) == SQLITE_NULL;
     } /* if */
     logFunction(printf("sqlIsNull --> %s\n", isNull ? "TRUE" : "FALSE"););
     return isNull;
@@ -2158,6 +2470,36 @@ static sqlStmtType sqlPrepare (databaseType database,
 
 
 
+/**
+ *  Reset a prepared statement to the state after sqlPrepare.
+ *  The result is released (together with the locks held by it)
+ *  and all parameters are unbound.
+ */
+static void sqlResetStmt (sqlStmtType sqlStatement)
+
+  {
+    preparedStmtType preparedStmt;
+    memSizeType pos;
+
+  /* sqlResetStmt */
+    logFunction(printf("sqlResetStmt(" FMT_U_MEM ")\n",
+                       (memSizeType) sqlStatement););
+    preparedStmt = (preparedStmtType) sqlStatement;
+    freeBatch(preparedStmt);
+    /* An error of the last sqlite3_step is returned again. It is ignored. */
+    sqlite3_reset(preparedStmt->ppStmt);
+    for (pos = 0; pos < preparedStmt->param_array_size; pos++) {
+      preparedStmt->param_array[pos].bound = FALSE;
+    } /* for */
+    preparedStmt->executeSuccessful = FALSE;
+    preparedStmt->useStoredFetchResult = FALSE;
+    preparedStmt->fetchOkay = FALSE;
+    preparedStmt->fetchFinished = FALSE;
+    logFunction(printf("sqlResetStmt -->\n"););
+  } /* sqlResetStmt */
+
+
+
 static void sqlRollback (databaseType database)
 
   {
@@ -2280,6 +2622,10 @@ static boolType setupFuncTable (void)
         memset(sqlFunc, 0, sizeof(sqlFuncRecord));
         sqlFunc->freeDatabase       = &freeDatabase;
         sqlFunc->freePreparedStmt   = &freePreparedStmt;
+        if (BATCH_FUNCTIONS_PRESENT) {
+          sqlFunc->sqlBatchSelectRow = &sqlBatchSelectRow;
+          sqlFunc->sqlBatchSize      = &sqlBatchSize;
+        } /* if */
         sqlFunc->sqlBindBigInt      = &sqlBindBigInt;
         sqlFunc->sqlBindBigRat      = &sqlBindBigRat;
         sqlFunc->sqlBindBool        = &sqlBindBool;
@@ -2303,9 +2649,13 @@ static boolType setupFuncTable (void)
         sqlFunc->sqlCommit          = &sqlCommit;
         sqlFunc->sqlExecute         = &sqlExecute;
         sqlFunc->sqlFetch           = &sqlFetch;
+        if (BATCH_FUNCTIONS_PRESENT) {
+          sqlFunc->sqlFetchBatch    = &sqlFetchBatch;
+        } /* if */
         sqlFunc->sqlGetAutoCommit   = &sqlGetAutoCommit;
         sqlFunc->sqlIsNull          = &sqlIsNull;
         sqlFunc->sqlPrepare         = &sqlPrepare;
+        sqlFunc->sqlResetStmt       = &sqlResetStmt;
         sqlFunc->sqlRollback        = &sqlRollback;
         sqlFunc->sqlSetAutoCommit   = &sqlSetAutoCommit;
         sqlFunc->sqlStmtColumnCount = &sqlStmtColumnCount;
@@ -1,7 +1,7 @@
 /********************************************************************/
 /*                                                                  */
 /*  sql_my.c      Database access functions for MariaDB and MySQL.  */
-/*  Copyright (C) 1989 - 2020  Thomas Mertes                        */
+/*  Copyright (C) 1989 - 2020, 2026  Thomas Mertes                  */
 /*                                                                  */
 /*  This file is part of the Seed7 Runtime Library.                 */
 /*                                                                  */
@@ -24,7 +24,7 @@
 /*                                                                  */
 /*  Module: Seed7 Runtime Library                                   */
 /*  File: seed7/src/sql_my.c                                        */
-/*  Changes: 2014, 2015, 2017 - 2020  Thomas Mertes                 */
+/*  Changes: 2014, 2015, 2017 - 2020, 2026  Thomas Mertes           */
 /*  Content: Database access functions for MariaDB and MySQL.       */
 /*                                                                  */
 /********************************************************************/
@@ -67,9 +67,11 @@ typedef struct {
     sqlFuncType  sqlFunc;
     int          driver;
     int          dbCategory;
+    stmtCacheType stmtCache;
     MYSQL       *connection;
     boolType     autoCommit;
     boolType     backslashEscapes;
+    sqlStmtType  streamingStmt;
   } dbRecordMy, *dbType;
 
 typedef struct {
@@ -96,6 +98,7 @@ typedef struct {
     boolType       executeSuccessful;
     boolType       fetchOkay;
     boolType       fetchFinished;
+    boolType       streaming;
   } preparedStmtRecordMy, *preparedStmtType;
 
 static sqlFuncType sqlFunc = NULL;
@@ -163,6 +166,7 @@ typedef int (STDCALL *tp_mysql_stmt_fetch_column) (MYSQL_STMT *stmt,
                                                    MYSQL_BIND *bnd,
                                                    unsigned int column,
                                                    unsigned long offset);
+typedef my_bool (STDCALL *tp_mysql_stmt_free_result) (MYSQL_STMT *stmt);
 typedef MYSQL_STMT *(STDCALL *tp_mysql_stmt_init) (MYSQL *mysql);
 typedef unsigned long (STDCALL *tp_mysql_stmt_param_count) (MYSQL_STMT *stmt);
 typedef int (STDCALL *tp_mysql_stmt_prepare) (MYSQL_STMT *stmt,
@@ -192,6 +196,7 @@ static tp_mysql_stmt_error           ptr_mysql_stmt_error;
 static tp_mysql_stmt_execute         ptr_mysql_stmt_execute;
 static tp_mysql_stmt_fetch           ptr_mysql_stmt_fetch;
 static tp_mysql_stmt_fetch_column    ptr_mysql_stmt_fetch_column;
+static tp_mysql_stmt_free_result     ptr_mysql_stmt_free_result;
 static tp_mysql_stmt_init            ptr_mysql_stmt_init;
 static tp_mysql_stmt_param_count     ptr_mysql_stmt_param_count;
 static tp_mysql_stmt_prepare         ptr_mysql_stmt_prepare;
@@ -219,6 +224,7 @@ static tp_mysql_stmt_store_result    ptr_mysql_stmt_store_result;
 #define mysql_stmt_execute         ptr_mysql_stmt_execute
 #define mysql_stmt_fetch           ptr_mysql_stmt_fetch
 #define mysql_stmt_fetch_column    ptr_mysql_stmt_fetch_column
+#define mysql_stmt_free_result     ptr_mysql_stmt_free_result
 #define mysql_stmt_init            ptr_mysql_stmt_init
 #define mysql_stmt_param_count     ptr_mysql_stmt_param_count
 #define mysql_stmt_prepare         ptr_mysql_stmt_prepare
@@ -258,6 +264,7 @@ static boolType setupDll (const char *dllName)
             (mysql_stmt_execute         = (tp_mysql_stmt_execute)         dllFunc(dbDll, "mysql_stmt_execute"))         == NULL ||
             (mysql_stmt_fetch           = (tp_mysql_stmt_fetch)           dllFunc(dbDll, "mysql_stmt_fetch"))           == NULL ||
             (mysql_stmt_fetch_column    = (tp_mysql_stmt_fetch_column)    dllFunc(dbDll, "mysql_stmt_fetch_column"))    == NULL ||
+            (mysql_stmt_free_result     = (tp_mysql_stmt_free_result)     dllFunc(dbDll, "mysql_stmt_free_result"))     == NULL ||
             (mysql_stmt_init            = (tp_mysql_stmt_init)            dllFunc(dbDll, "mysql_stmt_init"))            == NULL ||
             (mysql_stmt_param_count     = (tp_mysql_stmt_param_count)     dllFunc(dbDll, "mysql_stmt_param_count"))     == NULL ||
             (mysql_stmt_prepare         = (tp_mysql_stmt_prepare)         dllFunc(dbDll, "mysql_stmt_prepare"))         == NULL ||
@@ -318,6 +325,33 @@ static void setDbErrorMsg (const char *funcName, const char *dbFuncName,
 /**
  *  Closes a database and frees the memory used by it.
  */
+/**
+ *  Discard the rest of a streamed (unbuffered) result of 'db'.
+ *  As long as an unbuffered result has not been fetched completely
+ *  MySQL refuses to execute other commands with the same connection.
+ *  The remaining rows are discarded with mysql_stmt_free_result().
+ */
+static void finishStream (dbType db)
+
+  {
+    preparedStmtType preparedStmt;
+
+  /* finishStream */
+    logFunction(printf("finishStream(" FMT_U_MEM ")\n", (memSizeType) db););
+    if (db->streamingStmt != NULL) {
+      preparedStmt = (preparedStmtType) db->streamingStmt;
+      if (!preparedStmt->fetchFinished) {
+        mysql_stmt_free_result(preparedStmt->ppStmt);
+        preparedStmt->fetchOkay = FALSE;
+        preparedStmt->fetchFinished = TRUE;
+      } /* if */
+      db->streamingStmt = NULL;
+    } /* if */
+    logFunction(printf("finishStream -->\n"););
+  } /* finishStream */
+
+
+
 static void freeDatabase (databaseType database)
 
   {
@@ -365,6 +399,10 @@ static void freePreparedStmt (sqlStmtType sqlStatement)
     if (preparedStmt->result_data_array != NULL) {
       FREE_TABLE(preparedStmt->result_data_array, resultDataRecordMy, preparedStmt->result_array_size);
     } /* if */
+    if (preparedStmt->db != NULL &&
+        preparedStmt->db->streamingStmt == (sqlStmtType) preparedStmt) {
+      preparedStmt->db->streamingStmt = NULL;
+    } /* if */
     mysql_stmt_close(preparedStmt->ppStmt);
     if (preparedStmt->db != NULL &&
         preparedStmt->db->usage_count != 0) {
@@ -1513,6 +1551,7 @@ static void sqlClose (databaseType database)
     logFunction(printf("sqlClose(" FMT_U_MEM ")\n",
                        (memSizeType) database););
     db = (dbType) database;
+    db->streamingStmt = NULL;
     if (db->connection != NULL) {
       mysql_close(db->connection);
       db->connection = NULL;
@@ -2387,6 +2426,7 @@ static void sqlCommit (databaseType database)
     logFunction(printf("sqlCommit(" FMT_U_MEM ")\n",
                        (memSizeType) database););
     db = (dbType) database;
+    finishStream(db);
     if (unlikely(db->connection == NULL)) {
       dbNotOpen("sqlCommit");
       logError(printf("sqlCommit: Database is not open.\n"););
@@ -2420,6 +2460,7 @@ static void sqlExecute (sqlStmtType sqlStatement)
     } else {
       /* printf("ppStmt: " FMT_U_MEM "\n", (memSizeType) preparedStmt->ppStmt); */
       preparedStmt->fetchOkay = FALSE;
+      finishStream(preparedStmt->db);
       if (unlikely(mysql_stmt_bind_param(preparedStmt->ppStmt,
                                          preparedStmt->param_array) != 0)) {
         setDbErrorMsg("sqlExecute", "mysql_stmt_bind_param",
@@ -2447,7 +2488,8 @@ static void sqlExecute (sqlStmtType sqlStatement)
                         mysql_stmt_error(preparedStmt->ppStmt)););
         preparedStmt->executeSuccessful = FALSE;
         raise_error(DATABASE_ERROR);
-      } else if (unlikely(mysql_stmt_store_result(preparedStmt->ppStmt) != 0)) {
+      } else if (unlikely(!preparedStmt->streaming &&
+                          mysql_stmt_store_result(preparedStmt->ppStmt) != 0)) {
         setDbErrorMsg("sqlExecute", "mysql_stmt_store_result",
                       mysql_stmt_errno(preparedStmt->ppStmt),
                       mysql_stmt_error(preparedStmt->ppStmt));
@@ -2458,6 +2500,11 @@ static void sqlExecute (sqlStmtType sqlStatement)
       } else {
         preparedStmt->executeSuccessful = TRUE;
         preparedStmt->fetchFinished = FALSE;
+        if (preparedStmt->streaming && preparedStmt->result_array_size != 0) {
+          /* Without mysql_stmt_store_result() the rows are read */
+          /* from the server when mysql_stmt_fetch() is called.  */
+          preparedStmt->db->streamingStmt = (sqlStmtType) preparedStmt;
+        } /* if */
       } /* if */
     } /* if */
     logFunction(printf("sqlExecute -->\n"););
@@ -2496,6 +2543,9 @@ static boolType sqlFetch (sqlStmtType sqlStatement)
       } else if (fetch_result == MYSQL_NO_DATA) {
         preparedStmt->fetchOkay = FALSE;
         preparedStmt->fetchFinished = TRUE;
+        if (preparedStmt->db->streamingStmt == (sqlStmtType) preparedStmt) {
+          preparedStmt->db->streamingStmt = NULL;
+        } /* if */
       } else {
         setDbErrorMsg("sqlFetch", "mysql_stmt_fetch",
                       mysql_stmt_errno(preparedStmt->ppStmt),
@@ -2583,6 +2633,7 @@ static sqlStmtType sqlPrepare (databaseType database,
                        (memSizeType) database,
                        striAsUnquotedCStri(sqlStatementStri)););
     db = (dbType) database;
+    finishStream(db);
     if (unlikely(db->connection == NULL)) {
       dbNotOpen("sqlPrepare");
       logError(printf("sqlPrepare: Database is not open.\n"););
@@ -2683,6 +2734,7 @@ static void sqlRollback (databaseType database)
     logFunction(printf("sqlRollback(" FMT_U_MEM ")\n",
                        (memSizeType) database););
     db = (dbType) database;
+    finishStream(db);
     if (unlikely(db->connection == NULL)) {
       dbNotOpen("sqlRollback");
       logError(printf("sqlRollback: Database is not open.\n"););
@@ -2709,6 +2761,9 @@ static void sqlSetAutoCommit (databaseType database, boolType autoCommit)
     logFunction(printf("sqlSetAutoCommit(" FMT_U_MEM ", %d)\n",
                        (memSizeType) database, autoCommit););
     db = (dbType) database;
+    if (db->autoCommit != autoCommit) {
+      finishStream(db);
+    } /* if */
     if (unlikely(db->connection == NULL)) {
       dbNotOpen("sqlSetAutoCommit");
       logError(printf("sqlSetAutoCommit: Database is not open.\n"););
@@ -2730,6 +2785,17 @@ static void sqlSetAutoCommit (databaseType database, boolType autoCommit)
 
 
 
+static void sqlSetStreaming (sqlStmtType sqlStatement, boolType streaming)
+
+  { /* sqlSetStreaming */
+    logFunction(printf("sqlSetStreaming(" FMT_U_MEM ", %d)\n",
+                       (memSizeType) sqlStatement, streaming););
+    ((preparedStmtType) sqlStatement)->streaming = streaming;
+    logFunction(printf("sqlSetStreaming -->\n"););
+  } /* sqlSetStreaming */
+
+
+
 static intType sqlStmtColumnCount (sqlStmtType sqlStatement)
 
   {
@@ -2909,6 +2975,7 @@ static boolType setupFuncTable (void)
         sqlFunc->sqlPrepare         = &sqlPrepare;
         sqlFunc->sqlRollback        = &sqlRollback;
         sqlFunc->sqlSetAutoCommit   = &sqlSetAutoCommit;
+        sqlFunc->sqlSetStreaming    = &sqlSetStreaming;
         sqlFunc->sqlStmtColumnCount = &sqlStmtColumnCount;
         sqlFunc->sqlStmtColumnName  = &sqlStmtColumnName;
       } /* if */
@@ -1,7 +1,7 @@
 /********************************************************************/
 /*                                                                  */
 /*  sql_oci.c     Database access functions for OCI.                */
-/*  Copyright (C) 1989 - 2020  Thomas Mertes                        */
+/*  Copyright (C) 1989 - 2020, 2026  Thomas Mertes                  */
 /*                                                                  */
 /*  This file is part of the Seed7 Runtime Library.                 */
 /*                                                                  */
@@ -24,7 +24,7 @@
 /*                                                                  */
 /*  Module: Seed7 Runtime Library                                   */
 /*  File: seed7/src/sql_oci.c                                       */
-/*  Changes: 2013, 2014, 2015, 2017 - 2020  Thomas Mertes           */
+/*  Changes: 2013, 2014, 2015, 2017 - 2020, 2026  Thomas Mertes     */
 /*  Content: Database access functions for OCI.                     */
 /*                                                                  */
 /********************************************************************/
@@ -70,6 +70,7 @@ typedef struct {
     sqlFuncType  sqlFunc;
     int          driver;
     int          dbCategory;
+    stmtCacheType stmtCache;
     OCIEnv      *oci_environment;
     OCIServer   *oci_server;
     OCIError    *oci_error;
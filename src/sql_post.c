@@ -25,7 +25,7 @@
 /*                                                                  */
 /*  Module: Seed7 Runtime Library                                   */
 /*  File: seed7/src/sql_post.c                                      */
-/*  Changes: 2014, 2015, 2017 - 2020  Thomas Mertes                 */
+/*  Changes: 2014, 2015, 2017 - 2020, 2026  Thomas Mertes           */
 /*  Content: Database access functions for PostgreSQL.              */
 /*                                                                  */
 /********************************************************************/
@@ -87,11 +87,13 @@ typedef struct {
     sqlFuncType  sqlFunc;
     int          driver;
     int          dbCategory;
+    stmtCacheType stmtCache;
     PGconn      *connection;
     boolType     integerDatetimes;
     uintType     nextStmtNum;
     boolType     autoCommit;
     int64Type    moneyDenominator;
+    sqlStmtType  streamingStmt;
   } dbRecordPost, *dbType;
 
 typedef struct {
@@ -127,6 +129,14 @@ typedef struct {
     int            num_tuples;
     int            fetch_index;
     boolType       increment_index;
+    boolType       streaming;
+    boolType       streamActive;
+    PGresult     **batchResult;
+    int           *batchIndex;
+    memSizeType    batchCapacity;
+    intType        batchSize;
+    PGresult      *batchEndResult;
+    int            batchEndIndex;
   } preparedStmtRecordPost, *preparedStmtType;
 
 static sqlFuncType sqlFunc = NULL;
@@ -139,6 +149,7 @@ static sqlFuncType sqlFunc = NULL;
 #define SECONDS_FROM_1970_TO_2000 INT64_SUFFIX(946684800)
 #define DEFAULT_DECIMAL_SCALE 1000
 #define SHOW_DETAILS 0
+#define STREAMING_CHUNK_SIZE 256
 
 
 #ifdef POSTGRESQL_DLL
@@ -167,6 +178,7 @@ typedef char *(CDECL *tp_PQfname) (const PGresult *res, int field_num);
 typedef Oid (CDECL *tp_PQftype) (const PGresult *res, int field_num);
 typedef int (CDECL *tp_PQgetisnull) (const PGresult *res, int tup_num, int field_num);
 typedef int (CDECL *tp_PQgetlength) (const PGresult *res, int tup_num, int field_num);
+typedef PGresult *(CDECL *tp_PQgetResult) (PGconn *conn);
 typedef char *(CDECL *tp_PQgetvalue) (const PGresult *res, int tup_num, int field_num);
 typedef int (CDECL *tp_PQnfields) (const PGresult *res);
 typedef int (CDECL *tp_PQnparams) (const PGresult *res);
@@ -179,11 +191,22 @@ typedef PGresult *(CDECL *tp_PQprepare) (PGconn *conn, const char *stmtName,
 typedef char *(CDECL *tp_PQresStatus) (ExecStatusType status);
 typedef char *(CDECL *tp_PQresultErrorMessage) (const PGresult *res);
 typedef ExecStatusType (CDECL *tp_PQresultStatus) (const PGresult *res);
+typedef int (CDECL *tp_PQsendQueryPrepared) (PGconn *conn,
+                                             const char *stmtName,
+                                             int nParams,
+                                             const char *const * paramValues,
+                                             const int *paramLengths,
+                                             const int *paramFormats,
+                                             int resultFormat);
+#ifdef LIBPQ_HAS_CHUNK_MODE
+typedef int (CDECL *tp_PQsetChunkedRowsMode) (PGconn *conn, int chunkSize);
+#endif
 typedef int (CDECL *tp_PQsetClientEncoding) (PGconn *conn, const char *encoding);
 typedef PGconn *(CDECL *tp_PQsetdbLogin) (const char *pghost, const char *pgport,
                                           const char *pgoptions, const char *pgtty,
                                           const char *dbName,
                                           const char *login, const char *pwd);
+typedef int (CDECL *tp_PQsetSingleRowMode) (PGconn *conn);
 typedef ConnStatusType (CDECL *tp_PQstatus) (const PGconn *conn);
 
 static tp_PQclear              ptr_PQclear;
@@ -196,6 +219,7 @@ static tp_PQfname              ptr_PQfname;
 static tp_PQftype              ptr_PQftype;
 static tp_PQgetisnull          ptr_PQgetisnull;
 static tp_PQgetlength          ptr_PQgetlength;
+static tp_PQgetResult          ptr_PQgetResult;
 static tp_PQgetvalue           ptr_PQgetvalue;
 static tp_PQnfields            ptr_PQnfields;
 static tp_PQnparams            ptr_PQnparams;
@@ -206,8 +230,13 @@ static tp_PQprepare            ptr_PQprepare;
 static tp_PQresStatus          ptr_PQresStatus;
 static tp_PQresultErrorMessage ptr_PQresultErrorMessage;
 static tp_PQresultStatus       ptr_PQresultStatus;
+static tp_PQsendQueryPrepared  ptr_PQsendQueryPrepared;
+#ifdef LIBPQ_HAS_CHUNK_MODE
+static tp_PQsetChunkedRowsMode ptr_PQsetChunkedRowsMode;
+#endif
 static tp_PQsetClientEncoding  ptr_PQsetClientEncoding;
 static tp_PQsetdbLogin         ptr_PQsetdbLogin;
+static tp_PQsetSingleRowMode   ptr_PQsetSingleRowMode;
 static tp_PQstatus             ptr_PQstatus;
 
 #define PQclear              ptr_PQclear
@@ -220,6 +249,7 @@ static tp_PQstatus             ptr_PQstatus;
 #define PQftype              ptr_PQftype
 #define PQgetisnull          ptr_PQgetisnull
 #define PQgetlength          ptr_PQgetlength
+#define PQgetResult          ptr_PQgetResult
 #define PQgetvalue           ptr_PQgetvalue
 #define PQnfields            ptr_PQnfields
 #define PQnparams            ptr_PQnparams
@@ -230,10 +260,19 @@ static tp_PQstatus             ptr_PQstatus;
 #define PQresStatus          ptr_PQresStatus
 #define PQresultErrorMessage ptr_PQresultErrorMessage
 #define PQresultStatus       ptr_PQresultStatus
+#define PQsendQueryPrepared  ptr_PQsendQueryPrepared
+#ifdef LIBPQ_HAS_CHUNK_MODE
+#define PQsetChunkedRowsMode ptr_PQsetChunkedRowsMode
+#endif
 #define PQsetClientEncoding  ptr_PQsetClientEncoding
 #define PQsetdbLogin         ptr_PQsetdbLogin
+#define PQsetSingleRowMode   ptr_PQsetSingleRowMode
 #define PQstatus             ptr_PQstatus
 
+#ifdef LIBPQ_HAS_CHUNK_MODE
+#define CHUNKED_ROWS_MODE_PRESENT (PQsetChunkedRowsMode != NULL)
+#endif
+
 
 
 static void loadBaseDlls (void)
@@ -308,6 +347,7 @@ static boolType setupDll (const char *dllName)
             (PQftype              = (tp_PQftype)              dllFunc(dbDll, "PQftype"))              == NULL ||
             (PQgetisnull          = (tp_PQgetisnull)          dllFunc(dbDll, "PQgetisnull"))          == NULL ||
             (PQgetlength          = (tp_PQgetlength)          dllFunc(dbDll, "PQgetlength"))          == NULL ||
+            (PQgetResult          = (tp_PQgetResult)          dllFunc(dbDll, "PQgetResult"))          == NULL ||
             (PQgetvalue           = (tp_PQgetvalue)           dllFunc(dbDll, "PQgetvalue"))           == NULL ||
             (PQnfields            = (tp_PQnfields)            dllFunc(dbDll, "PQnfields"))            == NULL ||
             (PQnparams            = (tp_PQnparams)            dllFunc(dbDll, "PQnparams"))            == NULL ||
@@ -318,10 +358,17 @@ static boolType setupDll (const char *dllName)
             (PQresStatus          = (tp_PQresStatus)          dllFunc(dbDll, "PQresStatus"))          == NULL ||
             (PQresultErrorMessage = (tp_PQresultErrorMessage) dllFunc(dbDll, "PQresultErrorMessage")) == NULL ||
             (PQresultStatus       = (tp_PQresultStatus)       dllFunc(dbDll, "PQresultStatus"))       == NULL ||
+            (PQsendQueryPrepared  = (tp_PQsendQueryPrepared)  dllFunc(dbDll, "PQsendQueryPrepared"))  == NULL ||
             (PQsetClientEncoding  = (tp_PQsetClientEncoding)  dllFunc(dbDll, "PQsetClientEncoding"))  == NULL ||
             (PQsetdbLogin         = (tp_PQsetdbLogin)         dllFunc(dbDll, "PQsetdbLogin"))         == NULL ||
+            (PQsetSingleRowMode   = (tp_PQsetSingleRowMode)   dllFunc(dbDll, "PQsetSingleRowMode"))   == NULL ||
             (PQstatus             = (tp_PQstatus)             dllFunc(dbDll, "PQstatus"))             == NULL) {
           dbDll = NULL;
+        } else {
+#ifdef LIBPQ_HAS_CHUNK_MODE
+          /* PQsetChunkedRowsMode is optional (libpq 17 and later). */
+          PQsetChunkedRowsMode = (tp_PQsetChunkedRowsMode) dllFunc(dbDll, "PQsetChunkedRowsMode");
+#endif
         } /* if */
       } /* if */
     } /* if */
@@ -353,6 +400,10 @@ static boolType findDll (void)
 
 #define findDll() TRUE
 
+#ifdef LIBPQ_HAS_CHUNK_MODE
+#define CHUNKED_ROWS_MODE_PRESENT 1
+#endif
+
 #endif
 
 
@@ -565,6 +616,65 @@ static PGresult *PQdeallocate (PGconn *conn, const char *stmtName)
 
 
 
+/**
+ *  Discard the rest of a streamed result of the connection 'db'.
+ *  Libpq allows just one active query per connection. Before another
+ *  command is sent the pending results of a streamed query must be
+ *  consumed. The statement keeps its current result, but sqlFetch
+ *  will not deliver further rows.
+ */
+static void finishStream (dbType db)
+
+  {
+    preparedStmtType preparedStmt;
+    PGresult *pendingResult;
+
+  /* finishStream */
+    logFunction(printf("finishStream(" FMT_U_MEM ")\n", (memSizeType) db););
+    if (db->streamingStmt != NULL) {
+      preparedStmt = (preparedStmtType) db->streamingStmt;
+      if (db->connection != NULL) {
+        while ((pendingResult = PQgetResult(db->connection)) != NULL) {
+          PQclear(pendingResult);
+        } /* while */
+      } /* if */
+      preparedStmt->streamActive = FALSE;
+      db->streamingStmt = NULL;
+    } /* if */
+    logFunction(printf("finishStream -->\n"););
+  } /* finishStream */
+
+
+
+/**
+ *  Free the current batch of 'preparedStmt'.
+ *  The results of the batch, which have been replaced by a newer
+ *  streamed result, are freed. Afterwards the current row is the
+ *  row after the batch again.
+ */
+static void freeBatch (preparedStmtType preparedStmt)
+
+  {
+    intType pos;
+    PGresult *batchResult;
+
+  /* freeBatch */
+    if (preparedStmt->batchSize != 0) {
+      for (pos = 0; pos < preparedStmt->batchSize; pos++) {
+        batchResult = preparedStmt->batchResult[pos];
+        if (batchResult != preparedStmt->batchEndResult &&
+            (pos == 0 || batchResult != preparedStmt->batchResult[pos - 1])) {
+          PQclear(batchResult);
+        } /* if */
+      } /* for */
+      preparedStmt->execute_result = preparedStmt->batchEndResult;
+      preparedStmt->fetch_index = preparedStmt->batchEndIndex;
+      preparedStmt->batchSize = 0;
+    } /* if */
+  } /* freeBatch */
+
+
+
 /**
  *  Closes a database and frees the memory used by it.
  */
@@ -618,6 +728,12 @@ static void freePreparedStmt (sqlStmtType sqlStatement)
     if (preparedStmt->paramFormats != NULL) {
       FREE_TABLE(preparedStmt->paramFormats, int, preparedStmt->param_array_size);
     } /* if */
+    finishStream(preparedStmt->db);
+    freeBatch(preparedStmt);
+    if (preparedStmt->batchResult != NULL) {
+      FREE_TABLE(preparedStmt->batchResult, PGresult *, preparedStmt->batchCapacity);
+      FREE_TABLE(preparedStmt->batchIndex, int, preparedStmt->batchCapacity);
+    } /* if */
     if (preparedStmt->execute_result != NULL) {
       PQclear(preparedStmt->execute_result);
     } /* if */
@@ -1458,6 +1574,41 @@ static timeStampType getTimestamp1970 (timeStampType timestamp,
 
 
 
+static void sqlBatchSelectRow (sqlStmtType sqlStatement, intType row)
+
+  {
+    preparedStmtType preparedStmt;
+
+  /* sqlBatchSelectRow */
+    logFunction(printf("sqlBatchSelectRow(" FMT_U_MEM ", " FMT_D ")\n",
+                       (memSizeType) sqlStatement, row););
+    preparedStmt = (preparedStmtType) sqlStatement;
+    if (unlikely(row < 1 || row > preparedStmt->batchSize)) {
+      logError(printf("sqlBatchSelectRow: row: " FMT_D ", batch size: " FMT_D ".\n",
+                      row, preparedStmt->batchSize););
+      raise_error(RANGE_ERROR);
+    } else {
+      preparedStmt->execute_result = preparedStmt->batchResult[row - 1];
+      preparedStmt->fetch_index = preparedStmt->batchIndex[row - 1];
+      preparedStmt->fetchOkay = TRUE;
+    } /* if */
+    logFunction(printf("sqlBatchSelectRow -->\n"););
+  } /* sqlBatchSelectRow */
+
+
+
+static intType sqlBatchSize (sqlStmtType sqlStatement)
+
+  { /* sqlBatchSize */
+    logFunction(printf("sqlBatchSize(" FMT_U_MEM ")\n",
+                       (memSizeType) sqlStatement););
+    logFunction(printf("sqlBatchSize --> " FMT_D "\n",
+                       ((preparedStmtType) sqlStatement)->batchSize););
+    return ((preparedStmtType) sqlStatement)->batchSize;
+  } /* sqlBatchSize */
+
+
+
 static void sqlBindBigInt (sqlStmtType sqlStatement, intType pos,
     const const_bigIntType value)
 
@@ -2234,6 +2385,10 @@ static void sqlClose (databaseType database)
     logFunction(printf("sqlClose(" FMT_U_MEM ")\n",
                        (memSizeType) database););
     db = (dbType) database;
+    if (db->streamingStmt != NULL) {
+      ((preparedStmtType) db->streamingStmt)->streamActive = FALSE;
+      db->streamingStmt = NULL;
+    } /* if */
     if (db->connection != NULL) {
       PQfinish(db->connection);
       db->connection = NULL;
@@ -3261,6 +3416,7 @@ static void sqlCommit (databaseType database)
       logError(printf("sqlCommit: Database is not open.\n"););
       raise_error(DATABASE_ERROR);
     } else if (!db->autoCommit) {
+      finishStream(db);
       err_info = doExecSql(db->connection, "COMMIT", err_info);
       err_info = doExecSql(db->connection, "BEGIN TRANSACTION", err_info);
       if (unlikely(err_info != OKAY_NO_ERROR)) {
@@ -3272,6 +3428,135 @@ static void sqlCommit (databaseType database)
 
 
 
+/**
+ *  Get the next result of a streamed query.
+ *  In single row and chunked rows mode every PGresult contains just
+ *  a part of the result rows. The final result with the status
+ *  PGRES_TUPLES_OK contains no rows. It is kept as execute_result,
+ *  since it describes the columns. The old execute_result is freed,
+ *  when a new result is available and no row of the current batch
+ *  refers to it.
+ *  @return OKAY_NO_ERROR or DATABASE_ERROR.
+ */
+static errInfoType nextStreamResult (preparedStmtType preparedStmt)
+
+  {
+    PGresult *nextResult;
+    ExecStatusType status;
+    errInfoType err_info = OKAY_NO_ERROR;
+
+  /* nextStreamResult */
+    logFunction(printf("nextStreamResult(" FMT_U_MEM ")\n",
+                       (memSizeType) preparedStmt););
+    nextResult = PQgetResult(preparedStmt->db->connection);
+    if (nextResult == NULL) {
+      /* No more results: The stream is finished. */
+      preparedStmt->num_tuples = 0;
+      finishStream(preparedStmt->db);
+    } else {
+      status = PQresultStatus(nextResult);
+      if (status == PGRES_SINGLE_TUPLE ||
+#ifdef LIBPQ_HAS_CHUNK_MODE
+          status == PGRES_TUPLES_CHUNK ||
+#endif
+          status == PGRES_TUPLES_OK || status == PGRES_COMMAND_OK) {
+        if (preparedStmt->execute_result != NULL &&
+            (preparedStmt->batchSize == 0 ||
+             preparedStmt->batchResult[preparedStmt->batchSize - 1] !=
+             preparedStmt->execute_result)) {
+          PQclear(preparedStmt->execute_result);
+        } /* if */
+        preparedStmt->execute_result = nextResult;
+        preparedStmt->num_tuples = PQntuples(nextResult);
+        if (status == PGRES_TUPLES_OK || status == PGRES_COMMAND_OK) {
+          /* The last result of the query has been received. */
+          preparedStmt->execute_status = status;
+          finishStream(preparedStmt->db);
+        } /* if */
+      } else {
+        setDbErrorMsg("sqlFetch", "PQgetResult", preparedStmt->db->connection);
+        logError(printf("nextStreamResult: PQgetResult returns a status of %s:\n%s",
+                        PQresStatus(status), dbError.message););
+        PQclear(nextResult);
+        preparedStmt->num_tuples = 0;
+        finishStream(preparedStmt->db);
+        err_info = DATABASE_ERROR;
+      } /* if */
+    } /* if */
+    preparedStmt->fetch_index = 0;
+    logFunction(printf("nextStreamResult --> %d (num_tuples: %d)\n",
+                       err_info, preparedStmt->num_tuples););
+    return err_info;
+  } /* nextStreamResult */
+
+
+
+/**
+ *  Execute a prepared statement such that the result is streamed.
+ *  The query is sent with PQsendQueryPrepared and the rows are
+ *  received in chunks (or row by row, if the client library does
+ *  not support chunked rows mode) while they are fetched.
+ */
+static void executeStreaming (preparedStmtType preparedStmt)
+
+  {
+    PGconn *connection;
+    boolType rowModeSet = FALSE;
+    errInfoType err_info;
+
+  /* executeStreaming */
+    logFunction(printf("executeStreaming(" FMT_U_MEM ")\n",
+                       (memSizeType) preparedStmt););
+    connection = preparedStmt->db->connection;
+    finishStream(preparedStmt->db);
+    if (preparedStmt->execute_result != NULL) {
+      PQclear(preparedStmt->execute_result);
+      preparedStmt->execute_result = NULL;
+    } /* if */
+    if (unlikely(PQsendQueryPrepared(connection,
+                                     preparedStmt->stmtName,
+                                     (int) preparedStmt->param_array_size,
+                                     (const const_cstriType *) preparedStmt->paramValues,
+                                     preparedStmt->paramLengths,
+                                     preparedStmt->paramFormats,
+                                     1) == 0)) {
+      setDbErrorMsg("sqlExecute", "PQsendQueryPrepared", connection);
+      logError(printf("executeStreaming: PQsendQueryPrepared failed:\n%s",
+                      dbError.message););
+      preparedStmt->executeSuccessful = FALSE;
+      raise_error(DATABASE_ERROR);
+    } else {
+#ifdef CHUNKED_ROWS_MODE_PRESENT
+      if (CHUNKED_ROWS_MODE_PRESENT) {
+        rowModeSet = PQsetChunkedRowsMode(connection, STREAMING_CHUNK_SIZE) != 0;
+      } /* if */
+#endif
+      if (!rowModeSet) {
+        /* If this fails too, the whole result is delivered at once. */
+        PQsetSingleRowMode(connection);
+      } /* if */
+      preparedStmt->streamActive = TRUE;
+      preparedStmt->db->streamingStmt = (sqlStmtType) preparedStmt;
+      preparedStmt->execute_status = PGRES_TUPLES_OK;
+      err_info = nextStreamResult(preparedStmt);
+      if (unlikely(err_info != OKAY_NO_ERROR)) {
+        preparedStmt->executeSuccessful = FALSE;
+        raise_error(err_info);
+      } else if (unlikely(preparedStmt->execute_result == NULL)) {
+        dbInconsistent("sqlExecute", "PQgetResult");
+        logError(printf("executeStreaming: PQgetResult returns NULL\n"););
+        preparedStmt->executeSuccessful = FALSE;
+        raise_error(DATABASE_ERROR);
+      } else {
+        preparedStmt->executeSuccessful = TRUE;
+        preparedStmt->increment_index = FALSE;
+      } /* if */
+    } /* if */
+    logFunction(printf("executeStreaming -->\n"););
+  } /* executeStreaming */
+
+
+
 static void sqlExecute (sqlStmtType sqlStatement)
 
   {
@@ -3283,12 +3568,17 @@ static void sqlExecute (sqlStmtType sqlStatement)
     logFunction(printf("sqlExecute(" FMT_U_MEM ")\n",
                        (memSizeType) sqlStatement););
     preparedStmt = (preparedStmtType) sqlStatement;
+    freeBatch(preparedStmt);
     if (unlikely(!allParametersBound(preparedStmt))) {
       dbLibError("sqlExecute", "SQLExecute",
                  "Unbound statement parameter(s).\n");
       raise_error(DATABASE_ERROR);
+    } else if (preparedStmt->streaming) {
+      preparedStmt->fetchOkay = FALSE;
+      executeStreaming(preparedStmt);
     } else {
       preparedStmt->fetchOkay = FALSE;
+      finishStream(preparedStmt->db);
       if (preparedStmt->execute_result != NULL) {
         PQclear(preparedStmt->execute_result);
       } /* if */
@@ -3354,15 +3644,16 @@ static void sqlExecute (sqlStmtType sqlStatement)
 
 
 
-static boolType sqlFetch (sqlStmtType sqlStatement)
+/**
+ *  Advance to the next row of the result.
+ *  @return TRUE if a row is available, FALSE otherwise.
+ */
+static boolType fetchRow (preparedStmtType preparedStmt)
 
   {
-    preparedStmtType preparedStmt;
+    errInfoType err_info = OKAY_NO_ERROR;
 
-  /* sqlFetch */
-    logFunction(printf("sqlFetch(" FMT_U_MEM ")\n",
-                       (memSizeType) sqlStatement););
-    preparedStmt = (preparedStmtType) sqlStatement;
+  /* fetchRow */
     if (unlikely(!preparedStmt->executeSuccessful)) {
       dbLibError("sqlFetch", "PQexecPrepared",
                  "Execute was not successful.\n");
@@ -3378,17 +3669,133 @@ static boolType sqlFetch (sqlStmtType sqlStatement)
       } else {
         preparedStmt->fetch_index++;
       } /* if */
+      while (preparedStmt->fetch_index >= preparedStmt->num_tuples &&
+             preparedStmt->streamActive && err_info == OKAY_NO_ERROR) {
+        err_info = nextStreamResult(preparedStmt);
+      } /* while */
       preparedStmt->fetchOkay =
           preparedStmt->fetch_index < preparedStmt->num_tuples;
+      if (unlikely(err_info != OKAY_NO_ERROR)) {
+        raise_error(err_info);
+      } /* if */
     } else {
       preparedStmt->fetchOkay = FALSE;
     } /* if */
-    logFunction(printf("sqlFetch --> %d\n", preparedStmt->fetchOkay););
     return preparedStmt->fetchOkay;
+  } /* fetchRow */
+
+
+
+static boolType sqlFetch (sqlStmtType sqlStatement)
+
+  {
+    preparedStmtType preparedStmt;
+    boolType fetchOkay;
+
+  /* sqlFetch */
+    logFunction(printf("sqlFetch(" FMT_U_MEM ")\n",
+                       (memSizeType) sqlStatement););
+    preparedStmt = (preparedStmtType) sqlStatement;
+    freeBatch(preparedStmt);
+    fetchOkay = fetchRow(preparedStmt);
+    logFunction(printf("sqlFetch --> %d\n", fetchOkay););
+    return fetchOkay;
   } /* sqlFetch */
 
 
 
+/**
+ *  Make room for 'minCapacity' rows in the batch of 'preparedStmt'.
+ */
+static errInfoType reserveBatch (preparedStmtType preparedStmt,
+    memSizeType minCapacity)
+
+  {
+    memSizeType newCapacity;
+    PGresult **newResults;
+    int *newIndices;
+    errInfoType err_info = OKAY_NO_ERROR;
+
+  /* reserveBatch */
+    if (preparedStmt->batchCapacity < minCapacity) {
+      newCapacity = preparedStmt->batchCapacity * 2;
+      if (newCapacity < minCapacity) {
+        newCapacity = minCapacity;
+      } /* if */
+      if (unlikely(newCapacity > MAX_MEMSIZETYPE / sizeof(PGresult *) ||
+                   !ALLOC_TABLE(newResults, PGresult *, newCapacity))) {
+        err_info = MEMORY_ERROR;
+      } else if (unlikely(!ALLOC_TABLE(newIndices, int, newCapacity))) {
+        FREE_TABLE(newResults, PGresult *, newCapacity);
+        err_info = MEMORY_ERROR;
+      } else {
+        if (preparedStmt->batchResult != NULL) {
+          memcpy(newResults, preparedStmt->batchResult,
+                 (size_t) preparedStmt->batchSize * sizeof(PGresult *));
+          memcpy(newIndices, preparedStmt->batchIndex,
+                 (size_t) preparedStmt->batchSize * sizeof(int));
+          FREE_TABLE(preparedStmt->batchResult, PGresult *, preparedStmt->batchCapacity);
+          FREE_TABLE(preparedStmt->batchIndex, int, preparedStmt->batchCapacity);
+        } /* if */
+        preparedStmt->batchResult = newResults;
+        preparedStmt->batchIndex = newIndices;
+        preparedStmt->batchCapacity = newCapacity;
+      } /* if */
+    } /* if */
+    return err_info;
+  } /* reserveBatch */
+
+
+
+/**
+ *  Fetch up to 'maxRows' rows into the batch of 'sqlStatement'.
+ *  A batch row is described by a PGresult and a tuple index in it.
+ *  In streaming mode the rows of a batch can be spread over several
+ *  PGresults. These results are kept until the batch is freed.
+ */
+static intType sqlFetchBatch (sqlStmtType sqlStatement, intType maxRows)
+
+  {
+    preparedStmtType preparedStmt;
+    boolType fetchOkay = TRUE;
+    errInfoType err_info = OKAY_NO_ERROR;
+
+  /* sqlFetchBatch */
+    logFunction(printf("sqlFetchBatch(" FMT_U_MEM ", " FMT_D ")\n",
+                       (memSizeType) sqlStatement, maxRows););
+    preparedStmt = (preparedStmtType) sqlStatement;
+    freeBatch(preparedStmt);
+    while (preparedStmt->batchSize < maxRows && fetchOkay &&
+           err_info == OKAY_NO_ERROR) {
+      fetchOkay = fetchRow(preparedStmt);
+      preparedStmt->batchEndResult = preparedStmt->execute_result;
+      preparedStmt->batchEndIndex = preparedStmt->fetch_index;
+      if (fetchOkay) {
+        err_info = reserveBatch(preparedStmt,
+                                (memSizeType) preparedStmt->batchSize + 1);
+        if (likely(err_info == OKAY_NO_ERROR)) {
+          preparedStmt->batchResult[preparedStmt->batchSize] =
+              preparedStmt->execute_result;
+          preparedStmt->batchIndex[preparedStmt->batchSize] =
+              preparedStmt->fetch_index;
+          preparedStmt->batchSize++;
+        } /* if */
+      } /* if */
+    } /* while */
+    if (unlikely(err_info != OKAY_NO_ERROR)) {
+      freeBatch(preparedStmt);
+      preparedStmt->fetchOkay = FALSE;
+      raise_error(err_info);
+    } else if (preparedStmt->batchSize != 0) {
+      sqlBatchSelectRow(sqlStatement, preparedStmt->batchSize);
+    } /* if */
+    logFunction(printf("sqlFetchBatch --> " FMT_D "\n",
+                       preparedStmt->batchSize););
+    return preparedStmt->batchSize;
+  } /* sqlFetchBatch */
+
+
+
 static boolType sqlGetAutoCommit (databaseType database)
 
   {
@@ -3481,6 +3888,7 @@ static sqlStmtType sqlPrepare (databaseType database,
             db->nextStmtNum++;
             sprintf(preparedStmt->stmtName, STMT_NAME_PREFIX FMT_U,
                     preparedStmt->stmtNum);
+            finishStream(db);
             prepare_result = PQprepare(db->connection, preparedStmt->stmtName, query, 0, NULL);
             if (unlikely(prepare_result == NULL)) {
               FREE_RECORD2(preparedStmt, preparedStmtRecordPost,
@@ -3533,6 +3941,40 @@ static sqlStmtType sqlPrepare (databaseType database,
 
 
 
+/**
+ *  Reset a prepared statement to the state after sqlPrepare.
+ *  The result is released, an active stream is finished
+ *  and all parameters are unbound.
+ */
+static void sqlResetStmt (sqlStmtType sqlStatement)
+
+  {
+    preparedStmtType preparedStmt;
+    memSizeType pos;
+
+  /* sqlResetStmt */
+    logFunction(printf("sqlResetStmt(" FMT_U_MEM ")\n",
+                       (memSizeType) sqlStatement););
+    preparedStmt = (preparedStmtType) sqlStatement;
+    freeBatch(preparedStmt);
+    if (preparedStmt->db->streamingStmt == sqlStatement) {
+      finishStream(preparedStmt->db);
+    } /* if */
+    if (preparedStmt->execute_result != NULL) {
+      PQclear(preparedStmt->execute_result);
+      preparedStmt->execute_result = NULL;
+    } /* if */
+    for (pos = 0; pos < preparedStmt->param_array_size; pos++) {
+      preparedStmt->param_array[pos].bound = FALSE;
+    } /* for */
+    preparedStmt->executeSuccessful = FALSE;
+    preparedStmt->fetchOkay = FALSE;
+    preparedStmt->streaming = FALSE;
+    logFunction(printf("sqlResetStmt -->\n"););
+  } /* sqlResetStmt */
+
+
+
 static void sqlRollback (databaseType database)
 
   {
@@ -3548,6 +3990,7 @@ static void sqlRollback (databaseType database)
       logError(printf("sqlRollback: Database is not open.\n"););
       raise_error(DATABASE_ERROR);
     } else if (!db->autoCommit) {
+      finishStream(db);
       err_info = doExecSql(db->connection, "ROLLBACK", err_info);
       err_info = doExecSql(db->connection, "BEGIN TRANSACTION", err_info);
       if (unlikely(err_info != OKAY_NO_ERROR)) {
@@ -3575,6 +4018,7 @@ static void sqlSetAutoCommit (databaseType database, boolType autoCommit)
       raise_error(DATABASE_ERROR);
     } else {
       if (db->autoCommit != autoCommit) {
+        finishStream(db);
         if (autoCommit) {
           err_info = doExecSql(db->connection, "COMMIT", err_info);
         } else {
@@ -3592,6 +4036,17 @@ static void sqlSetAutoCommit (databaseType database, boolType autoCommit)
 
 
 
+static void sqlSetStreaming (sqlStmtType sqlStatement, boolType streaming)
+
+  { /* sqlSetStreaming */
+    logFunction(printf("sqlSetStreaming(" FMT_U_MEM ", %d)\n",
+                       (memSizeType) sqlStatement, streaming););
+    ((preparedStmtType) sqlStatement)->streaming = streaming;
+    logFunction(printf("sqlSetStreaming -->\n"););
+  } /* sqlSetStreaming */
+
+
+
 static intType sqlStmtColumnCount (sqlStmtType sqlStatement)
 
   {
@@ -3666,6 +4121,8 @@ static boolType setupFuncTable (void)
         memset(sqlFunc, 0, sizeof(sqlFuncRecord));
         sqlFunc->freeDatabase       = &freeDatabase;
         sqlFunc->freePreparedStmt   = &freePreparedStmt;
+        sqlFunc->sqlBatchSelectRow  = &sqlBatchSelectRow;
+        sqlFunc->sqlBatchSize       = &sqlBatchSize;
         sqlFunc->sqlBindBigInt      = &sqlBindBigInt;
         sqlFunc->sqlBindBigRat      = &sqlBindBigRat;
         sqlFunc->sqlBindBool        = &sqlBindBool;
@@ -3689,11 +4146,14 @@ static boolType setupFuncTable (void)
         sqlFunc->sqlCommit          = &sqlCommit;
         sqlFunc->sqlExecute         = &sqlExecute;
         sqlFunc->sqlFetch           = &sqlFetch;
+        sqlFunc->sqlFetchBatch      = &sqlFetchBatch;
         sqlFunc->sqlGetAutoCommit   = &sqlGetAutoCommit;
         sqlFunc->sqlIsNull          = &sqlIsNull;
         sqlFunc->sqlPrepare         = &sqlPrepare;
+        sqlFunc->sqlResetStmt       = &sqlResetStmt;
         sqlFunc->sqlRollback        = &sqlRollback;
         sqlFunc->sqlSetAutoCommit   = &sqlSetAutoCommit;
+        sqlFunc->sqlSetStreaming    = &sqlSetStreaming;
         sqlFunc->sqlStmtColumnCount = &sqlStmtColumnCount;
         sqlFunc->sqlStmtColumnName  = &sqlStmtColumnName;
       } /* if */
@@ -1,7 +1,7 @@
 /********************************************************************/
 /*                                                                  */
 /*  sql_rtl.c     Database access functions.                        */
-/*  Copyright (C) 1989 - 2020  Thomas Mertes                        */
+/*  Copyright (C) 1989 - 2020, 2026  Thomas Mertes                  */
 /*                                                                  */
 /*  This file is part of the Seed7 Runtime Library.                 */
 /*                                                                  */
@@ -24,7 +24,7 @@
 /*                                                                  */
 /*  Module: Seed7 Runtime Library                                   */
 /*  File: seed7/src/sql_rtl.c                                       */
-/*  Changes: 2014, 2015, 2017 - 2020  Thomas Mertes                 */
+/*  Changes: 2014, 2015, 2017 - 2020, 2026  Thomas Mertes           */
 /*  Content: Database access functions.                             */
 /*                                                                  */
 /********************************************************************/
@@ -36,13 +36,16 @@
 
 #include "stdlib.h"
 #include "stdio.h"
+#include "string.h"
 #include "math.h"
 #include "float.h"
 #include "time.h"
 
 #include "common.h"
 #include "data_rtl.h"
+#include "heaputl.h"
 #include "striutl.h"
+#include "str_rtl.h"
 #include "flt_rtl.h"
 #include "tim_rtl.h"
 #include "big_drv.h"
@@ -65,6 +68,7 @@ typedef struct dbStruct {
     sqlFuncType  sqlFunc;
     int          driver;
     int          dbCategory;
+    stmtCacheType stmtCache;
   } dbRecord, *dbType;
 
 typedef struct preparedStmtStruct {
@@ -73,6 +77,530 @@ typedef struct preparedStmtStruct {
     sqlFuncType  sqlFunc;
   } preparedStmtRecord, *preparedStmtType;
 
+typedef struct {
+    striType         sqlStatementStri;
+    intType          hashCode;
+    preparedStmtType statement;
+    uintType         lastUse;
+  } stmtCacheEntryRecord, *stmtCacheEntryType;
+
+typedef struct stmtCacheStruct {
+    memSizeType          capacity;
+    memSizeType          size;
+    uintType             useCounter;
+    intType              hits;
+    intType              misses;
+    stmtCacheEntryRecord entry[1];
+  } stmtCacheRecord;
+
+#define SIZ_STMT_CACHE(cap)       (sizeof(stmtCacheRecord) - sizeof(stmtCacheEntryRecord) + \
+                                   (cap) * sizeof(stmtCacheEntryRecord))
+#define MAX_STMT_CACHE_CAPACITY   ((MAX_MEMSIZETYPE - sizeof(stmtCacheRecord)) / \
+                                   sizeof(stmtCacheEntryRecord))
+#define ALLOC_STMT_CACHE(var,cap) (ALLOC_HEAP(var, stmtCacheType, SIZ_STMT_CACHE(cap))? \
+                                   CNT(CNT1_BYT(SIZ_STMT_CACHE(cap))) TRUE:FALSE)
+#define FREE_STMT_CACHE(var,cap)  (CNT(CNT2_BYT(SIZ_STMT_CACHE(cap))) \
+                                   FREE_HEAP(var, SIZ_STMT_CACHE(cap)))
+
+
+
+/**
+ *  Decrement the usage count of a cached statement.
+ *  The statement is freed, if it is not used elsewhere.
+ */
+static void releaseCachedStmt (preparedStmtType statement)
+
+  { /* releaseCachedStmt */
+    if (statement->usage_count != 0) {
+      statement->usage_count--;
+      if (statement->usage_count == 0 &&
+          statement->sqlFunc != NULL &&
+          statement->sqlFunc->freePreparedStmt != NULL) {
+        logMessage(printf("FREE " FMT_U_MEM "\n", (memSizeType) statement););
+        statement->sqlFunc->freePreparedStmt((sqlStmtType) statement);
+      } /* if */
+    } /* if */
+  } /* releaseCachedStmt */
+
+
+
+/**
+ *  Remove the entry with the given 'index' from the statement cache.
+ *  The last entry is moved to the free place.
+ */
+static void removeCacheEntry (stmtCacheType cache, memSizeType index)
+
+  {
+    stmtCacheEntryType entry;
+
+  /* removeCacheEntry */
+    entry = &cache->entry[index];
+    FREE_STRI(entry->sqlStatementStri);
+    releaseCachedStmt(entry->statement);
+    cache->size--;
+    if (index != cache->size) {
+      *entry = cache->entry[cache->size];
+    } /* if */
+  } /* removeCacheEntry */
+
+
+
+/**
+ *  Release all statements of a statement cache.
+ *  The cache itself and its hit and miss counters are kept.
+ */
+static void clearStmtCache (stmtCacheType cache)
+
+  { /* clearStmtCache */
+    while (cache->size != 0) {
+      removeCacheEntry(cache, cache->size - 1);
+    } /* while */
+  } /* clearStmtCache */
+
+
+
+/**
+ *  Free the statement cache of 'db', if only cached statements refer to 'db'.
+ *  This must be called before a reference to 'db' is released.
+ *  Every cached statement refers to its database. Without this
+ *  function a database with cached statements would never be freed.
+ *  After the statements are released only the reference, which is
+ *  about to be released, refers to 'db'.
+ */
+static void freeUnusedStmtCache (dbType db)
+
+  {
+    stmtCacheType cache;
+
+  /* freeUnusedStmtCache */
+    if (db != NULL && db->stmtCache != NULL &&
+        db->usage_count == (uintType) db->stmtCache->size + 1) {
+      cache = db->stmtCache;
+      db->stmtCache = NULL;
+      clearStmtCache(cache);
+      FREE_STMT_CACHE(cache, cache->capacity);
+    } /* if */
+  } /* freeUnusedStmtCache */
+
+
+
+/**
+ *  Reset a cached statement, which is not used elsewhere anymore.
+ *  This must be called when the usage count of 'statement' has been
+ *  decremented to 1. Resetting releases the result of the statement
+ *  (and the locks held by it) like freeing an uncached statement would.
+ */
+static void resetIdleStmt (preparedStmtType statement)
+
+  {
+    stmtCacheType cache;
+    memSizeType index;
+
+  /* resetIdleStmt */
+    if (statement->db != NULL && statement->db->stmtCache != NULL &&
+        statement->sqlFunc != NULL && statement->sqlFunc->sqlResetStmt != NULL) {
+      cache = statement->db->stmtCache;
+      for (index = 0; index < cache->size; index++) {
+        if (cache->entry[index].statement == statement) {
+          statement->sqlFunc->sqlResetStmt((sqlStmtType) statement);
+          index = cache->size;
+        } /* if */
+      } /* for */
+    } /* if */
+  } /* resetIdleStmt */
+
+
+
+/**
+ *  Prepare a statement with the statement cache of 'db'.
+ *  A cached statement is only returned if it is not used elsewhere.
+ *  Otherwise a new statement is prepared and added to the cache.
+ *  This way the cache can contain several statements with the same
+ *  SQL text. If the cache is full the least recently used entry
+ *  is removed.
+ */
+static sqlStmtType cachedPrepare (dbType db, const const_striType sqlStatementStri)
+
+  {
+    stmtCacheType cache;
+    intType hashCode;
+    memSizeType index;
+    memSizeType lruIndex;
+    stmtCacheEntryType entry = NULL;
+    striType sqlStatementCopy;
+    preparedStmtType statement;
+
+  /* cachedPrepare */
+    cache = db->stmtCache;
+    hashCode = strHashCode(sqlStatementStri);
+    for (index = 0; index < cache->size && entry == NULL; index++) {
+      if (cache->entry[index].hashCode == hashCode &&
+          cache->entry[index].statement->usage_count == 1 &&
+          cache->entry[index].sqlStatementStri->size == sqlStatementStri->size &&
+          memcmp(cache->entry[index].sqlStatementStri->mem, sqlStatementStri->mem,
+                 sqlStatementStri->size * sizeof(strElemType)) == 0) {
+        entry = &cache->entry[index];
+      } /* if */
+    } /* for */
+    if (entry != NULL) {
+      cache->hits++;
+      entry->lastUse = ++cache->useCounter;
+      entry->statement->usage_count++;
+      statement = entry->statement;
+    } else {
+      cache->misses++;
+      statement = (preparedStmtType) db->sqlFunc->sqlPrepare(
+          (databaseType) db, sqlStatementStri);
+      if (statement != NULL && statement->usage_count != 0 &&
+          ALLOC_STRI_SIZE_OK(sqlStatementCopy, sqlStatementStri->size)) {
+        sqlStatementCopy->size = sqlStatementStri->size;
+        memcpy(sqlStatementCopy->mem, sqlStatementStri->mem,
+               sqlStatementStri->size * sizeof(strElemType));
+        if (cache->size == cache->capacity) {
+          lruIndex = 0;
+          for (index = 1; index < cache->size; index++) {
+            if (cache->entry[index].lastUse < cache->entry[lruIndex].lastUse) {
+              lruIndex = index;
+            } /* if */
+          } /* for */
+          removeCacheEntry(cache, lruIndex);
+        } /* if */
+        entry = &cache->entry[cache->size];
+        entry->sqlStatementStri = sqlStatementCopy;
+        entry->hashCode = hashCode;
+        entry->statement = statement;
+        entry->lastUse = ++cache->useCounter;
+        statement->usage_count++;
+        cache->size++;
+      } /* if */
+    } /* if */
+    return (sqlStmtType) statement;
+  } /* cachedPrepare */
+
+
+
+/**
+ *  Determine the number of rows of the current batch of 'sqlStatement'.
+ *  Drivers without batch support deliver batches of one row.
+ *  @return the number of rows in the batch, or -1 if an exception
+ *          has been raised.
+ */
+static intType batchRowCount (sqlStmtType sqlStatement, const char *funcName)
+
+  {
+    intType rowCount;
+
+  /* batchRowCount */
+    if (unlikely(sqlStatement == NULL)) {
+      logError(printf("%s(" FMT_U_MEM "): SQL statement is empty.\n",
+                      funcName, (memSizeType) sqlStatement););
+      raise_error(RANGE_ERROR);
+      rowCount = -1;
+    } else if (unlikely(sqlStatement->db == NULL ||
+                        !sqlStatement->db->isOpen)) {
+      dbNotOpen(funcName);
+      logError(printf("%s(" FMT_U_MEM "): Database is not open.\n",
+                      funcName, (memSizeType) sqlStatement););
+      raise_error(DATABASE_ERROR);
+      rowCount = -1;
+    } else if (unlikely(((preparedStmtType) sqlStatement)->sqlFunc == NULL)) {
+      dbNoFuncPtr(funcName);
+      logError(printf("%s(" FMT_U_MEM "): Function pointer missing.\n",
+                      funcName, (memSizeType) sqlStatement););
+      raise_error(DATABASE_ERROR);
+      rowCount = -1;
+    } else if (((preparedStmtType) sqlStatement)->sqlFunc->sqlBatchSize == NULL) {
+      rowCount = 1;
+    } else {
+      rowCount = ((preparedStmtType) sqlStatement)->sqlFunc->sqlBatchSize(sqlStatement);
+    } /* if */
+    return rowCount;
+  } /* batchRowCount */
+
+
+
+static void selectBatchRow (sqlStmtType sqlStatement, intType row)
+
+  { /* selectBatchRow */
+    if (((preparedStmtType) sqlStatement)->sqlFunc->sqlBatchSelectRow != NULL) {
+      ((preparedStmtType) sqlStatement)->sqlFunc->sqlBatchSelectRow(sqlStatement, row);
+    } /* if */
+  } /* selectBatchRow */
+
+
+
+/**
+ *  Get the values of a float column for all rows of the current batch.
+ *  The values are converted with the same rules as sqlColumnFloat.
+ *  Afterwards the last row of the batch is the current row.
+ *  @param sqlStatement Prepared statement, where sqlFetchBatch
+ *         has been called.
+ *  @param column Number of the column (starting with 1).
+ *  @return an array with the column values of the batch rows
+ *          (indices starting with 1).
+ *  @exception RANGE_ERROR If the statement was not prepared or
+ *                         if no data was successfully fetched or
+ *                         if the specified column does not exist or
+ *                         if the column cannot be converted.
+ *  @exception DATABASE_ERROR If a database function fails.
+ */
+rtlArrayType sqlBatchColumnFloat (sqlStmtType sqlStatement, intType column)
+
+  {
+    intType rowCount;
+    intType row;
+    sqlFuncType sqlFunc;
+    rtlArrayType columnValues;
+
+  /* sqlBatchColumnFloat */
+    logFunction(printf("sqlBatchColumnFloat(" FMT_U_MEM ", " FMT_D ")\n",
+                       (memSizeType) sqlStatement, column););
+    rowCount = batchRowCount(sqlStatement, "sqlBatchColumnFloat");
+    if (unlikely(rowCount < 0)) {
+      columnValues = NULL;
+    } else if (unlikely((sqlFunc = ((preparedStmtType) sqlStatement)->sqlFunc)->
+                        sqlColumnFloat == NULL)) {
+      dbNoFuncPtr("sqlBatchColumnFloat");
+      raise_error(DATABASE_ERROR);
+      columnValues = NULL;
+    } else if (unlikely(!ALLOC_RTL_ARRAY(columnValues, (memSizeType) rowCount))) {
+      raise_error(MEMORY_ERROR);
+    } else {
+      columnValues->min_position = 1;
+      columnValues->max_position = rowCount;
+      for (row = 1; row <= rowCount; row++) {
+        selectBatchRow(sqlStatement, row);
+        columnValues->arr[row - 1].value.floatValue =
+            sqlFunc->sqlColumnFloat(sqlStatement, column);
+      } /* for */
+    } /* if */
+    logFunction(printf("sqlBatchColumnFloat --> " FMT_U_MEM "\n",
+                       (memSizeType) columnValues););
+    return columnValues;
+  } /* sqlBatchColumnFloat */
+
+
+
+/**
+ *  Get the values of an integer column for all rows of the current batch.
+ *  The values are converted with the same rules as sqlColumnInt.
+ *  Afterwards the last row of the batch is the current row.
+ *  @param sqlStatement Prepared statement, where sqlFetchBatch
+ *         has been called.
+ *  @param column Number of the column (starting with 1).
+ *  @return an array with the column values of the batch rows
+ *          (indices starting with 1).
+ *  @exception RANGE_ERROR If the statement was not prepared or
+ *                         if no data was successfully fetched or
+ *                         if the specified column does not exist or
+ *                         if the column cannot be converted.
+ *  @exception DATABASE_ERROR If a database function fails.
+ */
+rtlArrayType sqlBatchColumnInt (sqlStmtType sqlStatement, intType column)
+
+  {
+    intType rowCount;
+    intType row;
+    sqlFuncType sqlFunc;
+    rtlArrayType columnValues;
+
+  /* sqlBatchColumnInt */
+    logFunction(printf("sqlBatchColumnInt(" FMT_U_MEM ", " FMT_D ")\n",
+                       (memSizeType) sqlStatement, column););
+    rowCount = batchRowCount(sqlStatement, "sqlBatchColumnInt");
+    if (unlikely(rowCount < 0)) {
+      columnValues = NULL;
+    } else if (unlikely((sqlFunc = ((preparedStmtType) sqlStatement)->sqlFunc)->
+                        sqlColumnInt == NULL)) {
+      dbNoFuncPtr("sqlBatchColumnInt");
+      raise_error(DATABASE_ERROR);
+      columnValues = NULL;
+    } else if (unlikely(!ALLOC_RTL_ARRAY(columnValues, (memSizeType) rowCount))) {
+      raise_error(MEMORY_ERROR);
+    } else {
+      columnValues->min_position = 1;
+      columnValues->max_position = rowCount;
+      for (row = 1; row <= rowCount; row++) {
+        selectBatchRow(sqlStatement, row);
+        columnValues->arr[row - 1].value.intValue =
+            sqlFunc->sqlColumnInt(sqlStatement, column);
+      } /* for */
+    } /* if */
+    logFunction(printf("sqlBatchColumnInt --> " FMT_U_MEM "\n",
+                       (memSizeType) columnValues););
+    return columnValues;
+  } /* sqlBatchColumnInt */
+
+
+
+/**
+ *  Get the values of a string column for all rows of the current batch.
+ *  The values are converted with the same rules as sqlColumnStri.
+ *  Afterwards the last row of the batch is the current row.
+ *  @param sqlStatement Prepared statement, where sqlFetchBatch
+ *         has been called.
+ *  @param column Number of the column (starting with 1).
+ *  @return an array with the column values of the batch rows
+ *          (indices starting with 1).
+ *  @exception RANGE_ERROR If the statement was not prepared or
+ *                         if no data was successfully fetched or
+ *                         if the specified column does not exist or
+ *                         if the column cannot be converted.
+ *  @exception DATABASE_ERROR If a database function fails.
+ */
+rtlArrayType sqlBatchColumnStri (sqlStmtType sqlStatement, intType column)
+
+  {
+    intType rowCount;
+    intType row;
+    sqlFuncType sqlFunc;
+    striType stri;
+    rtlArrayType columnValues;
+
+  /* sqlBatchColumnStri */
+    logFunction(printf("sqlBatchColumnStri(" FMT_U_MEM ", " FMT_D ")\n",
+                       (memSizeType) sqlStatement, column););
+    rowCount = batchRowCount(sqlStatement, "sqlBatchColumnStri");
+    if (unlikely(rowCount < 0)) {
+      columnValues = NULL;
+    } else if (unlikely((sqlFunc = ((preparedStmtType) sqlStatement)->sqlFunc)->
+                        sqlColumnStri == NULL)) {
+      dbNoFuncPtr("sqlBatchColumnStri");
+      raise_error(DATABASE_ERROR);
+      columnValues = NULL;
+    } else if (unlikely(!ALLOC_RTL_ARRAY(columnValues, (memSizeType) rowCount))) {
+      raise_error(MEMORY_ERROR);
+    } else {
+      columnValues->min_position = 1;
+      columnValues->max_position = rowCount;
+      for (row = 1; row <= rowCount && columnValues != NULL; row++) {
+        selectBatchRow(sqlStatement, row);
+        stri = sqlFunc->sqlColumnStri(sqlStatement, column);
+        if (unlikely(stri == NULL)) {
+          /* An exception has been raised: Free the strings so far. */
+          while (row > 1) {
+            row--;
+            FREE_STRI(columnValues->arr[row - 1].value.striValue);
+          } /* while */
+          FREE_RTL_ARRAY(columnValues, (memSizeType) rowCount);
+          columnValues = NULL;
+        } else {
+          columnValues->arr[row - 1].value.striValue = stri;
+        } /* if */
+      } /* for */
+    } /* if */
+    logFunction(printf("sqlBatchColumnStri --> " FMT_U_MEM "\n",
+                       (memSizeType) columnValues););
+    return columnValues;
+  } /* sqlBatchColumnStri */
+
+
+
+/**
+ *  Determine which rows of the current batch have a NULL value in 'column'.
+ *  Afterwards the last row of the batch is the current row.
+ *  @param sqlStatement Prepared statement, where sqlFetchBatch
+ *         has been called.
+ *  @param column Number of the column (starting with 1).
+ *  @return a null mask with one byte per batch row. A byte is 1
+ *          if the column of the corresponding row is NULL and 0 otherwise.
+ *  @exception RANGE_ERROR If the statement was not prepared or
+ *                         if no data was successfully fetched or
+ *                         if the specified column does not exist.
+ *  @exception DATABASE_ERROR If a database function fails.
+ */
+bstriType sqlBatchIsNull (sqlStmtType sqlStatement, intType column)
+
+  {
+    intType rowCount;
+    intType row;
+    sqlFuncType sqlFunc;
+    bstriType nullMask;
+
+  /* sqlBatchIsNull */
+    logFunction(printf("sqlBatchIsNull(" FMT_U_MEM ", " FMT_D ")\n",
+                       (memSizeType) sqlStatement, column););
+    rowCount = batchRowCount(sqlStatement, "sqlBatchIsNull");
+    if (unlikely(rowCount < 0)) {
+      nullMask = NULL;
+    } else if (unlikely((sqlFunc = ((preparedStmtType) sqlStatement)->sqlFunc)->
+                        sqlIsNull == NULL)) {
+      dbNoFuncPtr("sqlBatchIsNull");
+      raise_error(DATABASE_ERROR);
+      nullMask = NULL;
+    } else if (unlikely(!ALLOC_BSTRI_CHECK_SIZE(nullMask, (memSizeType) rowCount))) {
+      raise_error(MEMORY_ERROR);
+    } else {
+      nullMask->size = (memSizeType) rowCount;
+      for (row = 1; row <= rowCount; row++) {
+        selectBatchRow(sqlStatement, row);
+        nullMask->mem[row - 1] =
+            (ucharType) (sqlFunc->sqlIsNull(sqlStatement, column) ? 1 : 0);
+      } /* for */
+    } /* if */
+    logFunction(printf("sqlBatchIsNull --> " FMT_U_MEM "\n",
+                       (memSizeType) nullMask););
+    return nullMask;
+  } /* sqlBatchIsNull */
+
+
+
+/**
+ *  Make 'row' of the current batch the current row of 'sqlStatement'.
+ *  Afterwards the column functions deliver the data of this row.
+ *  @param sqlStatement Prepared statement, where sqlFetchBatch
+ *         has been called.
+ *  @param row Number of the row in the batch (starting with 1).
+ *  @exception RANGE_ERROR If the statement was not prepared or
+ *                         if 'row' is not in the current batch.
+ *  @exception DATABASE_ERROR If a database function fails.
+ */
+void sqlBatchSelectRow (sqlStmtType sqlStatement, intType row)
+
+  {
+    intType rowCount;
+
+  /* sqlBatchSelectRow */
+    logFunction(printf("sqlBatchSelectRow(" FMT_U_MEM ", " FMT_D ")\n",
+                       (memSizeType) sqlStatement, row););
+    rowCount = batchRowCount(sqlStatement, "sqlBatchSelectRow");
+    if (rowCount >= 0) {
+      if (unlikely(row < 1 || row > rowCount)) {
+        logError(printf("sqlBatchSelectRow(" FMT_U_MEM ", " FMT_D "): "
+                        "Row not in batch of " FMT_D " rows.\n",
+                        (memSizeType) sqlStatement, row, rowCount););
+        raise_error(RANGE_ERROR);
+      } else {
+        selectBatchRow(sqlStatement, row);
+      } /* if */
+    } /* if */
+    logFunction(printf("sqlBatchSelectRow -->\n"););
+  } /* sqlBatchSelectRow */
+
+
+
+/**
+ *  Return the number of rows of the current batch of 'sqlStatement'.
+ *  The batch is the result of the last call of sqlFetchBatch.
+ *  @exception RANGE_ERROR If the statement was not prepared.
+ *  @exception DATABASE_ERROR If the database is not open.
+ */
+intType sqlBatchSize (sqlStmtType sqlStatement)
+
+  {
+    intType rowCount;
+
+  /* sqlBatchSize */
+    logFunction(printf("sqlBatchSize(" FMT_U_MEM ")\n",
+                       (memSizeType) sqlStatement););
+    rowCount = batchRowCount(sqlStatement, "sqlBatchSize");
+    if (rowCount < 0) {
+      rowCount = 0;
+    } /* if */
+    logFunction(printf("sqlBatchSize --> " FMT_D "\n", rowCount););
+    return rowCount;
+  } /* sqlBatchSize */
+
 
 
 /**
@@ -621,6 +1149,10 @@ void sqlClose (databaseType database)
                       (memSizeType) database););
       raise_error(DATABASE_ERROR);
     } else {
+      if (((dbType) database)->stmtCache != NULL) {
+        /* Cached statements must be freed before the connection is closed. */
+        clearStmtCache(((dbType) database)->stmtCache);
+      } /* if */
       ((dbType) database)->sqlFunc->sqlClose(database);
     } /* if */
     logFunction(printf("sqlClose -->\n"););
@@ -1186,6 +1718,7 @@ void sqlCpyDb (databaseType *const dest, const databaseType source)
       db_source->usage_count++;
     } /* if */
     if (db_dest != NULL && db_dest->usage_count != 0) {
+      freeUnusedStmtCache(db_dest);
       db_dest->usage_count--;
       if (db_dest->usage_count == 0 &&
           db_dest->sqlFunc != NULL &&
@@ -1249,7 +1782,10 @@ void sqlCpyStmt (sqlStmtType *const dest, const sqlStmtType source)
           statement_dest->sqlFunc != NULL &&
           statement_dest->sqlFunc->freePreparedStmt != NULL) {
         logMessage(printf("FREE " FMT_U_MEM "\n", (memSizeType) statement_dest););
+        freeUnusedStmtCache(statement_dest->db);
         statement_dest->sqlFunc->freePreparedStmt((sqlStmtType) statement_dest);
+      } else if (statement_dest->usage_count == 1) {
+        resetIdleStmt(statement_dest);
       } /* if */
     } /* if */
     *dest = (sqlStmtType) statement_source;
@@ -1397,6 +1933,7 @@ void sqlDestrDb (const databaseType old_db)
                        old_db != NULL ? old_db->usage_count : (uintType) 0););
     old_database = (dbType) old_db;
     if (old_database != NULL && old_database->usage_count != 0) {
+      freeUnusedStmtCache(old_database);
       old_database->usage_count--;
       if (old_database->usage_count == 0 &&
           old_database->sqlFunc != NULL &&
@@ -1448,8 +1985,11 @@ void sqlDestrStmt (const sqlStmtType old_stmt)
           old_statement->sqlFunc != NULL &&
           old_statement->sqlFunc->freePreparedStmt != NULL) {
         logMessage(printf("FREE " FMT_U_MEM "\n", (memSizeType) old_statement););
+        freeUnusedStmtCache(old_statement->db);
         old_statement->sqlFunc->freePreparedStmt((sqlStmtType) old_statement);
         old_statement = NULL;
+      } else if (old_statement->usage_count == 1) {
+        resetIdleStmt(old_statement);
       } /* if */
     } /* if */
     logFunction(printf("sqlDestrStmt(" FMT_U_MEM " (usage=" FMT_U ")) -->\n",
@@ -1616,6 +2156,58 @@ boolType sqlFetch (sqlStmtType sqlStatement)
 
 
 
+/**
+ *  Fetch up to 'maxRows' rows of the result data as one batch.
+ *  The rows of the batch can be accessed column-wise with the
+ *  sqlBatchColumn functions or row-wise with sqlBatchSelectRow.
+ *  After the call the last row of the batch is the current row,
+ *  so sqlFetch and sqlFetchBatch can be mixed. The batch stays
+ *  valid until the next call of sqlFetch, sqlFetchBatch or
+ *  sqlExecute. Drivers without batch support deliver batches
+ *  of one row.
+ *  @param sqlStatement Prepared statement, which has been executed.
+ *  @param maxRows Maximum number of rows in the batch.
+ *  @return the number of rows fetched, or 0 if no more result
+ *          data is available.
+ *  @exception RANGE_ERROR If 'maxRows' is less than 1.
+ *  @exception DATABASE_ERROR If a database function fails.
+ */
+intType sqlFetchBatch (sqlStmtType sqlStatement, intType maxRows)
+
+  {
+    intType rowCount;
+
+  /* sqlFetchBatch */
+    logFunction(printf("sqlFetchBatch(" FMT_U_MEM ", " FMT_D ")\n",
+                       (memSizeType) sqlStatement, maxRows););
+    if (sqlStatement == NULL) {
+      rowCount = 0;
+    } else if (unlikely(maxRows < 1)) {
+      logError(printf("sqlFetchBatch(" FMT_U_MEM ", " FMT_D "): "
+                      "The maximum number of rows must be positive.\n",
+                      (memSizeType) sqlStatement, maxRows););
+      raise_error(RANGE_ERROR);
+      rowCount = 0;
+    } else if (unlikely(((preparedStmtType) sqlStatement)->sqlFunc == NULL ||
+                        ((preparedStmtType) sqlStatement)->sqlFunc->sqlFetch == NULL)) {
+      dbNoFuncPtr("sqlFetchBatch");
+      logError(printf("sqlFetchBatch(" FMT_U_MEM ", " FMT_D "): "
+                      "Function pointer missing.\n",
+                      (memSizeType) sqlStatement, maxRows););
+      raise_error(DATABASE_ERROR);
+      rowCount = 0;
+    } else if (((preparedStmtType) sqlStatement)->sqlFunc->sqlFetchBatch == NULL) {
+      rowCount = ((preparedStmtType) sqlStatement)->sqlFunc->sqlFetch(sqlStatement) ? 1 : 0;
+    } else {
+      rowCount = ((preparedStmtType) sqlStatement)->sqlFunc->sqlFetchBatch(sqlStatement,
+                                                                            maxRows);
+    } /* if */
+    logFunction(printf("sqlFetchBatch --> " FMT_D "\n", rowCount););
+    return rowCount;
+  } /* sqlFetchBatch */
+
+
+
 /**
  *  Get the current auto-commit mode for the specified database 'database'.
  */
@@ -1749,6 +2341,8 @@ sqlStmtType sqlPrepare (databaseType database,
                       striAsUnquotedCStri(sqlStatementStri)););
       raise_error(DATABASE_ERROR);
       preparedStmt = NULL;
+    } else if (((dbType) database)->stmtCache != NULL) {
+      preparedStmt = cachedPrepare((dbType) database, sqlStatementStri);
     } else {
       preparedStmt = ((dbType) database)->sqlFunc->sqlPrepare(database, sqlStatementStri);
     } /* if */
@@ -1827,6 +2421,163 @@ void sqlSetAutoCommit (databaseType database, boolType autoCommit)
 
 
 
+/**
+ *  Set the capacity of the prepared statement cache of 'database'.
+ *  With a statement cache sqlPrepare returns a cached statement,
+ *  if the same SQL statement has been prepared before and the cached
+ *  statement is not used elsewhere. This avoids parsing and planning
+ *  the statement again. Cached statements, which are not used anymore,
+ *  are reset (if the driver supports it). If the cache is full the
+ *  least recently used statement is removed. Setting the capacity
+ *  empties the cache and resets the hit and miss counters.
+ *  @param capacity Maximum number of cached statements. Zero
+ *         switches the statement cache off (this is the default).
+ *  @exception RANGE_ERROR If the database is empty or
+ *                         if 'capacity' is negative.
+ *  @exception DATABASE_ERROR If the database is not open.
+ *  @exception MEMORY_ERROR Not enough memory to create the cache.
+ */
+void sqlSetStmtCache (databaseType database, intType capacity)
+
+  {
+    dbType db;
+    stmtCacheType cache;
+
+  /* sqlSetStmtCache */
+    logFunction(printf("sqlSetStmtCache(" FMT_U_MEM ", " FMT_D ")\n",
+                       (memSizeType) database, capacity););
+    db = (dbType) database;
+    if (unlikely(db == NULL || capacity < 0)) {
+      logError(printf("sqlSetStmtCache(" FMT_U_MEM ", " FMT_D "): "
+                      "Database is empty or capacity is negative.\n",
+                      (memSizeType) database, capacity););
+      raise_error(RANGE_ERROR);
+    } else if (unlikely(!db->isOpen)) {
+      dbNotOpen("sqlSetStmtCache");
+      logError(printf("sqlSetStmtCache(" FMT_U_MEM ", " FMT_D "): "
+                      "Database is not open.\n",
+                      (memSizeType) database, capacity););
+      raise_error(DATABASE_ERROR);
+    } else {
+      if (db->stmtCache != NULL) {
+        cache = db->stmtCache;
+        db->stmtCache = NULL;
+        clearStmtCache(cache);
+        FREE_STMT_CACHE(cache, cache->capacity);
+      } /* if */
+      if (capacity != 0) {
+        if (unlikely((uintType) capacity > MAX_STMT_CACHE_CAPACITY ||
+                     !ALLOC_STMT_CACHE(cache, (memSizeType) capacity))) {
+          raise_error(MEMORY_ERROR);
+        } else {
+          cache->capacity = (memSizeType) capacity;
+          cache->size = 0;
+          cache->useCounter = 0;
+          cache->hits = 0;
+          cache->misses = 0;
+          db->stmtCache = cache;
+        } /* if */
+      } /* if */
+    } /* if */
+    logFunction(printf("sqlSetStmtCache -->\n"););
+  } /* sqlSetStmtCache */
+
+
+
+/**
+ *  Switch the result retrieval of 'sqlStatement' to streaming mode.
+ *  In streaming mode sqlFetch retrieves rows from the server as they
+ *  are needed, instead of buffering the whole result when the
+ *  statement is executed. The memory needed is bounded by a single
+ *  row (or a small chunk of rows). As long as the result has not been
+ *  fetched completely no other statement can be executed with the
+ *  same database connection. Drivers, which do not support streaming,
+ *  ignore this request and keep buffering the result.
+ *  The mode is used by the next sqlExecute of 'sqlStatement'.
+ */
+void sqlSetStreaming (sqlStmtType sqlStatement, boolType streaming)
+
+  { /* sqlSetStreaming */
+    logFunction(printf("sqlSetStreaming(" FMT_U_MEM ", %d)\n",
+                       (memSizeType) sqlStatement, streaming););
+    if (sqlStatement == NULL) {
+      /* Do nothing */
+    } else if (((preparedStmtType) sqlStatement)->sqlFunc == NULL ||
+               ((preparedStmtType) sqlStatement)->sqlFunc->sqlSetStreaming == NULL) {
+      /* The driver does not support streaming: Keep buffering. */
+    } else {
+      ((preparedStmtType) sqlStatement)->sqlFunc->sqlSetStreaming(sqlStatement,
+                                                                   streaming);
+    } /* if */
+    logFunction(printf("sqlSetStreaming -->\n"););
+  } /* sqlSetStreaming */
+
+
+
+/**
+ *  Return the number of sqlPrepare calls served from the statement cache.
+ *  @return the number of cache hits since the capacity of the
+ *          statement cache has been set, or 0 if 'database' has
+ *          no statement cache.
+ *  @exception RANGE_ERROR If the database is empty.
+ */
+intType sqlStmtCacheHits (databaseType database)
+
+  {
+    intType hits;
+
+  /* sqlStmtCacheHits */
+    logFunction(printf("sqlStmtCacheHits(" FMT_U_MEM ")\n",
+                       (memSizeType) database););
+    if (unlikely(database == NULL)) {
+      logError(printf("sqlStmtCacheHits(" FMT_U_MEM "): "
+                      "Database is empty.\n",
+                      (memSizeType) database););
+      raise_error(RANGE_ERROR);
+      hits = 0;
+    } else if (((dbType) database)->stmtCache == NULL) {
+      hits = 0;
+    } else {
+      hits = ((dbType) database)->stmtCache->hits;
+    } /* if */
+    logFunction(printf("sqlStmtCacheHits --> " FMT_D "\n", hits););
+    return hits;
+  } /* sqlStmtCacheHits */
+
+
+
+/**
+ *  Return the number of sqlPrepare calls not served from the statement cache.
+ *  @return the number of cache misses since the capacity of the
+ *          statement cache has been set, or 0 if 'database' has
+ *          no statement cache.
+ *  @exception RANGE_ERROR If the database is empty.
+ */
+intType sqlStmtCacheMisses (databaseType database)
+
+  {
+    intType misses;
+
+  /* sqlStmtCacheMisses */
+    logFunction(printf("sqlStmtCacheMisses(" FMT_U_MEM ")\n",
+                       (memSizeType) database););
+    if (unlikely(database == NULL)) {
+      logError(printf("sqlStmtCacheMisses(" FMT_U_MEM "): "
+                      "Database is empty.\n",
+                      (memSizeType) database););
+      raise_error(RANGE_ERROR);
+      misses = 0;
+    } else if (((dbType) database)->stmtCache == NULL) {
+      misses = 0;
+    } else {
+      misses = ((dbType) database)->stmtCache->misses;
+    } /* if */
+    logFunction(printf("sqlStmtCacheMisses --> " FMT_D "\n", misses););
+    return misses;
+  } /* sqlStmtCacheMisses */
+
+
+
 /**
  *  Return the number of columns in the result data of a ''statement''.
  *  It is not necessary to ''execute'' the prepared statement, before
@@ -1,7 +1,7 @@
 /********************************************************************/
 /*                                                                  */
 /*  sql_rtl.h     Database access functions.                        */
-/*  Copyright (C) 1989 - 2014  Thomas Mertes                        */
+/*  Copyright (C) 1989 - 2014, 2026  Thomas Mertes                  */
 /*                                                                  */
 /*  This file is part of the Seed7 Runtime Library.                 */
 /*                                                                  */
@@ -24,11 +24,17 @@
 /*                                                                  */
 /*  Module: Seed7 Runtime Library                                   */
 /*  File: seed7/src/sql_rtl.h                                       */
-/*  Changes: 2014  Thomas Mertes                                    */
+/*  Changes: 2014, 2026  Thomas Mertes                              */
 /*  Content: Database access functions.                             */
 /*                                                                  */
 /********************************************************************/
 
+rtlArrayType sqlBatchColumnFloat (sqlStmtType sqlStatement, intType column);
+rtlArrayType sqlBatchColumnInt (sqlStmtType sqlStatement, intType column);
+rtlArrayType sqlBatchColumnStri (sqlStmtType sqlStatement, intType column);
+bstriType sqlBatchIsNull (sqlStmtType sqlStatement, intType column);
+void sqlBatchSelectRow (sqlStmtType sqlStatement, intType row);
+intType sqlBatchSize (sqlStmtType sqlStatement);
 void sqlBindBigInt (sqlStmtType sqlStatement, intType pos,
                     const const_bigIntType value);
 void sqlBindBigRat (sqlStmtType sqlStatement, intType pos,
@@ -80,11 +86,16 @@ striType sqlErrLibFunc (void);
 striType sqlErrMessage (void);
 void sqlExecute (sqlStmtType sqlStatement);
 boolType sqlFetch (sqlStmtType sqlStatement);
+intType sqlFetchBatch (sqlStmtType sqlStatement, intType maxRows);
 boolType sqlGetAutoCommit (databaseType database);
 boolType sqlIsNull (sqlStmtType sqlStatement, intType column);
 sqlStmtType sqlPrepare (databaseType database,
                         const const_striType sqlStatementStri);
 void sqlRollback (databaseType database);
 void sqlSetAutoCommit (databaseType database, boolType autoCommit);
+void sqlSetStmtCache (databaseType database, intType capacity);
+void sqlSetStreaming (sqlStmtType sqlStatement, boolType streaming);
+intType sqlStmtCacheHits (databaseType database);
+intType sqlStmtCacheMisses (databaseType database);
 intType sqlStmtColumnCount (sqlStmtType sqlStatement);
 striType sqlStmtColumnName (sqlStmtType sqlStatement, intType column);
@@ -1,7 +1,7 @@
 /********************************************************************/
 /*                                                                  */
 /*  sql_tds.c    Database access functions for Tabular Data Stream. */
-/*  Copyright (C) 1989 - 2020  Thomas Mertes                        */
+/*  Copyright (C) 1989 - 2020, 2026  Thomas Mertes                  */
 /*                                                                  */
 /*  This file is part of the Seed7 Runtime Library.                 */
 /*                                                                  */
@@ -24,7 +24,7 @@
 /*                                                                  */
 /*  Module: Seed7 Runtime Library                                   */
 /*  File: seed7/src/sql_tds.c                                       */
-/*  Changes: 2017, 2019, 2020  Thomas Mertes                        */
+/*  Changes: 2017, 2019, 2020, 2026  Thomas Mertes                  */
 /*  Content: Database access functions for Tabular Data Stream.     */
 /*                                                                  */
 /********************************************************************/
@@ -70,6 +70,7 @@ typedef struct {
     sqlFuncType  sqlFunc;
     int          driver;
     int          dbCategory;
+    stmtCacheType stmtCache;
     DBPROCESS   *dbproc;
     boolType     autoCommit;
   } dbRecordTds, *dbType;
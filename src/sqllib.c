@@ -1,7 +1,7 @@
 /********************************************************************/
 /*                                                                  */
 /*  s7   Seed7 interpreter                                          */
-/*  Copyright (C) 1990 - 2020  Thomas Mertes                        */
+/*  Copyright (C) 1990 - 2020, 2026  Thomas Mertes                  */
 /*                                                                  */
 /*  This program is free software; you can redistribute it and/or   */
 /*  modify it under the terms of the GNU General Public License as  */
@@ -20,7 +20,7 @@
 /*                                                                  */
 /*  Module: Library                                                 */
 /*  File: seed7/src/sqllib.c                                        */
-/*  Changes: 2013, 2014, 2017 - 2020  Thomas Mertes                 */
+/*  Changes: 2013, 2014, 2017 - 2020, 2026  Thomas Mertes           */
 /*  Content: All primitive actions for database access.             */
 /*                                                                  */
 /********************************************************************/
@@ -30,18 +30,152 @@
 
 #include "version.h"
 
+#include "stdlib.h"
 #include "stdio.h"
 
 #include "common.h"
 #include "data.h"
+#include "data_rtl.h"
+#include "heaputl.h"
 #include "syvarutl.h"
 #include "objutl.h"
 #include "runerr.h"
+#include "str_rtl.h"
 #include "sql_rtl.h"
 #include "sql_drv.h"
 
 
 
+/**
+ *  Convert a column array of a batch to an array object.
+ *  The elements of 'aRtlArray' are moved to the array object.
+ *  @param category INTOBJECT, FLOATOBJECT or STRIOBJECT.
+ */
+static objectType toBatchArray (rtlArrayType aRtlArray,
+    typeType elementType, objectCategory category)
+
+  {
+    memSizeType arraySize;
+    memSizeType pos;
+    arrayType anArray;
+    objectType element;
+    objectType result;
+
+  /* toBatchArray */
+    if (unlikely(aRtlArray == NULL)) {
+      /* Assume that an exception was already raised */
+      result = NULL;
+    } else {
+      arraySize = arraySize(aRtlArray);
+      if (unlikely(!ALLOC_ARRAY(anArray, arraySize))) {
+        if (category == STRIOBJECT) {
+          for (pos = 0; pos < arraySize; pos++) {
+            strDestr(aRtlArray->arr[pos].value.striValue);
+          } /* for */
+        } /* if */
+        FREE_RTL_ARRAY(aRtlArray, arraySize);
+        result = raise_exception(SYS_MEM_EXCEPTION);
+      } else {
+        anArray->min_position = aRtlArray->min_position;
+        anArray->max_position = aRtlArray->max_position;
+        element = anArray->arr;
+        for (pos = 0; pos < arraySize; pos++, element++) {
+          element->type_of = elementType;
+          element->descriptor.property = NULL;
+          switch (category) {
+            case INTOBJECT:
+              element->value.intValue = aRtlArray->arr[pos].value.intValue;
+              break;
+            case FLOATOBJECT:
+              element->value.floatValue = aRtlArray->arr[pos].value.floatValue;
+              break;
+            default:
+              element->value.striValue = aRtlArray->arr[pos].value.striValue;
+              break;
+          } /* switch */
+          INIT_CATEGORY_OF_VAR(element, category);
+        } /* for */
+        FREE_RTL_ARRAY(aRtlArray, arraySize);
+        result = bld_array_temp(anArray);
+      } /* if */
+    } /* if */
+    return result;
+  } /* toBatchArray */
+
+
+
+objectType sql_batch_float (listType arguments)
+
+  { /* sql_batch_float */
+    isit_sqlstmt(arg_1(arguments));
+    isit_int(arg_2(arguments));
+    return toBatchArray(sqlBatchColumnFloat(take_sqlstmt(arg_1(arguments)),
+                                            take_int(arg_2(arguments))),
+                        take_type(SYS_FLT_TYPE), FLOATOBJECT);
+  } /* sql_batch_float */
+
+
+
+objectType sql_batch_int (listType arguments)
+
+  { /* sql_batch_int */
+    isit_sqlstmt(arg_1(arguments));
+    isit_int(arg_2(arguments));
+    return toBatchArray(sqlBatchColumnInt(take_sqlstmt(arg_1(arguments)),
+                                          take_int(arg_2(arguments))),
+                        take_type(SYS_INT_TYPE), INTOBJECT);
+  } /* sql_batch_int */
+
+
+
+objectType sql_batch_is_null (listType arguments)
+
+  {
+    bstriType nullMask;
+
+  /* sql_batch_is_null */
+    isit_sqlstmt(arg_1(arguments));
+    isit_int(arg_2(arguments));
+    nullMask = sqlBatchIsNull(take_sqlstmt(arg_1(arguments)),
+                              take_int(arg_2(arguments)));
+    return bld_bstri_temp(nullMask);
+  } /* sql_batch_is_null */
+
+
+
+objectType sql_batch_select_row (listType arguments)
+
+  { /* sql_batch_select_row */
+    isit_sqlstmt(arg_1(arguments));
+    isit_int(arg_2(arguments));
+    sqlBatchSelectRow(take_sqlstmt(arg_1(arguments)),
+                      take_int(arg_2(arguments)));
+    return SYS_EMPTY_OBJECT;
+  } /* sql_batch_select_row */
+
+
+
+objectType sql_batch_size (listType arguments)
+
+  { /* sql_batch_size */
+    isit_sqlstmt(arg_1(arguments));
+    return bld_int_temp(sqlBatchSize(take_sqlstmt(arg_1(arguments))));
+  } /* sql_batch_size */
+
+
+
+objectType sql_batch_stri (listType arguments)
+
+  { /* sql_batch_stri */
+    isit_sqlstmt(arg_1(arguments));
+    isit_int(arg_2(arguments));
+    return toBatchArray(sqlBatchColumnStri(take_sqlstmt(arg_1(arguments)),
+                                           take_int(arg_2(arguments))),
+                        take_type(SYS_STRI_TYPE), STRIOBJECT);
+  } /* sql_batch_stri */
+
+
+
 objectType sql_bind_bigint (listType arguments)
 
   { /* sql_bind_bigint */
@@ -695,6 +829,17 @@ objectType sql_fetch (listType arguments)
 
 
 
+objectType sql_fetch_batch (listType arguments)
+
+  { /* sql_fetch_batch */
+    isit_sqlstmt(arg_1(arguments));
+    isit_int(arg_2(arguments));
+    return bld_int_temp(sqlFetchBatch(take_sqlstmt(arg_1(arguments)),
+                                      take_int(arg_2(arguments))));
+  } /* sql_fetch_batch */
+
+
+
 /**
  *  Get the current auto-commit mode for database/arg_1.
  */
@@ -1015,6 +1160,60 @@ objectType sql_set_auto_commit (listType arguments)
 
 
 
+/**
+ *  Set the capacity of the prepared statement cache of database/arg_1.
+ */
+objectType sql_set_stmt_cache (listType arguments)
+
+  { /* sql_set_stmt_cache */
+    isit_database(arg_1(arguments));
+    isit_int(arg_2(arguments));
+    sqlSetStmtCache(take_database(arg_1(arguments)),
+                    take_int(arg_2(arguments)));
+    return SYS_EMPTY_OBJECT;
+  } /* sql_set_stmt_cache */
+
+
+
+/**
+ *  Switch sqlStatement/arg_1 to streaming (TRUE) or buffered (FALSE) mode.
+ */
+objectType sql_set_streaming (listType arguments)
+
+  { /* sql_set_streaming */
+    isit_sqlstmt(arg_1(arguments));
+    isit_bool(arg_2(arguments));
+    sqlSetStreaming(take_sqlstmt(arg_1(arguments)),
+                    take_bool(arg_2(arguments)) == SYS_TRUE_OBJECT);
+    return SYS_EMPTY_OBJECT;
+  } /* sql_set_streaming */
+
+
+
+/**
+ *  Number of prepare calls served from the statement cache of database/arg_1.
+ */
+objectType sql_stmt_cache_hits (listType arguments)
+
+  { /* sql_stmt_cache_hits */
+    isit_database(arg_1(arguments));
+    return bld_int_temp(sqlStmtCacheHits(take_database(arg_1(arguments))));
+  } /* sql_stmt_cache_hits */
+
+
+
+/**
+ *  Number of prepare calls not served from the statement cache of database/arg_1.
+ */
+objectType sql_stmt_cache_misses (listType arguments)
+
+  { /* sql_stmt_cache_misses */
+    isit_database(arg_1(arguments));
+    return bld_int_temp(sqlStmtCacheMisses(take_database(arg_1(arguments))));
+  } /* sql_stmt_cache_misses */
+
+
+
 objectType sql_stmt_column_count (listType arguments)
 
   {
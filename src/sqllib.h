@@ -1,7 +1,7 @@
 /********************************************************************/
 /*                                                                  */
 /*  s7   Seed7 interpreter                                          */
-/*  Copyright (C) 1990 - 2014  Thomas Mertes                        */
+/*  Copyright (C) 1990 - 2014, 2026  Thomas Mertes                  */
 /*                                                                  */
 /*  This program is free software; you can redistribute it and/or   */
 /*  modify it under the terms of the GNU General Public License as  */
@@ -20,11 +20,17 @@
 /*                                                                  */
 /*  Module: Library                                                 */
 /*  File: seed7/src/sqllib.h                                        */
-/*  Changes: 2013, 2014  Thomas Mertes                              */
+/*  Changes: 2013, 2014, 2026  Thomas Mertes                        */
 /*  Content: All primitive actions for database access.             */
 /*                                                                  */
 /********************************************************************/
 
+objectType sql_batch_float       (listType arguments);
+objectType sql_batch_int         (listType arguments);
+objectType sql_batch_is_null     (listType arguments);
+objectType sql_batch_select_row  (listType arguments);
+objectType sql_batch_size        (listType arguments);
+objectType sql_batch_stri        (listType arguments);
 objectType sql_bind_bigint       (listType arguments);
 objectType sql_bind_bigrat       (listType arguments);
 objectType sql_bind_bool         (listType arguments);
@@ -66,6 +72,7 @@ objectType sql_err_lib_func      (listType arguments);
 objectType sql_err_message       (listType arguments);
 objectType sql_execute           (listType arguments);
 objectType sql_fetch             (listType arguments);
+objectType sql_fetch_batch       (listType arguments);
 objectType sql_get_auto_commit   (listType arguments);
 objectType sql_is_null           (listType arguments);
 objectType sql_ne_db             (listType arguments);
@@ -83,5 +90,9 @@ objectType sql_open_tds          (listType arguments);
 objectType sql_prepare           (listType arguments);
 objectType sql_rollback          (listType arguments);
 objectType sql_set_auto_commit   (listType arguments);
+objectType sql_set_stmt_cache    (listType arguments);
+objectType sql_set_streaming     (listType arguments);
+objectType sql_stmt_cache_hits   (listType arguments);
+objectType sql_stmt_cache_misses (listType arguments);
 objectType sql_stmt_column_count (listType arguments);
 objectType sql_stmt_column_name  (listType arguments);
@@ -2,6 +2,7 @@
 /*                                                                  */
 /*  str_rtl.c     Primitive actions for the string type.            */
 /*  Copyright (C) 1991 - 1994, 2005, 2007 - 2025  Thomas Mertes     */
+/*                2026  Thomas Mertes                               */
 /*                                                                  */
 /*  This file is part of the Seed7 Runtime Library.                 */
 /*                                                                  */
@@ -24,7 +25,7 @@
 /*                                                                  */
 /*  Module: Seed7 Runtime Library                                   */
 /*  File: seed7/src/str_rtl.c                                       */
-/*  Changes: 1991 - 1994, 2005, 2007 - 2025  Thomas Mertes          */
+/*  Changes: 1991 - 1994, 2005, 2007 - 2025, 2026  Thomas Mertes    */
 /*  Content: Primitive actions for the string type.                 */
 /*                                                                  */
 /********************************************************************/
@@ -38,6 +39,9 @@
 #include "stdio.h"
 #include "string.h"
 #include "wchar.h"
+#if HAS_SSE2_INTRINSICS
+#include "emmintrin.h"
+#endif
 
 #include "common.h"
 #include "data_rtl.h"
@@ -54,7 +58,12 @@
 #define CHAR_DELTA_BEYOND  128
 #define INITIAL_ARRAY_SIZE 256
 #define ARRAY_SIZE_FACTOR    2
+#if HAS_SSE2_INTRINSICS
+/* For shorter searched strings search_stri() is faster. */
+#define BOYER_MOORE_SEARCHED_STRI_THRESHOLD   32
+#else
 #define BOYER_MOORE_SEARCHED_STRI_THRESHOLD    2
+#endif
 #define BOYER_MOORE_MAIN_STRI_THRESHOLD     1400
 
 /* memset_to_strelem is not used because it is */
@@ -117,7 +126,28 @@ static inline const strElemType *search_strelem2 (const strElemType *mem,
 static inline const strElemType *rsearch_strelem (const strElemType *mem,
     const strElemType ch, size_t len)
 
-  { /* rsearch_strelem */
+  {
+#if HAS_SSE2_INTRINSICS
+    __m128i searchedChars;
+    int mask;
+#endif
+
+  /* rsearch_strelem */
+#if HAS_SSE2_INTRINSICS
+    searchedChars = _mm_set1_epi32((int) ch);
+    for (; len >= 4; mem -= 4, len -= 4) {
+      mask = _mm_movemask_ps(_mm_castsi128_ps(_mm_cmpeq_epi32(searchedChars,
+          _mm_loadu_si128((const __m128i *) &mem[-3]))));
+      if (mask != 0) {
+        /* Bit 3 of mask corresponds to mem[0]. */
+        while ((mask & 8) == 0) {
+          mask <<= 1;
+          mem--;
+        } /* while */
+        return mem;
+      } /* if */
+    } /* for */
+#endif
     for (; len > 0; mem--, len--) {
       if (*mem == ch) {
         return mem;
@@ -147,6 +177,134 @@ static inline const strElemType *rsearch_strelem2 (const strElemType *mem,
 
 
 
+/**
+ *  Search the leftmost occurrence of 'searched_mem' in 'mem'.
+ *  With SSE2 the first and the last character of 'searched_mem'
+ *  are compared at eight positions in parallel. Only positions where
+ *  both characters match are compared completely.
+ *  @param mem Characters to be searched.
+ *  @param len Number of characters in 'mem'.
+ *  @param searched_mem Characters of the searched string.
+ *  @param searched_size Length of the searched string (1 <= searched_size <= len).
+ *  @return a pointer to the match, or NULL if there is no match.
+ */
+static const strElemType *search_stri (const strElemType *mem,
+    memSizeType len, const strElemType *searched_mem,
+    const memSizeType searched_size)
+
+  {
+#if HAS_SSE2_INTRINSICS
+    __m128i firstChars;
+    __m128i lastChars;
+    int mask;
+    const strElemType *candidate;
+#endif
+    const strElemType *search_end;
+
+  /* search_stri */
+    if (searched_size == 1) {
+      return memchr_strelem(mem, searched_mem[0], len);
+    } else {
+      len -= searched_size - 1;
+#if HAS_SSE2_INTRINSICS
+      firstChars = _mm_set1_epi32((int) searched_mem[0]);
+      lastChars = _mm_set1_epi32((int) searched_mem[searched_size - 1]);
+      for (; len >= 8; mem += 8, len -= 8) {
+        mask = _mm_movemask_ps(_mm_castsi128_ps(_mm_and_si128(
+                   _mm_cmpeq_epi32(firstChars,
+                       _mm_loadu_si128((const __m128i *) mem)),
+                   _mm_cmpeq_epi32(lastChars,
+                       _mm_loadu_si128((const __m128i *) &mem[searched_size - 1]))))) |
+               _mm_movemask_ps(_mm_castsi128_ps(_mm_and_si128(
+                   _mm_cmpeq_epi32(firstChars,
+                       _mm_loadu_si128((const __m128i *) &mem[4])),
+                   _mm_cmpeq_epi32(lastChars,
+                       _mm_loadu_si128((const __m128i *) &mem[searched_size + 3]))))) << 4;
+        for (candidate = mem; mask != 0; candidate++, mask >>= 1) {
+          if ((mask & 1) != 0 &&
+              memcmp(&candidate[1], &searched_mem[1],
+                     (searched_size - 2) * sizeof(strElemType)) == 0) {
+            return candidate;
+          } /* if */
+        } /* for */
+      } /* for */
+#endif
+      search_end = &mem[len];
+      while (mem < search_end &&
+          (mem = memchr_strelem(mem, searched_mem[0],
+              (memSizeType) (search_end - mem))) != NULL) {
+        if (memcmp(&mem[1], &searched_mem[1],
+                   (searched_size - 1) * sizeof(strElemType)) == 0) {
+          return mem;
+        } /* if */
+        mem++;
+      } /* while */
+      return NULL;
+    } /* if */
+  } /* search_stri */
+
+
+
+/**
+ *  Search the rightmost occurrence of 'searched_mem' in 'mem'.
+ *  The search considers only matches that start at or before
+ *  'search_start'. With SSE2 the first and the last character of
+ *  'searched_mem' are compared at four positions in parallel.
+ *  @param mem Start of the characters to be searched.
+ *  @param search_start Rightmost position where a match may start.
+ *  @param searched_mem Characters of the searched string.
+ *  @param searched_size Length of the searched string.
+ *  @return a pointer to the match, or NULL if there is no match.
+ */
+static const strElemType *rsearch_stri (const strElemType *const mem,
+    const strElemType *search_start, const strElemType *searched_mem,
+    const memSizeType searched_size)
+
+  {
+#if HAS_SSE2_INTRINSICS
+    __m128i firstChars;
+    __m128i lastChars;
+    int mask;
+    const strElemType *candidate;
+#endif
+
+  /* rsearch_stri */
+#if HAS_SSE2_INTRINSICS
+    if (searched_size >= 2) {
+      firstChars = _mm_set1_epi32((int) searched_mem[0]);
+      lastChars = _mm_set1_epi32((int) searched_mem[searched_size - 1]);
+      for (; search_start - mem >= 3; search_start -= 4) {
+        mask = _mm_movemask_ps(_mm_castsi128_ps(_mm_and_si128(
+            _mm_cmpeq_epi32(firstChars,
+                _mm_loadu_si128((const __m128i *) &search_start[-3])),
+            _mm_cmpeq_epi32(lastChars,
+                _mm_loadu_si128((const __m128i *) &search_start[searched_size - 4])))));
+        /* Bit 3 of mask corresponds to search_start[0]. */
+        for (candidate = search_start; mask != 0;
+             candidate--, mask = (mask << 1) & 15) {
+          if ((mask & 8) != 0 &&
+              memcmp(&candidate[1], &searched_mem[1],
+                     (searched_size - 2) * sizeof(strElemType)) == 0) {
+            return candidate;
+          } /* if */
+        } /* for */
+      } /* for */
+    } /* if */
+#endif
+    while (search_start >= mem &&
+        (search_start = rsearch_strelem(search_start, searched_mem[0],
+            (memSizeType) (search_start - mem) + 1)) != NULL) {
+      if (memcmp(search_start, searched_mem,
+                 searched_size * sizeof(strElemType)) == 0) {
+        return search_start;
+      } /* if */
+      search_start--;
+    } /* while */
+    return NULL;
+  } /* rsearch_stri */
+
+
+
 intType ustriCmpValue (const rtlValueUnion value1, const rtlValueUnion value2)
 
   {
@@ -211,7 +369,7 @@ intType ustriHashCode (const const_ustriType ustri)
       hashCode = 0;
     } else {
       length = strlen((const_cstriType) ustri);
-      hashCode = ustringHashCode(ustri, length);
+      hashCode = (intType) hash_ustri_chars(ustri, length);
     } /* if */
     logFunctionResult(printf(FMT_D "\n", hashCode););
     return hashCode;
@@ -2942,7 +3100,7 @@ boolType strGt (const const_striType stri1, const const_striType stri2)
 intType strHashCode (const const_striType stri)
 
   { /* strHashCode */
-    return hashCode(stri);
+    return (intType) hash_strelem(stri->mem, stri->size);
   } /* strHashCode */
 
 
@@ -3273,13 +3431,8 @@ intType strIPos (const const_striType mainStri, const const_striType searched,
   {
     memSizeType main_size;
     memSizeType searched_size;
-    strElemType ch_n;
-    const strElemType *ch_n_pos;
-    memSizeType delta;
     const strElemType *main_mem;
-    const strElemType *searched_mem;
-    const strElemType *search_start;
-    const strElemType *search_end;
+    const strElemType *found_pos;
 
   /* strIPos */
     logFunction(printf("strIPos(\"%s\", ",
@@ -3304,31 +3457,11 @@ intType strIPos (const const_striType mainStri, const const_striType searched,
         } else if (searched_size == 1) {
           return strChIPos(mainStri, searched->mem[0], fromIndex);
         } else {
-          searched_mem = searched->mem;
-          ch_n = searched_mem[searched_size - 1];
-          ch_n_pos = rsearch_strelem(&searched_mem[searched_size - 2], ch_n, searched_size - 1);
-          if (ch_n_pos == NULL) {
-            delta = searched_size;
-          } else {
-            delta = (memSizeType) (&searched_mem[searched_size - 1] - ch_n_pos);
-          } /* if */
           main_mem = &mainStri->mem[fromIndex - 1];
-          search_start = &main_mem[searched_size - 1];
-          search_end = &main_mem[main_size];
-          while (search_start < search_end) {
-            search_start = memchr_strelem(search_start, ch_n,
-                (memSizeType) (search_end - search_start));
-            if (search_start == NULL) {
-              return 0;
-            } else {
-              if (memcmp(search_start - searched_size + 1, searched_mem,
-                  (searched_size - 1) * sizeof(strElemType)) == 0) {
-                return ((intType) (search_start - searched_size + 1 - main_mem)) + fromIndex;
-              } else {
-                search_start += delta;
-              } /* if */
-            } /* if */
-          } /* while */
+          found_pos = search_stri(main_mem, main_size, searched->mem, searched_size);
+          if (found_pos != NULL) {
+            return ((intType) (found_pos - main_mem)) + fromIndex;
+          } /* if */
         } /* if */
       } /* if */
     } /* if */
@@ -3949,13 +4082,8 @@ intType strPos (const const_striType mainStri, const const_striType searched)
   {
     memSizeType main_size;
     memSizeType searched_size;
-    strElemType ch_n;
-    const strElemType *ch_n_pos;
-    memSizeType delta;
     const strElemType *main_mem;
-    const strElemType *searched_mem;
-    const strElemType *search_start;
-    const strElemType *search_end;
+    const strElemType *found_pos;
 
   /* strPos */
     logFunction(printf("strPos(\"%s\", ",
@@ -3971,31 +4099,11 @@ intType strPos (const const_striType mainStri, const const_striType searched)
       } else if (searched_size == 1) {
         return strChPos(mainStri, searched->mem[0]);
       } else {
-        searched_mem = searched->mem;
-        ch_n = searched_mem[searched_size - 1];
-        ch_n_pos = rsearch_strelem(&searched_mem[searched_size - 2], ch_n, searched_size - 1);
-        if (ch_n_pos == NULL) {
-          delta = searched_size;
-        } else {
-          delta = (memSizeType) (&searched_mem[searched_size - 1] - ch_n_pos);
-        } /* if */
         main_mem = mainStri->mem;
-        search_start = &main_mem[searched_size - 1];
-        search_end = &main_mem[main_size];
-        while (search_start < search_end) {
-          search_start = memchr_strelem(search_start, ch_n,
-              (memSizeType) (search_end - search_start));
-          if (search_start == NULL) {
-            return 0;
-          } else {
-            if (memcmp(search_start - searched_size + 1, searched_mem,
-                (searched_size - 1) * sizeof(strElemType)) == 0) {
-              return ((intType) (search_start - searched_size + 1 - main_mem)) + 1;
-            } else {
-              search_start += delta;
-            } /* if */
-          } /* if */
-        } /* while */
+        found_pos = search_stri(main_mem, main_size, searched->mem, searched_size);
+        if (found_pos != NULL) {
+          return ((intType) (found_pos - main_mem)) + 1;
+        } /* if */
       } /* if */
     } /* if */
     return 0;
@@ -4389,11 +4497,10 @@ striType strRepl (const const_striType mainStri,
     memSizeType searched_size;
     memSizeType guessed_result_size;
     memSizeType result_size;
-    strElemType ch_1;
-    const strElemType *main_mem;
     const strElemType *searched_mem;
     const strElemType *search_start;
     const strElemType *search_end;
+    const strElemType *found_pos;
     const strElemType *copy_start;
     strElemType *result_end;
     striType resized_result;
@@ -4433,26 +4540,20 @@ striType strRepl (const const_striType mainStri,
         result_end = result->mem;
         if (searched_size != 0 && searched_size <= main_size) {
           searched_mem = searched->mem;
-          ch_1 = searched_mem[0];
-          main_mem = mainStri->mem;
-          search_start = main_mem;
-          search_end = &main_mem[main_size - searched_size + 1];
-          while (search_start < search_end &&
-              (search_start = memchr_strelem(search_start, ch_1,
-                  (memSizeType) (search_end - search_start))) != NULL) {
-            if (memcmp(search_start, searched_mem,
-                searched_size * sizeof(strElemType)) == 0) {
-              memcpy(result_end, copy_start,
-                     (memSizeType) (search_start - copy_start) * sizeof(strElemType));
-              result_end += search_start - copy_start;
-              memcpy(result_end, replacement->mem,
-                     replacement->size * sizeof(strElemType));
-              result_end += replacement->size;
-              search_start += searched_size;
-              copy_start = search_start;
-            } else {
-              search_start++;
-            } /* if */
+          search_start = mainStri->mem;
+          search_end = &mainStri->mem[main_size];
+          while ((memSizeType) (search_end - search_start) >= searched_size &&
+              (found_pos = search_stri(search_start,
+                  (memSizeType) (search_end - search_start),
+                  searched_mem, searched_size)) != NULL) {
+            memcpy(result_end, copy_start,
+                   (memSizeType) (found_pos - copy_start) * sizeof(strElemType));
+            result_end += found_pos - copy_start;
+            memcpy(result_end, replacement->mem,
+                   replacement->size * sizeof(strElemType));
+            result_end += replacement->size;
+            search_start = found_pos + searched_size;
+            copy_start = search_start;
           } /* while */
         } /* if */
         memcpy(result_end, copy_start,
@@ -4564,11 +4665,9 @@ intType strRIPos (const const_striType mainStri, const const_striType searched,
   {
     memSizeType main_size;
     memSizeType searched_size;
-    strElemType ch_1;
-    const strElemType *searched_mem;
     const strElemType *main_mem;
     const strElemType *search_start;
-    const strElemType *search_end;
+    const strElemType *found_pos;
 
   /* strRIPos */
     logFunction(printf("strRIPos(\"%s\", ",
@@ -4590,23 +4689,16 @@ intType strRIPos (const const_striType mainStri, const const_striType searched,
               main_size >= BOYER_MOORE_MAIN_STRI_THRESHOLD) {
             return strRIPos2(mainStri, searched, fromIndex);
           } else {
-            searched_mem = searched->mem;
-            ch_1 = searched_mem[0];
             main_mem = mainStri->mem;
             if ((uintType) fromIndex - 1 <= main_size - searched_size) {
               search_start = &main_mem[fromIndex - 1];
             } else {
               search_start = &main_mem[main_size - searched_size];
             } /* if */
-            search_end = &main_mem[-1];
-            while ((search_start = rsearch_strelem(search_start,
-                ch_1, (memSizeType) (search_start - search_end))) != NULL) {
-              if (memcmp(search_start, searched_mem,
-                  searched_size * sizeof(strElemType)) == 0) {
-                return ((intType) (search_start - main_mem)) + 1;
-              } else {
-                search_start--;
-              } /* if */
+            found_pos = rsearch_stri(main_mem, search_start,
+                                     searched->mem, searched_size);
+            if (found_pos != NULL) {
+              return ((intType) (found_pos - main_mem)) + 1;
             } /* if */
           } /* if */
         } /* if */
@@ -4742,11 +4834,8 @@ intType strRPos (const const_striType mainStri, const const_striType searched)
   {
     memSizeType main_size;
     memSizeType searched_size;
-    strElemType ch_1;
     const strElemType *main_mem;
-    const strElemType *searched_mem;
-    const strElemType *search_start;
-    const strElemType *search_end;
+    const strElemType *found_pos;
 
   /* strRPos */
     logFunction(printf("strRPos(\"%s\", ",
@@ -4760,19 +4849,11 @@ intType strRPos (const const_striType mainStri, const const_striType searched)
           main_size >= BOYER_MOORE_MAIN_STRI_THRESHOLD) {
         return strRPos2(mainStri, searched);
       } else {
-        searched_mem = searched->mem;
-        ch_1 = searched_mem[0];
         main_mem = mainStri->mem;
-        search_start = &main_mem[main_size - searched_size];
-        search_end = &main_mem[-1];
-        while ((search_start = rsearch_strelem(search_start,
-            ch_1, (memSizeType) (search_start - search_end))) != NULL) {
-          if (memcmp(search_start, searched_mem,
-              searched_size * sizeof(strElemType)) == 0) {
-            return ((intType) (search_start - main_mem)) + 1;
-          } else {
-            search_start--;
-          } /* if */
+        found_pos = rsearch_stri(main_mem, &main_mem[main_size - searched_size],
+                                 searched->mem, searched_size);
+        if (found_pos != NULL) {
+          return ((intType) (found_pos - main_mem)) + 1;
         } /* if */
       } /* if */
     } /* if */
@@ -4836,7 +4917,6 @@ rtlArrayType strSplit (const const_striType mainStri,
   {
     memSizeType delimiter_size;
     const strElemType *delimiter_mem;
-    strElemType ch_1;
     intType used_max_position;
     const strElemType *search_start;
     const strElemType *segment_start;
@@ -4856,26 +4936,19 @@ rtlArrayType strSplit (const const_striType mainStri,
       delimiter_mem = delimiter->mem;
       search_start = mainStri->mem;
       segment_start = search_start;
-      if (delimiter_size != 0 && mainStri->size >= delimiter_size) {
-        ch_1 = delimiter_mem[0];
-        search_end = &mainStri->mem[mainStri->size - delimiter_size + 1];
-        while ((found_pos = memchr_strelem(search_start, ch_1,
-            (memSizeType) (search_end - search_start))) != NULL &&
+      if (delimiter_size != 0) {
+        search_end = &mainStri->mem[mainStri->size];
+        while ((memSizeType) (search_end - search_start) >= delimiter_size &&
+            (found_pos = search_stri(search_start,
+                (memSizeType) (search_end - search_start),
+                delimiter_mem, delimiter_size)) != NULL &&
             result_array != NULL) {
-          if (memcmp(found_pos, delimiter_mem,
-              delimiter_size * sizeof(strElemType)) == 0) {
-            result_array = addCopiedStriToRtlArray(segment_start,
-                (memSizeType) (found_pos - segment_start), result_array,
-                used_max_position);
-            used_max_position++;
-            search_start = found_pos + delimiter_size;
-            segment_start = search_start;
-            if (search_start > search_end) {
-              search_start = search_end;
-            } /* if */
-          } else {
-            search_start = found_pos + 1;
-          } /* if */
+          result_array = addCopiedStriToRtlArray(segment_start,
+              (memSizeType) (found_pos - segment_start), result_array,
+              used_max_position);
+          used_max_position++;
+          search_start = found_pos + delimiter_size;
+          segment_start = search_start;
         } /* while */
       } /* if */
       if (likely(result_array != NULL)) {
@@ -5259,7 +5332,18 @@ striType strToUtf8 (const const_striType stri)
       for (pos = 0; pos < stri->size; pos++) {
         ch = stri->mem[pos];
         if (ch <= 0x7F) {
-          *dest++ = ch;
+          while (stri->size - pos >= 5 &&
+                 (stri->mem[pos + 1] | stri->mem[pos + 2] |
+                  stri->mem[pos + 3] | stri->mem[pos + 4]) <= 0x7F) {
+            /* Copy four ASCII characters at once. */
+            dest[0] = stri->mem[pos];
+            dest[1] = stri->mem[pos + 1];
+            dest[2] = stri->mem[pos + 2];
+            dest[3] = stri->mem[pos + 3];
+            dest += 4;
+            pos += 4;
+          } /* while */
+          *dest++ = stri->mem[pos];
         } else if (ch <= 0x7FF) {
           dest[0] = 0xC0 | ( ch >>  6);
           dest[1] = 0x80 | ( ch        & 0x3F);
@@ -1,7 +1,7 @@
 /********************************************************************/
 /*                                                                  */
 /*  str_rtl.h     Primitive actions for the string type.            */
-/*  Copyright (C) 1989 - 2015  Thomas Mertes                        */
+/*  Copyright (C) 1989 - 2015, 2026  Thomas Mertes                  */
 /*                                                                  */
 /*  This file is part of the Seed7 Runtime Library.                 */
 /*                                                                  */
@@ -24,28 +24,11 @@
 /*                                                                  */
 /*  Module: Seed7 Runtime Library                                   */
 /*  File: seed7/src/str_rtl.h                                       */
-/*  Changes: 1991 - 1994, 2005, 2008 - 2015  Thomas Mertes          */
+/*  Changes: 1991 - 1994, 2005, 2008 - 2015, 2026  Thomas Mertes    */
 /*  Content: Primitive actions for the string type.                 */
 /*                                                                  */
 /********************************************************************/
 
-/**
- *  Macro to compute the hashcode of a string.
- *  A corresponding macro is inlined by the compiler. If this macro
- *  is changed the code in the compiler must be changed as well.
- */
-#define hashCode(stri) (intType) ((stri)->size == 0 ? 0 : \
-                                     ((stri)->mem[0] << 5 ^ \
-                                      (stri)->mem[(stri)->size >> 1] << 3 ^ \
-                                      (stri)->mem[(stri)->size - 1] << 1 ^ \
-                                      (stri)->size))
-
-#define ustringHashCode(ustri, length) (intType) ((uintType) ((ustri)[0]) << 5 ^ \
-                                                  (uintType) ((ustri)[(length) >> 1]) << 3 ^ \
-                                                  (uintType) ((ustri)[(length) - 1]) << 1 ^ \
-                                                  (length));
-
-
 void toLower (const strElemType *const source, memSizeType length,
     strElemType *const dest);
 void toUpper (const strElemType *const source, memSizeType length,
@@ -1,7 +1,7 @@
 /********************************************************************/
 /*                                                                  */
 /*  striutl.c     Functions to work with wide char strings.         */
-/*  Copyright (C) 1989 - 2021  Thomas Mertes                        */
+/*  Copyright (C) 1989 - 2021, 2026  Thomas Mertes                  */
 /*                                                                  */
 /*  This file is part of the Seed7 Runtime Library.                 */
 /*                                                                  */
@@ -24,7 +24,7 @@
 /*                                                                  */
 /*  Module: Seed7 Runtime Library                                   */
 /*  File: seed7/src/striutl.c                                       */
-/*  Changes: 1991 - 1994, 2005 - 2021  Thomas Mertes                */
+/*  Changes: 1991 - 1994, 2005 - 2021, 2026  Thomas Mertes          */
 /*  Content: Functions to work with wide char strings.              */
 /*                                                                  */
 /********************************************************************/
@@ -41,6 +41,9 @@
 #ifdef OS_STRI_WCHAR
 #include "wchar.h"
 #endif
+#if HAS_SSE2_INTRINSICS
+#include "emmintrin.h"
+#endif
 
 #include "common.h"
 #include "heaputl.h"
@@ -82,6 +85,7 @@ const os_charType emulated_root[] = {'/', '\0'};
 
 #define USE_DUFFS_UNROLLING 1
 #define STACK_ALLOC_SIZE    1000
+#define ASCII_HIGH_BITS     (~(memSizeType) 0 / 0xFF * 0x80)
 
 #ifdef OS_STRI_WCHAR
 
@@ -627,9 +631,9 @@ void memset_to_strelem (register strElemType *const dest,
     register const strElemType ch, memSizeType len)
 
   { /* memset_to_strelem */
-    while (len != 0) { \
+    while (len != 0) {
       len--;
-      dest[len] = (strElemType) ch; \
+      dest[len] = (strElemType) ch;
     } /* while */
   } /* memset_to_strelem */
 
@@ -652,8 +656,8 @@ boolType memcpy_from_strelem (register const ustriType dest,
   /* memcpy_from_strelem */
     while (len != 0) {
       len--;
-      check |= src[len]
-      dest[len] = src[len];
+      check |= src[len];
+      dest[len] = (ucharType) src[len];
     } /* while */
     return check >= 256;
   } /* memcpy_from_strelem */
@@ -686,6 +690,176 @@ const strElemType *memchr_strelem (register const strElemType *mem,
 
 
 
+/* Multiplicative constants and rotation used by the hash functions. */
+#define HASH_PRIME_1 ((uint32Type) 0x9E3779B1)
+#define HASH_PRIME_2 ((uint32Type) 0x85EBCA77)
+#define HASH_PRIME_3 ((uint32Type) 0xC2B2AE3D)
+#define HASH_PRIME_4 ((uint32Type) 0x27D4EB2F)
+#define HASH_PRIME_5 ((uint32Type) 0x165667B1)
+#define HASH_ROTL(x, n) ((uint32Type) ((x) << (n)) | ((x) >> (32 - (n))))
+#define HASH_ROUND(acc, value) HASH_ROTL((uint32Type) ((acc) + (value) * HASH_PRIME_2), 13) * HASH_PRIME_1
+
+
+
+static inline uint32Type hashAvalanche (uint32Type hash)
+
+  { /* hashAvalanche */
+    hash ^= hash >> 15;
+    hash *= HASH_PRIME_2;
+    hash ^= hash >> 13;
+    hash *= HASH_PRIME_3;
+    hash ^= hash >> 16;
+    return hash;
+  } /* hashAvalanche */
+
+
+
+/**
+ *  Compute a hash value from all characters of a string.
+ *  Four independent lanes consume four characters per step. This
+ *  way consecutive steps do not depend on each other and the loop
+ *  can be pipelined or vectorized by the C compiler.
+ *  @param mem Characters of the string.
+ *  @param len Number of characters.
+ *  @return the hash value (identical on all platforms).
+ */
+uint32Type hash_strelem (const strElemType *mem, memSizeType len)
+
+  {
+    const strElemType *beyond;
+    uint32Type lane1;
+    uint32Type lane2;
+    uint32Type lane3;
+    uint32Type lane4;
+    uint32Type hash;
+
+  /* hash_strelem */
+    beyond = &mem[len];
+    if (len >= 4) {
+      lane1 = HASH_PRIME_1 + HASH_PRIME_2;
+      lane2 = HASH_PRIME_2;
+      lane3 = 0;
+      lane4 = (uint32Type) 0 - HASH_PRIME_1;
+      for (; beyond - mem >= 4; mem += 4) {
+        lane1 = HASH_ROUND(lane1, (uint32Type) mem[0]);
+        lane2 = HASH_ROUND(lane2, (uint32Type) mem[1]);
+        lane3 = HASH_ROUND(lane3, (uint32Type) mem[2]);
+        lane4 = HASH_ROUND(lane4, (uint32Type) mem[3]);
+      } /* for */
+      hash = HASH_ROTL(lane1, 1) + HASH_ROTL(lane2, 7) +
+             HASH_ROTL(lane3, 12) + HASH_ROTL(lane4, 18);
+    } else {
+      hash = HASH_PRIME_5;
+    } /* if */
+    hash += (uint32Type) len;
+    for (; mem < beyond; mem++) {
+      hash = HASH_ROTL(hash + (uint32Type) *mem * HASH_PRIME_3, 17) * HASH_PRIME_4;
+    } /* for */
+    return hashAvalanche(hash);
+  } /* hash_strelem */
+
+
+
+/**
+ *  Compute the hash value of a string with bytes as characters.
+ *  Each byte is handled like a character of hash_strelem().
+ *  This way the result is identical to the hash value of a string
+ *  with the same characters. The compiler relies on this, when it
+ *  computes hash codes of element names at compile time.
+ *  @param ustri Characters of the string as bytes.
+ *  @param len Number of bytes.
+ *  @return the hash value (identical on all platforms).
+ */
+uint32Type hash_ustri_chars (const_ustriType ustri, memSizeType len)
+
+  {
+    const_ustriType beyond;
+    uint32Type lane1;
+    uint32Type lane2;
+    uint32Type lane3;
+    uint32Type lane4;
+    uint32Type hash;
+
+  /* hash_ustri_chars */
+    beyond = &ustri[len];
+    if (len >= 4) {
+      lane1 = HASH_PRIME_1 + HASH_PRIME_2;
+      lane2 = HASH_PRIME_2;
+      lane3 = 0;
+      lane4 = (uint32Type) 0 - HASH_PRIME_1;
+      for (; beyond - ustri >= 4; ustri += 4) {
+        lane1 = HASH_ROUND(lane1, (uint32Type) ustri[0]);
+        lane2 = HASH_ROUND(lane2, (uint32Type) ustri[1]);
+        lane3 = HASH_ROUND(lane3, (uint32Type) ustri[2]);
+        lane4 = HASH_ROUND(lane4, (uint32Type) ustri[3]);
+      } /* for */
+      hash = HASH_ROTL(lane1, 1) + HASH_ROTL(lane2, 7) +
+             HASH_ROTL(lane3, 12) + HASH_ROTL(lane4, 18);
+    } else {
+      hash = HASH_PRIME_5;
+    } /* if */
+    hash += (uint32Type) len;
+    for (; ustri < beyond; ustri++) {
+      hash = HASH_ROTL(hash + (uint32Type) *ustri * HASH_PRIME_3, 17) * HASH_PRIME_4;
+    } /* for */
+    return hashAvalanche(hash);
+  } /* hash_ustri_chars */
+
+
+
+/**
+ *  Compute a hash value from all bytes of a byte string.
+ *  Groups of four bytes are combined to little endian words, such
+ *  that the result does not depend on the byte order of the machine.
+ *  @param ustri Bytes of the byte string.
+ *  @param len Number of bytes.
+ *  @return the hash value (identical on all platforms).
+ */
+uint32Type hash_ustri (const_ustriType ustri, memSizeType len)
+
+  {
+    const_ustriType beyond;
+    uint32Type lane1;
+    uint32Type lane2;
+    uint32Type lane3;
+    uint32Type lane4;
+    uint32Type hash;
+
+  /* hash_ustri */
+    beyond = &ustri[len];
+    if (len >= 16) {
+      lane1 = HASH_PRIME_1 + HASH_PRIME_2;
+      lane2 = HASH_PRIME_2;
+      lane3 = 0;
+      lane4 = (uint32Type) 0 - HASH_PRIME_1;
+      for (; beyond - ustri >= 16; ustri += 16) {
+        lane1 = HASH_ROUND(lane1, ((uint32Type) ustri[0] |
+            (uint32Type) ustri[1] << 8 | (uint32Type) ustri[2] << 16 |
+            (uint32Type) ustri[3] << 24));
+        lane2 = HASH_ROUND(lane2, ((uint32Type) ustri[4] |
+            (uint32Type) ustri[5] << 8 | (uint32Type) ustri[6] << 16 |
+            (uint32Type) ustri[7] << 24));
+        lane3 = HASH_ROUND(lane3, ((uint32Type) ustri[8] |
+            (uint32Type) ustri[9] << 8 | (uint32Type) ustri[10] << 16 |
+            (uint32Type) ustri[11] << 24));
+        lane4 = HASH_ROUND(lane4, ((uint32Type) ustri[12] |
+            (uint32Type) ustri[13] << 8 | (uint32Type) ustri[14] << 16 |
+            (uint32Type) ustri[15] << 24));
+      } /* for */
+      hash = HASH_ROTL(lane1, 1) + HASH_ROTL(lane2, 7) +
+             HASH_ROTL(lane3, 12) + HASH_ROTL(lane4, 18);
+    } else {
+      hash = HASH_PRIME_5;
+    } /* if */
+    hash += (uint32Type) len;
+    for (; ustri < beyond; ustri++) {
+      hash = HASH_ROTL(hash + (uint32Type) *ustri * HASH_PRIME_5, 11) * HASH_PRIME_1;
+    } /* for */
+    return hashAvalanche(hash);
+  } /* hash_ustri */
+
+
+
 #if STACK_LIKE_ALLOC_FOR_OS_STRI
 os_striType heapAllocOsStri (memSizeType len)
 
@@ -742,6 +916,159 @@ void heapFreeOsStri (const_os_striType var)
 
 
 
+/**
+ *  Copy the ASCII characters at the beginning of an UTF-8 string.
+ *  With SSE2 16 bytes and otherwise a machine word of bytes are
+ *  checked with one test. This way long runs of ASCII characters
+ *  are converted without a branch per byte.
+ *  @param dest Destination of the UTF-32 encoded characters.
+ *  @param ustri UTF-8 encoded string that starts with ASCII characters.
+ *  @param len Number of bytes in ustri.
+ *  @return the number of ASCII characters copied to 'dest'.
+ */
+static inline memSizeType copy_ascii_bytes (strElemType *const dest,
+    const const_ustriType ustri, const memSizeType len)
+
+  {
+#if HAS_SSE2_INTRINSICS
+    __m128i bytes;
+    __m128i halfs;
+    __m128i zero;
+#endif
+    memSizeType word;
+    memSizeType idx;
+    memSizeType pos = 0;
+
+  /* copy_ascii_bytes */
+#if HAS_SSE2_INTRINSICS
+    zero = _mm_setzero_si128();
+    while (len - pos >= 16) {
+      bytes = _mm_loadu_si128((const __m128i *) &ustri[pos]);
+      if (_mm_movemask_epi8(bytes) != 0) {
+        break;
+      } /* if */
+      halfs = _mm_unpacklo_epi8(bytes, zero);
+      _mm_storeu_si128((__m128i *) &dest[pos],      _mm_unpacklo_epi16(halfs, zero));
+      _mm_storeu_si128((__m128i *) &dest[pos +  4], _mm_unpackhi_epi16(halfs, zero));
+      halfs = _mm_unpackhi_epi8(bytes, zero);
+      _mm_storeu_si128((__m128i *) &dest[pos +  8], _mm_unpacklo_epi16(halfs, zero));
+      _mm_storeu_si128((__m128i *) &dest[pos + 12], _mm_unpackhi_epi16(halfs, zero));
+      pos += 16;
+    } /* while */
+#endif
+    while (len - pos >= sizeof(memSizeType)) {
+      memcpy(&word, &ustri[pos], sizeof(memSizeType));
+      if ((word & ASCII_HIGH_BITS) != 0) {
+        break;
+      } /* if */
+      for (idx = 0; idx < sizeof(memSizeType); idx++) {
+        dest[pos + idx] = (strElemType) ustri[pos + idx];
+      } /* for */
+      pos += sizeof(memSizeType);
+    } /* while */
+    while (pos < len && ustri[pos] <= 0x7F) {
+      dest[pos] = (strElemType) ustri[pos];
+      pos++;
+    } /* while */
+    return pos;
+  } /* copy_ascii_bytes */
+
+
+
+/**
+ *  Copy the ASCII characters at the beginning of an UTF-32 string.
+ *  Four characters are checked with one test. This way long runs of
+ *  ASCII characters are copied without a branch per character.
+ *  @param dest Destination of the copied characters.
+ *  @param strelem UTF-32 encoded string that starts with ASCII characters.
+ *  @param len Number of UTF-32 characters in strelem.
+ *  @return the number of ASCII characters copied to 'dest'.
+ */
+static inline memSizeType copy_ascii_strelems (strElemType *const dest,
+    const strElemType *const strelem, const memSizeType len)
+
+  {
+    memSizeType pos = 0;
+
+  /* copy_ascii_strelems */
+    while (len - pos >= 4 &&
+           (strelem[pos]     | strelem[pos + 1] |
+            strelem[pos + 2] | strelem[pos + 3]) <= 0x7F) {
+      dest[pos]     = strelem[pos];
+      dest[pos + 1] = strelem[pos + 1];
+      dest[pos + 2] = strelem[pos + 2];
+      dest[pos + 3] = strelem[pos + 3];
+      pos += 4;
+    } /* while */
+    while (pos < len && strelem[pos] <= 0x7F) {
+      dest[pos] = strelem[pos];
+      pos++;
+    } /* while */
+    return pos;
+  } /* copy_ascii_strelems */
+
+
+
+/**
+ *  Copy the ASCII characters at the beginning of an UTF-32 string to bytes.
+ *  Several characters are checked with one test. This way long runs
+ *  of ASCII characters are converted without a branch per character.
+ *  @param out_stri Destination of the UTF-8 encoded bytes.
+ *  @param strelem UTF-32 encoded string that starts with ASCII characters.
+ *  @param len Number of UTF-32 characters in strelem.
+ *  @return the number of ASCII characters copied to 'out_stri'.
+ */
+static inline memSizeType copy_ascii_to_bytes (const ustriType out_stri,
+    const strElemType *const strelem, const memSizeType len)
+
+  {
+#if HAS_SSE2_INTRINSICS
+    __m128i quad0;
+    __m128i quad1;
+    __m128i quad2;
+    __m128i quad3;
+    __m128i nonAsciiBits;
+    __m128i zero;
+#endif
+    memSizeType pos = 0;
+
+  /* copy_ascii_to_bytes */
+#if HAS_SSE2_INTRINSICS
+    nonAsciiBits = _mm_set1_epi32(~0x7F);
+    zero = _mm_setzero_si128();
+    while (len - pos >= 16) {
+      quad0 = _mm_loadu_si128((const __m128i *) &strelem[pos]);
+      quad1 = _mm_loadu_si128((const __m128i *) &strelem[pos +  4]);
+      quad2 = _mm_loadu_si128((const __m128i *) &strelem[pos +  8]);
+      quad3 = _mm_loadu_si128((const __m128i *) &strelem[pos + 12]);
+      if (_mm_movemask_epi8(_mm_cmpeq_epi32(_mm_and_si128(
+          _mm_or_si128(_mm_or_si128(quad0, quad1), _mm_or_si128(quad2, quad3)),
+          nonAsciiBits), zero)) != 0xFFFF) {
+        break;
+      } /* if */
+      _mm_storeu_si128((__m128i *) &out_stri[pos], _mm_packus_epi16(
+          _mm_packs_epi32(quad0, quad1), _mm_packs_epi32(quad2, quad3)));
+      pos += 16;
+    } /* while */
+#endif
+    while (len - pos >= 4 &&
+           (strelem[pos]     | strelem[pos + 1] |
+            strelem[pos + 2] | strelem[pos + 3]) <= 0x7F) {
+      out_stri[pos]     = (ucharType) strelem[pos];
+      out_stri[pos + 1] = (ucharType) strelem[pos + 1];
+      out_stri[pos + 2] = (ucharType) strelem[pos + 2];
+      out_stri[pos + 3] = (ucharType) strelem[pos + 3];
+      pos += 4;
+    } /* while */
+    while (pos < len && strelem[pos] <= 0x7F) {
+      out_stri[pos] = (ucharType) strelem[pos];
+      pos++;
+    } /* while */
+    return pos;
+  } /* copy_ascii_to_bytes */
+
+
+
 /**
  *  Convert an UTF-8 encoded string to an UTF-32 encoded string.
  *  The memory for the destination dest_stri is not allocated.
@@ -757,12 +1084,16 @@ memSizeType stri8_to_stri (strElemType *const dest_stri,
 
   {
     strElemType *stri;
+    memSizeType ascii;
 
   /* stri8_to_stri */
     stri = dest_stri;
     for (; len > 0; len--) {
       if (*stri8 <= 0x7F) {
-        *stri++ = (strElemType) *stri8++;
+        ascii = copy_ascii_strelems(stri, stri8, len);
+        stri += ascii;
+        stri8 += ascii;
+        len -= ascii - 1;
       } else if (stri8[0] >= 0xC0 && stri8[0] <= 0xDF && len >= 2 &&
                  stri8[1] >= 0x80 && stri8[1] <= 0xBF) {
         /* stri8[0]   range 192 to 223 (leading bits 110.....) */
@@ -852,12 +1183,16 @@ memSizeType utf8_to_stri (strElemType *const dest_stri,
 
   {
     strElemType *stri;
+    memSizeType ascii;
 
   /* utf8_to_stri */
     stri = dest_stri;
     for (; len > 0; len--) {
       if (*ustri <= 0x7F) {
-        *stri++ = (strElemType) *ustri++;
+        ascii = copy_ascii_bytes(stri, ustri, len);
+        stri += ascii;
+        ustri += ascii;
+        len -= ascii - 1;
       } else if (ustri[0] >= 0xC0 && ustri[0] <= 0xDF && len >= 2 &&
                  ustri[1] >= 0x80 && ustri[1] <= 0xBF) {
         /* ustri[0]   range 192 to 223 (leading bits 110.....) */
@@ -1039,13 +1374,17 @@ memSizeType stri_to_utf8 (const ustriType out_stri,
   {
     register ustriType ustri;
     register strElemType ch;
+    memSizeType ascii;
 
   /* stri_to_utf8 */
     ustri = out_stri;
     for (; len > 0; strelem++, len--) {
       ch = *strelem;
       if (ch <= 0x7F) {
-        *ustri++ = (ucharType) ch;
+        ascii = copy_ascii_to_bytes(ustri, strelem, len);
+        ustri += ascii;
+        strelem += ascii - 1;
+        len -= ascii - 1;
       } else if (ch <= 0x7FF) {
         ustri[0] = (ucharType) (0xC0 | (ch >>  6));
         ustri[1] = (ucharType) (0x80 |( ch        & 0x3F));
@@ -1,7 +1,7 @@
 /********************************************************************/
 /*                                                                  */
 /*  striutl.h     Functions to work with wide char strings.         */
-/*  Copyright (C) 1989 - 2015  Thomas Mertes                        */
+/*  Copyright (C) 1989 - 2015, 2026  Thomas Mertes                  */
 /*                                                                  */
 /*  This file is part of the Seed7 Runtime Library.                 */
 /*                                                                  */
@@ -24,7 +24,7 @@
 /*                                                                  */
 /*  Module: Seed7 Runtime Library                                   */
 /*  File: seed7/src/striutl.h                                       */
-/*  Changes: 1991 - 1994, 2005 - 2015  Thomas Mertes                */
+/*  Changes: 1991 - 1994, 2005 - 2015, 2026  Thomas Mertes          */
 /*  Content: Functions to work with wide char strings.              */
 /*                                                                  */
 /********************************************************************/
@@ -225,6 +225,9 @@ boolType memcpy_from_strelem (register const ustriType dest,
 const strElemType *memchr_strelem (register const strElemType *mem,
     const strElemType ch, memSizeType len);
 #endif
+uint32Type hash_strelem (const strElemType *mem, memSizeType len);
+uint32Type hash_ustri_chars (const_ustriType ustri, memSizeType len);
+uint32Type hash_ustri (const_ustriType ustri, memSizeType len);
 #if STACK_LIKE_ALLOC_FOR_OS_STRI
 os_striType heapAllocOsStri (memSizeType len);
 void heapFreeOsStri (const_os_striType var);
@@ -2,7 +2,7 @@
 /*                                                                  */
 /*  s7   Seed7 interpreter                                          */
 /*  Copyright (C) 1990 - 2008, 2010, 2013 - 2021  Thomas Mertes     */
-/*                2023 - 2025  Thomas Mertes                        */
+/*                2023 - 2025, 2026  Thomas Mertes                  */
 /*                                                                  */
 /*  This program is free software; you can redistribute it and/or   */
 /*  modify it under the terms of the GNU General Public License as  */
@@ -22,7 +22,7 @@
 /*  Module: Library                                                 */
 /*  File: seed7/src/strlib.c                                        */
 /*  Changes: 1991 - 1994, 2008, 2010, 2013 - 2021  Thomas Mertes    */
-/*           2023 - 2025  Thomas Mertes                             */
+/*           2023 - 2025, 2026  Thomas Mertes                       */
 /*  Content: All primitive actions for the string type.             */
 /*                                                                  */
 /********************************************************************/
@@ -49,6 +49,7 @@
 #include "exec.h"
 #include "runerr.h"
 #include "str_rtl.h"
+#include "dfl_rtl.h"
 #include "rtl_err.h"
 
 #undef EXTERN
@@ -597,6 +598,22 @@ objectType str_c_literal (listType arguments)
 
 
 
+/**
+ *  Compress a string with the DEFLATE algorithm.
+ *  The result is raw DEFLATE data without zlib or gzip header.
+ *  @return a string of bytes with the deflated data.
+ *  @exception RANGE_ERROR If characters beyond '\255;' are present.
+ */
+objectType str_deflate (listType arguments)
+
+  { /* str_deflate */
+    isit_stri(arg_1(arguments));
+    return bld_stri_temp(
+        dflDeflate(take_stri(arg_1(arguments))));
+  } /* str_deflate */
+
+
+
 /**
  *  Free the memory referred by 'old_string/arg_1'.
  *  After str_destr is left 'old_string/arg_1' is NULL.
@@ -874,7 +891,7 @@ objectType str_hashcode (listType arguments)
                 printf(")\n"););
     isit_stri(arg_1(arguments));
     stri = take_stri(arg_1(arguments));
-    return bld_int_temp(hashCode(stri));
+    return bld_int_temp(strHashCode(stri));
   } /* str_hashcode */
 
 
@@ -978,6 +995,56 @@ objectType str_idx (listType arguments)
 
 
 
+/**
+ *  Decompress DEFLATE data from 'compressed' starting at 'position'.
+ *  Afterwards 'position' refers to the byte after the compressed data.
+ *  @return the uncompressed string.
+ *  @exception INDEX_ERROR If 'position' is not in the range
+ *                         1 .. length(compressed) + 1.
+ *  @exception RANGE_ERROR If 'compressed' is not in DEFLATE format.
+ */
+objectType str_inflate (listType arguments)
+
+  {
+    objectType position_var;
+
+  /* str_inflate */
+    isit_stri(arg_1(arguments));
+    position_var = arg_2(arguments);
+    isit_int(position_var);
+    is_variable(position_var);
+    return bld_stri_temp(
+        dflInflate(take_stri(arg_1(arguments)),
+                   &position_var->value.intValue, FALSE));
+  } /* str_inflate */
+
+
+
+/**
+ *  Decompress DEFLATE64 data from 'compressed' starting at 'position'.
+ *  Afterwards 'position' refers to the byte after the compressed data.
+ *  @return the uncompressed string.
+ *  @exception INDEX_ERROR If 'position' is not in the range
+ *                         1 .. length(compressed) + 1.
+ *  @exception RANGE_ERROR If 'compressed' is not in DEFLATE64 format.
+ */
+objectType str_inflate64 (listType arguments)
+
+  {
+    objectType position_var;
+
+  /* str_inflate64 */
+    isit_stri(arg_1(arguments));
+    position_var = arg_2(arguments);
+    isit_int(position_var);
+    is_variable(position_var);
+    return bld_stri_temp(
+        dflInflate(take_stri(arg_1(arguments)),
+                   &position_var->value.intValue, TRUE));
+  } /* str_inflate64 */
+
+
+
 /**
  *  Search string 'searched' in 'mainStri' at or after 'fromIndex'.
  *  The search starts at 'fromIndex' and proceeds to the right.
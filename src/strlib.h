@@ -34,6 +34,7 @@ objectType str_cmp           (listType arguments);
 objectType str_cpy           (listType arguments);
 objectType str_create        (listType arguments);
 objectType str_c_literal     (listType arguments);
+objectType str_deflate       (listType arguments);
 objectType str_destr         (listType arguments);
 objectType str_elemcpy       (listType arguments);
 objectType str_eq            (listType arguments);
@@ -46,6 +47,8 @@ objectType str_gt            (listType arguments);
 objectType str_hashcode      (listType arguments);
 objectType str_head          (listType arguments);
 objectType str_idx           (listType arguments);
+objectType str_inflate       (listType arguments);
+objectType str_inflate64     (listType arguments);
 objectType str_ipos          (listType arguments);
 objectType str_le            (listType arguments);
 objectType str_literal       (listType arguments);
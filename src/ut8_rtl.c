@@ -1,7 +1,7 @@
 /********************************************************************/
 /*                                                                  */
 /*  ut8_rtl.c     Primitive actions for the UTF-8 file type.        */
-/*  Copyright (C) 1989 - 2015, 2018  Thomas Mertes                  */
+/*  Copyright (C) 1989 - 2015, 2018, 2026  Thomas Mertes            */
 /*                                                                  */
 /*  This file is part of the Seed7 Runtime Library.                 */
 /*                                                                  */
@@ -24,7 +24,7 @@
 /*                                                                  */
 /*  Module: Seed7 Runtime Library                                   */
 /*  File: seed7/src/ut8_rtl.c                                       */
-/*  Changes: 2005, 2010, 2013, 2014  Thomas Mertes                  */
+/*  Changes: 2005, 2010, 2013, 2014, 2026  Thomas Mertes            */
 /*  Content: Primitive actions for the UTF-8 file type.             */
 /*                                                                  */
 /********************************************************************/
@@ -56,8 +56,6 @@
 #define BUFFER_SIZE             2048
 #define GETS_DEFAULT_SIZE    1048576
 #define GETS_STRI_SIZE_DELTA    4096
-#define READ_STRI_INIT_SIZE      256
-#define READ_STRI_SIZE_DELTA    2048
 #define WRITE_STRI_BLOCK_SIZE    512
 
 
@@ -689,14 +687,11 @@ striType ut8LineRead (fileType inFile, charType *const terminationChar)
 
   {
     cFileType cInFile;
-    register int ch;
-    register memSizeType position;
-    ucharType *memory;
-    memSizeType memlength;
-    memSizeType newmemlength;
-    bstriType resized_buffer;
+    int ch;
     bstriType buffer;
+    memSizeType length;
     memSizeType result_size;
+    errInfoType err_info = OKAY_NO_ERROR;
     striType resized_result;
     striType result;
 
@@ -719,72 +714,38 @@ striType ut8LineRead (fileType inFile, charType *const terminationChar)
       result = NULL;
 #endif
     } else {
-      memlength = READ_STRI_INIT_SIZE;
-      if (unlikely(!ALLOC_BSTRI_SIZE_OK(buffer, memlength))) {
-        raise_error(MEMORY_ERROR);
+      buffer = readDelimitedBytes(cInFile, (int) '\n', &ch, &err_info);
+      if (unlikely(buffer == NULL)) {
+        raise_error(err_info);
         result = NULL;
       } else {
-        memory = buffer->mem;
-        position = 0;
-        flockfile(cInFile);
-        while ((ch = getc_unlocked(cInFile)) != (int) '\n' && ch != EOF) {
-          if (position >= memlength) {
-            newmemlength = memlength + READ_STRI_SIZE_DELTA;
-            REALLOC_BSTRI_CHECK_SIZE(resized_buffer, buffer, memlength, newmemlength);
-            if (unlikely(resized_buffer == NULL)) {
-              FREE_BSTRI(buffer, memlength);
-              funlockfile(cInFile);
-              raise_error(MEMORY_ERROR);
-              return NULL;
-            } /* if */
-            buffer = resized_buffer;
-            COUNT3_BSTRI(memlength, newmemlength);
-            memory = buffer->mem;
-            memlength = newmemlength;
-          } /* if */
-          memory[position++] = (ucharType) ch;
-        } /* while */
-        funlockfile(cInFile);
-        if (ch == (int) '\n' && position != 0 && memory[position - 1] == '\r') {
-          position--;
+        length = buffer->size;
+        if (ch == (int) '\n' && length != 0 && buffer->mem[length - 1] == '\r') {
+          length--;
         } /* if */
-        if (unlikely(ch == EOF && position == 0 && ferror(cInFile))) {
-          FREE_BSTRI(buffer, memlength);
+        if (unlikely(!ALLOC_STRI_CHECK_SIZE(result, length))) {
+          raise_error(MEMORY_ERROR);
+        } else if (unlikely(utf8_to_stri(result->mem, &result_size,
+                                         buffer->mem, length) != 0)) {
+          FREE_STRI2(result, length);
           logError(printf("ut8LineRead(%d, '\\" FMT_U32 ";'): "
-                          "getc_unlocked(%d) failed:\n"
-                          "errno=%d\nerror: %s\n",
-                          safe_fileno(cInFile), *terminationChar,
-                          safe_fileno(cInFile), errno, strerror(errno)););
-          raise_error(FILE_ERROR);
+                          "The file contains an invalid encoding.\n",
+                          safe_fileno(cInFile), *terminationChar););
+          raise_error(RANGE_ERROR);
           result = NULL;
         } else {
-          if (unlikely(!ALLOC_STRI_CHECK_SIZE(result, position))) {
-            FREE_BSTRI(buffer, memlength);
+          REALLOC_STRI_SIZE_OK2(resized_result, result, length, result_size);
+          if (unlikely(resized_result == NULL)) {
+            FREE_STRI2(result, length);
             raise_error(MEMORY_ERROR);
+            result = NULL;
           } else {
-            if (unlikely(utf8_to_stri(result->mem, &result_size, buffer->mem, position) != 0)) {
-              FREE_BSTRI(buffer, memlength);
-              FREE_STRI2(result, position);
-              logError(printf("ut8LineRead(%d, '\\" FMT_U32 ";'): "
-                              "The file contains an invalid encoding.\n",
-                              safe_fileno(cInFile), *terminationChar););
-              raise_error(RANGE_ERROR);
-              result = NULL;
-            } else {
-              FREE_BSTRI(buffer, memlength);
-              REALLOC_STRI_SIZE_OK2(resized_result, result, position, result_size);
-              if (unlikely(resized_result == NULL)) {
-                FREE_STRI2(result, position);
-                raise_error(MEMORY_ERROR);
-                result = NULL;
-              } else {
-                result = resized_result;
-                result->size = result_size;
-                *terminationChar = (charType) ch;
-              } /* if */
-            } /* if */
+            result = resized_result;
+            result->size = result_size;
+            *terminationChar = (charType) ch;
           } /* if */
         } /* if */
+        FREE_BSTRI(buffer, buffer->size);
       } /* if */
     } /* if */
     logFunction(printf("ut8LineRead(%d, '\\" FMT_U32 ";') --> \"%s\"\n",
@@ -904,14 +865,11 @@ striType ut8WordRead (fileType inFile, charType *const terminationChar)
 
   {
     cFileType cInFile;
-    register int ch;
-    register memSizeType position;
-    ucharType *memory;
-    memSizeType memlength;
-    memSizeType newmemlength;
-    bstriType resized_buffer;
+    int ch;
     bstriType buffer;
+    memSizeType length;
     memSizeType result_size;
+    errInfoType err_info = OKAY_NO_ERROR;
     striType resized_result;
     striType result;
 
@@ -934,77 +892,38 @@ striType ut8WordRead (fileType inFile, charType *const terminationChar)
       result = NULL;
 #endif
     } else {
-      memlength = READ_STRI_INIT_SIZE;
-      if (unlikely(!ALLOC_BSTRI_SIZE_OK(buffer, memlength))) {
-        raise_error(MEMORY_ERROR);
+      buffer = readDelimitedBytes(cInFile, READ_WORD_DELIMITERS, &ch, &err_info);
+      if (unlikely(buffer == NULL)) {
+        raise_error(err_info);
         result = NULL;
       } else {
-        memory = buffer->mem;
-        position = 0;
-        flockfile(cInFile);
-        do {
-          ch = getc_unlocked(cInFile);
-        } while (ch == (int) ' ' || ch == (int) '\t');
-        while (ch != (int) ' ' && ch != (int) '\t' &&
-            ch != (int) '\n' && ch != EOF) {
-          if (position >= memlength) {
-            newmemlength = memlength + READ_STRI_SIZE_DELTA;
-            REALLOC_BSTRI_CHECK_SIZE(resized_buffer, buffer, memlength, newmemlength);
-            if (unlikely(resized_buffer == NULL)) {
-              FREE_BSTRI(buffer, memlength);
-              funlockfile(cInFile);
-              raise_error(MEMORY_ERROR);
-              return NULL;
-            } /* if */
-            buffer = resized_buffer;
-            COUNT3_BSTRI(memlength, newmemlength);
-            memory = buffer->mem;
-            memlength = newmemlength;
-          } /* if */
-          memory[position++] = (ucharType) ch;
-          ch = getc_unlocked(cInFile);
-        } /* while */
-        funlockfile(cInFile);
-        if (ch == (int) '\n' && position != 0 && memory[position - 1] == '\r') {
-          position--;
+        length = buffer->size;
+        if (ch == (int) '\n' && length != 0 && buffer->mem[length - 1] == '\r') {
+          length--;
         } /* if */
-        if (unlikely(ch == EOF && position == 0 && ferror(cInFile))) {
-          FREE_BSTRI(buffer, memlength);
+        if (unlikely(!ALLOC_STRI_CHECK_SIZE(result, length))) {
+          raise_error(MEMORY_ERROR);
+        } else if (unlikely(utf8_to_stri(result->mem, &result_size,
+                                         buffer->mem, length) != 0)) {
+          FREE_STRI2(result, length);
           logError(printf("ut8WordRead(%d, '\\" FMT_U32 ";'): "
-                          "getc_unlocked(%d) failed:\n"
-                          "errno=%d\nerror: %s\n",
-                          safe_fileno(cInFile), *terminationChar,
-                          safe_fileno(cInFile), errno, strerror(errno)););
-          raise_error(FILE_ERROR);
+                          "The file contains an invalid encoding.\n",
+                          safe_fileno(cInFile), *terminationChar););
+          raise_error(RANGE_ERROR);
           result = NULL;
         } else {
-          if (unlikely(!ALLOC_STRI_CHECK_SIZE(result, position))) {
-            FREE_BSTRI(buffer, memlength);
+          REALLOC_STRI_SIZE_OK2(resized_result, result, length, result_size);
+          if (unlikely(resized_result == NULL)) {
+            FREE_STRI2(result, length);
             raise_error(MEMORY_ERROR);
+            result = NULL;
           } else {
-            if (unlikely(utf8_to_stri(result->mem, &result_size, buffer->mem, position) != 0)) {
-              FREE_BSTRI(buffer, memlength);
-              FREE_STRI2(result, position);
-              logError(printf("ut8WordRead(%d, '\\" FMT_U32 ";'): "
-                              "The file contains an invalid encoding.\n",
-                              safe_fileno(cInFile), *terminationChar););
-              raise_error(RANGE_ERROR);
-              result = NULL;
-            } else {
-              FREE_BSTRI(buffer, memlength);
-              REALLOC_STRI_SIZE_OK2(resized_result, result, position, result_size);
-              if (unlikely(resized_result == NULL)) {
-                FREE_STRI2(result, position);
-                raise_error(MEMORY_ERROR);
-                result = NULL;
-              } else {
-                result = resized_result;
-                result->size = result_size;
-                *terminationChar = (charType) ch;
-              } /* if */
-            } /* if */
+            result = resized_result;
+            result->size = result_size;
+            *terminationChar = (charType) ch;
           } /* if */
         } /* if */
+        FREE_BSTRI(buffer, buffer->size);
       } /* if */
     } /* if */
     logFunction(printf("ut8WordRead(%d, '\\" FMT_U32 ";') --> \"%s\"\n",